@@ -29,6 +29,7 @@ EXPERIMENTS = {
             "promise_based_client_call",
             "promise_based_server_call",
             "work_stealing",
+            "work_serializer_time_slice",
         ],
         "cpp_end2end_test": [
             "promise_based_server_call",
@@ -43,6 +44,9 @@ EXPERIMENTS = {
         "event_engine_listener_test": [
             "event_engine_listener",
         ],
+        "event_engine_timer_test": [
+            "timer_wheel",
+        ],
         "flow_control_test": [
             "peer_state_based_framing",
             "tcp_frame_size_tuning",
@@ -56,6 +60,9 @@ EXPERIMENTS = {
             "memory_pressure_controller",
             "unconstrained_max_quota_buffer_size",
         ],
+        "work_serializer_test": [
+            "work_serializer_time_slice",
+        ],
         "xds_end2end_test": [
             "promise_based_server_call",
         ],
@@ -265,10 +265,13 @@
         'upb',
       ],
       'sources': [
+        'src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc',
         'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
         'src/core/ext/filters/channel_idle/idle_filter_state.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle_filter.cc',
         'src/core/ext/filters/client_channel/backend_metric.cc',
         'src/core/ext/filters/client_channel/backup_poller.cc',
         'src/core/ext/filters/client_channel/channel_connectivity.cc',
@@ -289,8 +292,10 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/health_check_client.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+        'src/core/ext/filters/client_channel/lb_policy/peak_ewma/peak_ewma.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
@@ -446,6 +451,7 @@
         'src/core/ext/upb-generated/envoy/extensions/http/stateful_session/cookie/v3/cookie.upb.c',
         'src/core/ext/upb-generated/envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.upb.c',
         'src/core/ext/upb-generated/envoy/extensions/load_balancing_policies/common/v3/common.upb.c',
+        'src/core/ext/upb-generated/envoy/extensions/load_balancing_policies/least_request/v3/least_request.upb.c',
         'src/core/ext/upb-generated/envoy/extensions/load_balancing_policies/ring_hash/v3/ring_hash.upb.c',
         'src/core/ext/upb-generated/envoy/extensions/load_balancing_policies/wrr_locality/v3/wrr_locality.upb.c',
         'src/core/ext/upb-generated/envoy/extensions/transport_sockets/tls/v3/cert.upb.c',
@@ -948,6 +954,7 @@
         'src/core/lib/security/security_connector/ssl_utils.cc',
         'src/core/lib/security/security_connector/tls/tls_security_connector.cc',
         'src/core/lib/security/transport/client_auth_filter.cc',
+        'src/core/lib/security/transport/handshake_offload_pool.cc',
         'src/core/lib/security/transport/secure_endpoint.cc',
         'src/core/lib/security/transport/security_handshaker.cc',
         'src/core/lib/security/transport/server_auth_filter.cc',
@@ -1026,6 +1033,7 @@
         'src/core/tsi/ssl/session_cache/ssl_session_boringssl.cc',
         'src/core/tsi/ssl/session_cache/ssl_session_cache.cc',
         'src/core/tsi/ssl/session_cache/ssl_session_openssl.cc',
+        'src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.cc',
         'src/core/tsi/ssl_transport_security.cc',
         'src/core/tsi/ssl_transport_security_utils.cc',
         'src/core/tsi/transport_security.cc',
@@ -1095,10 +1103,13 @@
         'upb',
       ],
       'sources': [
+        'src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.cc',
         'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
         'src/core/ext/filters/channel_idle/idle_filter_state.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle_filter.cc',
         'src/core/ext/filters/client_channel/backend_metric.cc',
         'src/core/ext/filters/client_channel/backup_poller.cc',
         'src/core/ext/filters/client_channel/channel_connectivity.cc',
@@ -1119,8 +1130,10 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/health_check_client.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+        'src/core/ext/filters/client_channel/lb_policy/peak_ewma/peak_ewma.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
@@ -1409,6 +1422,7 @@
         'src/core/lib/security/security_connector/load_system_roots_supported.cc',
         'src/core/lib/security/security_connector/security_connector.cc',
         'src/core/lib/security/transport/client_auth_filter.cc',
+        'src/core/lib/security/transport/handshake_offload_pool.cc',
         'src/core/lib/security/transport/secure_endpoint.cc',
         'src/core/lib/security/transport/security_handshaker.cc',
         'src/core/lib/security/transport/server_auth_filter.cc',
@@ -1928,6 +1942,7 @@
         'src/core/lib/security/security_connector/load_system_roots_supported.cc',
         'src/core/lib/security/security_connector/security_connector.cc',
         'src/core/lib/security/transport/client_auth_filter.cc',
+        'src/core/lib/security/transport/handshake_offload_pool.cc',
         'src/core/lib/security/transport/secure_endpoint.cc',
         'src/core/lib/security/transport/security_handshaker.cc',
         'src/core/lib/security/transport/server_auth_filter.cc',
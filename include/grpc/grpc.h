@@ -580,6 +580,15 @@ GRPCAPI char* grpc_channelz_get_subchannel(intptr_t subchannel_id);
    is allocated and must be freed by the application. */
 GRPCAPI char* grpc_channelz_get_socket(intptr_t socket_id);
 
+/* EXPERIMENTAL - Subject to change.
+   Returns the process-wide gRPC core stats (counters such as syscall_write
+   and histograms such as tcp_write_size) in the Prometheus text exposition
+   format, for applications that serve a metrics endpoint. The metric names
+   follow gRPC's internal stats and may change between releases. Reading the
+   stats does not block threads that are updating them. The returned string
+   is allocated and must be freed by the application. */
+GRPCAPI char* grpc_stats_get_prometheus_text(void);
+
 /**
  * EXPERIMENTAL - Subject to change.
  * Fetch a vtable for grpc_channel_arg that points to
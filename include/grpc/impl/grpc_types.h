@@ -144,6 +144,16 @@ typedef struct {
 /** If non-zero, call metric recording is enabled. */
 #define GRPC_ARG_SERVER_CALL_METRIC_RECORDING \
   "grpc.server_call_metric_recording"
+/** If non-zero, the server estimates how many calls it can have in flight
+    from their latency, and fails calls beyond that with RESOURCE_EXHAUSTED. */
+#define GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT \
+  "grpc.server_adaptive_concurrency_limit"
+/** Bounds on the adaptive concurrency limit. Int valued; default 10 and
+    1000. */
+#define GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MIN_LIMIT \
+  "grpc.server_adaptive_concurrency_min_limit"
+#define GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MAX_LIMIT \
+  "grpc.server_adaptive_concurrency_max_limit"
 /** Request that optional features default to off (regardless of what they
     usually default to) - to enable tight control over what gets enabled */
 #define GRPC_ARG_MINIMAL_STACK "grpc.minimal_stack"
@@ -184,6 +194,11 @@ typedef struct {
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
+/** Granularity, in milliseconds, at which call deadlines on a channel are
+    enforced. Deadlines are rounded up to a multiple of this value so that
+    calls expiring close together share a single timer wakeup, at the cost of
+    being cancelled up to this much late. Defaults to 0 (exact). */
+#define GRPC_ARG_DEADLINE_TIMER_SLACK_MS "grpc.deadline_timer_slack_ms"
 /** Initial stream ID for http2 transports. Int valued. */
 #define GRPC_ARG_HTTP2_INITIAL_SEQUENCE_NUMBER \
   "grpc.http2.initial_sequence_number"
@@ -204,6 +219,12 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** If non-zero, size HTTP/2 flow control windows BBR-style from the measured
+    delivery rate and min round trip time, instead of from a PID-smoothed BDP
+    estimate. This ramps up faster on high bandwidth-delay links. Only
+    effective when BDP probing is enabled. Defaults to 0. */
+#define GRPC_ARG_HTTP2_DELIVERY_RATE_FLOW_CONTROL \
+  "grpc.http2.delivery_rate_flow_control"
 /** (DEPRECATED) Does not have any effect.
     Earlier, this arg configured the minimum time between successive ping frames
     without receiving any data/header frame, Int valued, milliseconds. This put
@@ -234,6 +255,18 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** If non-zero, writes triggered only by newly queued messages are held back
+    until at least this many message bytes are pending (or
+    GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US elapses), so that small messages
+    from many streams share a single write syscall. Int valued, bytes.
+    Defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES \
+  "grpc.http2.write_coalescing_min_bytes"
+/** Upper bound on how long a write may be held back waiting for
+    GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES to accumulate. Int valued,
+    microseconds. Defaults to 100. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US \
+  "grpc.http2.write_coalescing_delay_us"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -293,6 +326,13 @@ typedef struct {
  *  protector.
  */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, the steps of security handshakes (e.g. the key exchange and
+ *  signatures of TLS handshakes) run on a process-wide pool with a thread for
+ *  every two cores, instead of the thread that read the handshake bytes. This
+ *  keeps bursts of new connections from holding up established ones, at the
+ *  cost of a thread hop per step. Defaults to 0.
+ */
+#define GRPC_ARG_TSI_HANDSHAKE_OFFLOAD "grpc.tsi.handshake_offload"
 /** Maximum metadata size (soft limit), in bytes. Note this limit applies to the
    max sum of all metadata key-value entries in a batch of headers. Some random
    sample of requests between this limit and
@@ -415,17 +455,16 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: Hedging policies in the service config are ignored unless
+          the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    Default is currently false, since this functionality is still
+    experimental.
     NOTE: This channel arg is experimental and will eventually be removed.
-          Once hedging functionality has been implemented and proves stable,
+          Once hedging functionality proves stable,
           this arg will be removed, and the hedging functionality will
           be enabled via the GRPC_ARG_ENABLE_RETRIES arg above. */
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
@@ -464,6 +503,13 @@ typedef struct {
  * timeouts/backoff/retry logic, and so the actual DNS resolution may time out
  * sooner than the value specified here. */
 #define GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS "grpc.dns_ares_query_timeout"
+/** If set to a positive value, DNS results are kept in a process-wide cache
+ * shared by every channel that sets this arg, for this many milliseconds.
+ * Concurrent lookups of the same name share a single query, and names that
+ * are looked up again shortly before they expire are refreshed in the
+ * background. Defaults to 0 (no caching). Note that this works only with the
+ * "ares" DNS resolver. */
+#define GRPC_ARG_DNS_CACHE_TTL_MS "grpc.dns_cache_ttl_ms"
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
@@ -288,6 +288,18 @@ class ClientContext {
   /// DEPRECATED: Use set_wait_for_ready() instead.
   void set_fail_fast(bool fail_fast) { set_wait_for_ready(!fail_fast); }
 
+  /// EXPERIMENTAL: Pass the request of a unary call to the server by reference
+  /// instead of serializing it. Only for channels to an in-process server
+  /// (Server::InProcessChannel()) implemented with the same generated message
+  /// types. See WriteOptions::set_pass_by_reference().
+  void set_pass_messages_by_reference(bool pass_messages_by_reference) {
+    pass_messages_by_reference_ = pass_messages_by_reference;
+  }
+
+  bool pass_messages_by_reference() const {
+    return pass_messages_by_reference_;
+  }
+
   /// Return the deadline for the client call.
   std::chrono::system_clock::time_point deadline() const {
     return grpc::Timespec2Timepoint(deadline_);
@@ -488,6 +500,7 @@ class ClientContext {
   bool initial_metadata_received_;
   bool wait_for_ready_;
   bool wait_for_ready_explicitly_set_;
+  bool pass_messages_by_reference_ = false;
   std::shared_ptr<grpc::Channel> channel_;
   grpc::internal::Mutex mu_;
   grpc_call* call_;
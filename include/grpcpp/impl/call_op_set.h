@@ -22,6 +22,7 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <utility>
 
 #include <grpc/grpc.h>
 #include <grpc/impl/compression_types.h>
@@ -80,7 +81,10 @@ class WriteOptions {
   WriteOptions() : flags_(0), last_message_(false) {}
 
   /// Clear all flags.
-  inline void Clear() { flags_ = 0; }
+  inline void Clear() {
+    flags_ = 0;
+    pass_by_reference_ = false;
+  }
 
   /// Returns raw flags bitset.
   inline uint32_t flags() const { return flags_; }
@@ -184,6 +188,24 @@ class WriteOptions {
 
   inline bool is_write_through() const { return GetBit(GRPC_WRITE_THROUGH); }
 
+  /// EXPERIMENTAL: hand the message to the peer by reference rather than
+  /// serializing it, for message types whose SerializationTraits support it
+  /// (generated protobuf messages do). The peer must be an in-process server
+  /// or client (see Server::InProcessChannel()) that reads the same generated
+  /// type; anything else fails to parse the message. Message size limits are
+  /// not applied to messages passed this way.
+  inline WriteOptions& set_pass_by_reference() {
+    pass_by_reference_ = true;
+    return *this;
+  }
+
+  inline WriteOptions& clear_pass_by_reference() {
+    pass_by_reference_ = false;
+    return *this;
+  }
+
+  bool is_pass_by_reference() const { return pass_by_reference_; }
+
  private:
   void SetBit(const uint32_t mask) { flags_ |= mask; }
 
@@ -193,10 +215,47 @@ class WriteOptions {
 
   uint32_t flags_;
   bool last_message_;
+  bool pass_by_reference_ = false;
 };
 
 namespace internal {
 
+// Serializes through SerializationTraits<M>::SerializeByReference when a write
+// asks for it and the traits provide one, else through Serialize.
+template <class M, class = void>
+struct MessageSerializer {
+  template <class BufferPtr>
+  static Status Serialize(const M& message, bool /*by_reference*/,
+                          BufferPtr bb, bool* own_buffer) {
+    return SerializationTraits<M>::Serialize(message, bb, own_buffer);
+  }
+};
+
+template <class M>
+struct MessageSerializer<
+    M, decltype(SerializationTraits<M>::SerializeByReference(
+                    std::declval<const M&>(), std::declval<ByteBuffer*>(),
+                    std::declval<bool*>()),
+                void())> {
+  template <class BufferPtr>
+  static Status Serialize(const M& message, bool by_reference, BufferPtr bb,
+                          bool* own_buffer) {
+    return by_reference ? SerializationTraits<M>::SerializeByReference(
+                              message, bb, own_buffer)
+                        : SerializationTraits<M>::Serialize(message, bb,
+                                                            own_buffer);
+  }
+};
+
+// Write options for the single message a unary call sends from \a context
+// (a client or server context).
+template <class Context>
+WriteOptions UnaryWriteOptions(const Context& context) {
+  WriteOptions options;
+  if (context.pass_messages_by_reference()) options.set_pass_by_reference();
+  return options;
+}
+
 /// Default argument for CallOpSet. The Unused parameter is unused by
 /// the class, but can be used for generating multiple names for the
 /// same thing.
@@ -380,8 +439,8 @@ Status CallOpSendMessage::SendMessage(const M& message, WriteOptions options) {
   write_options_ = options;
   // Serialize immediately since we do not have access to the message pointer
   bool own_buf;
-  Status result = SerializationTraits<M>::Serialize(
-      message, send_buf_.bbuf_ptr(), &own_buf);
+  Status result = MessageSerializer<M>::Serialize(
+      message, options.is_pass_by_reference(), send_buf_.bbuf_ptr(), &own_buf);
   if (!own_buf) {
     send_buf_.Duplicate();
   }
@@ -399,14 +458,12 @@ Status CallOpSendMessage::SendMessagePtr(const M* message,
   msg_ = message;
   write_options_ = options;
   // Store the serializer for later since we have access to the message
-  serializer_ = [this](const void* message) {
+  serializer_ = [this, by_reference = options.is_pass_by_reference()](
+                    const void* message) {
     bool own_buf;
-    // TODO(vjpai): Remove the void below when possible
-    // The void in the template parameter below should not be needed
-    // (since it should be implicit) but is needed due to an observed
-    // difference in behavior between clang and gcc for certain internal users
-    Status result = SerializationTraits<M>::Serialize(
-        *static_cast<const M*>(message), send_buf_.bbuf_ptr(), &own_buf);
+    Status result = MessageSerializer<M>::Serialize(
+        *static_cast<const M*>(message), by_reference, send_buf_.bbuf_ptr(),
+        &own_buf);
     if (!own_buf) {
       send_buf_.Duplicate();
     }
@@ -65,7 +65,7 @@ class BlockingUnaryCallImpl {
               CallOpRecvInitialMetadata, CallOpRecvMessage<OutputMessage>,
               CallOpClientSendClose, CallOpClientRecvStatus>
         ops;
-    status_ = ops.SendMessagePtr(&request);
+    status_ = ops.SendMessagePtr(&request, UnaryWriteOptions(*context));
     if (!status_.ok()) {
       return;
     }
@@ -19,9 +19,13 @@
 #ifndef GRPCPP_IMPL_PROTO_UTILS_H
 #define GRPCPP_IMPL_PROTO_UTILS_H
 
+#include <cstddef>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include <grpc/byte_buffer_reader.h>
+#include <grpc/grpc.h>
 #include <grpc/impl/grpc_types.h>
 #include <grpc/slice.h>
 #include <grpc/support/log.h>
@@ -29,7 +33,9 @@
 #include <grpcpp/impl/serialization_traits.h>
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/proto_buffer_reader.h>
+#include <grpcpp/support/message_allocator.h>
 #include <grpcpp/support/proto_buffer_writer.h>
+#include <grpcpp/support/server_callback.h>
 #include <grpcpp/support/slice.h>
 #include <grpcpp/support/status.h>
 
@@ -48,7 +54,9 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = static_cast<int>(msg.ByteSizeLong());
-  if (static_cast<size_t>(byte_size) <= GRPC_SLICE_INLINED_SIZE) {
+  // Anything that fits in a single writer block goes into one slice of exactly
+  // the right size (inlined when small enough), skipping the stream entirely.
+  if (byte_size <= kProtoBufferWriterMaxBufferLength) {
     Slice slice(byte_size);
     // We serialize directly into the allocated slices memory
     GPR_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
@@ -92,6 +100,97 @@ Status GenericDeserialize(ByteBuffer* buffer,
 // this is needed so the following class does not conflict with protobuf
 // serializers that utilize internal-only tools.
 #ifdef GRPC_OPEN_SOURCE_PROTO
+namespace internal {
+
+// Messages written with WriteOptions::set_pass_by_reference() travel as a
+// buffer holding one slice that owns a copy of the message. Its only byte is
+// zero, which is not a valid protobuf, so a reference that reaches a peer
+// that does not understand it fails to parse instead of reading as empty.
+
+// Stores \a message, freed with \a destroy, in \a bb.
+void MakeMessageReference(void* message, const void* type_tag,
+                          void (*destroy)(void*), ByteBuffer* bb);
+// Returns the message in \a bb if it was made by MakeMessageReference() with
+// the same \a type_tag, else nullptr. The message stays owned by \a bb.
+void* GetMessageReference(const ByteBuffer& bb, const void* type_tag);
+
+// How to pass a T by reference; only generated (concrete) messages can be.
+template <class T, class = void>
+struct MessageReferenceTraits {
+  static constexpr bool kEnabled = false;
+  static const void* TypeTag() { return nullptr; }
+  static void* Copy(const grpc::protobuf::MessageLite&) { return nullptr; }
+  static void Destroy(void*) {}
+  static void Move(void*, grpc::protobuf::MessageLite*) {}
+};
+
+template <class T>
+struct MessageReferenceTraits<T, decltype(&T::default_instance, void())> {
+  static constexpr bool kEnabled = true;
+  static const void* TypeTag() { return &T::default_instance(); }
+  static void* Copy(const grpc::protobuf::MessageLite& msg) {
+    return new T(static_cast<const T&>(msg));
+  }
+  static void Destroy(void* msg) { delete static_cast<T*>(msg); }
+  static void Move(void* from, grpc::protobuf::MessageLite* to) {
+    *static_cast<T*>(to) = std::move(*static_cast<T*>(from));
+  }
+};
+
+// Size of the first protobuf arena block that callback unary messages get
+// from the call arena. Messages that outgrow it spill onto the heap.
+constexpr size_t kCallbackMessageArenaInitialBlockSize = 1024;
+
+// Holds the request and response of a callback unary RPC on a protobuf arena
+// whose first block is carved out of the call arena. Small RPCs therefore
+// make no heap allocations for their messages, including while parsing.
+template <class Request, class Response>
+class ProtoArenaMessageHolder : public MessageHolder<Request, Response> {
+ public:
+  ProtoArenaMessageHolder(char* initial_block, size_t initial_block_size)
+      : arena_(MakeOptions(initial_block, initial_block_size)) {
+    this->set_request(protobuf::Arena::CreateMessage<Request>(&arena_));
+    this->set_response(protobuf::Arena::CreateMessage<Response>(&arena_));
+  }
+  void Release() override {
+    // the object is allocated in the call arena; this only returns blocks the
+    // protobuf arena had to take from the heap.
+    this->~ProtoArenaMessageHolder<Request, Response>();
+  }
+
+ private:
+  static protobuf::ArenaOptions MakeOptions(char* initial_block,
+                                            size_t initial_block_size) {
+    protobuf::ArenaOptions options;
+    options.initial_block = initial_block;
+    options.initial_block_size = initial_block_size;
+    return options;
+  }
+
+  protobuf::Arena arena_;
+};
+
+template <class Request, class Response>
+struct DefaultMessageHolderFactory<
+    Request, Response,
+    typename std::enable_if<
+        std::is_base_of<grpc::protobuf::MessageLite, Request>::value &&
+        std::is_base_of<grpc::protobuf::MessageLite, Response>::value>::type> {
+  static MessageHolder<Request, Response>* Create(grpc_call* call) {
+    using Holder = ProtoArenaMessageHolder<Request, Response>;
+    // The holder and the protobuf arena's first block share one allocation.
+    constexpr size_t kHolderSize =
+        (sizeof(Holder) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);
+    char* storage = static_cast<char*>(grpc_call_arena_alloc(
+        call, kHolderSize + kCallbackMessageArenaInitialBlockSize));
+    return new (storage)
+        Holder(storage + kHolderSize, kCallbackMessageArenaInitialBlockSize);
+  }
+};
+
+}  // namespace internal
+
 // This class provides a protobuf serializer. It translates between protobuf
 // objects and grpc_byte_buffers. More information about SerializationTraits can
 // be found in include/grpcpp/impl/codegen/serialization_traits.h.
@@ -105,8 +204,29 @@ class SerializationTraits<
     return GenericSerialize<ProtoBufferWriter, T>(msg, bb, own_buffer);
   }
 
+  static Status SerializeByReference(const grpc::protobuf::MessageLite& msg,
+                                     ByteBuffer* bb, bool* own_buffer) {
+    using Ref = internal::MessageReferenceTraits<T>;
+    if (!Ref::kEnabled) {
+      return GenericSerialize<ProtoBufferWriter, T>(msg, bb, own_buffer);
+    }
+    *own_buffer = true;
+    internal::MakeMessageReference(Ref::Copy(msg), Ref::TypeTag(),
+                                   Ref::Destroy, bb);
+    return grpc::Status::OK;
+  }
+
   static Status Deserialize(ByteBuffer* buffer,
                             grpc::protobuf::MessageLite* msg) {
+    using Ref = internal::MessageReferenceTraits<T>;
+    if (Ref::kEnabled && buffer != nullptr) {
+      void* message = internal::GetMessageReference(*buffer, Ref::TypeTag());
+      if (message != nullptr) {
+        Ref::Move(message, msg);
+        buffer->Clear();
+        return grpc::Status::OK;
+      }
+    }
     return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
   }
 };
@@ -53,6 +53,15 @@ namespace grpc {
 ///
 /// Both functions return a Status, allowing them to explain what went
 /// wrong if required.
+///
+/// An implementation may additionally provide
+/// 3.  static Status SerializeByReference(const Message& msg,
+///                                        ByteBuffer* buffer,
+///                                        bool* own_buffer);
+///     which is used instead of Serialize for writes that ask for
+///     WriteOptions::set_pass_by_reference(). Its output only needs to be
+///     understood by a Deserialize for the same Message type in the same
+///     process.
 template <class Message,
           class UnusedButHereForPartialTemplateSpecialization = void>
 class SerializationTraits;
@@ -87,9 +87,8 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
     if (allocator_ != nullptr) {
       allocator_state = allocator_->AllocateMessages();
     } else {
-      allocator_state = new (grpc_call_arena_alloc(
-          call, sizeof(DefaultMessageHolder<RequestType, ResponseType>)))
-          DefaultMessageHolder<RequestType, ResponseType>();
+      allocator_state =
+          DefaultMessageHolderFactory<RequestType, ResponseType>::Create(call);
     }
     *handler_data = allocator_state;
     request = allocator_state->request();
@@ -137,7 +136,10 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
       // The response is dropped if the status is not OK.
       if (s.ok()) {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_,
-                                     finish_ops_.SendMessagePtr(response()));
+                                     finish_ops_.SendMessagePtr(
+                                         response(),
+                                         grpc::internal::UnaryWriteOptions(
+                                             *ctx_)));
       } else {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_, s);
       }
@@ -250,6 +250,18 @@ class ServerContextBase {
   /// \a set_compression_level.
   bool compression_level_set() const { return compression_level_set_; }
 
+  /// EXPERIMENTAL: Pass the response of a unary call back to the client by
+  /// reference instead of serializing it. Only for calls from an in-process
+  /// channel (Server::InProcessChannel()) whose client uses the same generated
+  /// message types. See WriteOptions::set_pass_by_reference().
+  void set_pass_messages_by_reference(bool pass_messages_by_reference) {
+    pass_messages_by_reference_ = pass_messages_by_reference;
+  }
+
+  bool pass_messages_by_reference() const {
+    return pass_messages_by_reference_;
+  }
+
   /// Return the compression algorithm the server call will request be used.
   /// Note that the gRPC runtime may decide to ignore this request, for example,
   /// due to resource constraints, or if the server is aware the client doesn't
@@ -483,6 +495,7 @@ class ServerContextBase {
   std::multimap<std::string, std::string> trailing_metadata_;
 
   bool compression_level_set_ = false;
+  bool pass_messages_by_reference_ = false;
   grpc_compression_level compression_level_;
   grpc_compression_algorithm compression_algorithm_;
 
@@ -585,10 +598,12 @@ class ServerContext : public ServerContextBase {
   using ServerContextBase::compression_level_set;
   using ServerContextBase::deadline;
   using ServerContextBase::IsCancelled;
+  using ServerContextBase::pass_messages_by_reference;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
+  using ServerContextBase::set_pass_messages_by_reference;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
 
@@ -628,11 +643,13 @@ class CallbackServerContext : public ServerContextBase {
   using ServerContextBase::context_allocator;
   using ServerContextBase::deadline;
   using ServerContextBase::IsCancelled;
+  using ServerContextBase::pass_messages_by_reference;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
   using ServerContextBase::set_context_allocator;
+  using ServerContextBase::set_pass_messages_by_reference;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
 
@@ -100,7 +100,8 @@ class ClientAsyncResponseReaderHelper {
         ClientAsyncResponseReader<R>(call, context);
     SetupRequest<BaseR, BaseW>(
         call.call(), &result->single_buf_, &result->read_initial_metadata_,
-        &result->finish_, static_cast<const BaseW&>(request));
+        &result->finish_, static_cast<const BaseW&>(request),
+        grpc::internal::UnaryWriteOptions(*context));
 
     return result;
   }
@@ -118,7 +119,7 @@ class ClientAsyncResponseReaderHelper {
           void(ClientContext*, internal::Call*, bool initial_metadata_read,
                internal::CallOpSendInitialMetadata*,
                internal::CallOpSetInterface**, void*, Status*, void*)>* finish,
-      const W& request) {
+      const W& request, grpc::WriteOptions options) {
     using SingleBufType =
         grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
                                   grpc::internal::CallOpSendMessage,
@@ -130,7 +131,7 @@ class ClientAsyncResponseReaderHelper {
         new (grpc_call_arena_alloc(call, sizeof(SingleBufType))) SingleBufType;
     *single_buf_ptr = single_buf;
     // TODO(ctiller): don't assert
-    GPR_ASSERT(single_buf->SendMessage(request).ok());
+    GPR_ASSERT(single_buf->SendMessage(request, options).ok());
     single_buf->ClientSendClose();
 
     // The purpose of the following functions is to type-erase the actual
@@ -349,7 +350,9 @@ class ServerAsyncResponseWriter final
     // The response is dropped if the status is not OK.
     if (status.ok()) {
       finish_buf_.ServerSendStatus(&ctx_->trailing_metadata_,
-                                   finish_buf_.SendMessage(msg));
+                                   finish_buf_.SendMessage(
+                                       msg, grpc::internal::UnaryWriteOptions(
+                                                *ctx_)));
     } else {
       finish_buf_.ServerSendStatus(&ctx_->trailing_metadata_, status);
     }
@@ -92,7 +92,8 @@ class CallbackUnaryCallImpl {
         grpc::internal::CallbackWithStatusTag(call.call(), on_completion, ops);
 
     // TODO(vjpai): Unify code with sync API as much as possible
-    grpc::Status s = ops->SendMessagePtr(request);
+    grpc::Status s = ops->SendMessagePtr(
+        request, grpc::internal::UnaryWriteOptions(*context));
     if (!s.ok()) {
       tag->force_run(s);
       return;
@@ -1159,7 +1160,10 @@ class ClientCallbackUnaryImpl final : public ClientCallbackUnary {
       : context_(context), call_(call), reactor_(reactor) {
     this->BindReactor(reactor);
     // TODO(vjpai): don't assert
-    GPR_ASSERT(start_ops_.SendMessagePtr(request).ok());
+    GPR_ASSERT(start_ops_
+                   .SendMessagePtr(request,
+                                   grpc::internal::UnaryWriteOptions(*context))
+                   .ok());
     start_ops_.ClientSendClose();
     finish_ops_.RecvMessage(response);
     finish_ops_.AllowNoMessage();
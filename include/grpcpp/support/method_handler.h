@@ -68,7 +68,8 @@ void UnaryRunHandlerHelper(const MethodHandler::HandlerParameter& param,
     ops.set_compression_level(param.server_context->compression_level());
   }
   if (status.ok()) {
-    status = ops.SendMessagePtr(rsp);
+    status = ops.SendMessagePtr(
+        rsp, grpc::internal::UnaryWriteOptions(*param.server_context));
   }
   ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
   param.call->PerformOps(&ops);
@@ -174,6 +174,18 @@ class DefaultMessageHolder : public MessageHolder<Request, Response> {
   Response response_obj_;
 };
 
+// Creates the messages for a callback unary RPC that has no custom
+// MessageAllocator. The holder lives in the call arena. Protobuf messages get
+// a specialization in proto_utils.h that also places their contents there.
+template <class Request, class Response, class = void>
+struct DefaultMessageHolderFactory {
+  static MessageHolder<Request, Response>* Create(grpc_call* call) {
+    return new (grpc_call_arena_alloc(
+        call, sizeof(DefaultMessageHolder<Request, Response>)))
+        DefaultMessageHolder<Request, Response>();
+  }
+};
+
 }  // namespace internal
 
 // Forward declarations
@@ -0,0 +1,263 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.h"
+
+#include <limits.h>
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_adaptive_concurrency_filter_trace(false,
+                                                 "adaptive_concurrency");
+
+namespace {
+
+int64_t NowNanos() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+// Holds an admitted call's slot in the limiter until the call ends.
+//
+// The latency sampled is the time until the server starts to respond,
+// not the length of the whole call: a streaming call lasts as long as the
+// client and server keep talking, which says nothing about how loaded the
+// server is.  For a unary call the two are close, since the response
+// headers go out with the response.
+class CallPermit {
+ public:
+  explicit CallPermit(AdaptiveConcurrencyLimiter* limiter)
+      : limiter_(limiter), start_ns_(NowNanos()) {}
+
+  CallPermit(const CallPermit&) = delete;
+  CallPermit& operator=(const CallPermit&) = delete;
+
+  // A call that is cancelled before it finishes gives its slot back
+  // without a latency sample.
+  ~CallPermit() {
+    if (limiter_ != nullptr) limiter_->Release(NowNanos(), -1);
+  }
+
+  // Called when the server sends its initial metadata.
+  void FirstResponse() {
+    if (first_response_ns_ < 0) first_response_ns_ = NowNanos();
+  }
+
+  // Called when the server sends its trailing metadata.  A trailers-only
+  // response never sends initial metadata, so the trailers count as the
+  // first response.
+  void Finish() {
+    const int64_t now_ns = NowNanos();
+    if (first_response_ns_ < 0) first_response_ns_ = now_ns;
+    limiter_->Release(now_ns, first_response_ns_ - start_ns_);
+    limiter_ = nullptr;
+  }
+
+ private:
+  AdaptiveConcurrencyLimiter* limiter_;
+  const int64_t start_ns_;
+  int64_t first_response_ns_ = -1;
+};
+
+}  // namespace
+
+//
+// AdaptiveConcurrencyLimiter
+//
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(const Options& options)
+    : options_(options),
+      limit_(Clamp(options.initial_limit, options.min_limit,
+                   options.max_limit)),
+      estimated_limit_(limit_.load(std::memory_order_relaxed)) {}
+
+AdaptiveConcurrencyLimiter::Options
+AdaptiveConcurrencyLimiter::OptionsFromChannelArgs(const ChannelArgs& args) {
+  Options options;
+  options.min_limit = std::max(
+      1, args.GetInt(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MIN_LIMIT)
+             .value_or(options.min_limit));
+  options.max_limit = std::max<uint32_t>(
+      options.min_limit,
+      std::max(1, args.GetInt(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MAX_LIMIT)
+                      .value_or(options.max_limit)));
+  return options;
+}
+
+bool AdaptiveConcurrencyLimiter::TryAcquire() {
+  uint32_t current = in_flight_.load(std::memory_order_relaxed);
+  do {
+    if (current >= limit()) return false;
+  } while (!in_flight_.compare_exchange_weak(current, current + 1,
+                                             std::memory_order_relaxed));
+  return true;
+}
+
+void AdaptiveConcurrencyLimiter::Release(int64_t now_ns, int64_t latency_ns) {
+  const uint32_t in_flight =
+      in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  if (latency_ns < 0) return;
+  MutexLock lock(&mu_);
+  if (window_start_ns_ < 0) window_start_ns_ = now_ns;
+  ++window_samples_;
+  window_rtt_sum_ns_ += static_cast<double>(latency_ns);
+  window_max_in_flight_ = std::max(window_max_in_flight_, in_flight);
+  if (window_samples_ < options_.min_window_samples ||
+      now_ns - window_start_ns_ < options_.window_duration.millis() *
+                                      static_cast<int64_t>(GPR_NS_PER_MS)) {
+    return;
+  }
+  UpdateLimitLocked();
+  window_start_ns_ = now_ns;
+  window_samples_ = 0;
+  window_rtt_sum_ns_ = 0;
+  window_max_in_flight_ = 0;
+}
+
+void AdaptiveConcurrencyLimiter::UpdateLimitLocked() {
+  const double short_rtt_ns = window_rtt_sum_ns_ / window_samples_;
+  if (long_rtt_ns_ == 0) {
+    long_rtt_ns_ = short_rtt_ns;
+  } else {
+    long_rtt_ns_ += (short_rtt_ns - long_rtt_ns_) * 2 /
+                    (static_cast<double>(options_.long_window) + 1);
+  }
+  // After a sustained drop in latency the long term average takes a long
+  // time to catch up, and would let the limit grow unchecked meanwhile.
+  if (short_rtt_ns > 0 && long_rtt_ns_ / short_rtt_ns > 2) {
+    long_rtt_ns_ *= 0.95;
+  }
+  // Don't grow the limit while the server isn't using most of it: the
+  // latency measured says nothing about how it would cope with more.
+  if (window_max_in_flight_ * 2 < estimated_limit_) return;
+  const double gradient =
+      short_rtt_ns <= 0
+          ? 1.0
+          : Clamp(options_.rtt_tolerance * long_rtt_ns_ / short_rtt_ns, 0.5,
+                  1.0);
+  const double new_limit =
+      estimated_limit_ * gradient + sqrt(estimated_limit_);
+  estimated_limit_ =
+      Clamp(estimated_limit_ * (1 - options_.smoothing) +
+                new_limit * options_.smoothing,
+            static_cast<double>(options_.min_limit),
+            static_cast<double>(options_.max_limit));
+  const uint32_t limit = static_cast<uint32_t>(estimated_limit_);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_adaptive_concurrency_filter_trace) &&
+      limit != limit_.load(std::memory_order_relaxed)) {
+    gpr_log(GPR_INFO,
+            "[adaptive_concurrency %p] limit %u -> %u (window rtt %.0fus, "
+            "long term rtt %.0fus, max in flight %u)",
+            this, limit_.load(std::memory_order_relaxed), limit,
+            short_rtt_ns / 1000, long_rtt_ns_ / 1000, window_max_in_flight_);
+  }
+  limit_.store(limit, std::memory_order_relaxed);
+}
+
+//
+// AdaptiveConcurrencyFilter
+//
+
+const grpc_channel_filter AdaptiveConcurrencyFilter::kFilter =
+    MakePromiseBasedFilter<AdaptiveConcurrencyFilter, FilterEndpoint::kServer>(
+        "adaptive_concurrency");
+
+absl::StatusOr<AdaptiveConcurrencyFilter> AdaptiveConcurrencyFilter::Create(
+    const ChannelArgs& args, ChannelFilter::Args) {
+  auto limiter = args.GetObjectRef<AdaptiveConcurrencyLimiter>();
+  // The limiter is normally added to the server's args, so that it covers
+  // all of the server's connections.  Fall back to one per connection if
+  // it's missing.
+  if (limiter == nullptr) {
+    limiter = MakeRefCounted<AdaptiveConcurrencyLimiter>(
+        AdaptiveConcurrencyLimiter::OptionsFromChannelArgs(args));
+  }
+  return AdaptiveConcurrencyFilter(std::move(limiter));
+}
+
+ArenaPromise<ServerMetadataHandle> AdaptiveConcurrencyFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  if (!limiter_->TryAcquire()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_adaptive_concurrency_filter_trace)) {
+      gpr_log(GPR_INFO,
+              "[adaptive_concurrency %p] rejecting call: %u calls in flight",
+              limiter_.get(), limiter_->in_flight());
+    }
+    return Immediate(ServerMetadataFromStatus(
+        absl::ResourceExhaustedError("Server concurrency limit reached")));
+  }
+  // Both the initial metadata interceptor and the trailing metadata
+  // mapper need the permit, so it lives in the call's arena.  The arena
+  // also destroys it, releasing the slot, if the call is cancelled.
+  auto* permit = GetContext<Arena>()->ManagedNew<CallPermit>(limiter_.get());
+  call_args.server_initial_metadata->InterceptAndMap(
+      [permit](ServerMetadataHandle md) {
+        permit->FirstResponse();
+        return md;
+      });
+  return Map(next_promise_factory(std::move(call_args)),
+             [permit](ServerMetadataHandle trailing_metadata) {
+               permit->Finish();
+               return trailing_metadata;
+             });
+}
+
+void RegisterAdaptiveConcurrencyFilter(CoreConfiguration::Builder* builder) {
+  // Give each server a single limiter for all of its connections.
+  builder->channel_args_preconditioning()->RegisterStage(
+      [](ChannelArgs args) {
+        if (!args.GetBool(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT)
+                 .value_or(false) ||
+            args.GetObject<AdaptiveConcurrencyLimiter>() != nullptr) {
+          return args;
+        }
+        return args.SetObject(MakeRefCounted<AdaptiveConcurrencyLimiter>(
+            AdaptiveConcurrencyLimiter::OptionsFromChannelArgs(args)));
+      });
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, INT_MAX, [](ChannelStackBuilder* builder) {
+        if (builder->channel_args()
+                .GetBool(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT)
+                .value_or(false)) {
+          builder->PrependFilter(&AdaptiveConcurrencyFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,153 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+// Estimates how many calls a server can have in flight before they start
+// queueing, and turns away calls beyond that.  Shared by all connections
+// of a server.
+//
+// The limit follows the gradient algorithm from Netflix's
+// concurrency-limits library: completed calls are grouped into sample
+// windows, and at the end of each window the window's average latency is
+// compared with a long term average.  While they match, the limit grows by
+// a fraction of its square root per window; once latency rises above the
+// long term average by more than the tolerance, the limit shrinks in
+// proportion.  The long term average follows sustained changes in latency
+// slowly, so a server that settles at a new latency grows its limit again.
+//
+// TryAcquire() is called for every incoming call and is lock-free.  The
+// limit is recomputed under a lock when calls complete.
+class AdaptiveConcurrencyLimiter
+    : public RefCounted<AdaptiveConcurrencyLimiter> {
+ public:
+  struct Options {
+    uint32_t initial_limit = 100;
+    uint32_t min_limit = 10;
+    uint32_t max_limit = 1000;
+    // How far the window latency may rise above the long term latency
+    // before the limit starts to shrink.
+    double rtt_tolerance = 1.5;
+    // Weight given to each new limit estimate.
+    double smoothing = 0.2;
+    // Number of windows the long term latency is averaged over.
+    uint32_t long_window = 600;
+    // A window closes once it has at least this many samples and has
+    // lasted at least window_duration.
+    uint32_t min_window_samples = 10;
+    Duration window_duration = Duration::Milliseconds(100);
+  };
+
+  explicit AdaptiveConcurrencyLimiter(const Options& options);
+
+  // Reads the GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_* args.
+  static Options OptionsFromChannelArgs(const ChannelArgs& args);
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.adaptive_concurrency_limiter";
+  }
+  static int ChannelArgsCompare(const AdaptiveConcurrencyLimiter* a,
+                                const AdaptiveConcurrencyLimiter* b) {
+    return QsortCompare(a, b);
+  }
+
+  // Admits a call if fewer than limit() calls are in flight.  Every
+  // successful call must be matched by one call to Release().
+  bool TryAcquire();
+
+  // Ends an admitted call.  latency_ns is the time the server took to
+  // start responding to the call, or -1 if the call did not complete
+  // normally and shouldn't be sampled.  now_ns
+  // is a monotonic timestamp, used to close sample windows.
+  void Release(int64_t now_ns, int64_t latency_ns);
+
+  uint32_t limit() const { return limit_.load(std::memory_order_relaxed); }
+  uint32_t in_flight() const {
+    return in_flight_.load(std::memory_order_relaxed);
+  }
+
+  // Fraction of the limit currently in use, reported to clients over ORCA.
+  double utilization() const {
+    return static_cast<double>(in_flight()) / limit();
+  }
+
+ private:
+  void UpdateLimitLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+  std::atomic<uint32_t> limit_;
+  std::atomic<uint32_t> in_flight_{0};
+
+  Mutex mu_;
+  double estimated_limit_ ABSL_GUARDED_BY(mu_);
+  // Exponential average of the window latencies, or 0 before the first
+  // window has closed.
+  double long_rtt_ns_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t window_start_ns_ ABSL_GUARDED_BY(mu_) = -1;
+  uint32_t window_samples_ ABSL_GUARDED_BY(mu_) = 0;
+  double window_rtt_sum_ns_ ABSL_GUARDED_BY(mu_) = 0;
+  // Highest in-flight count seen during the window.
+  uint32_t window_max_in_flight_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+// Server filter that rejects calls beyond the adaptive concurrency limit
+// with RESOURCE_EXHAUSTED.  Enabled with
+// GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_LIMIT.
+class AdaptiveConcurrencyFilter : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<AdaptiveConcurrencyFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ private:
+  explicit AdaptiveConcurrencyFilter(
+      RefCountedPtr<AdaptiveConcurrencyLimiter> limiter)
+      : limiter_(std::move(limiter)) {}
+
+  RefCountedPtr<AdaptiveConcurrencyLimiter> limiter_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_ADAPTIVE_CONCURRENCY_ADAPTIVE_CONCURRENCY_FILTER_H
@@ -53,6 +53,10 @@ absl::optional<std::string> BackendMetricFilter::MaybeSerializeBackendMetrics(
     BackendMetricProvider* provider) const {
   if (provider == nullptr) return absl::nullopt;
   BackendMetricData data = provider->GetBackendMetricData();
+  if (concurrency_limiter_ != nullptr) {
+    data.utilization.emplace("grpc.adaptive_concurrency",
+                             concurrency_limiter_->utilization());
+  }
   upb::Arena arena;
   xds_data_orca_v3_OrcaLoadReport* response =
       xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
@@ -115,8 +119,9 @@ const grpc_channel_filter BackendMetricFilter::kFilter =
         "backend_metric");
 
 absl::StatusOr<BackendMetricFilter> BackendMetricFilter::Create(
-    const ChannelArgs&, ChannelFilter::Args) {
-  return BackendMetricFilter();
+    const ChannelArgs& args, ChannelFilter::Args) {
+  return BackendMetricFilter(
+      args.GetObjectRef<AdaptiveConcurrencyLimiter>());
 }
 
 ArenaPromise<ServerMetadataHandle> BackendMetricFilter::MakeCallPromise(
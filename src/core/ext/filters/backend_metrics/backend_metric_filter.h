@@ -18,14 +18,17 @@
 #include <grpc/support/port_platform.h>
 
 #include <string>
+#include <utility>
 
 #include "absl/status/statusor.h"
 #include "absl/types/optional.h"
 
+#include "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.h"
 #include "src/core/ext/filters/backend_metrics/backend_metric_provider.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/transport/transport.h"
 
@@ -43,8 +46,16 @@ class BackendMetricFilter : public ChannelFilter {
       CallArgs call_args, NextPromiseFactory next_promise_factory) override;
 
  private:
+  explicit BackendMetricFilter(
+      RefCountedPtr<AdaptiveConcurrencyLimiter> concurrency_limiter)
+      : concurrency_limiter_(std::move(concurrency_limiter)) {}
+
   absl::optional<std::string> MaybeSerializeBackendMetrics(
       BackendMetricProvider* provider) const;
+
+  // Set when the server limits concurrency, in which case the fraction of
+  // the limit in use is reported along with the call's metrics.
+  RefCountedPtr<AdaptiveConcurrencyLimiter> concurrency_limiter_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,150 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/random/random.h"
+
+namespace grpc_core {
+namespace internal {
+
+namespace {
+
+// The snapshots divide the window into this many intervals.
+constexpr int64_t kNumSnapshotIntervals = 10;
+
+// How often the rejection probability is recomputed.
+constexpr Duration kUpdateInterval = Duration::Milliseconds(20);
+
+}  // namespace
+
+//
+// ServerAdaptiveThrottleData
+//
+
+ServerAdaptiveThrottleData::ServerAdaptiveThrottleData(
+    Duration window, double accepts_multiplier)
+    : window_(window), accepts_multiplier_(accepts_multiplier) {
+  absl::BitGen bit_gen;
+  for (Shard& shard : shards_) {
+    shard.random_state.store(absl::Uniform<uint64_t>(bit_gen),
+                             std::memory_order_relaxed);
+  }
+  Totals start;
+  start.time = Timestamp::Now();
+  snapshots_.push_back(start);
+}
+
+bool ServerAdaptiveThrottleData::RecordRequest() {
+  MaybeUpdate(Timestamp::Now());
+  Shard& shard = shards_.this_cpu();
+  shard.requests.fetch_add(1, std::memory_order_relaxed);
+  const double reject_probability = this->reject_probability();
+  if (reject_probability <= 0) return true;
+  // SplitMix64 on the shard's own state, so that concurrent calls don't
+  // contend on a shared generator.
+  uint64_t z = shard.random_state.fetch_add(0x9e3779b97f4a7c15,
+                                            std::memory_order_relaxed) +
+               0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z ^= z >> 31;
+  const double uniform = static_cast<double>(z >> 11) /
+                         static_cast<double>(uint64_t{1} << 53);
+  return uniform >= reject_probability;
+}
+
+void ServerAdaptiveThrottleData::RecordAccept() {
+  shards_.this_cpu().accepts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerAdaptiveThrottleData::MaybeUpdate(Timestamp now) {
+  const int64_t now_ms = now.milliseconds_after_process_epoch();
+  int64_t next_update = next_update_.load(std::memory_order_relaxed);
+  if (now_ms < next_update) return;
+  // Only one caller recomputes; the others carry on with the old value.
+  if (!next_update_.compare_exchange_strong(next_update,
+                                            now_ms + kUpdateInterval.millis(),
+                                            std::memory_order_relaxed)) {
+    return;
+  }
+  MutexLock lock(&mu_);
+  const Totals totals = SumShards(now);
+  if (now - snapshots_.back().time >= window_ / kNumSnapshotIntervals) {
+    snapshots_.push_back(totals);
+  }
+  // Drop the snapshots that have fallen out of the window.  The counts are
+  // taken against the oldest one left, so they may cover a little less
+  // than the full window, but never stale traffic.
+  while (snapshots_.size() > 1 && now - snapshots_.front().time > window_) {
+    snapshots_.pop_front();
+  }
+  const double requests =
+      static_cast<double>(totals.requests - snapshots_.front().requests);
+  const double accepts =
+      static_cast<double>(totals.accepts - snapshots_.front().accepts);
+  reject_probability_.store(
+      std::max(0.0,
+               (requests - accepts_multiplier_ * accepts) / (requests + 1)),
+      std::memory_order_relaxed);
+}
+
+ServerAdaptiveThrottleData::Totals ServerAdaptiveThrottleData::SumShards(
+    Timestamp now) {
+  Totals totals;
+  totals.time = now;
+  for (const Shard& shard : shards_) {
+    totals.requests += shard.requests.load(std::memory_order_relaxed);
+    totals.accepts += shard.accepts.load(std::memory_order_relaxed);
+  }
+  return totals;
+}
+
+//
+// ServerAdaptiveThrottleMap
+//
+
+ServerAdaptiveThrottleMap* ServerAdaptiveThrottleMap::Get() {
+  static ServerAdaptiveThrottleMap* m = new ServerAdaptiveThrottleMap();
+  return m;
+}
+
+RefCountedPtr<ServerAdaptiveThrottleData>
+ServerAdaptiveThrottleMap::GetDataForServer(const std::string& server_name,
+                                            Duration window,
+                                            double accepts_multiplier) {
+  MutexLock lock(&mu_);
+  RefCountedPtr<ServerAdaptiveThrottleData>& throttle_data =
+      map_[server_name];
+  if (throttle_data == nullptr || throttle_data->window() != window ||
+      throttle_data->accepts_multiplier() != accepts_multiplier) {
+    // Entry not found, or found with old parameters.  Start over: channels
+    // still using the old entry keep it until they pick up the new config.
+    throttle_data = MakeRefCounted<ServerAdaptiveThrottleData>(
+        window, accepts_multiplier);
+  }
+  return throttle_data;
+}
+
+}  // namespace internal
+}  // namespace grpc_core
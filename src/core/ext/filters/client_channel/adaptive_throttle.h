@@ -0,0 +1,138 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+namespace internal {
+
+/// Tracks client-side adaptive throttling for an individual server name,
+/// as described in the "Handling Overload" chapter of the Google SRE book.
+///
+/// Over a sliding window, the client counts the requests it was asked to
+/// send and the ones the server accepted, and rejects new requests
+/// locally with probability
+///   max(0, (requests - accepts_multiplier * accepts) / (requests + 1)).
+///
+/// The counters are per-CPU, and the rejection probability is only
+/// recomputed every few milliseconds, so recording a call is a couple of
+/// uncontended atomic increments.
+class ServerAdaptiveThrottleData
+    : public RefCounted<ServerAdaptiveThrottleData> {
+ public:
+  ServerAdaptiveThrottleData(Duration window, double accepts_multiplier);
+
+  /// Records a request.  Returns true if it should be sent, or false if it
+  /// should be rejected locally.  Locally rejected requests still count
+  /// as requests, so that throttling keeps up with the offered load.
+  bool RecordRequest();
+
+  /// Records that the server accepted a request.
+  void RecordAccept();
+
+  /// Probability with which requests are currently rejected.
+  double reject_probability() const {
+    return reject_probability_.load(std::memory_order_relaxed);
+  }
+
+  Duration window() const { return window_; }
+  double accepts_multiplier() const { return accepts_multiplier_; }
+
+ private:
+  struct Totals {
+    Timestamp time;
+    int64_t requests = 0;
+    int64_t accepts = 0;
+  };
+
+  // See the comment on PerCpuCallCountingHelper::PerCpuData.
+#if __cplusplus >= 201703L
+  struct alignas(GPR_CACHELINE_SIZE) Shard {
+    std::atomic<int64_t> requests{0};
+    std::atomic<int64_t> accepts{0};
+    std::atomic<uint64_t> random_state{0};
+  };
+#else
+  struct ShardHeader {
+    std::atomic<int64_t> requests{0};
+    std::atomic<int64_t> accepts{0};
+    std::atomic<uint64_t> random_state{0};
+  };
+  struct Shard : public ShardHeader {
+    uint8_t padding[GPR_CACHELINE_SIZE - sizeof(ShardHeader)];
+  };
+#endif
+
+  // Recomputes the rejection probability if it is due.
+  void MaybeUpdate(Timestamp now);
+  Totals SumShards(Timestamp now);
+
+  const Duration window_;
+  const double accepts_multiplier_;
+  PerCpu<Shard> shards_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
+  std::atomic<double> reject_probability_{0};
+  // Milliseconds after the process epoch at which the rejection
+  // probability is next recomputed.
+  std::atomic<int64_t> next_update_{0};
+
+  Mutex mu_;
+  // Snapshots of the counter totals, oldest first, taken at intervals of
+  // a fraction of the window.  The counts over the window are the current
+  // totals minus the oldest snapshot.
+  std::deque<Totals> snapshots_ ABSL_GUARDED_BY(mu_);
+};
+
+/// Global map of server name to adaptive throttling data.
+class ServerAdaptiveThrottleMap {
+ public:
+  static ServerAdaptiveThrottleMap* Get();
+
+  /// Returns the throttling data for \a server_name, creating a new entry
+  /// if needed.
+  RefCountedPtr<ServerAdaptiveThrottleData> GetDataForServer(
+      const std::string& server_name, Duration window,
+      double accepts_multiplier);
+
+ private:
+  using StringToDataMap =
+      std::map<std::string, RefCountedPtr<ServerAdaptiveThrottleData>>;
+
+  Mutex mu_;
+  StringToDataMap map_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace internal
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_H
@@ -0,0 +1,189 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
+
+#include <functional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/strip.h"
+#include "absl/types/optional.h"
+
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/uri/uri_parser.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_adaptive_throttle_trace(false, "adaptive_throttle");
+
+namespace internal {
+
+//
+// AdaptiveThrottleGlobalConfig
+//
+
+const JsonLoaderInterface* AdaptiveThrottleGlobalConfig::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<AdaptiveThrottleGlobalConfig>()
+          .OptionalField("window", &AdaptiveThrottleGlobalConfig::window_)
+          .OptionalField("acceptsMultiplier",
+                         &AdaptiveThrottleGlobalConfig::accepts_multiplier_)
+          .Finish();
+  return loader;
+}
+
+void AdaptiveThrottleGlobalConfig::JsonPostLoad(const Json& /*json*/,
+                                                const JsonArgs& /*args*/,
+                                                ValidationErrors* errors) {
+  {
+    ValidationErrors::ScopedField field(errors, ".window");
+    if (!errors->FieldHasErrors() && window_ <= Duration::Zero()) {
+      errors->AddError("must be greater than 0");
+    }
+  }
+  // With a multiplier below 1, calls would be throttled even when the
+  // server accepts all of them.
+  ValidationErrors::ScopedField field(errors, ".acceptsMultiplier");
+  if (!errors->FieldHasErrors() && accepts_multiplier_ < 1) {
+    errors->AddError("must be at least 1");
+  }
+}
+
+//
+// AdaptiveThrottleServiceConfigParser
+//
+
+size_t AdaptiveThrottleServiceConfigParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+void AdaptiveThrottleServiceConfigParser::Register(
+    CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      std::make_unique<AdaptiveThrottleServiceConfigParser>());
+}
+
+namespace {
+
+struct GlobalConfig {
+  std::unique_ptr<AdaptiveThrottleGlobalConfig> adaptive_throttling;
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<GlobalConfig>()
+            .OptionalField("adaptiveThrottling",
+                           &GlobalConfig::adaptive_throttling)
+            .Finish();
+    return loader;
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+AdaptiveThrottleServiceConfigParser::ParseGlobalParams(
+    const ChannelArgs& /*args*/, const Json& json, ValidationErrors* errors) {
+  auto global_params = LoadFromJson<GlobalConfig>(json, JsonArgs(), errors);
+  return std::move(global_params.adaptive_throttling);
+}
+
+}  // namespace internal
+
+//
+// AdaptiveThrottleFilter
+//
+
+const grpc_channel_filter AdaptiveThrottleFilter::kFilter =
+    MakePromiseBasedFilter<AdaptiveThrottleFilter, FilterEndpoint::kClient>(
+        "adaptive_throttle");
+
+absl::StatusOr<AdaptiveThrottleFilter> AdaptiveThrottleFilter::Create(
+    const ChannelArgs& args, ChannelFilter::Args) {
+  auto* service_config = args.GetObject<ServiceConfig>();
+  if (service_config == nullptr) return AdaptiveThrottleFilter(nullptr);
+  const auto* config =
+      static_cast<const internal::AdaptiveThrottleGlobalConfig*>(
+          service_config->GetGlobalParsedConfig(
+              internal::AdaptiveThrottleServiceConfigParser::ParserIndex()));
+  if (config == nullptr) return AdaptiveThrottleFilter(nullptr);
+  // Get server name from target URI.
+  auto server_uri = args.GetString(GRPC_ARG_SERVER_URI);
+  if (!server_uri.has_value()) {
+    return absl::InternalError(
+        "server URI channel arg missing or wrong type in client channel "
+        "filter");
+  }
+  absl::StatusOr<URI> uri = URI::Parse(*server_uri);
+  if (!uri.ok() || uri->path().empty()) {
+    return absl::InternalError(
+        "could not extract server name from target URI");
+  }
+  std::string server_name(absl::StripPrefix(uri->path(), "/"));
+  return AdaptiveThrottleFilter(
+      internal::ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+          server_name, config->window(), config->accepts_multiplier()));
+}
+
+ArenaPromise<ServerMetadataHandle> AdaptiveThrottleFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  if (throttle_data_ == nullptr) {
+    return next_promise_factory(std::move(call_args));
+  }
+  if (!throttle_data_->RecordRequest()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_adaptive_throttle_trace)) {
+      gpr_log(GPR_INFO,
+              "[adaptive_throttle %p] rejecting call locally with "
+              "probability %f",
+              throttle_data_.get(), throttle_data_->reject_probability());
+    }
+    return Immediate(ServerMetadataFromStatus(
+        absl::UnavailableError("Call throttled by client")));
+  }
+  // Calls the server turns away for being overloaded don't count as
+  // accepted; everything else does, whether or not it succeeded.  A status
+  // the client generated itself, such as UNAVAILABLE because there is no
+  // connection, says nothing about the server's load.
+  return Map(next_promise_factory(std::move(call_args)),
+             [throttle_data = throttle_data_](
+                 ServerMetadataHandle trailing_metadata) {
+               const grpc_status_code status =
+                   trailing_metadata->get(GrpcStatusMetadata())
+                       .value_or(GRPC_STATUS_UNKNOWN);
+               const bool from_server =
+                   trailing_metadata->get(GrpcStatusFromWire())
+                       .value_or(false);
+               if (!from_server || (status != GRPC_STATUS_RESOURCE_EXHAUSTED &&
+                                    status != GRPC_STATUS_UNAVAILABLE)) {
+                 throttle_data->RecordAccept();
+               }
+               return trailing_metadata;
+             });
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,106 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+namespace internal {
+
+// The adaptiveThrottling field of the service config.
+class AdaptiveThrottleGlobalConfig : public ServiceConfigParser::ParsedConfig {
+ public:
+  Duration window() const { return window_; }
+  double accepts_multiplier() const { return accepts_multiplier_; }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+  void JsonPostLoad(const Json& json, const JsonArgs& args,
+                    ValidationErrors* errors);
+
+ private:
+  Duration window_ = Duration::Minutes(2);
+  double accepts_multiplier_ = 2;
+};
+
+class AdaptiveThrottleServiceConfigParser : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParseGlobalParams(
+      const ChannelArgs& /*args*/, const Json& json,
+      ValidationErrors* errors) override;
+
+  static size_t ParserIndex();
+  static void Register(CoreConfiguration::Builder* builder);
+
+ private:
+  static absl::string_view parser_name() { return "adaptive_throttle"; }
+};
+
+}  // namespace internal
+
+// Dynamic filter that applies client-side adaptive throttling, rejecting
+// calls locally with UNAVAILABLE while the server is turning away too many
+// of them.  Added to the dynamic filter stack by the client channel when
+// the service config sets adaptiveThrottling.
+class AdaptiveThrottleFilter : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<AdaptiveThrottleFilter> Create(
+      const ChannelArgs& args, ChannelFilter::Args filter_args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ private:
+  explicit AdaptiveThrottleFilter(
+      RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data)
+      : throttle_data_(std::move(throttle_data)) {}
+
+  // Null if the service config doesn't enable throttling.
+  RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
@@ -48,6 +48,7 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
 
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
 #include "src/core/ext/filters/client_channel/backend_metric.h"
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
@@ -1053,13 +1054,16 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
                              grpc_error_handle* error)
     : channel_args_(args->channel_args),
       deadline_checking_enabled_(grpc_deadline_checking_enabled(channel_args_)),
+      deadline_timer_queue_(MakeOrphanable<DeadlineTimerQueue>(channel_args_)),
       owning_stack_(args->channel_stack),
       client_channel_factory_(channel_args_.GetObject<ClientChannelFactory>()),
       channelz_node_(channel_args_.GetObject<channelz::ChannelNode>()),
       interested_parties_(grpc_pollset_set_create()),
       service_config_parser_index_(
           internal::ClientChannelServiceConfigParser::ParserIndex()),
-      work_serializer_(std::make_shared<WorkSerializer>()),
+      work_serializer_(std::make_shared<WorkSerializer>(
+          channel_args_.GetObjectRef<
+              grpc_event_engine::experimental::EventEngine>())),
       state_tracker_("client_channel", GRPC_CHANNEL_IDLE),
       subchannel_pool_(GetSubchannelPool(channel_args_)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_trace)) {
@@ -1506,13 +1510,19 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
   // Construct dynamic filter stack.
   std::vector<const grpc_channel_filter*> filters =
       config_selector->GetFilters();
+  if (!new_args.WantMinimalStack() &&
+      service_config->GetGlobalParsedConfig(
+          internal::AdaptiveThrottleServiceConfigParser::ParserIndex()) !=
+          nullptr) {
+    filters.push_back(&AdaptiveThrottleFilter::kFilter);
+  }
   if (enable_retries) {
     filters.push_back(&kRetryFilterVtable);
   } else {
     filters.push_back(&DynamicTerminationFilter::kFilterVtable);
   }
-  RefCountedPtr<DynamicFilters> dynamic_filters =
-      DynamicFilters::Create(new_args, std::move(filters));
+  RefCountedPtr<DynamicFilters> dynamic_filters = DynamicFilters::Create(
+      new_args, std::move(filters), config_selector->GetNoopFilters());
   GPR_ASSERT(dynamic_filters != nullptr);
   // Grab data plane lock to update service config.
   //
@@ -1898,6 +1908,12 @@ grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
         !wait_for_ready->explicitly_set) {
       wait_for_ready->value = method_params->wait_for_ready().value();
     }
+    // Likewise for the HTTP/2 stream weight.
+    if (method_params->stream_weight().has_value() &&
+        send_initial_metadata()->get(GrpcStreamWeight()) == absl::nullopt) {
+      send_initial_metadata()->Set(GrpcStreamWeight(),
+                                   *method_params->stream_weight());
+    }
   }
   return absl::OkStatus();
 }
@@ -1991,7 +2007,9 @@ ClientChannel::FilterBasedCallData::FilterBasedCallData(
                       GPR_LIKELY(static_cast<ClientChannel*>(elem->channel_data)
                                      ->deadline_checking_enabled_)
                           ? args.deadline
-                          : Timestamp::InfFuture()) {
+                          : Timestamp::InfFuture(),
+                      static_cast<ClientChannel*>(elem->channel_data)
+                          ->deadline_timer_queue_.get()) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: created call", chand(), this);
   }
@@ -2325,9 +2343,18 @@ void ClientChannel::FilterBasedCallData::RetryCheckResolutionLocked() {
 }
 
 void ClientChannel::FilterBasedCallData::CreateDynamicCall() {
-  DynamicFilters::Call::Args args = {dynamic_filters(), pollent_,       path_,
-                                     call_start_time_,  deadline_,      arena(),
-                                     call_context_,     call_combiner()};
+  // Use the dynamic filters specialized for the call's method config, which
+  // leave out the filters that have nothing to do for the call.
+  RefCountedPtr<DynamicFilters> dynamic_filters = this->dynamic_filters();
+  auto* service_config_call_data = static_cast<ServiceConfigCallData*>(
+      call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (service_config_call_data != nullptr) {
+    dynamic_filters =
+        dynamic_filters->ForMethod(service_config_call_data->method_configs());
+  }
+  DynamicFilters::Call::Args args = {
+      std::move(dynamic_filters), pollent_, path_, call_start_time_,
+      deadline_, arena(), call_context_, call_combiner()};
   grpc_error_handle error;
   DynamicFilters* channel_stack = args.channel_stack.get();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
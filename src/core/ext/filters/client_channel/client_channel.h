@@ -43,6 +43,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/lib/channel/call_tracer.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
@@ -283,6 +284,8 @@ class ClientChannel {
   //
   ChannelArgs channel_args_;
   const bool deadline_checking_enabled_;
+  // Drives the deadline timers of all calls on this channel.
+  OrphanablePtr<DeadlineTimerQueue> deadline_timer_queue_;
   grpc_channel_stack* owning_stack_;
   ClientChannelFactory* client_channel_factory_;
   RefCountedPtr<ServiceConfig> default_service_config_;
@@ -28,6 +28,7 @@
 #include "absl/types/optional.h"
 
 #include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/transport/metadata_batch.h"
 
 // As per the retry design, we do not allow more than 5 retry attempts.
 #define MAX_MAX_RETRY_ATTEMPTS 5
@@ -115,10 +116,25 @@ const JsonLoaderInterface* ClientChannelMethodParsedConfig::JsonLoader(
           .OptionalField("timeout", &ClientChannelMethodParsedConfig::timeout_)
           .OptionalField("waitForReady",
                          &ClientChannelMethodParsedConfig::wait_for_ready_)
+          .OptionalField("streamWeight",
+                         &ClientChannelMethodParsedConfig::stream_weight_)
           .Finish();
   return loader;
 }
 
+void ClientChannelMethodParsedConfig::JsonPostLoad(const Json& /*json*/,
+                                                   const JsonArgs&,
+                                                   ValidationErrors* errors) {
+  if (stream_weight_.has_value() &&
+      (*stream_weight_ < GrpcStreamWeight::kMin ||
+       *stream_weight_ > GrpcStreamWeight::kMax)) {
+    ValidationErrors::ScopedField field(errors, ".streamWeight");
+    errors->AddError(absl::StrCat("must be in the range [",
+                                  GrpcStreamWeight::kMin, ", ",
+                                  GrpcStreamWeight::kMax, "]"));
+  }
+}
+
 //
 // ClientChannelServiceConfigParser
 //
@@ -20,6 +20,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <string>
@@ -79,11 +80,17 @@ class ClientChannelMethodParsedConfig
 
   absl::optional<bool> wait_for_ready() const { return wait_for_ready_; }
 
+  // HTTP/2 stream weight (1..256) to request for calls to this method.
+  absl::optional<uint32_t> stream_weight() const { return stream_weight_; }
+
   static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+  void JsonPostLoad(const Json& json, const JsonArgs&,
+                    ValidationErrors* errors);
 
  private:
   Duration timeout_;
   absl::optional<bool> wait_for_ready_;
+  absl::optional<uint32_t> stream_weight_;
 };
 
 class ClientChannelServiceConfigParser : public ServiceConfigParser::Parser {
@@ -31,6 +31,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/client_channel_internal.h"
+#include "src/core/ext/filters/client_channel/dynamic_filters.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -70,6 +71,15 @@ class ConfigSelector : public RefCounted<ConfigSelector> {
   // to determine what set of dynamic filters will be configured.
   virtual std::vector<const grpc_channel_filter*> GetFilters() { return {}; }
 
+  // Returns every method config that GetCallConfig() may set, and a
+  // function telling whether the filter at a given position in GetFilters()
+  // has nothing to do for calls with a given method config. The channel
+  // leaves such filters out of those calls' dynamic filters. Positions past
+  // the end of GetFilters() are for filters added by the channel, for which
+  // the function must return false. The function is null if the filters
+  // always have work to do.
+  virtual DynamicFilters::NoopFilters GetNoopFilters() { return {}; }
+
   // Returns the call config to use for the call, or a status to fail
   // the call with.
   virtual absl::Status GetCallConfig(GetCallConfigArgs args) = 0;
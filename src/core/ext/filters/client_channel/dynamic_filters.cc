@@ -20,6 +20,8 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <map>
 #include <new>
 #include <string>
 #include <utility>
@@ -150,17 +152,79 @@ absl::StatusOr<RefCountedPtr<grpc_channel_stack>> CreateChannelStack(
 }  // namespace
 
 RefCountedPtr<DynamicFilters> DynamicFilters::Create(
-    const ChannelArgs& args, std::vector<const grpc_channel_filter*> filters) {
+    const ChannelArgs& args, std::vector<const grpc_channel_filter*> filters,
+    NoopFilters noop_filters) {
   // Attempt to create channel stack from requested filters.
-  auto p = CreateChannelStack(args, std::move(filters));
+  auto p = CreateChannelStack(args, filters);
   if (!p.ok()) {
     // Channel stack creation failed with requested filters.
     // Create with lame filter instead.
     auto error = p.status();
     p = CreateChannelStack(args.Set(MakeLameClientErrorArg(&error)),
                            {&LameClientFilter::kFilter});
+    return MakeRefCounted<DynamicFilters>(std::move(p.value()));
+  }
+  auto dynamic_filters = MakeRefCounted<DynamicFilters>(std::move(p.value()));
+  if (noop_filters.is_noop == nullptr) return dynamic_filters;
+  // Stacks by which of the filters they keep.
+  std::map<std::vector<bool>, RefCountedPtr<DynamicFilters>> stacks;
+  for (MethodConfig& method_config : noop_filters.method_configs) {
+    if (dynamic_filters->method_stacks_.contains(
+            method_config.method_configs)) {
+      continue;
+    }
+    // Filters find their per-method config by their instance number, i.e.
+    // how many instances of the same filter come before them in the stack,
+    // so an instance is only left out if all later instances are left out
+    // too.
+    std::vector<bool> keep(filters.size());
+    std::vector<const grpc_channel_filter*> kept_filters;
+    bool all_kept = true;
+    for (size_t i = filters.size(); i-- > 0;) {
+      keep[i] = std::find(kept_filters.begin(), kept_filters.end(),
+                          filters[i]) != kept_filters.end() ||
+                !noop_filters.is_noop(i, method_config.method_configs);
+      if (keep[i]) {
+        kept_filters.push_back(filters[i]);
+      } else {
+        all_kept = false;
+      }
+    }
+    if (all_kept) continue;
+    auto it = stacks.find(keep);
+    if (it == stacks.end()) {
+      std::vector<const grpc_channel_filter*> stack_filters;
+      for (size_t i = 0; i < filters.size(); ++i) {
+        if (keep[i]) stack_filters.push_back(filters[i]);
+      }
+      auto stack = CreateChannelStack(args, std::move(stack_filters));
+      if (!stack.ok()) {
+        gpr_log(GPR_ERROR,
+                "failed to create specialized dynamic filter stack, using "
+                "the full stack instead: %s",
+                stack.status().ToString().c_str());
+        continue;
+      }
+      it = stacks
+               .emplace(std::move(keep),
+                        MakeRefCounted<DynamicFilters>(std::move(*stack)))
+               .first;
+    }
+    dynamic_filters->method_stacks_.emplace(method_config.method_configs,
+                                            it->second);
+    if (method_config.service_config != nullptr) {
+      dynamic_filters->service_configs_.push_back(
+          std::move(method_config.service_config));
+    }
   }
-  return MakeRefCounted<DynamicFilters>(std::move(p.value()));
+  return dynamic_filters;
+}
+
+RefCountedPtr<DynamicFilters> DynamicFilters::ForMethod(
+    const ServiceConfigParser::ParsedConfigVector* method_configs) {
+  auto it = method_stacks_.find(method_configs);
+  if (it == method_stacks_.end()) return Ref();
+  return it->second;
 }
 
 RefCountedPtr<DynamicFilters::Call> DynamicFilters::CreateCall(
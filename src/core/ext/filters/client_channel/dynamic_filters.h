@@ -19,9 +19,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+
 #include <grpc/slice.h>
 
 #include "src/core/lib/channel/channel_args.h"
@@ -38,6 +43,8 @@
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/transport/transport.h"
 
 namespace grpc_core {
@@ -91,16 +98,52 @@ class DynamicFilters : public RefCounted<DynamicFilters> {
     grpc_closure* after_call_stack_destroy_ = nullptr;
   };
 
+  // Tells whether the filter at the given position in the stack has nothing
+  // to do for calls with the given method config, which may be null.
+  using NoopFilterPredicate = absl::AnyInvocable<bool(
+      size_t index,
+      const ServiceConfigParser::ParsedConfigVector* method_configs) const>;
+
+  // A method config that calls may get, along with the service config that
+  // owns it.
+  struct MethodConfig {
+    RefCountedPtr<ServiceConfig> service_config;
+    const ServiceConfigParser::ParsedConfigVector* method_configs;
+  };
+
+  // Which filters can be left out of calls with which method configs.
+  struct NoopFilters {
+    NoopFilterPredicate is_noop;
+    std::vector<MethodConfig> method_configs;
+  };
+
+  // Also builds, for each of noop_filters.method_configs, a stack without the
+  // filters that have nothing to do for calls with it.
   static RefCountedPtr<DynamicFilters> Create(
-      const ChannelArgs& args, std::vector<const grpc_channel_filter*> filters);
+      const ChannelArgs& args, std::vector<const grpc_channel_filter*> filters,
+      NoopFilters noop_filters = {});
 
   explicit DynamicFilters(RefCountedPtr<grpc_channel_stack> channel_stack)
       : channel_stack_(std::move(channel_stack)) {}
 
+  // Returns the stack to use for calls with the given method config: the one
+  // that Create() built for it, or this one. The stacks are not changed after
+  // Create(), so this takes no lock.
+  RefCountedPtr<DynamicFilters> ForMethod(
+      const ServiceConfigParser::ParsedConfigVector* method_configs);
+
   RefCountedPtr<Call> CreateCall(Call::Args args, grpc_error_handle* error);
 
  private:
   RefCountedPtr<grpc_channel_stack> channel_stack_;
+  // Keep the keys of method_stacks_ from being freed and their addresses
+  // reused.
+  std::vector<RefCountedPtr<ServiceConfig>> service_configs_;
+  // The stacks of the method configs whose calls can do without some of the
+  // filters. Method configs that leave out the same filters share a stack.
+  absl::flat_hash_map<const ServiceConfigParser::ParsedConfigVector*,
+                      RefCountedPtr<DynamicFilters>>
+      method_stacks_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,189 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/power_of_choices.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_least_request_trace(false, "least_request_lb");
+
+namespace {
+
+//
+// least_request LB policy
+//
+
+constexpr absl::string_view kLeastRequest = "least_request";
+
+// Config for least_request policy.
+class LeastRequestConfig : public LoadBalancingPolicy::Config {
+ public:
+  LeastRequestConfig() = default;
+
+  LeastRequestConfig(const LeastRequestConfig&) = delete;
+  LeastRequestConfig& operator=(const LeastRequestConfig&) = delete;
+
+  LeastRequestConfig(LeastRequestConfig&&) = delete;
+  LeastRequestConfig& operator=(LeastRequestConfig&&) = delete;
+
+  absl::string_view name() const override { return kLeastRequest; }
+
+  uint32_t choice_count() const { return choice_count_; }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<LeastRequestConfig>()
+            .OptionalField("choiceCount", &LeastRequestConfig::choice_count_)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors* errors) {
+    ValidateChoiceCount(&choice_count_, errors);
+  }
+
+ private:
+  uint32_t choice_count_ = 2;
+};
+
+// Load metric for least_request: the number of calls in flight.
+class OutstandingRequestsMetric {
+ public:
+  // Number of calls currently in flight on a subchannel.
+  class Stats : public RefCounted<Stats> {
+   public:
+    uint64_t Get() const { return count_.load(std::memory_order_relaxed); }
+    void Increment() { count_.fetch_add(1, std::memory_order_relaxed); }
+    void Decrement() { count_.fetch_sub(1, std::memory_order_relaxed); }
+
+   private:
+    std::atomic<uint64_t> count_{0};
+  };
+
+  // Nothing needs to be computed ahead of the candidates.
+  struct PickContext {};
+
+  explicit OutstandingRequestsMetric(const LeastRequestConfig& /*config*/) {}
+
+  static TraceFlag* trace_flag() { return &grpc_lb_least_request_trace; }
+  static const char* tag() { return "LR"; }
+
+  PickContext StartPick() const { return PickContext(); }
+
+  uint64_t Load(const Stats& stats, const PickContext& /*context*/) const {
+    return stats.Get();
+  }
+
+  std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+  MakeCallTracker(RefCountedPtr<Stats> stats) const {
+    return std::make_unique<SubchannelCallTracker>(std::move(stats));
+  }
+
+  std::string ToString(const Stats& stats) const {
+    return absl::StrFormat("outstanding_requests=%d", stats.Get());
+  }
+
+ private:
+  // Counts a call against its subchannel for as long as it is in flight.
+  class SubchannelCallTracker
+      : public LoadBalancingPolicy::SubchannelCallTrackerInterface {
+   public:
+    explicit SubchannelCallTracker(RefCountedPtr<Stats> outstanding_requests)
+        : outstanding_requests_(std::move(outstanding_requests)) {}
+
+    ~SubchannelCallTracker() override {
+      // Not expected to happen, but don't leak the count if the call is
+      // dropped between Start() and Finish().
+      if (started_) outstanding_requests_->Decrement();
+    }
+
+    void Start() override {
+      outstanding_requests_->Increment();
+      started_ = true;
+    }
+
+    void Finish(FinishArgs /*args*/) override {
+      if (!started_) return;
+      outstanding_requests_->Decrement();
+      started_ = false;
+    }
+
+   private:
+    RefCountedPtr<Stats> outstanding_requests_;
+    bool started_ = false;
+  };
+};
+
+class LeastRequest
+    : public PowerOfChoicesLb<OutstandingRequestsMetric, LeastRequestConfig> {
+ public:
+  using PowerOfChoicesLb::PowerOfChoicesLb;
+
+  absl::string_view name() const override { return kLeastRequest; }
+};
+
+//
+// factory
+//
+
+class LeastRequestFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<LeastRequest>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kLeastRequest; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    return LoadFromJson<RefCountedPtr<LeastRequestConfig>>(
+        json, JsonArgs(), "errors validating least_request LB policy config");
+  }
+};
+
+}  // namespace
+
+void RegisterLeastRequestLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      std::make_unique<LeastRequestFactory>());
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,292 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/power_of_choices.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_peak_ewma_trace(false, "peak_ewma_lb");
+
+namespace {
+
+//
+// peak_ewma LB policy
+//
+
+constexpr absl::string_view kPeakEwma = "peak_ewma";
+
+// Config for peak_ewma policy.
+class PeakEwmaConfig : public LoadBalancingPolicy::Config {
+ public:
+  PeakEwmaConfig() = default;
+
+  PeakEwmaConfig(const PeakEwmaConfig&) = delete;
+  PeakEwmaConfig& operator=(const PeakEwmaConfig&) = delete;
+
+  PeakEwmaConfig(PeakEwmaConfig&&) = delete;
+  PeakEwmaConfig& operator=(PeakEwmaConfig&&) = delete;
+
+  absl::string_view name() const override { return kPeakEwma; }
+
+  uint32_t choice_count() const { return choice_count_; }
+  Duration decay_time() const { return decay_time_; }
+  Duration default_rtt() const { return default_rtt_; }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<PeakEwmaConfig>()
+            .OptionalField("choiceCount", &PeakEwmaConfig::choice_count_)
+            .OptionalField("decayTime", &PeakEwmaConfig::decay_time_)
+            .OptionalField("defaultRtt", &PeakEwmaConfig::default_rtt_)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors* errors) {
+    ValidateChoiceCount(&choice_count_, errors);
+    if (decay_time_ <= Duration::Zero()) {
+      ValidationErrors::ScopedField field(errors, ".decayTime");
+      errors->AddError("must be greater than 0");
+    }
+  }
+
+ private:
+  uint32_t choice_count_ = 2;
+  // Time constant of the latency average: older samples lose weight by a
+  // factor of e every decayTime.
+  Duration decay_time_ = Duration::Seconds(10);
+  // Latency assumed for a subchannel that hasn't completed any calls yet.
+  Duration default_rtt_ = Duration::Milliseconds(30);
+};
+
+// Monotonic time in nanoseconds.  Timestamp only has millisecond
+// resolution, which is too coarse for the latencies this policy compares.
+int64_t NowNanos() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+// Load metric for peak_ewma: the latency estimate times the number of
+// calls that would be in flight if the pick went to the subchannel.
+class LatencyMetric {
+ public:
+  // Latency and load of a subchannel.
+  //
+  // The latency estimate is a peak-sensitive EWMA: a sample larger than
+  // the current estimate replaces it outright, so a replica that slows
+  // down is avoided from its first slow response, while smaller samples
+  // only pull the estimate down gradually.  Samples are written under a
+  // lock from Finish(); the pick path only reads atomics, so it never
+  // waits.
+  class Stats : public RefCounted<Stats> {
+   public:
+    uint64_t outstanding() const {
+      return outstanding_.load(std::memory_order_relaxed);
+    }
+    void AddOutstanding() {
+      outstanding_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void RemoveOutstanding() {
+      outstanding_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Folds a call's latency into the estimate.
+    void AddLatencySample(int64_t now_ns, double rtt_ns, double decay_ns);
+
+    // Returns the latency estimate, decayed for the time since the last
+    // sample, or default_rtt_ns if there hasn't been a sample yet.
+    double Latency(int64_t now_ns, double decay_ns,
+                   double default_rtt_ns) const;
+
+   private:
+    std::atomic<uint64_t> outstanding_{0};
+    Mutex mu_;
+    // Negative until the first sample.
+    std::atomic<double> latency_ns_{-1};
+    std::atomic<int64_t> last_sample_ns_{0};
+  };
+
+  // The clock is read once per pick rather than once per candidate.
+  struct PickContext {
+    int64_t now_ns;
+  };
+
+  explicit LatencyMetric(const PeakEwmaConfig& config)
+      : decay_ns_(static_cast<double>(config.decay_time().millis()) *
+                  GPR_NS_PER_MS),
+        default_rtt_ns_(static_cast<double>(config.default_rtt().millis()) *
+                        GPR_NS_PER_MS) {}
+
+  static TraceFlag* trace_flag() { return &grpc_lb_peak_ewma_trace; }
+  static const char* tag() { return "PE"; }
+
+  PickContext StartPick() const { return PickContext{NowNanos()}; }
+
+  // Expected cost of sending one more call to this subchannel.
+  double Load(const Stats& stats, const PickContext& context) const {
+    return stats.Latency(context.now_ns, decay_ns_, default_rtt_ns_) *
+           static_cast<double>(stats.outstanding() + 1);
+  }
+
+  std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+  MakeCallTracker(RefCountedPtr<Stats> stats) const {
+    return std::make_unique<SubchannelCallTracker>(std::move(stats),
+                                                   decay_ns_);
+  }
+
+  std::string ToString(const Stats& stats) const {
+    return absl::StrFormat(
+        "outstanding_requests=%d, latency=%.0fns", stats.outstanding(),
+        stats.Latency(NowNanos(), decay_ns_, default_rtt_ns_));
+  }
+
+ private:
+  // Counts a call against its subchannel while it is in flight, and
+  // reports its latency when it finishes.
+  class SubchannelCallTracker
+      : public LoadBalancingPolicy::SubchannelCallTrackerInterface {
+   public:
+    SubchannelCallTracker(RefCountedPtr<Stats> stats, double decay_ns)
+        : stats_(std::move(stats)), decay_ns_(decay_ns) {}
+
+    ~SubchannelCallTracker() override {
+      // Not expected to happen, but don't leak the count if the call is
+      // dropped between Start() and Finish().
+      if (start_ns_ != 0) stats_->RemoveOutstanding();
+    }
+
+    void Start() override {
+      stats_->AddOutstanding();
+      start_ns_ = NowNanos();
+    }
+
+    void Finish(FinishArgs /*args*/) override {
+      if (start_ns_ == 0) return;
+      const int64_t now_ns = NowNanos();
+      stats_->AddLatencySample(now_ns, static_cast<double>(now_ns - start_ns_),
+                               decay_ns_);
+      stats_->RemoveOutstanding();
+      start_ns_ = 0;
+    }
+
+   private:
+    RefCountedPtr<Stats> stats_;
+    const double decay_ns_;
+    int64_t start_ns_ = 0;
+  };
+
+  const double decay_ns_;
+  const double default_rtt_ns_;
+};
+
+//
+// LatencyMetric::Stats
+//
+
+void LatencyMetric::Stats::AddLatencySample(int64_t now_ns, double rtt_ns,
+                                            double decay_ns) {
+  MutexLock lock(&mu_);
+  double latency_ns = latency_ns_.load(std::memory_order_relaxed);
+  if (latency_ns < 0 || rtt_ns > latency_ns) {
+    latency_ns = rtt_ns;
+  } else {
+    const int64_t elapsed_ns =
+        std::max<int64_t>(0, now_ns - last_sample_ns_.load(
+                                          std::memory_order_relaxed));
+    const double w = exp(-static_cast<double>(elapsed_ns) / decay_ns);
+    latency_ns = latency_ns * w + rtt_ns * (1 - w);
+  }
+  last_sample_ns_.store(now_ns, std::memory_order_relaxed);
+  latency_ns_.store(latency_ns, std::memory_order_relaxed);
+}
+
+double LatencyMetric::Stats::Latency(int64_t now_ns, double decay_ns,
+                                     double default_rtt_ns) const {
+  const double latency_ns = latency_ns_.load(std::memory_order_relaxed);
+  if (latency_ns < 0) return default_rtt_ns;
+  // Let the estimate decay while no samples arrive, so that a subchannel
+  // that was avoided because of a latency spike gets retried eventually.
+  const int64_t elapsed_ns =
+      now_ns - last_sample_ns_.load(std::memory_order_relaxed);
+  if (elapsed_ns <= 0) return latency_ns;
+  return latency_ns * exp(-static_cast<double>(elapsed_ns) / decay_ns);
+}
+
+class PeakEwma : public PowerOfChoicesLb<LatencyMetric, PeakEwmaConfig> {
+ public:
+  using PowerOfChoicesLb::PowerOfChoicesLb;
+
+  absl::string_view name() const override { return kPeakEwma; }
+};
+
+//
+// factory
+//
+
+class PeakEwmaFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<PeakEwma>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kPeakEwma; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    return LoadFromJson<RefCountedPtr<PeakEwmaConfig>>(
+        json, JsonArgs(), "errors validating peak_ewma LB policy config");
+  }
+};
+
+}  // namespace
+
+void RegisterPeakEwmaLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      std::make_unique<PeakEwmaFactory>());
+}
+
+}  // namespace grpc_core
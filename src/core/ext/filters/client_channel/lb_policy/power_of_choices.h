@@ -0,0 +1,612 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_H
+#define GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_H
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/connectivity_state.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+// Validates the choiceCount field of a power-of-choices policy's config.
+// Values above 10 are capped: more choices than that only add pick cost
+// without improving the balance.
+inline void ValidateChoiceCount(uint32_t* choice_count,
+                                ValidationErrors* errors) {
+  if (*choice_count < 2) {
+    ValidationErrors::ScopedField field(errors, ".choiceCount");
+    errors->AddError("must be at least 2");
+  }
+  *choice_count = std::min(*choice_count, 10u);
+}
+
+// A policy that samples choice_count READY subchannels at random for each
+// pick and returns the least loaded of them.
+//
+// Metric defines what "loaded" means.  It must provide:
+// - A constructor taking `const PolicyConfig&`.  A new Metric is built for
+//   each picker, from the config that was current at the time.
+// - Metric::Stats, derived from RefCounted<Stats>: the load of one
+//   subchannel.  It is shared between the subchannel list, the pickers and
+//   the call trackers, so that calls started from an older picker are still
+//   accounted for.
+// - Metric::PickContext and `PickContext StartPick() const`: whatever is
+//   computed once per pick rather than once per candidate.
+// - `Load(const Stats&, const PickContext&) const`, returning a value that
+//   is compared with operator<.
+// - `MakeCallTracker(RefCountedPtr<Stats>) const`, returning the
+//   SubchannelCallTrackerInterface that keeps Stats up to date for a call.
+// - `std::string ToString(const Stats&) const`, for tracing.
+// - Static `TraceFlag* trace_flag()` and `const char* tag()`, the latter
+//   used to prefix log lines.
+//
+// PolicyConfig must provide `uint32_t choice_count() const`.
+template <typename Metric, typename PolicyConfig>
+class PowerOfChoicesLb : public LoadBalancingPolicy {
+ public:
+  explicit PowerOfChoicesLb(Args args);
+
+  absl::Status UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ protected:
+  ~PowerOfChoicesLb() override;
+
+ private:
+  using Stats = typename Metric::Stats;
+
+  // Forward declaration.
+  class PowerOfChoicesSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class PowerOfChoicesSubchannelData
+      : public SubchannelData<PowerOfChoicesSubchannelList,
+                              PowerOfChoicesSubchannelData> {
+   public:
+    PowerOfChoicesSubchannelData(
+        SubchannelList<PowerOfChoicesSubchannelList,
+                       PowerOfChoicesSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData<PowerOfChoicesSubchannelList,
+                         PowerOfChoicesSubchannelData>(
+              subchannel_list, address, std::move(subchannel)),
+          stats_(MakeRefCounted<Stats>()) {}
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    RefCountedPtr<Stats> stats() const { return stats_; }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.
+    void UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<Stats> stats_;
+  };
+
+  // A list of subchannels.
+  class PowerOfChoicesSubchannelList
+      : public SubchannelList<PowerOfChoicesSubchannelList,
+                              PowerOfChoicesSubchannelData> {
+   public:
+    PowerOfChoicesSubchannelList(PowerOfChoicesLb* policy,
+                                 ServerAddressList addresses,
+                                 const ChannelArgs& args)
+        : SubchannelList<PowerOfChoicesSubchannelList,
+                         PowerOfChoicesSubchannelData>(
+              policy,
+              (TraceEnabled() ? "PowerOfChoicesSubchannelList" : nullptr),
+              std::move(addresses), policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~PowerOfChoicesSubchannelList() override {
+      PowerOfChoicesLb* p = static_cast<PowerOfChoicesLb*>(this->policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateConnectivityStateLocked(absl::Status status_for_tf);
+
+   private:
+    std::shared_ptr<WorkSerializer> work_serializer() const override {
+      return static_cast<PowerOfChoicesLb*>(this->policy())->work_serializer();
+    }
+
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", this->num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    absl::Status last_failure_;
+  };
+
+  // A picker that samples choice_count READY subchannels at random and
+  // returns the one with the lowest load.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(PowerOfChoicesLb* parent,
+           PowerOfChoicesSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Info stored about each subchannel.
+    struct SubchannelInfo {
+      SubchannelInfo(RefCountedPtr<SubchannelInterface> subchannel,
+                     RefCountedPtr<Stats> stats)
+          : subchannel(std::move(subchannel)), stats(std::move(stats)) {}
+
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<Stats> stats;
+    };
+
+    // Returns a random index into subchannels_.  Picks may run
+    // concurrently, so this uses a lock-free SplitMix64 generator rather
+    // than a shared absl::BitGen.
+    size_t RandomIndex();
+
+    // Using pointer value only, no ref held -- do not dereference!
+    PowerOfChoicesLb* parent_;
+
+    const Metric metric_;
+    const uint32_t choice_count_;
+    std::atomic<uint64_t> random_state_;
+    std::vector<SubchannelInfo> subchannels_;
+  };
+
+  static bool TraceEnabled() {
+    return GRPC_TRACE_FLAG_ENABLED(*Metric::trace_flag());
+  }
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<PolicyConfig> config_;
+
+  // List of subchannels.
+  RefCountedPtr<PowerOfChoicesSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  RefCountedPtr<PowerOfChoicesSubchannelList> latest_pending_subchannel_list_;
+
+  bool shutdown_ = false;
+
+  absl::BitGen bit_gen_;
+};
+
+//
+// PowerOfChoicesLb::Picker
+//
+
+template <typename Metric, typename PolicyConfig>
+PowerOfChoicesLb<Metric, PolicyConfig>::Picker::Picker(
+    PowerOfChoicesLb* parent, PowerOfChoicesSubchannelList* subchannel_list)
+    : parent_(parent),
+      metric_(*parent->config_),
+      choice_count_(parent->config_->choice_count()),
+      random_state_(absl::Uniform<uint64_t>(parent->bit_gen_)) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    PowerOfChoicesSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+        GRPC_CHANNEL_READY) {
+      subchannels_.emplace_back(sd->subchannel()->Ref(), sd->stats());
+    }
+  }
+  if (TraceEnabled()) {
+    gpr_log(GPR_INFO,
+            "[%s %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; choice_count=%" PRIu32,
+            Metric::tag(), parent_, this, subchannel_list,
+            subchannels_.size(), choice_count_);
+  }
+}
+
+template <typename Metric, typename PolicyConfig>
+size_t PowerOfChoicesLb<Metric, PolicyConfig>::Picker::RandomIndex() {
+  uint64_t z = random_state_.fetch_add(0x9e3779b97f4a7c15,
+                                       std::memory_order_relaxed) +
+               0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z ^= z >> 31;
+  return static_cast<size_t>(z % subchannels_.size());
+}
+
+template <typename Metric, typename PolicyConfig>
+LoadBalancingPolicy::PickResult
+PowerOfChoicesLb<Metric, PolicyConfig>::Picker::Pick(PickArgs /*args*/) {
+  size_t index = 0;
+  if (subchannels_.size() > 1) {
+    // Power of choice_count choices: sample with replacement, and keep
+    // the candidate with the lowest load.  Ties go to the first candidate
+    // sampled, which is itself random.
+    const typename Metric::PickContext context = metric_.StartPick();
+    index = RandomIndex();
+    auto min_load = metric_.Load(*subchannels_[index].stats, context);
+    for (uint32_t i = 1; i < choice_count_; ++i) {
+      const size_t candidate = RandomIndex();
+      const auto load = metric_.Load(*subchannels_[candidate].stats, context);
+      if (load < min_load) {
+        index = candidate;
+        min_load = load;
+      }
+    }
+  }
+  const SubchannelInfo& subchannel_info = subchannels_[index];
+  if (TraceEnabled()) {
+    gpr_log(GPR_INFO,
+            "[%s %p picker %p] returning index %" PRIuPTR
+            ", subchannel=%p, %s",
+            Metric::tag(), parent_, this, index,
+            subchannel_info.subchannel.get(),
+            metric_.ToString(*subchannel_info.stats).c_str());
+  }
+  return PickResult::Complete(subchannel_info.subchannel,
+                              metric_.MakeCallTracker(subchannel_info.stats));
+}
+
+//
+// PowerOfChoicesLb
+//
+
+template <typename Metric, typename PolicyConfig>
+PowerOfChoicesLb<Metric, PolicyConfig>::PowerOfChoicesLb(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (TraceEnabled()) {
+    gpr_log(GPR_INFO, "[%s %p] Created", Metric::tag(), this);
+  }
+}
+
+template <typename Metric, typename PolicyConfig>
+PowerOfChoicesLb<Metric, PolicyConfig>::~PowerOfChoicesLb() {
+  if (TraceEnabled()) {
+    gpr_log(GPR_INFO, "[%s %p] Destroying policy", Metric::tag(), this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::ShutdownLocked() {
+  if (TraceEnabled()) {
+    gpr_log(GPR_INFO, "[%s %p] Shutting down", Metric::tag(), this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+template <typename Metric, typename PolicyConfig>
+absl::Status PowerOfChoicesLb<Metric, PolicyConfig>::UpdateLocked(
+    UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO, "[%s %p] received update with %" PRIuPTR " addresses",
+              Metric::tag(), this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO, "[%s %p] received update with address error: %s",
+              Metric::tag(), this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then keep using the existing
+    // list, but still report back that the update was not accepted.
+    if (subchannel_list_ != nullptr) return args.addresses.status();
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (TraceEnabled() && latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[%s %p] replacing previous pending subchannel list %p",
+            Metric::tag(), this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ =
+      MakeRefCounted<PowerOfChoicesSubchannelList>(this, std::move(addresses),
+                                                   args.args);
+  latest_pending_subchannel_list_->StartWatchingLocked();
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (TraceEnabled() && subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[%s %p] replacing previous subchannel list %p",
+              Metric::tag(), this, subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        MakeRefCounted<TransientFailurePicker>(status));
+    return status;
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_.
+  if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  }
+  return absl::OkStatus();
+}
+
+//
+// PowerOfChoicesLb::PowerOfChoicesSubchannelList
+//
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::PowerOfChoicesSubchannelList::
+    UpdateStateCountersLocked(absl::optional<grpc_connectivity_state> old_state,
+                              grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::PowerOfChoicesSubchannelList::
+    MaybeUpdateConnectivityStateLocked(absl::Status status_for_tf) {
+  PowerOfChoicesLb* p = static_cast<PowerOfChoicesLb*>(this->policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel and we have seen the
+  //   initial connectivity state notification for all subchannels.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 ||
+       (num_ready_ > 0 && this->AllSubchannelsSeenInitialState()) ||
+       num_transient_failure_ == this->num_subchannels())) {
+    if (TraceEnabled()) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(GPR_INFO,
+              "[%s %p] swapping out subchannel list %p (%s) in favor of %p "
+              "(%s)",
+              Metric::tag(), p, p->subchannel_list_.get(),
+              old_counters_string.c_str(), this, CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO, "[%s %p] reporting READY with subchannel list %p",
+              Metric::tag(), p, this);
+    }
+    p->channel_control_helper()->UpdateState(GRPC_CHANNEL_READY, absl::Status(),
+                                             MakeRefCounted<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO, "[%s %p] reporting CONNECTING with subchannel list %p",
+              Metric::tag(), p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        MakeRefCounted<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == this->num_subchannels()) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO,
+              "[%s %p] reporting TRANSIENT_FAILURE with subchannel list %p: %s",
+              Metric::tag(), p, this, status_for_tf.ToString().c_str());
+    }
+    if (!status_for_tf.ok()) {
+      last_failure_ = absl::UnavailableError(
+          absl::StrCat("connections to all backends failing; last error: ",
+                       status_for_tf.ToString()));
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, last_failure_,
+        MakeRefCounted<TransientFailurePicker>(last_failure_));
+  }
+}
+
+//
+// PowerOfChoicesLb::PowerOfChoicesSubchannelData
+//
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::PowerOfChoicesSubchannelData::
+    ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) {
+  PowerOfChoicesLb* p =
+      static_cast<PowerOfChoicesLb*>(this->subchannel_list()->policy());
+  GPR_ASSERT(this->subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve.
+  // Note that we don't want to do this on the initial state notification,
+  // because that would result in an endless loop of re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO,
+              "[%s %p] Subchannel %p reported %s; requesting re-resolution",
+              Metric::tag(), p, this->subchannel(),
+              ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO,
+              "[%s %p] Subchannel %p reported IDLE; requesting connection",
+              Metric::tag(), p, this->subchannel());
+    }
+    this->subchannel()->RequestConnection();
+  }
+  // Update logical connectivity state.
+  UpdateLogicalConnectivityStateLocked(new_state);
+  // Update the policy state.
+  this->subchannel_list()->MaybeUpdateConnectivityStateLocked(
+      this->connectivity_status());
+}
+
+template <typename Metric, typename PolicyConfig>
+void PowerOfChoicesLb<Metric, PolicyConfig>::PowerOfChoicesSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  PowerOfChoicesLb* p =
+      static_cast<PowerOfChoicesLb*>(this->subchannel_list()->policy());
+  if (TraceEnabled()) {
+    gpr_log(
+        GPR_INFO,
+        "[%s %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        Metric::tag(), p, this->subchannel(), this->subchannel_list(),
+        this->Index(), this->subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (TraceEnabled()) {
+      gpr_log(GPR_INFO,
+              "[%s %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              Metric::tag(), p, this->subchannel(), this->subchannel_list(),
+              this->Index(), this->subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return;
+  }
+  // Otherwise, update counters and logical state.
+  this->subchannel_list()->UpdateStateCountersLocked(
+      logical_connectivity_state_, connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_H
@@ -61,6 +61,7 @@
 
 #include <address_sorting/address_sorting.h>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
 
@@ -85,6 +86,347 @@ namespace grpc_core {
 
 namespace {
 
+// A process-wide cache of DNS results, shared by every c-ares resolver whose
+// channel sets GRPC_ARG_DNS_CACHE_TTL_MS.  Concurrent lookups of the same name
+// share a single set of c-ares queries, and a name that is looked up again in
+// the last quarter of its lifetime is refreshed in the background so that it
+// keeps being served from the cache.
+//
+// The hostname lookups go through ares_gethostbyname(), whose results carry
+// no record TTLs, so entries live for the TTL configured by the channel that
+// started the lookup.
+//
+// A background refresh has no caller waiting on it, so nothing adds a
+// pollset to its pollset_set unless a lookup that misses the cache joins it.
+// With pollers that only watch fds through pollsets (everything but epoll),
+// such a refresh is driven by the c-ares wrapper's backup poll alarm, which
+// checks its fds about once a second.
+class AresDnsCache {
+ public:
+  struct Key {
+    std::string authority;
+    std::string name;
+    bool enable_srv_queries;
+    bool request_service_config;
+
+    bool operator==(const Key& other) const {
+      return authority == other.authority && name == other.name &&
+             enable_srv_queries == other.enable_srv_queries &&
+             request_service_config == other.request_service_config;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.authority, key.name,
+                        key.enable_srv_queries, key.request_service_config);
+    }
+  };
+
+  // The outcome of resolving a name.
+  struct Records {
+    grpc_error_handle error;
+    std::unique_ptr<ServerAddressList> addresses;
+    std::unique_ptr<ServerAddressList> balancer_addresses;
+    absl::optional<std::string> service_config_json;
+  };
+
+  using Callback = std::function<void(std::shared_ptr<const Records>)>;
+
+  static AresDnsCache* Get() {
+    static AresDnsCache* cache = new AresDnsCache();
+    return cache;
+  }
+
+  // Invokes on_done with the records for key: synchronously if a fresh entry
+  // is cached, otherwise once a lookup (possibly one already started by
+  // somebody else) completes.  on_done may still be invoked after the
+  // returned handle is orphaned.
+  OrphanablePtr<Orphanable> Lookup(Key key, Duration ttl, int query_timeout_ms,
+                                   grpc_pollset_set* interested_parties,
+                                   Callback on_done);
+
+  // Cancels any outstanding lookups and drops all entries.
+  void Shutdown();
+
+ private:
+  class Query;
+  class Waiter;
+
+  struct Entry {
+    // The last successful result, if any.
+    std::shared_ptr<const Records> records;
+    Timestamp expiry;
+    Timestamp refresh_at;
+    // The lookup in flight for this name, if any.
+    OrphanablePtr<Query> query;
+    // Callers waiting for query to finish.  Each holds a ref.
+    absl::flat_hash_set<Waiter*> waiters;
+  };
+
+  void OnQueryDone(const Key& key, Query* query,
+                   std::shared_ptr<const Records> records);
+  void RemoveWaiter(const Key& key, Waiter* waiter);
+
+  Mutex mu_;
+  absl::flat_hash_map<Key, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  // Expired entries are dropped at most this often.
+  Timestamp next_sweep_ ABSL_GUARDED_BY(mu_);
+};
+
+// One round of c-ares queries for a name.  Waiters add their pollset_sets to
+// ours so that the query is driven by whoever is interested in it.
+class AresDnsCache::Query : public InternallyRefCounted<Query> {
+ public:
+  Query(AresDnsCache* cache, Key key, Duration ttl, int query_timeout_ms)
+      : cache_(cache),
+        key_(std::move(key)),
+        ttl_(ttl),
+        pollset_set_(grpc_pollset_set_create()) {
+    MutexLock lock(&mu_);
+    Ref(DEBUG_LOCATION, "OnHostnameResolved").release();
+    GRPC_CLOSURE_INIT(&on_hostname_resolved_, OnHostnameResolved, this,
+                      nullptr);
+    hostname_request_.reset(grpc_dns_lookup_hostname_ares(
+        key_.authority.c_str(), key_.name.c_str(), kDefaultSecurePort,
+        pollset_set_, &on_hostname_resolved_, &records_->addresses,
+        query_timeout_ms));
+    if (key_.enable_srv_queries) {
+      Ref(DEBUG_LOCATION, "OnSRVResolved").release();
+      GRPC_CLOSURE_INIT(&on_srv_resolved_, OnSRVResolved, this, nullptr);
+      srv_request_.reset(grpc_dns_lookup_srv_ares(
+          key_.authority.c_str(), key_.name.c_str(), pollset_set_,
+          &on_srv_resolved_, &records_->balancer_addresses,
+          query_timeout_ms));
+    }
+    if (key_.request_service_config) {
+      Ref(DEBUG_LOCATION, "OnTXTResolved").release();
+      GRPC_CLOSURE_INIT(&on_txt_resolved_, OnTXTResolved, this, nullptr);
+      txt_request_.reset(grpc_dns_lookup_txt_ares(
+          key_.authority.c_str(), key_.name.c_str(), pollset_set_,
+          &on_txt_resolved_, &service_config_json_, query_timeout_ms));
+    }
+    GRPC_CARES_TRACE_LOG("dns_cache: query:%p started for %s", this,
+                         key_.name.c_str());
+  }
+
+  ~Query() override {
+    gpr_free(service_config_json_);
+    grpc_pollset_set_destroy(pollset_set_);
+  }
+
+  // Note that thread safety cannot be analyzed due to this being invoked from
+  // OrphanablePtr<>, and there's no way to pass the lock annotation through
+  // there.
+  void Orphan() override ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    {
+      MutexLock lock(&mu_);
+      if (hostname_request_ != nullptr) {
+        grpc_cancel_ares_request(hostname_request_.get());
+      }
+      if (srv_request_ != nullptr) {
+        grpc_cancel_ares_request(srv_request_.get());
+      }
+      if (txt_request_ != nullptr) {
+        grpc_cancel_ares_request(txt_request_.get());
+      }
+    }
+    Unref(DEBUG_LOCATION, "Orphan");
+  }
+
+  grpc_pollset_set* pollset_set() const { return pollset_set_; }
+  Duration ttl() const { return ttl_; }
+
+ private:
+  static void OnHostnameResolved(void* arg, grpc_error_handle error) {
+    auto* self = static_cast<Query*>(arg);
+    self->OnRequestDone(&self->hostname_request_, error);
+    self->Unref(DEBUG_LOCATION, "OnHostnameResolved");
+  }
+  static void OnSRVResolved(void* arg, grpc_error_handle error) {
+    auto* self = static_cast<Query*>(arg);
+    self->OnRequestDone(&self->srv_request_, error);
+    self->Unref(DEBUG_LOCATION, "OnSRVResolved");
+  }
+  static void OnTXTResolved(void* arg, grpc_error_handle error) {
+    auto* self = static_cast<Query*>(arg);
+    self->OnRequestDone(&self->txt_request_, error);
+    self->Unref(DEBUG_LOCATION, "OnTXTResolved");
+  }
+
+  void OnRequestDone(std::unique_ptr<grpc_ares_request>* request,
+                     grpc_error_handle error) {
+    std::shared_ptr<Records> records;
+    {
+      MutexLock lock(&mu_);
+      request->reset();
+      // As with the resolver itself, the last error seen is the one
+      // reported.
+      records_->error = error;
+      if (hostname_request_ != nullptr || srv_request_ != nullptr ||
+          txt_request_ != nullptr) {
+        return;
+      }
+      if (service_config_json_ != nullptr) {
+        records_->service_config_json = service_config_json_;
+      }
+      records = std::move(records_);
+    }
+    cache_->OnQueryDone(key_, this, std::move(records));
+  }
+
+  AresDnsCache* const cache_;
+  const Key key_;
+  const Duration ttl_;
+  grpc_pollset_set* const pollset_set_;
+  Mutex mu_;
+  grpc_closure on_hostname_resolved_;
+  std::unique_ptr<grpc_ares_request> hostname_request_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_srv_resolved_;
+  std::unique_ptr<grpc_ares_request> srv_request_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_txt_resolved_;
+  std::unique_ptr<grpc_ares_request> txt_request_ ABSL_GUARDED_BY(mu_);
+  // Output fields from ares requests.
+  std::shared_ptr<Records> records_ ABSL_GUARDED_BY(mu_) =
+      std::make_shared<Records>();
+  char* service_config_json_ ABSL_GUARDED_BY(mu_) = nullptr;
+};
+
+// A caller's interest in a name.  Orphaning it stops on_done from being
+// called if the lookup has not completed yet.
+class AresDnsCache::Waiter : public InternallyRefCounted<Waiter> {
+ public:
+  Waiter(AresDnsCache* cache, Key key, grpc_pollset_set* interested_parties,
+         Callback on_done)
+      : cache_(cache),
+        key_(std::move(key)),
+        interested_parties_(interested_parties),
+        on_done_(std::move(on_done)) {}
+
+  void Orphan() override {
+    cache_->RemoveWaiter(key_, this);
+    Unref();
+  }
+
+  void Deliver(std::shared_ptr<const Records> records) {
+    on_done_(std::move(records));
+  }
+
+  grpc_pollset_set* interested_parties() const { return interested_parties_; }
+
+ private:
+  // For the refs held by Entry::waiters.
+  friend class AresDnsCache;
+
+  AresDnsCache* const cache_;
+  const Key key_;
+  grpc_pollset_set* const interested_parties_;
+  Callback on_done_;
+};
+
+OrphanablePtr<Orphanable> AresDnsCache::Lookup(
+    Key key, Duration ttl, int query_timeout_ms,
+    grpc_pollset_set* interested_parties, Callback on_done) {
+  auto waiter = MakeOrphanable<Waiter>(this, key, interested_parties,
+                                       std::move(on_done));
+  std::shared_ptr<const Records> cached;
+  {
+    MutexLock lock(&mu_);
+    const Timestamp now = Timestamp::Now();
+    Entry& entry = entries_[key];
+    if (entry.records != nullptr && now < entry.expiry) {
+      cached = entry.records;
+      // The caller already has its result, so the refresh is not added to
+      // its interested_parties; see the class comment.
+      if (now >= entry.refresh_at && entry.query == nullptr) {
+        GRPC_CARES_TRACE_LOG("dns_cache: refreshing %s in the background",
+                             key.name.c_str());
+        entry.query = MakeOrphanable<Query>(this, key, ttl, query_timeout_ms);
+      }
+    } else {
+      if (entry.query == nullptr) {
+        entry.query = MakeOrphanable<Query>(this, key, ttl, query_timeout_ms);
+      }
+      grpc_pollset_set_add_pollset_set(entry.query->pollset_set(),
+                                       interested_parties);
+      entry.waiters.insert(waiter->Ref().release());
+    }
+  }
+  if (cached != nullptr) {
+    GRPC_CARES_TRACE_LOG("dns_cache: hit for %s", key.name.c_str());
+    waiter->Deliver(std::move(cached));
+  }
+  return waiter;
+}
+
+void AresDnsCache::RemoveWaiter(const Key& key, Waiter* waiter) {
+  {
+    MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.waiters.erase(waiter) == 0) return;
+    grpc_pollset_set_del_pollset_set(it->second.query->pollset_set(),
+                                     waiter->interested_parties());
+  }
+  waiter->Unref();
+}
+
+void AresDnsCache::OnQueryDone(const Key& key, Query* query,
+                               std::shared_ptr<const Records> records) {
+  absl::flat_hash_set<Waiter*> waiters;
+  OrphanablePtr<Query> finished_query;
+  {
+    MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.query.get() != query) return;
+    Entry& entry = it->second;
+    const Timestamp now = Timestamp::Now();
+    // Only successful lookups are cached; a failed refresh leaves the
+    // previous result in place until it expires.
+    if (records->addresses != nullptr ||
+        records->balancer_addresses != nullptr) {
+      entry.records = records;
+      entry.expiry = now + query->ttl();
+      entry.refresh_at = now + query->ttl() * 0.75;
+    }
+    waiters = std::move(entry.waiters);
+    entry.waiters.clear();
+    for (Waiter* waiter : waiters) {
+      grpc_pollset_set_del_pollset_set(query->pollset_set(),
+                                       waiter->interested_parties());
+    }
+    finished_query = std::move(entry.query);
+    if (now >= next_sweep_) {
+      next_sweep_ = now + Duration::Minutes(1);
+      absl::erase_if(entries_, [now](const auto& key_and_entry) {
+        const Entry& entry = key_and_entry.second;
+        return entry.query == nullptr && now >= entry.expiry;
+      });
+    }
+  }
+  for (Waiter* waiter : waiters) {
+    waiter->Deliver(records);
+    waiter->Unref();
+  }
+}
+
+void AresDnsCache::Shutdown() {
+  absl::flat_hash_map<Key, Entry> entries;
+  {
+    MutexLock lock(&mu_);
+    entries = std::move(entries_);
+    entries_.clear();
+  }
+  // Orphaning the queries cancels them; their callbacks find no entry.
+  for (auto& key_and_entry : entries) {
+    Entry& entry = key_and_entry.second;
+    if (entry.query == nullptr) continue;
+    for (Waiter* waiter : entry.waiters) {
+      grpc_pollset_set_del_pollset_set(entry.query->pollset_set(),
+                                       waiter->interested_parties());
+      waiter->Unref();
+    }
+  }
+}
+
 class AresClientChannelDNSResolver : public PollingResolver {
  public:
   AresClientChannelDNSResolver(ResolverArgs args,
@@ -189,12 +531,20 @@ class AresClientChannelDNSResolver : public PollingResolver {
 
   ~AresClientChannelDNSResolver() override;
 
+  // Builds the result to report from the outputs of the ares requests.
+  Result MakeResult(grpc_error_handle error,
+                    std::unique_ptr<ServerAddressList> addresses,
+                    std::unique_ptr<ServerAddressList> balancer_addresses,
+                    const char* service_config_json);
+
   /// whether to request the service config
   const bool request_service_config_;
   // whether or not to enable SRV DNS queries
   const bool enable_srv_queries_;
   // timeout in milliseconds for active DNS queries
   const int query_timeout_ms_;
+  // how long results are kept in AresDnsCache; zero to bypass it
+  const Duration dns_cache_ttl_;
 };
 
 AresClientChannelDNSResolver::AresClientChannelDNSResolver(
@@ -218,7 +568,12 @@ AresClientChannelDNSResolver::AresClientChannelDNSResolver(
       query_timeout_ms_(
           std::max(0, channel_args()
                           .GetInt(GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS)
-                          .value_or(GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS))) {}
+                          .value_or(GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS))),
+      dns_cache_ttl_(std::max(
+          Duration::Zero(),
+          channel_args()
+              .GetDurationFromIntMillis(GRPC_ARG_DNS_CACHE_TTL_MS)
+              .value_or(Duration::Zero()))) {}
 
 AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
   GRPC_CARES_TRACE_LOG("resolver:%p destroying AresClientChannelDNSResolver",
@@ -226,6 +581,28 @@ AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
+  if (dns_cache_ttl_ > Duration::Zero()) {
+    RefCountedPtr<AresClientChannelDNSResolver> self =
+        Ref(DEBUG_LOCATION, "dns-cache");
+    return AresDnsCache::Get()->Lookup(
+        {authority(), name_to_resolve(), enable_srv_queries_,
+         request_service_config_},
+        dns_cache_ttl_, query_timeout_ms_, interested_parties(),
+        [self = std::move(self)](
+            std::shared_ptr<const AresDnsCache::Records> records) {
+          auto copy = [](const std::unique_ptr<ServerAddressList>& list) {
+            return list == nullptr
+                       ? nullptr
+                       : std::make_unique<ServerAddressList>(*list);
+          };
+          self->OnRequestComplete(self->MakeResult(
+              records->error, copy(records->addresses),
+              copy(records->balancer_addresses),
+              records->service_config_json.has_value()
+                  ? records->service_config_json->c_str()
+                  : nullptr));
+        });
+  }
   return MakeOrphanable<AresRequestWrapper>(
       Ref(DEBUG_LOCATION, "dns-resolving"));
 }
@@ -293,18 +670,27 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
     return absl::nullopt;
   }
   GRPC_CARES_TRACE_LOG("resolver:%p OnResolved() proceeding", this);
+  return resolver_->MakeResult(error, std::move(addresses_),
+                               std::move(balancer_addresses_),
+                               service_config_json_);
+}
+
+AresClientChannelDNSResolver::Result AresClientChannelDNSResolver::MakeResult(
+    grpc_error_handle error, std::unique_ptr<ServerAddressList> addresses,
+    std::unique_ptr<ServerAddressList> balancer_addresses,
+    const char* service_config_json) {
   Result result;
-  result.args = resolver_->channel_args();
+  result.args = channel_args();
   // TODO(roth): Change logic to be able to report failures for addresses
   // and service config independently of each other.
-  if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
-    if (addresses_ != nullptr) {
-      result.addresses = std::move(*addresses_);
+  if (addresses != nullptr || balancer_addresses != nullptr) {
+    if (addresses != nullptr) {
+      result.addresses = std::move(*addresses);
     } else {
       result.addresses = ServerAddressList();
     }
-    if (service_config_json_ != nullptr) {
-      auto service_config_string = ChooseServiceConfig(service_config_json_);
+    if (service_config_json != nullptr) {
+      auto service_config_string = ChooseServiceConfig(service_config_json);
       if (!service_config_string.ok()) {
         result.service_config = absl::UnavailableError(
             absl::StrCat("failed to parse service config: ",
@@ -312,8 +698,8 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
       } else if (!service_config_string->empty()) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
                              this, service_config_string->c_str());
-        result.service_config = ServiceConfigImpl::Create(
-            resolver_->channel_args(), *service_config_string);
+        result.service_config =
+            ServiceConfigImpl::Create(channel_args(), *service_config_string);
         if (!result.service_config.ok()) {
           result.service_config = absl::UnavailableError(
               absl::StrCat("failed to parse service config: ",
@@ -321,9 +707,9 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
         }
       }
     }
-    if (balancer_addresses_ != nullptr) {
+    if (balancer_addresses != nullptr) {
       result.args = SetGrpcLbBalancerAddresses(
-          result.args, ServerAddressList(*balancer_addresses_));
+          result.args, ServerAddressList(*balancer_addresses));
     }
   } else {
     GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
@@ -331,13 +717,13 @@ AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
     std::string error_message;
     grpc_error_get_str(error, StatusStrProperty::kDescription, &error_message);
     absl::Status status = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", resolver_->name_to_resolve(),
-                     ": ", error_message));
+        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
+                     error_message));
     result.addresses = status;
     result.service_config = status;
   }
 
-  return std::move(result);
+  return result;
 }
 
 //
@@ -740,6 +1126,7 @@ void grpc_resolver_dns_ares_init() {
 void grpc_resolver_dns_ares_shutdown() {
   if (grpc_core::ShouldUseAresDnsResolver(
           grpc_core::ConfigVars::Get().DnsResolver())) {
+    grpc_core::AresDnsCache::Get()->Shutdown();
     address_sorting_shutdown();
     grpc_ares_cleanup();
   }
@@ -16,6 +16,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -58,6 +59,7 @@
 
 #include "src/core/ext/filters/client_channel/client_channel_internal.h"
 #include "src/core/ext/filters/client_channel/config_selector.h"
+#include "src/core/ext/filters/client_channel/dynamic_filters.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
 #include "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.h"
 #include "src/core/ext/xds/xds_bootstrap.h"
@@ -93,6 +95,7 @@
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/service_config/service_config.h"
 #include "src/core/lib/service_config/service_config_impl.h"
+#include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
 #include "src/core/lib/uri/uri_parser.h"
@@ -315,6 +318,9 @@ class XdsResolver : public Resolver {
     RouteEntry* GetRouteForRequest(absl::string_view path,
                                    grpc_metadata_batch* initial_metadata);
 
+    // Returns every method config that a route may give calls.
+    std::vector<RefCountedPtr<ServiceConfig>> GetMethodConfigs() const;
+
    private:
     class RouteListIterator;
 
@@ -359,10 +365,20 @@ class XdsResolver : public Resolver {
       return filters_;
     }
 
+    DynamicFilters::NoopFilters GetNoopFilters() override;
+
    private:
+    struct FilterNoopCheck {
+      XdsHttpFilterImpl::NoopCheck check;
+      // Instance number of the filter in the stack.
+      size_t instance;
+    };
+
     RefCountedPtr<XdsResolver> resolver_;
     RefCountedPtr<RouteConfigData> route_config_data_;
     std::vector<const grpc_channel_filter*> filters_;
+    // One for each of filters_.
+    std::vector<FilterNoopCheck> filter_noop_checks_;
   };
 
   class XdsRouteStateAttributeImpl : public XdsRouteStateAttribute {
@@ -500,6 +516,22 @@ XdsResolver::RouteConfigData::Create(
   return data;
 }
 
+std::vector<RefCountedPtr<ServiceConfig>>
+XdsResolver::RouteConfigData::GetMethodConfigs() const {
+  std::vector<RefCountedPtr<ServiceConfig>> method_configs;
+  for (const RouteEntry& entry : routes_) {
+    if (entry.method_config != nullptr) {
+      method_configs.push_back(entry.method_config);
+    }
+    for (const auto& cluster_weight_state : entry.weighted_cluster_state) {
+      if (cluster_weight_state.method_config != nullptr) {
+        method_configs.push_back(cluster_weight_state.method_config);
+      }
+    }
+  }
+  return method_configs;
+}
+
 XdsResolver::RouteConfigData::RouteEntry*
 XdsResolver::RouteConfigData::GetRouteForRequest(
     absl::string_view path, grpc_metadata_batch* initial_metadata) {
@@ -699,11 +731,47 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
             http_filter.config.config_proto_type_name);
     GPR_ASSERT(filter_impl != nullptr);
     // Add C-core filter to list.
-    if (filter_impl->channel_filter() != nullptr) {
-      filters_.push_back(filter_impl->channel_filter());
+    const grpc_channel_filter* filter = filter_impl->channel_filter();
+    if (filter != nullptr) {
+      filter_noop_checks_.push_back(
+          {filter_impl->channel_filter_noop_check(),
+           static_cast<size_t>(
+               std::count(filters_.begin(), filters_.end(), filter))});
+      filters_.push_back(filter);
     }
   }
   filters_.push_back(&ClusterSelectionFilter::kFilter);
+  filter_noop_checks_.push_back({nullptr, 0});
+}
+
+DynamicFilters::NoopFilters XdsResolver::XdsConfigSelector::GetNoopFilters() {
+  DynamicFilters::NoopFilters noop_filters;
+  if (std::none_of(filter_noop_checks_.begin(), filter_noop_checks_.end(),
+                   [](const FilterNoopCheck& filter_noop_check) {
+                     return filter_noop_check.check != nullptr;
+                   })) {
+    return noop_filters;
+  }
+  noop_filters.is_noop =
+      [filter_noop_checks = filter_noop_checks_](
+          size_t index,
+          const ServiceConfigParser::ParsedConfigVector* method_configs) {
+        if (index >= filter_noop_checks.size()) return false;
+        const FilterNoopCheck& filter_noop_check = filter_noop_checks[index];
+        return filter_noop_check.check != nullptr &&
+               filter_noop_check.check(method_configs,
+                                       filter_noop_check.instance);
+      };
+  // GetCallConfig() gives calls the default method config of their route's
+  // service config.
+  for (RefCountedPtr<ServiceConfig>& method_config :
+       route_config_data_->GetMethodConfigs()) {
+    auto* method_configs =
+        method_config->GetMethodParsedConfigVector(grpc_empty_slice());
+    noop_filters.method_configs.push_back(
+        {std::move(method_config), method_configs});
+  }
+  return noop_filters;
 }
 
 XdsResolver::XdsConfigSelector::~XdsConfigSelector() {
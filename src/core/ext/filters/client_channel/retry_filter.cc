@@ -116,9 +116,16 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
+//
+// When the method has a hedging policy instead of a retry policy, we
+// start a new call attempt every hedgingDelay without waiting for the
+// previous one to fail, up to maxAttempts.  All in-flight attempts are
+// kept in CallData::hedged_attempts_, and every batch from the surface is
+// started on each of them.  The first attempt to commit (by receiving
+// data from the server or failing with a fatal status) wins, and all of
+// the others are cancelled.  Since filters below us may take ownership
+// of a send_message payload while the op is in flight, each hedged
+// attempt sends its own copy of the cached message.
 
 // By default, we buffer 256 KiB per RPC for retries.
 // TODO(roth): Do we have any data to suggest a better value?
@@ -254,10 +261,17 @@ class RetryFilter::CallData {
 
     bool lb_call_committed() const { return lb_call_committed_; }
 
+    size_t started_send_message_count() const {
+      return started_send_message_count_;
+    }
+
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -265,6 +279,10 @@ class RetryFilter::CallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Cancels a hedged attempt that was not committed and abandons it.
+    // Adds the cancellation batch to closures.
+    void CancelHedgedAttempt(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -398,9 +416,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -417,6 +432,12 @@ class RetryFilter::CallData {
     bool ShouldRetry(absl::optional<grpc_status_code> status,
                      absl::optional<Duration> server_pushback_ms);
 
+    // Returns true if this hedged attempt should be dropped in favor of
+    // the other in-flight attempts or a new one.  Returns false if the
+    // call should be committed to this attempt.
+    bool ShouldContinueHedging(grpc_status_code status,
+                               absl::optional<Duration> server_pushback);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -425,6 +446,8 @@ class RetryFilter::CallData {
     void MaybeCancelPerAttemptRecvTimer();
 
     CallData* calld_;
+    // Value of the grpc-previous-rpc-attempts header sent on this attempt.
+    const int num_previous_attempts_;
     OrphanablePtr<ClientChannel::FilterBasedLoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
 
@@ -435,6 +458,8 @@ class RetryFilter::CallData {
     grpc_transport_stream_op_batch_payload batch_payload_;
     // For send_initial_metadata.
     grpc_metadata_batch send_initial_metadata_{calld_->arena_};
+    // For send_message when hedging.
+    SliceBuffer send_message_;
     // For send_trailing_metadata.
     grpc_metadata_batch send_trailing_metadata_{calld_->arena_};
     // For intercepting recv_initial_metadata.
@@ -494,6 +519,12 @@ class RetryFilter::CallData {
 
   void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
 
+  // Returns true if the method has a hedging policy.
+  bool hedging() const {
+    return retry_policy_ != nullptr &&
+           retry_policy_->hedging_policy().has_value();
+  }
+
   // Returns the index into pending_batches_ to be used for batch.
   static size_t GetBatchIndex(grpc_transport_stream_op_batch* batch);
   PendingBatch* PendingBatchesAdd(grpc_transport_stream_op_batch* batch);
@@ -537,6 +568,26 @@ class RetryFilter::CallData {
 
   void CreateCallAttempt(bool is_transparent_retry);
 
+  // Creates a hedged attempt and adds its batches to closures.
+  void AddHedgedAttempt(bool is_transparent_retry,
+                        CallCombinerClosureList* closures);
+  // Starts as many hedged attempts as the hedging delay allows right now,
+  // then arms the hedging timer for the next one.
+  void AddHedgedAttempts(CallCombinerClosureList* closures);
+  // Returns true if another hedged attempt may be started.
+  bool CanStartHedgedAttempt();
+  // Removes a failed attempt from hedged_attempts_.
+  void RemoveHedgedAttempt(CallAttempt* call_attempt);
+  // Starts the next hedged attempt after a non-fatal failure, either now
+  // or after server_pushback.
+  void StartNextHedgedAttempt(absl::optional<Duration> server_pushback,
+                              CallCombinerClosureList* closures);
+
+  void MaybeStartHedgingTimer(Duration delay);
+  void MaybeCancelHedgingTimer();
+  void OnHedgingTimer();
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle /*error*/);
+
   RetryFilter* chand_;
   grpc_polling_entity* pollent_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
@@ -554,11 +605,13 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
+  // The current call attempt.  When hedging, this is not set until we
+  // commit to one of the attempts in hedged_attempts_.
   RefCountedPtr<CallAttempt> call_attempt_;
 
+  // In-flight hedged attempts that have not yet been committed.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 3> hedged_attempts_;
+
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
   // path for long-running streaming calls that minimizes overhead.
@@ -583,6 +636,13 @@ class RetryFilter::CallData {
   absl::optional<EventEngine::TaskHandle> retry_timer_handle_;
   grpc_closure retry_closure_;
 
+  // Hedging state.
+  // Set when the server tells us not to send any more hedged attempts.
+  bool hedging_stopped_ = false;
+  int num_hedged_attempts_started_ = 0;
+  absl::optional<EventEngine::TaskHandle> hedging_timer_handle_;
+  grpc_closure hedging_closure_;
+
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
@@ -666,6 +726,9 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
     : RefCounted(GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "CallAttempt"
                                                            : nullptr),
       calld_(calld),
+      num_previous_attempts_(calld->hedging()
+                                 ? calld->num_hedged_attempts_started_
+                                 : calld->num_attempts_completed_),
       batch_payload_(calld->call_context_),
       started_send_initial_metadata_(false),
       completed_send_initial_metadata_(false),
@@ -681,7 +744,8 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
   lb_call_ = calld->CreateLoadBalancedCall(
       [this]() {
         lb_call_committed_ = true;
-        if (calld_->retry_committed_) {
+        // A hedged attempt that lost the race must not commit the call.
+        if (calld_->retry_committed_ && !abandoned_) {
           auto* service_config_call_data =
               static_cast<ClientChannelServiceConfigCallData*>(
                   calld_->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
@@ -726,10 +790,8 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Abandoned hedged attempts may still have ops in flight, but they send
+  // their own copies of the cached data, so it is safe to free it here.
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -770,13 +832,11 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
+  // If we committed to a different hedged attempt, this one is done.
+  if (calld_->call_attempt_.get() != this) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
   if (per_attempt_recv_timer_handle_.has_value()) return;
   // If there are still send ops to replay, we can't switch yet.
@@ -1097,6 +1157,22 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling uncommitted hedged "
+            "attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(GRPC_ERROR_CREATE("hedged call attempt not committed"),
+                         StatusIntProperty::kRpcStatus, GRPC_STATUS_CANCELLED),
+      closures);
+  Abandon();
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
@@ -1185,6 +1261,58 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldContinueHedging(
+    grpc_status_code status, absl::optional<Duration> server_pushback) {
+  if (GPR_LIKELY(status == GRPC_STATUS_OK)) {
+    if (calld_->retry_throttle_data_ != nullptr) {
+      calld_->retry_throttle_data_->RecordSuccess();
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: call succeeded",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  // Any status not listed as non-fatal commits the call.
+  if (!calld_->retry_policy_->hedging_policy()
+           ->non_fatal_status_codes.Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: status %s not configured as "
+              "non-fatal for hedging",
+              calld_->chand_, calld_, this,
+              grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // Record the failure.  Unlike retries, throttling does not stop the
+  // attempts that are already in flight; it only prevents new ones from
+  // being started (see CanStartHedgedAttempt()).
+  if (calld_->retry_throttle_data_ != nullptr) {
+    calld_->retry_throttle_data_->RecordFailure();
+  }
+  if (calld_->retry_committed_) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: retries already committed",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: not sending further hedged "
+              "attempts due to server push-back",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  // Keep going as long as some other attempt can still succeed.
+  return calld_->hedged_attempts_.size() > 1 ||
+         calld_->CanStartHedgedAttempt();
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
@@ -1320,10 +1448,8 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Abandoned hedged attempts send their own copies of the cached data,
+  // so nothing else can be using it at this point.
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1728,9 +1854,12 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
         retry = kTransparentRetry;
       }
     }
-    // If not transparently retrying, check for configurable retry.
+    // If not transparently retrying, check for configurable retry or,
+    // when hedging, whether to give up on this attempt.
     if (retry == kNoRetry &&
-        call_attempt->ShouldRetry(status, server_pushback)) {
+        (calld->hedging()
+             ? call_attempt->ShouldContinueHedging(status, server_pushback)
+             : call_attempt->ShouldRetry(status, server_pushback))) {
       retry = kConfigurableRetry;
     }
     // If we're retrying, do so.
@@ -1743,10 +1872,20 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
                            StatusIntProperty::kRpcStatus, GRPC_STATUS_CANCELLED)
                      : error,
           &closures);
+      // When hedging, drop this attempt and replace it if allowed.  A
+      // transparent retry replaces it immediately without counting
+      // against maxAttempts.
       // For transparent retries, add a closure to immediately start a new
       // call attempt.
       // For configurable retries, start retry timer.
-      if (retry == kTransparentRetry) {
+      if (calld->hedging()) {
+        calld->RemoveHedgedAttempt(call_attempt);
+        if (retry == kTransparentRetry) {
+          calld->AddHedgedAttempt(/*is_transparent_retry=*/true, &closures);
+        } else {
+          calld->StartNextHedgedAttempt(server_pushback, &closures);
+        }
+      } else if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
       } else {
         calld->StartRetryTimer(server_pushback);
@@ -1789,6 +1928,15 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   if (pending == nullptr) {
     return;
   }
+  // When hedging, a faster attempt may already have completed this
+  // send_message op and the surface may have started the next one.  Only
+  // complete the pending batch once this attempt has sent its message.
+  if (calld->hedging() && batch_.send_message &&
+      (!pending->send_ops_cached ||
+       call_attempt_->completed_send_message_count_ !=
+           calld->send_messages_.size())) {
+    return;
+  }
   // Propagate payload.
   if (batch_.send_message) {
     pending->batch->payload->send_message.stream_write_closed =
@@ -1939,9 +2087,10 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   // If we've already completed one or more attempts, add the
   // grpc-retry-attempts header.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
-    call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+  if (GPR_UNLIKELY(call_attempt_->num_previous_attempts_ > 0)) {
+    call_attempt_->send_initial_metadata_.Set(
+        GrpcPreviousRpcAttemptsMetadata(),
+        call_attempt_->num_previous_attempts_);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -1967,7 +2116,14 @@ void RetryFilter::CallData::CallAttempt::BatchData::
       calld->send_messages_[call_attempt_->started_send_message_count_];
   ++call_attempt_->started_send_message_count_;
   batch_.send_message = true;
-  batch_.payload->send_message.send_message = cache.slices;
+  if (calld->hedging()) {
+    // Other hedged attempts may be sending the same message concurrently,
+    // so give each attempt its own copy of the slices.
+    call_attempt_->send_message_ = cache.slices->Copy();
+    batch_.payload->send_message.send_message = &call_attempt_->send_message_;
+  } else {
+    batch_.payload->send_message.send_message = cache.slices;
+  }
   batch_.payload->send_message.flags = cache.flags;
 }
 
@@ -2167,17 +2323,16 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     }
     // Fail any pending batches.
     PendingBatchesFail(cancelled_from_surface_);
+    // If hedged attempts are in flight, commit to one of them.  This
+    // cancels all of the others and makes it the current call attempt.
+    if (!hedged_attempts_.empty()) {
+      RetryCommit(hedged_attempts_.front().get());
+    }
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
     if (call_attempt_ != nullptr) {
       RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
       // Note: This will release the call combiner.
       call_attempt_->CancelFromSurface(batch);
       return;
@@ -2194,6 +2349,11 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
       retry_timer_handle_.reset();
       FreeAllCachedSendOpData();
     }
+    // Cancel hedging timer if needed.
+    if (hedging_timer_handle_.has_value()) {
+      MaybeCancelHedgingTimer();
+      FreeAllCachedSendOpData();
+    }
     // We have no call attempt, so there's nowhere to send the cancellation
     // batch.  Return it back to the surface immediately.
     // Note: This will release the call combiner.
@@ -2210,6 +2370,28 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
                             "added pending batch while retry timer pending");
     return;
   }
+  // If we have hedged attempts in flight, start the batch on all of them.
+  if (!hedged_attempts_.empty()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: starting batch on %" PRIuPTR
+              " hedged attempts",
+              chand_, this, hedged_attempts_.size());
+    }
+    CallCombinerClosureList closures;
+    for (auto& hedged_attempt : hedged_attempts_) {
+      hedged_attempt->AddRetriableBatches(&closures);
+    }
+    closures.RunClosures(call_combiner_);
+    return;
+  }
+  // Similarly, if all hedged attempts have failed and we are waiting for
+  // the hedging timer to start the next one, wait for it to run.
+  if (call_attempt_ == nullptr && hedging_timer_handle_.has_value()) {
+    GRPC_CALL_COMBINER_STOP(call_combiner_,
+                            "added pending batch while hedging timer pending");
+    return;
+  }
   // If we do not yet have a call attempt, create one.
   if (call_attempt_ == nullptr) {
     // If this is the first batch and retries are already committed
@@ -2254,6 +2436,12 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
               this);
     }
     retry_codepath_started_ = true;
+    if (hedging() && !retry_committed_) {
+      CallCombinerClosureList closures;
+      AddHedgedAttempts(&closures);
+      closures.RunClosures(call_combiner_);
+      return;
+    }
     CreateCallAttempt(/*is_transparent_retry=*/false);
     return;
   }
@@ -2284,6 +2472,116 @@ void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
   call_attempt_->StartRetriableBatches();
 }
 
+//
+// hedging
+//
+
+void RetryFilter::CallData::AddHedgedAttempt(
+    bool is_transparent_retry, CallCombinerClosureList* closures) {
+  auto call_attempt = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: starting hedged attempt=%p", chand_,
+            this, call_attempt.get());
+  }
+  if (!is_transparent_retry) ++num_hedged_attempts_started_;
+  call_attempt->AddRetriableBatches(closures);
+  hedged_attempts_.push_back(std::move(call_attempt));
+}
+
+void RetryFilter::CallData::AddHedgedAttempts(
+    CallCombinerClosureList* closures) {
+  const Duration hedging_delay = retry_policy_->hedging_policy()->hedging_delay;
+  while (CanStartHedgedAttempt()) {
+    AddHedgedAttempt(/*is_transparent_retry=*/false, closures);
+    // With a zero delay, all attempts are started at once.
+    if (hedging_delay != Duration::Zero()) break;
+  }
+  MaybeStartHedgingTimer(hedging_delay);
+}
+
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  if (retry_committed_ || !cancelled_from_surface_.ok() || hedging_stopped_) {
+    return false;
+  }
+  if (num_hedged_attempts_started_ >= retry_policy_->max_attempts()) {
+    return false;
+  }
+  // Throttling never prevents the original attempt from being sent.
+  return num_hedged_attempts_started_ == 0 ||
+         retry_throttle_data_ == nullptr ||
+         !retry_throttle_data_->IsThrottled();
+}
+
+void RetryFilter::CallData::RemoveHedgedAttempt(CallAttempt* call_attempt) {
+  for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end(); ++it) {
+    if (it->get() == call_attempt) {
+      hedged_attempts_.erase(it);
+      return;
+    }
+  }
+}
+
+void RetryFilter::CallData::StartNextHedgedAttempt(
+    absl::optional<Duration> server_pushback,
+    CallCombinerClosureList* closures) {
+  if (!CanStartHedgedAttempt()) return;
+  // A non-fatal failure starts the next attempt immediately, unless the
+  // server asked us to wait, in which case the pushback replaces whatever
+  // is left of the hedging delay.
+  MaybeCancelHedgingTimer();
+  if (server_pushback.has_value()) {
+    MaybeStartHedgingTimer(*server_pushback);
+  } else {
+    AddHedgedAttempts(closures);
+  }
+}
+
+void RetryFilter::CallData::MaybeStartHedgingTimer(Duration delay) {
+  if (hedging_timer_handle_.has_value() || !CanStartHedgedAttempt()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: next hedged attempt in %" PRId64 " ms", chand_,
+            this, delay.millis());
+  }
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  hedging_timer_handle_ = chand_->event_engine_->RunAfter(delay, [this] {
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    OnHedgingTimer();
+  });
+}
+
+void RetryFilter::CallData::MaybeCancelHedgingTimer() {
+  if (hedging_timer_handle_.has_value()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling hedging timer", chand_,
+              this);
+    }
+    if (chand_->event_engine_->Cancel(*hedging_timer_handle_)) {
+      GRPC_CALL_STACK_UNREF(owning_call_, "OnHedgingTimer");
+    }
+    hedging_timer_handle_.reset();
+  }
+}
+
+void RetryFilter::CallData::OnHedgingTimer() {
+  GRPC_CLOSURE_INIT(&hedging_closure_, OnHedgingTimerLocked, this, nullptr);
+  GRPC_CALL_COMBINER_START(call_combiner_, &hedging_closure_, absl::OkStatus(),
+                           "hedging timer fired");
+}
+
+void RetryFilter::CallData::OnHedgingTimerLocked(void* arg,
+                                                 grpc_error_handle /*error*/) {
+  auto* calld = static_cast<CallData*>(arg);
+  calld->hedging_timer_handle_.reset();
+  // Note: If no attempt can be started, the closure list is empty and
+  // running it just yields the call combiner.
+  CallCombinerClosureList closures;
+  calld->AddHedgedAttempts(&closures);
+  closures.RunClosures(calld->call_combiner_);
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
 //
 // send op data caching
 //
@@ -2398,9 +2696,6 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size_)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2408,7 +2703,17 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    // If hedged attempts are in flight, commit to the one on which the
+    // most send ops have already been sent.
+    CallAttempt* call_attempt = call_attempt_.get();
+    for (auto& hedged_attempt : hedged_attempts_) {
+      if (call_attempt == nullptr ||
+          hedged_attempt->started_send_message_count() >
+              call_attempt->started_send_message_count()) {
+        call_attempt = hedged_attempt.get();
+      }
+    }
+    RetryCommit(call_attempt);
   }
   return pending;
 }
@@ -2515,6 +2820,21 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
+  // When hedging, the committed attempt becomes the current call attempt
+  // and all of the other in-flight attempts are cancelled.
+  MaybeCancelHedgingTimer();
+  if (!hedged_attempts_.empty()) {
+    CallCombinerClosureList closures;
+    for (auto& hedged_attempt : hedged_attempts_) {
+      if (hedged_attempt.get() == call_attempt) {
+        call_attempt_ = std::move(hedged_attempt);
+      } else {
+        hedged_attempt->CancelHedgedAttempt(&closures);
+      }
+    }
+    hedged_attempts_.clear();
+    closures.RunClosuresWithoutYielding(call_combiner_);
+  }
   if (call_attempt != nullptr) {
     // If the call attempt's LB call has been committed, invoke the
     // call's on_commit callback.
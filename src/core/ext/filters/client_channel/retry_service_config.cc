@@ -25,6 +25,7 @@
 
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
@@ -43,6 +44,46 @@
 namespace grpc_core {
 namespace internal {
 
+namespace {
+
+// Validates the maxAttempts field of a retry or hedging policy, clamping it
+// to MAX_MAX_RETRY_ATTEMPTS.
+void ValidateMaxAttempts(const char* policy_name, int* max_attempts,
+                         ValidationErrors* errors) {
+  ValidationErrors::ScopedField field(errors, ".maxAttempts");
+  if (errors->FieldHasErrors()) return;
+  if (*max_attempts <= 1) {
+    errors->AddError("must be at least 2");
+  } else if (*max_attempts > MAX_MAX_RETRY_ATTEMPTS) {
+    gpr_log(GPR_ERROR, "service config: clamped %s.maxAttempts at %d",
+            policy_name, MAX_MAX_RETRY_ATTEMPTS);
+    *max_attempts = MAX_MAX_RETRY_ATTEMPTS;
+  }
+}
+
+// Parses the optional list of status code names in field_name into
+// status_codes.
+void ParseStatusCodes(const Json& json, const JsonArgs& args,
+                      absl::string_view field_name,
+                      StatusCodeSet* status_codes, ValidationErrors* errors) {
+  auto status_code_list = LoadJsonObjectField<std::vector<std::string>>(
+      json.object(), args, field_name, errors, /*required=*/false);
+  if (!status_code_list.has_value()) return;
+  for (size_t i = 0; i < status_code_list->size(); ++i) {
+    ValidationErrors::ScopedField field(
+        errors, absl::StrCat(".", field_name, "[", i, "]"));
+    grpc_status_code status;
+    if (!grpc_status_code_from_string((*status_code_list)[i].c_str(),
+                                      &status)) {
+      errors->AddError("failed to parse status code");
+    } else {
+      status_codes->Add(status);
+    }
+  }
+}
+
+}  // namespace
+
 //
 // RetryGlobalConfig
 //
@@ -136,19 +177,7 @@ const JsonLoaderInterface* RetryMethodConfig::JsonLoader(const JsonArgs&) {
 void RetryMethodConfig::JsonPostLoad(const Json& json, const JsonArgs& args,
                                      ValidationErrors* errors) {
   // Validate maxAttempts.
-  {
-    ValidationErrors::ScopedField field(errors, ".maxAttempts");
-    if (!errors->FieldHasErrors()) {
-      if (max_attempts_ <= 1) {
-        errors->AddError("must be at least 2");
-      } else if (max_attempts_ > MAX_MAX_RETRY_ATTEMPTS) {
-        gpr_log(GPR_ERROR,
-                "service config: clamped retryPolicy.maxAttempts at %d",
-                MAX_MAX_RETRY_ATTEMPTS);
-        max_attempts_ = MAX_MAX_RETRY_ATTEMPTS;
-      }
-    }
-  }
+  ValidateMaxAttempts("retryPolicy", &max_attempts_, errors);
   // Validate initialBackoff.
   {
     ValidationErrors::ScopedField field(errors, ".initialBackoff");
@@ -171,22 +200,8 @@ void RetryMethodConfig::JsonPostLoad(const Json& json, const JsonArgs& args,
     }
   }
   // Parse retryableStatusCodes.
-  auto status_code_list = LoadJsonObjectField<std::vector<std::string>>(
-      json.object(), args, "retryableStatusCodes", errors,
-      /*required=*/false);
-  if (status_code_list.has_value()) {
-    for (size_t i = 0; i < status_code_list->size(); ++i) {
-      ValidationErrors::ScopedField field(
-          errors, absl::StrCat(".retryableStatusCodes[", i, "]"));
-      grpc_status_code status;
-      if (!grpc_status_code_from_string((*status_code_list)[i].c_str(),
-                                        &status)) {
-        errors->AddError("failed to parse status code");
-      } else {
-        retryable_status_codes_.Add(status);
-      }
-    }
-  }
+  ParseStatusCodes(json, args, "retryableStatusCodes", &retryable_status_codes_,
+                   errors);
   // Validate perAttemptRecvTimeout.
   if (args.IsEnabled(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING)) {
     if (per_attempt_recv_timeout_.has_value()) {
@@ -216,6 +231,32 @@ void RetryMethodConfig::JsonPostLoad(const Json& json, const JsonArgs& args,
   }
 }
 
+//
+// RetryMethodConfig::HedgingPolicy
+//
+
+const JsonLoaderInterface* RetryMethodConfig::HedgingPolicy::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<HedgingPolicy>()
+          // Note: The "nonFatalStatusCodes" field requires custom parsing,
+          // so it's handled in JsonPostLoad() instead.
+          .Field("maxAttempts", &HedgingPolicy::max_attempts)
+          .OptionalField("hedgingDelay", &HedgingPolicy::hedging_delay)
+          .Finish();
+  return loader;
+}
+
+void RetryMethodConfig::HedgingPolicy::JsonPostLoad(const Json& json,
+                                                    const JsonArgs& args,
+                                                    ValidationErrors* errors) {
+  // Validate maxAttempts.
+  ValidateMaxAttempts("hedgingPolicy", &max_attempts, errors);
+  // Parse nonFatalStatusCodes.
+  ParseStatusCodes(json, args, "nonFatalStatusCodes", &non_fatal_status_codes,
+                   errors);
+}
+
 //
 // RetryServiceConfigParser
 //
@@ -258,14 +299,25 @@ namespace {
 
 struct MethodConfig {
   std::unique_ptr<RetryMethodConfig> retry_policy;
+  absl::optional<RetryMethodConfig::HedgingPolicy> hedging_policy;
 
   static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
     static const auto* loader =
         JsonObjectLoader<MethodConfig>()
             .OptionalField("retryPolicy", &MethodConfig::retry_policy)
+            .OptionalField("hedgingPolicy", &MethodConfig::hedging_policy,
+                           GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING)
             .Finish();
     return loader;
   }
+
+  void JsonPostLoad(const Json& /*json*/, const JsonArgs& /*args*/,
+                    ValidationErrors* errors) {
+    if (retry_policy != nullptr && hedging_policy.has_value()) {
+      ValidationErrors::ScopedField field(errors, ".hedgingPolicy");
+      errors->AddError("may not be set together with retryPolicy");
+    }
+  }
 };
 
 }  // namespace
@@ -276,6 +328,10 @@ RetryServiceConfigParser::ParsePerMethodParams(const ChannelArgs& args,
                                                ValidationErrors* errors) {
   auto method_params =
       LoadFromJson<MethodConfig>(json, JsonChannelArgs(args), errors);
+  if (method_params.hedging_policy.has_value()) {
+    return std::make_unique<RetryMethodConfig>(
+        std::move(*method_params.hedging_policy));
+  }
   return std::move(method_params.retry_policy);
 }
 
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -54,8 +55,31 @@ class RetryGlobalConfig : public ServiceConfigParser::ParsedConfig {
   uintptr_t milli_token_ratio_ = 0;
 };
 
+// Holds a method's retryPolicy or, when hedging is enabled, its
+// hedgingPolicy.  The two are mutually exclusive.
 class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
  public:
+  struct HedgingPolicy {
+    int max_attempts = 0;
+    Duration hedging_delay;
+    StatusCodeSet non_fatal_status_codes;
+
+    static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
+    void JsonPostLoad(const Json& json, const JsonArgs& args,
+                      ValidationErrors* errors);
+  };
+
+  RetryMethodConfig() = default;
+  explicit RetryMethodConfig(HedgingPolicy hedging_policy)
+      : max_attempts_(hedging_policy.max_attempts),
+        hedging_policy_(std::move(hedging_policy)) {}
+
+  // If set, the remaining retryPolicy fields are unused, and max_attempts()
+  // is the hedging policy's maxAttempts.
+  const absl::optional<HedgingPolicy>& hedging_policy() const {
+    return hedging_policy_;
+  }
+
   int max_attempts() const { return max_attempts_; }
   Duration initial_backoff() const { return initial_backoff_; }
   Duration max_backoff() const { return max_backoff_; }
@@ -78,6 +102,7 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  absl::optional<HedgingPolicy> hedging_policy_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -18,7 +18,9 @@
 
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <new>
 #include <utility>
@@ -28,11 +30,13 @@
 
 #include <grpc/grpc.h>
 #include <grpc/status.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/status_helper.h"
 #include "src/core/lib/iomgr/error.h"
@@ -47,6 +51,138 @@
 
 namespace grpc_core {
 
+//
+// DeadlineTimerQueue
+//
+
+DeadlineTimerQueue::DeadlineTimerQueue(const ChannelArgs& args)
+    : event_engine_(
+          args.GetObjectRef<grpc_event_engine::experimental::EventEngine>()),
+      slack_ms_(std::max(
+          0, args.GetInt(GRPC_ARG_DEADLINE_TIMER_SLACK_MS).value_or(0))),
+      num_shards_(Clamp(gpr_cpu_num_cores(), 1u, 16u)),
+      shards_(new Shard[num_shards_]) {}
+
+DeadlineTimerQueue::~DeadlineTimerQueue() = default;
+
+void DeadlineTimerQueue::Orphan() {
+  {
+    MutexLock lock(&timer_mu_);
+    // Every call holds a ref to the channel, so normally nothing is left in
+    // the heaps by now and we can stop the timer from waking up for nothing.
+    // Anything that is left is still owed its closure: in that case the
+    // timer keeps running, and its ref keeps us alive until it has fired.
+    bool idle = true;
+    for (size_t i = 0; i < num_shards_ && idle; ++i) {
+      MutexLock shard_lock(&shards_[i].mu);
+      idle = grpc_timer_heap_is_empty(&shards_[i].heap);
+    }
+    if (idle && timer_handle_.has_value() &&
+        event_engine_->Cancel(*timer_handle_)) {
+      timer_handle_.reset();
+      armed_deadline_.store(std::numeric_limits<int64_t>::max(),
+                            std::memory_order_relaxed);
+    }
+  }
+  Unref();
+}
+
+DeadlineTimerQueue::Shard* DeadlineTimerQueue::ShardFor(
+    grpc_timer* timer) const {
+  return &shards_[HashPointer(timer, num_shards_)];
+}
+
+void DeadlineTimerQueue::TimerInit(grpc_timer* timer, Timestamp deadline,
+                                   grpc_closure* closure) {
+  timer->deadline = deadline.milliseconds_after_process_epoch();
+  timer->closure = closure;
+  if (deadline <= Timestamp::Now()) {
+    timer->pending = false;
+    ExecCtx::Run(DEBUG_LOCATION, closure, absl::OkStatus());
+    return;
+  }
+  const int64_t fire_at = CoalescedDeadline(timer->deadline);
+  Shard* shard = ShardFor(timer);
+  {
+    MutexLock lock(&shard->mu);
+    timer->pending = true;
+    grpc_timer_heap_add(&shard->heap, timer);
+  }
+  // The timer may already have fired or been cancelled by now, so we must
+  // not touch it from here on.
+  if (fire_at >= armed_deadline_.load(std::memory_order_relaxed)) return;
+  MutexLock lock(&timer_mu_);
+  MaybeArmTimerLocked(fire_at);
+}
+
+void DeadlineTimerQueue::TimerCancel(grpc_timer* timer) {
+  Shard* shard = ShardFor(timer);
+  MutexLock lock(&shard->mu);
+  if (!timer->pending) return;
+  timer->pending = false;
+  grpc_timer_heap_remove(&shard->heap, timer);
+  // The EventEngine timer is left armed: if this was the earliest deadline,
+  // it wakes up for nothing and re-arms for whatever is then due next.
+  ExecCtx::Run(DEBUG_LOCATION, timer->closure, absl::CancelledError());
+}
+
+int64_t DeadlineTimerQueue::CoalescedDeadline(int64_t deadline) const {
+  if (slack_ms_ > 1 &&
+      deadline <= std::numeric_limits<int64_t>::max() - slack_ms_) {
+    deadline = (deadline + slack_ms_ - 1) / slack_ms_ * slack_ms_;
+  }
+  return deadline;
+}
+
+void DeadlineTimerQueue::MaybeArmTimerLocked(int64_t fire_at) {
+  if (fire_at >= armed_deadline_.load(std::memory_order_relaxed)) return;
+  if (timer_handle_.has_value()) {
+    // If the timer could not be cancelled, its callback is about to run and
+    // will re-arm for whatever is then due first.
+    if (!event_engine_->Cancel(*timer_handle_)) return;
+  }
+  armed_deadline_.store(fire_at, std::memory_order_relaxed);
+  timer_handle_ = event_engine_->RunAfter(
+      Timestamp::FromMillisecondsAfterProcessEpoch(fire_at) - Timestamp::Now(),
+      [self = Ref()]() mutable {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        self->OnTimer();
+        // Release the ref while ExecCtx is still alive.
+        self.reset();
+      });
+}
+
+void DeadlineTimerQueue::OnTimer() {
+  MutexLock lock(&timer_mu_);
+  timer_handle_.reset();
+  // Until the scan below is done we do not know when the timer is next due.
+  // Say "never" meanwhile, so that a TimerInit() landing in a shard we have
+  // already scanned does not compare against the deadline we were armed for
+  // (which is in the past) and skip arming: it waits for us to finish
+  // instead, and then arms if it is still earliest.
+  armed_deadline_.store(std::numeric_limits<int64_t>::max(),
+                        std::memory_order_relaxed);
+  const int64_t now = Timestamp::Now().milliseconds_after_process_epoch();
+  int64_t next = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard& shard = shards_[i];
+    MutexLock shard_lock(&shard.mu);
+    while (!grpc_timer_heap_is_empty(&shard.heap)) {
+      grpc_timer* timer = grpc_timer_heap_top(&shard.heap);
+      if (timer->deadline > now) {
+        next = std::min(next, CoalescedDeadline(timer->deadline));
+        break;
+      }
+      timer->pending = false;
+      grpc_timer_heap_pop(&shard.heap);
+      // Scheduled on the ExecCtx, so these run after we release the locks.
+      ExecCtx::Run(DEBUG_LOCATION, timer->closure, absl::OkStatus());
+    }
+  }
+  if (next != std::numeric_limits<int64_t>::max()) MaybeArmTimerLocked(next);
+}
+
 // A fire-and-forget class representing a pending deadline timer.
 // Allocated on the call arena.
 class TimerState {
@@ -55,10 +191,10 @@ class TimerState {
       : deadline_state_(deadline_state) {
     GRPC_CALL_STACK_REF(deadline_state->call_stack, "DeadlineTimerState");
     GRPC_CLOSURE_INIT(&closure_, TimerCallback, this, nullptr);
-    grpc_timer_init(&timer_, deadline, &closure_);
+    deadline_state->timer_queue->TimerInit(&timer_, deadline, &closure_);
   }
 
-  void Cancel() { grpc_timer_cancel(&timer_); }
+  void Cancel() { deadline_state_->timer_queue->TimerCancel(&timer_); }
 
  private:
   // The on_complete callback used when sending a cancel_error batch down the
@@ -196,13 +332,14 @@ static void start_timer_after_init(void* arg, grpc_error_handle error) {
                           "done scheduling deadline timer");
 }
 
-grpc_deadline_state::grpc_deadline_state(grpc_call_element* elem,
-                                         const grpc_call_element_args& args,
-                                         grpc_core::Timestamp deadline)
+grpc_deadline_state::grpc_deadline_state(
+    grpc_call_element* elem, const grpc_call_element_args& args,
+    grpc_core::Timestamp deadline, grpc_core::DeadlineTimerQueue* timer_queue)
     : elem(elem),
       call_stack(args.call_stack),
       call_combiner(args.call_combiner),
-      arena(args.arena) {
+      arena(args.arena),
+      timer_queue(timer_queue) {
   // Deadline will always be infinite on servers, so the timer will only be
   // set on clients with a finite deadline.
   if (deadline != grpc_core::Timestamp::InfFuture()) {
@@ -246,15 +383,27 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // filter code
 //
 
+// Channel data.  Used for both client and server filters.
+struct channel_data {
+  explicit channel_data(const grpc_core::ChannelArgs& args)
+      : timer_queue(
+            grpc_core::MakeOrphanable<grpc_core::DeadlineTimerQueue>(args)) {}
+
+  grpc_core::OrphanablePtr<grpc_core::DeadlineTimerQueue> timer_queue;
+};
+
 // Constructor for channel_data.  Used for both client and server filters.
 static grpc_error_handle deadline_init_channel_elem(
-    grpc_channel_element* /*elem*/, grpc_channel_element_args* args) {
+    grpc_channel_element* elem, grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
+  new (elem->channel_data) channel_data(args->channel_args);
   return absl::OkStatus();
 }
 
 // Destructor for channel_data.  Used for both client and server filters.
-static void deadline_destroy_channel_elem(grpc_channel_element* /*elem*/) {}
+static void deadline_destroy_channel_elem(grpc_channel_element* elem) {
+  static_cast<channel_data*>(elem->channel_data)->~channel_data();
+}
 
 // Additional call data used only for the server filter.
 struct server_call_data {
@@ -271,7 +420,9 @@ struct server_call_data {
 // Constructor for call_data.  Used for both client and server filters.
 static grpc_error_handle deadline_init_call_elem(
     grpc_call_element* elem, const grpc_call_element_args* args) {
-  new (elem->call_data) grpc_deadline_state(elem, *args, args->deadline);
+  new (elem->call_data) grpc_deadline_state(
+      elem, *args, args->deadline,
+      static_cast<channel_data*>(elem->channel_data)->timer_queue.get());
   return absl::OkStatus();
 }
 
@@ -351,7 +502,7 @@ const grpc_channel_filter grpc_client_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     grpc_channel_stack_no_post_init,
     deadline_destroy_channel_elem,
@@ -376,7 +527,7 @@ const grpc_channel_filter grpc_server_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     grpc_channel_stack_no_post_init,
     deadline_destroy_channel_elem,
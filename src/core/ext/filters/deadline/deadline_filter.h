@@ -19,17 +19,93 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
+
+#include <grpc/event_engine/event_engine.h>
+
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_heap.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/transport/transport.h"
 
 namespace grpc_core {
+
 class TimerState;
+
+// Tracks the deadlines of all calls on a channel and drives them from a
+// single EventEngine timer armed for the earliest one, rather than one timer
+// per call.  Deadlines are rounded up to a multiple of the
+// GRPC_ARG_DEADLINE_TIMER_SLACK_MS channel arg, so calls whose deadlines
+// fall in the same slack window expire on the same wakeup.
+//
+// Every call on the channel arms and cancels a timer here, so the pending
+// deadlines are spread over a few independently locked heaps (as the iomgr
+// timer list does) and the lock guarding the EventEngine timer is only taken
+// when a call's deadline is earlier than the one the timer is armed for.
+class DeadlineTimerQueue final
+    : public InternallyRefCounted<DeadlineTimerQueue> {
+ public:
+  explicit DeadlineTimerQueue(const ChannelArgs& args);
+  ~DeadlineTimerQueue() override;
+
+  // Timers still pending keep the queue alive and fire as usual.
+  void Orphan() override;
+
+  // Same contract as grpc_timer_init(): closure runs exactly once, with
+  // absl::OkStatus() once deadline has passed or absl::CancelledError() if
+  // the timer is cancelled first.  timer is only used as a heap entry.
+  void TimerInit(grpc_timer* timer, Timestamp deadline, grpc_closure* closure);
+  // Same contract as grpc_timer_cancel().
+  void TimerCancel(grpc_timer* timer);
+
+ private:
+  struct Shard {
+    Shard() { grpc_timer_heap_init(&heap); }
+    ~Shard() { grpc_timer_heap_destroy(&heap); }
+
+    Mutex mu;
+    grpc_timer_heap heap ABSL_GUARDED_BY(mu);
+  };
+
+  Shard* ShardFor(grpc_timer* timer) const;
+  // Returns the time at which a timer with the given deadline should fire.
+  int64_t CoalescedDeadline(int64_t deadline) const;
+  // Arms the EventEngine timer for fire_at if it is not already armed for
+  // that time or earlier.
+  void MaybeArmTimerLocked(int64_t fire_at)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(timer_mu_);
+  void OnTimer();
+
+  const std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+      event_engine_;
+  const int64_t slack_ms_;
+  const size_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
+  Mutex timer_mu_;
+  absl::optional<grpc_event_engine::experimental::EventEngine::TaskHandle>
+      timer_handle_ ABSL_GUARDED_BY(timer_mu_);
+  // When the EventEngine timer is due, or "never" if it is not armed (or
+  // OnTimer() is still working out when it should next be due).  Only
+  // written with timer_mu_ held; read without it by TimerInit().
+  std::atomic<int64_t> armed_deadline_{std::numeric_limits<int64_t>::max()};
+};
+
 }  // namespace grpc_core
 
 // State used for filters that enforce call deadlines.
@@ -37,7 +113,8 @@ class TimerState;
 struct grpc_deadline_state {
   grpc_deadline_state(grpc_call_element* elem,
                       const grpc_call_element_args& args,
-                      grpc_core::Timestamp deadline);
+                      grpc_core::Timestamp deadline,
+                      grpc_core::DeadlineTimerQueue* timer_queue);
   ~grpc_deadline_state();
 
   // We take a reference to the call stack for the timer callback.
@@ -45,6 +122,8 @@ struct grpc_deadline_state {
   grpc_call_stack* call_stack;
   grpc_core::CallCombiner* call_combiner;
   grpc_core::Arena* arena;
+  // Owned by the channel, which outlives the call.
+  grpc_core::DeadlineTimerQueue* timer_queue;
   grpc_core::TimerState* timer_state = nullptr;
   // Closure to invoke when we receive trailing metadata.
   // We use this to cancel the timer.
@@ -142,6 +142,31 @@ FaultInjectionFilter::FaultInjectionFilter(ChannelFilter::Args filter_args)
           FaultInjectionServiceConfigParser::ParserIndex()),
       mu_(new Mutex) {}
 
+bool FaultInjectionFilter::IsNoopForMethod(
+    const ServiceConfigParser::ParsedConfigVector* method_configs,
+    size_t instance) {
+  if (method_configs == nullptr) return false;
+  auto* method_params = static_cast<FaultInjectionMethodParsedConfig*>(
+      (*method_configs)[FaultInjectionServiceConfigParser::ParserIndex()]
+          .get());
+  if (method_params == nullptr) return false;
+  const FaultInjectionMethodParsedConfig::FaultInjectionPolicy* fi_policy =
+      method_params->fault_injection_policy(instance);
+  if (fi_policy == nullptr) return false;
+  // Headers can turn on faults for any call.
+  if (!fi_policy->abort_code_header.empty() ||
+      !fi_policy->abort_percentage_header.empty() ||
+      !fi_policy->delay_header.empty() ||
+      !fi_policy->delay_percentage_header.empty()) {
+    return false;
+  }
+  const bool may_abort = fi_policy->abort_code != GRPC_STATUS_OK &&
+                         fi_policy->abort_percentage_numerator > 0;
+  const bool may_delay = fi_policy->delay != Duration::Zero() &&
+                         fi_policy->delay_percentage_numerator > 0;
+  return !may_abort && !may_delay;
+}
+
 // Construct a promise for one call.
 ArenaPromise<ServerMetadataHandle> FaultInjectionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
@@ -32,6 +32,7 @@
 #include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/transport/transport.h"
 
 namespace grpc_core {
@@ -47,6 +48,12 @@ class FaultInjectionFilter : public ChannelFilter {
   static absl::StatusOr<FaultInjectionFilter> Create(
       const ChannelArgs& args, ChannelFilter::Args filter_args);
 
+  // Returns whether the given instance of the filter in a stack would never
+  // inject a fault into calls with the given method config.
+  static bool IsNoopForMethod(
+      const ServiceConfigParser::ParsedConfigVector* method_configs,
+      size_t instance);
+
   // Construct a promise for one call.
   ArenaPromise<ServerMetadataHandle> MakeCallPromise(
       CallArgs call_args, NextPromiseFactory next_promise_factory) override;
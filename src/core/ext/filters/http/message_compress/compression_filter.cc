@@ -118,7 +118,7 @@ MessageHandle CompressionFilter::CompressMessage(
   auto* call_tracer = static_cast<CallTracerInterface*>(
       call_context[GRPC_CONTEXT_CALL_TRACER].value);
   if (call_tracer != nullptr) {
-    call_tracer->RecordSendMessage(*message->payload());
+    call_tracer->OnSendMessage(*message->payload());
   }
   // Check if we're allowed to compress this message
   // (apps might want to disable compression for certain messages to avoid
@@ -151,7 +151,7 @@ MessageHandle CompressionFilter::CompressMessage(
     tmp.Swap(payload);
     flags |= GRPC_WRITE_INTERNAL_COMPRESS;
     if (call_tracer != nullptr) {
-      call_tracer->RecordSendCompressedMessage(*message->payload());
+      call_tracer->OnSendCompressedMessage(*message->payload());
     }
   } else {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
@@ -177,7 +177,7 @@ absl::StatusOr<MessageHandle> CompressionFilter::DecompressMessage(
   auto* call_tracer = static_cast<CallTracerInterface*>(
       call_context[GRPC_CONTEXT_CALL_TRACER].value);
   if (call_tracer != nullptr) {
-    call_tracer->RecordReceivedMessage(*message->payload());
+    call_tracer->OnReceivedMessage(*message->payload());
   }
   // Check max message length.
   if (args.max_recv_message_length.has_value() &&
@@ -206,7 +206,7 @@ absl::StatusOr<MessageHandle> CompressionFilter::DecompressMessage(
   message->mutable_flags() &= ~GRPC_WRITE_INTERNAL_COMPRESS;
   message->mutable_flags() |= GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED;
   if (call_tracer != nullptr) {
-    call_tracer->RecordReceivedDecompressedMessage(*message->payload());
+    call_tracer->OnReceivedDecompressedMessage(*message->payload());
   }
   return std::move(message);
 }
@@ -183,7 +183,10 @@ void EncodeMessageToPayload(const SliceBuffer* message, uint32_t log_len,
                             LoggingSink::Entry* entry) {
   auto* sb = message->c_slice_buffer();
   entry->payload.message_length = sb->length;
-  // Log the message to a max of the configured message length
+  // Log the message to a max of the configured message length, copying only
+  // the logged prefix.
+  entry->payload.message.reserve(
+      std::min(sb->length, static_cast<size_t>(log_len)));
   for (size_t i = 0; i < sb->count; i++) {
     absl::StrAppend(
         &entry->payload.message,
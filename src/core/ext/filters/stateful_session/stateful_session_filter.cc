@@ -223,6 +223,18 @@ bool IsConfiguredPath(absl::string_view configured_path,
 }
 }  // namespace
 
+bool StatefulSessionFilter::IsNoopForMethod(
+    const ServiceConfigParser::ParsedConfigVector* method_configs,
+    size_t instance) {
+  if (method_configs == nullptr) return false;
+  auto* method_params = static_cast<StatefulSessionMethodParsedConfig*>(
+      (*method_configs)[StatefulSessionServiceConfigParser::ParserIndex()]
+          .get());
+  if (method_params == nullptr) return false;
+  auto* cookie_config = method_params->GetConfig(instance);
+  return cookie_config != nullptr && !cookie_config->name.has_value();
+}
+
 // Construct a promise for one call.
 ArenaPromise<ServerMetadataHandle> StatefulSessionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
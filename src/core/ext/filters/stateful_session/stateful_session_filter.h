@@ -30,6 +30,7 @@
 #include "src/core/lib/gprpp/unique_type_name.h"
 #include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/service_config/service_config_call_data.h"
+#include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/transport/transport.h"
 
 namespace grpc_core {
@@ -58,6 +59,12 @@ class StatefulSessionFilter : public ChannelFilter {
   static absl::StatusOr<StatefulSessionFilter> Create(
       const ChannelArgs& args, ChannelFilter::Args filter_args);
 
+  // Returns whether the given instance of the filter in a stack has no
+  // cookie configured for calls with the given method config.
+  static bool IsNoopForMethod(
+      const ServiceConfigParser::ParsedConfigVector* method_configs,
+      size_t instance);
+
   // Construct a promise for one call.
   ArenaPromise<ServerMetadataHandle> MakeCallPromise(
       CallArgs call_args, NextPromiseFactory next_promise_factory) override;
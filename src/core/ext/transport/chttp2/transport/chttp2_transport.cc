@@ -147,6 +147,8 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalescing_timer_fired_locked(void* t,
+                                                grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -374,6 +376,12 @@ static void read_channel_args(grpc_chttp2_transport* t,
   t->write_buffer_size =
       std::max(0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)
                       .value_or(grpc_core::chttp2::kDefaultWindow));
+  t->write_coalescing_min_bytes = std::max(
+      0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES)
+             .value_or(0));
+  t->write_coalescing_delay = std::chrono::microseconds(std::max(
+      0, channel_args.GetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US)
+             .value_or(100)));
   t->keepalive_time =
       std::max(grpc_core::Duration::Milliseconds(1),
                channel_args.GetDurationFromIntMillis(GRPC_ARG_KEEPALIVE_TIME_MS)
@@ -589,7 +597,9 @@ grpc_chttp2_transport::grpc_chttp2_transport(
       flow_control(
           peer_string.as_string_view(),
           channel_args.GetBool(GRPC_ARG_HTTP2_BDP_PROBE).value_or(true),
-          &memory_owner),
+          &memory_owner,
+          channel_args.GetBool(GRPC_ARG_HTTP2_DELIVERY_RATE_FLOW_CONTROL)
+              .value_or(false)),
       deframe_state(is_client ? GRPC_DTS_FH_0 : GRPC_DTS_CLIENT_PREFIX_0),
       event_engine(
           channel_args
@@ -724,6 +734,12 @@ static void close_transport_locked(grpc_chttp2_transport* t,
         t->next_bdp_ping_timer_handle.reset();
       }
     }
+    if (t->write_coalescing_timer_handle.has_value()) {
+      if (t->event_engine->Cancel(*t->write_coalescing_timer_handle)) {
+        GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalescing");
+        t->write_coalescing_timer_handle.reset();
+      }
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
         if (t->keepalive_ping_timer_handle.has_value()) {
@@ -936,10 +952,54 @@ static void set_write_state(grpc_chttp2_transport* t,
   }
 }
 
+// Writes triggered only by newly queued messages may be held back for a short
+// while so that messages from several streams go out in one syscall. Returns
+// true if the write should be deferred.
+static bool maybe_coalesce_write(grpc_chttp2_transport* t,
+                                 grpc_chttp2_initiate_write_reason reason) {
+  if (reason != GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE ||
+      t->write_coalescing_min_bytes == 0 ||
+      t->write_coalescing_pending_bytes >= t->write_coalescing_min_bytes) {
+    return false;
+  }
+  if (!t->write_coalescing_timer_handle.has_value()) {
+    GRPC_CHTTP2_REF_TRANSPORT(t, "write_coalescing");
+    t->write_coalescing_timer_handle =
+        t->event_engine->RunAfter(t->write_coalescing_delay, [t] {
+          grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+          grpc_core::ExecCtx exec_ctx;
+          t->combiner->Run(
+              GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                                write_coalescing_timer_fired_locked, t,
+                                nullptr),
+              absl::OkStatus());
+        });
+  }
+  return true;
+}
+
+static void write_coalescing_timer_fired_locked(
+    void* tp, GRPC_UNUSED grpc_error_handle error) {
+  GPR_DEBUG_ASSERT(error.ok());
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->write_coalescing_timer_handle.has_value());
+  t->write_coalescing_timer_handle.reset();
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_COALESCING_TIMER);
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalescing");
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
+      if (maybe_coalesce_write(t, reason)) break;
+      // Anything else going out flushes the held back messages too, so the
+      // coalescing timer is no longer needed.
+      if (t->write_coalescing_timer_handle.has_value() &&
+          t->event_engine->Cancel(*t->write_coalescing_timer_handle)) {
+        t->write_coalescing_timer_handle.reset();
+        GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalescing");
+      }
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
@@ -993,6 +1053,7 @@ static void write_action_begin_locked(void* gt,
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
   grpc_chttp2_begin_write_result r;
+  t->write_coalescing_pending_bytes = 0;
   if (!t->closed_with_error.ok()) {
     r.writing = false;
   } else {
@@ -1424,6 +1485,8 @@ static void perform_stream_op_locked(void* stream_op,
           s->deadline,
           s->send_initial_metadata->get(grpc_core::GrpcTimeoutMetadata())
               .value_or(grpc_core::Timestamp::InfFuture()));
+      auto weight = s->send_initial_metadata->get(grpc_core::GrpcStreamWeight());
+      if (weight.has_value()) grpc_chttp2_set_stream_weight(s, *weight);
     }
     if (contains_non_ok_status(s->send_initial_metadata)) {
       s->seen_error = true;
@@ -1495,6 +1558,7 @@ static void perform_stream_op_locked(void* stream_op,
           s->flow_controlled_bytes_written +
           static_cast<int64_t>(s->flow_controlled_buffer.length) +
           static_cast<int64_t>(len);
+      t->write_coalescing_pending_bytes += GRPC_HEADER_SIZE_IN_BYTES + len;
       if (flags & GRPC_WRITE_BUFFER_HINT) {
         s->next_message_end_offset -= t->write_buffer_size;
         s->write_buffering = true;
@@ -1963,6 +2027,12 @@ static void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
 // INPUT PROCESSING - GENERAL
 //
 
+void grpc_chttp2_set_stream_weight(grpc_chttp2_stream* s, uint32_t weight) {
+  s->write_weight = grpc_core::Clamp(weight, grpc_core::GrpcStreamWeight::kMin,
+                                     grpc_core::GrpcStreamWeight::kMax);
+  s->flow_control.set_weight(s->write_weight);
+}
+
 void grpc_chttp2_maybe_complete_recv_initial_metadata(grpc_chttp2_transport* t,
                                                       grpc_chttp2_stream* s) {
   if (s->recv_initial_metadata_ready != nullptr &&
@@ -3154,6 +3224,8 @@ const char* grpc_chttp2_initiate_write_reason_string(
       return "PING_RESPONSE";
     case GRPC_CHTTP2_INITIATE_WRITE_FORCE_RST_STREAM:
       return "FORCE_RST_STREAM";
+    case GRPC_CHTTP2_INITIATE_WRITE_COALESCING_TIMER:
+      return "COALESCING_TIMER";
   }
   GPR_UNREACHABLE_CODE(return "unknown");
 }
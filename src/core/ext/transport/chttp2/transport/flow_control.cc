@@ -52,6 +52,10 @@ TestOnlyTransportTargetWindowEstimatesMocker*
 namespace {
 
 constexpr const int64_t kMaxWindowUpdateSize = (1u << 31) - 1;
+// Multiple of the BDP estimate to target while the delivery rate model is
+// still seeing the delivery rate grow: BBR's startup gain of 2/ln(2), which
+// is the smallest gain that lets the delivery rate double every round.
+constexpr const double kStartupWindowGain = 2.89;
 
 }  // namespace
 
@@ -102,10 +106,12 @@ std::ostream& operator<<(std::ostream& out, const FlowControlAction& action) {
 
 TransportFlowControl::TransportFlowControl(absl::string_view name,
                                            bool enable_bdp_probe,
-                                           MemoryOwner* memory_owner)
+                                           MemoryOwner* memory_owner,
+                                           bool delivery_rate_model)
     : memory_owner_(memory_owner),
       enable_bdp_probe_(enable_bdp_probe),
-      bdp_estimator_(name),
+      delivery_rate_model_(delivery_rate_model),
+      bdp_estimator_(name, delivery_rate_model),
       pid_controller_(PidController::Args()
                           .set_gain_p(4)
                           .set_gain_i(8)
@@ -206,7 +212,8 @@ double TransportFlowControl::TargetLogBdp() {
       memory_owner_->is_valid()
           ? memory_owner_->GetPressureInfo().pressure_control_value
           : 0.0,
-      1 + log2(bdp_estimator_.EstimateBdp()));
+      log2(bdp_estimator_.FillingPipe() ? kStartupWindowGain : 2.0) +
+          log2(bdp_estimator_.EstimateBdp()));
 }
 
 double TransportFlowControl::SmoothLogBdp(double value) {
@@ -322,11 +329,15 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    uint32_t target = static_cast<uint32_t>(RoundUpToPowerOf2(
-        Clamp(IsMemoryPressureControllerEnabled()
-                  ? TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
-                  : pow(2, SmoothLogBdp(TargetLogBdp())),
-              0.0, static_cast<double>(kMaxInitialWindowSize))));
+    // The delivery rate model already filters its inputs, and smoothing its
+    // output again would only slow down the ramp up, so it skips the pid
+    // controller.
+    uint32_t target = static_cast<uint32_t>(RoundUpToPowerOf2(Clamp(
+        IsMemoryPressureControllerEnabled()
+            ? TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
+            : pow(2, delivery_rate_model_ ? TargetLogBdp()
+                                          : SmoothLogBdp(TargetLogBdp())),
+        0.0, static_cast<double>(kMaxInitialWindowSize))));
     if (target < kMinPositiveInitialWindowSize) target = 0;
     if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
       // Hook for simulating unusual flow control situations in tests.
@@ -397,11 +408,14 @@ FlowControlAction StreamFlowControl::UpdateAction(FlowControlAction action) {
         FlowControlAction::Urgency::QUEUE_UPDATE;
     // Size at which we probably want to wake up and write regardless of whether
     // we *have* to.
-    // Currently set at half the initial window size or 8kb (whichever is
+    // Currently set at half the initial window size (scaled down for streams
+    // weighted above the default, up for those below) or 8kb (whichever is
     // greater). 8kb means we don't send rapidly unnecessarily when the initial
     // window size is small.
-    const int64_t hurry_up_size = std::max(
-        static_cast<int64_t>(tfc_->sent_init_window()) / 2, int64_t{8192});
+    const int64_t hurry_up_size =
+        std::max(static_cast<int64_t>(tfc_->sent_init_window()) / 2 *
+                     kDefaultWeight / weight_,
+                 int64_t{8192});
     if (desired_announce_size > hurry_up_size) {
       urgency = FlowControlAction::Urgency::UPDATE_IMMEDIATELY;
     }
@@ -24,6 +24,7 @@
 #include <limits.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <iosfwd>
 #include <string>
 #include <utility>
@@ -169,11 +170,16 @@ std::ostream& operator<<(std::ostream& out, const FlowControlAction& action);
 // to be as performant as possible.
 class TransportFlowControl final {
  public:
+  // If \a delivery_rate_model is set, windows are sized directly from the
+  // BBR-style delivery rate and min RTT estimate kept by the BDP estimator,
+  // rather than from a PID-smoothed BDP estimate.
   explicit TransportFlowControl(absl::string_view name, bool enable_bdp_probe,
-                                MemoryOwner* memory_owner);
+                                MemoryOwner* memory_owner,
+                                bool delivery_rate_model = false);
   ~TransportFlowControl() {}
 
   bool bdp_probe() const { return enable_bdp_probe_; }
+  bool delivery_rate_model() const { return delivery_rate_model_; }
 
   // returns an announce if we should send a transport update to our peer,
   // else returns zero; writing_anyway indicates if a write would happen
@@ -304,6 +310,8 @@ class TransportFlowControl final {
 
   /// should we probe bdp?
   const bool enable_bdp_probe_;
+  /// size windows from the delivery rate model instead of the pid controller?
+  const bool delivery_rate_model_;
 
   // bdp estimation
   BdpEstimator bdp_estimator_;
@@ -385,8 +393,15 @@ class StreamFlowControl final {
   int64_t announced_window_delta() const { return announced_window_delta_; }
   int64_t min_progress_size() const { return min_progress_size_; }
 
+  // Relative priority of this stream (an HTTP/2 weight, 1..256, default 16).
+  // Heavier streams have their window replenished sooner.
+  static constexpr uint32_t kDefaultWeight = 16;
+  void set_weight(uint32_t weight) { weight_ = std::max(weight, 1u); }
+  uint32_t weight() const { return weight_; }
+
  private:
   TransportFlowControl* const tfc_;
+  uint32_t weight_ = kDefaultWeight;
   int64_t min_progress_size_ = 0;
   int64_t remote_window_delta_ = 0;
   int64_t announced_window_delta_ = 0;
@@ -34,6 +34,7 @@
 #include "src/core/ext/transport/chttp2/transport/http_trace.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/surface/validate_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
@@ -43,6 +44,7 @@ namespace grpc_core {
 namespace {
 
 constexpr size_t kDataFrameHeaderSize = 9;
+constexpr size_t kPriorityBlockSize = 5;
 
 }  // namespace
 
@@ -87,6 +89,10 @@ void HPackCompressor::Frame(const EncodeHeaderOptions& options,
   if (options.is_end_of_stream) {
     flags |= GRPC_CHTTP2_DATA_FLAG_END_STREAM;
   }
+  // The PRIORITY block (exclusive bit + stream dependency, then weight) rides
+  // in the first HEADERS frame only.
+  size_t priority_size = options.stream_weight != 0 ? kPriorityBlockSize : 0;
+  if (priority_size != 0) flags |= GRPC_CHTTP2_FLAG_HAS_PRIORITY;
   options.stats->header_bytes += raw.Length();
   while (frame_type == GRPC_CHTTP2_FRAME_HEADER || raw.Length() > 0) {
     // per the HTTP/2 spec:
@@ -94,14 +100,26 @@ void HPackCompressor::Frame(const EncodeHeaderOptions& options,
     //   a CONTINUATION frame for the same stream.
     // Thus, we add the END_HEADER flag to the last frame.
     size_t len = raw.Length();
-    if (len <= options.max_frame_size) {
+    if (len + priority_size <= options.max_frame_size) {
       flags |= GRPC_CHTTP2_DATA_FLAG_END_HEADERS;
     } else {
-      len = options.max_frame_size;
+      len = options.max_frame_size - priority_size;
     }
     FillHeader(grpc_slice_buffer_tiny_add(output, kDataFrameHeaderSize),
-               frame_type, options.stream_id, len, flags);
+               frame_type, options.stream_id, len + priority_size, flags);
     options.stats->framing_bytes += kDataFrameHeaderSize;
+    if (priority_size != 0) {
+      uint8_t* p = grpc_slice_buffer_tiny_add(output, priority_size);
+      // Stream dependency 0 (the root), not exclusive.
+      p[0] = p[1] = p[2] = p[3] = 0;
+      // Weights are sent on the wire as weight - 1.
+      p[4] = static_cast<uint8_t>(
+          Clamp(options.stream_weight, GrpcStreamWeight::kMin,
+                GrpcStreamWeight::kMax) -
+          1);
+      options.stats->framing_bytes += priority_size;
+      priority_size = 0;
+    }
     grpc_slice_buffer_move_first(raw.c_slice_buffer(), len, output);
 
     frame_type = GRPC_CHTTP2_FRAME_CONTINUATION;
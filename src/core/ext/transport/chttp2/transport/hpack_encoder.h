@@ -343,6 +343,9 @@ class HPackCompressor {
     bool use_true_binary_metadata;
     size_t max_frame_size;
     grpc_transport_one_way_stats* stats;
+    // If non-zero, the HEADERS frame carries a PRIORITY block giving this
+    // stream the requested weight (1..256), with no stream dependency.
+    uint32_t stream_weight = 0;
   };
 
   template <typename HeaderSet>
@@ -1102,6 +1102,12 @@ void HPackParser::ParseInputInner(Input* input) {
         input->UnexpectedEOF();
         return;
       }
+      // Surface the stream weight (sent as weight - 1) so the transport can
+      // schedule this stream accordingly; dependencies are not supported.
+      if (metadata_buffer_ != nullptr) {
+        metadata_buffer_->Set(GrpcStreamWeight(),
+                              static_cast<uint32_t>(input->cur_ptr()[4]) + 1);
+      }
       input->Advance(5);
       input->UpdateFrontier();
       priority_ = Priority::None;
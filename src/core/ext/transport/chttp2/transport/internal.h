@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <chrono>
 #include <memory>
 
 #include "absl/strings/string_view.h"
@@ -136,6 +137,7 @@ typedef enum {
   GRPC_CHTTP2_INITIATE_WRITE_TRANSPORT_FLOW_CONTROL_UNSTALLED,
   GRPC_CHTTP2_INITIATE_WRITE_PING_RESPONSE,
   GRPC_CHTTP2_INITIATE_WRITE_FORCE_RST_STREAM,
+  GRPC_CHTTP2_INITIATE_WRITE_COALESCING_TIMER,
 } grpc_chttp2_initiate_write_reason;
 
 const char* grpc_chttp2_initiate_write_reason_string(
@@ -316,6 +318,19 @@ struct grpc_chttp2_transport : public grpc_core::KeepsGrpcInitialized {
   ///
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /// hold back writes triggered by new messages until this many message bytes
+  /// are pending; zero disables write coalescing
+  uint32_t write_coalescing_min_bytes = 0;
+  /// ... but never for longer than this
+  grpc_event_engine::experimental::EventEngine::Duration
+      write_coalescing_delay = std::chrono::microseconds(100);
+  /// message bytes queued since the last write began
+  size_t write_coalescing_pending_bytes = 0;
+  /// timer that forces a held back write out
+  absl::optional<grpc_event_engine::experimental::EventEngine::TaskHandle>
+      write_coalescing_timer_handle;
+  grpc_closure write_coalescing_timer_fired_locked;
+
   /// Set to a grpc_error object if a goaway frame is received. By default, set
   /// to absl::OkStatus()
   grpc_error_handle goaway_error;
@@ -585,6 +600,12 @@ struct grpc_chttp2_stream {
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
   grpc_chttp2_write_cb* finish_after_write = nullptr;
   size_t sending_bytes = 0;
+  /// bytes this stream may still send before yielding to the next writable
+  /// stream; topped up by one quantum each time the writer visits the stream
+  int64_t write_credit = 0;
+  /// relative share of the connection this stream gets while other streams
+  /// are also writable: the HTTP/2 weight the client asked for (1..256)
+  uint32_t write_weight = grpc_core::GrpcStreamWeight::kDefault;
 
   /// Whether the bytes needs to be traced using Fathom
   bool traced = false;
@@ -782,6 +803,11 @@ void grpc_chttp2_add_ping_strike(grpc_chttp2_transport* t);
 /// pings_before_data_required.
 void grpc_chttp2_reset_ping_clock(grpc_chttp2_transport* t);
 
+/// Record the HTTP/2 weight requested for \a s (clamped to 1..256); it scales
+/// both the stream's share of each write and how eagerly its receive window
+/// is replenished.
+void grpc_chttp2_set_stream_weight(grpc_chttp2_stream* s, uint32_t weight);
+
 /// add a ref to the stream and add it to the writable list;
 /// ref will be dropped in writing.c
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
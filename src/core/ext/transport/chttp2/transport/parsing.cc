@@ -860,6 +860,11 @@ grpc_error_handle grpc_chttp2_header_parser_parse(void* hpack_parser,
         if (s->header_frames_received == 2) {
           return GRPC_ERROR_CREATE("Too many trailer frames");
         }
+        if (!t->is_client && s->header_frames_received == 0) {
+          auto weight =
+              s->initial_metadata_buffer.get(grpc_core::GrpcStreamWeight());
+          if (weight.has_value()) grpc_chttp2_set_stream_weight(s, *weight);
+        }
         s->published_metadata[s->header_frames_received] =
             GRPC_METADATA_PUBLISHED_FROM_WIRE;
         maybe_complete_funcs[s->header_frames_received](t, s);
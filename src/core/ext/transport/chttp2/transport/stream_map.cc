@@ -25,21 +25,80 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+static size_t round_up_to_power_of_two(size_t n) {
+  size_t out = 1;
+  while (out < n) out <<= 1;
+  return out;
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
+  initial_capacity = round_up_to_power_of_two(initial_capacity);
   map->keys =
       static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
   map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+      static_cast<void**>(gpr_zalloc(sizeof(void*) * initial_capacity));
   map->count = 0;
-  map->free = 0;
   map->capacity = initial_capacity;
+  map->base = 0;
+  map->last_key = 0;
+  map->shift = 1;
+  map->overflow_keys = nullptr;
+  map->overflow_values = nullptr;
+  map->overflow_count = 0;
+  map->overflow_free = 0;
+  map->overflow_capacity = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->keys);
   gpr_free(map->values);
+  gpr_free(map->overflow_keys);
+  gpr_free(map->overflow_values);
+}
+
+static size_t slot_of(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return (key >> map->shift) & (map->capacity - 1);
+}
+
+// Advance base to the oldest occupied slot; requires a non-empty ring.
+static void advance_base(grpc_chttp2_stream_map* map) {
+  GPR_DEBUG_ASSERT(map->count > 0);
+  while (map->values[map->base & (map->capacity - 1)] == nullptr) {
+    map->base++;
+  }
+}
+
+// Re-layout the ring with a new capacity and/or shift. The window of live
+// keys must fit in the new ring.
+static void rebuild_ring(grpc_chttp2_stream_map* map, size_t new_capacity,
+                         uint32_t new_shift) {
+  uint32_t* keys =
+      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * new_capacity));
+  void** values = static_cast<void**>(gpr_zalloc(sizeof(void*) * new_capacity));
+  uint32_t new_base = 0;
+  if (map->count > 0) {
+    const size_t mask = map->capacity - 1;
+    const uint32_t last = map->last_key >> map->shift;
+    new_base = map->keys[map->base & mask] >> new_shift;
+    for (size_t off = 0; off <= last - map->base; off++) {
+      const size_t slot = (map->base + off) & mask;
+      if (map->values[slot] == nullptr) continue;
+      const uint32_t key = map->keys[slot];
+      GPR_DEBUG_ASSERT((key >> new_shift) - new_base < new_capacity);
+      const size_t new_slot = (key >> new_shift) & (new_capacity - 1);
+      keys[new_slot] = key;
+      values[new_slot] = map->values[slot];
+    }
+  }
+  gpr_free(map->keys);
+  gpr_free(map->values);
+  map->keys = keys;
+  map->values = values;
+  map->capacity = new_capacity;
+  map->shift = new_shift;
+  map->base = new_base;
 }
 
 static size_t compact(uint32_t* keys, void** values, size_t count) {
@@ -56,57 +115,101 @@ static size_t compact(uint32_t* keys, void** values, size_t count) {
   return out;
 }
 
+static void overflow_append(grpc_chttp2_stream_map* map, uint32_t key,
+                            void* value) {
+  GPR_DEBUG_ASSERT(map->overflow_count == 0 ||
+                   map->overflow_keys[map->overflow_count - 1] < key);
+  if (map->overflow_count == map->overflow_capacity) {
+    if (map->overflow_free > map->overflow_capacity / 4) {
+      map->overflow_count = compact(map->overflow_keys, map->overflow_values,
+                                    map->overflow_count);
+      map->overflow_free = 0;
+    } else {
+      // resize when less than 25% of the table is free, because compaction
+      // won't help much
+      map->overflow_capacity =
+          map->overflow_capacity == 0 ? 4 : 2 * map->overflow_capacity;
+      map->overflow_keys = static_cast<uint32_t*>(gpr_realloc(
+          map->overflow_keys, map->overflow_capacity * sizeof(uint32_t)));
+      map->overflow_values = static_cast<void**>(gpr_realloc(
+          map->overflow_values, map->overflow_capacity * sizeof(void*)));
+    }
+  }
+  map->overflow_keys[map->overflow_count] = key;
+  map->overflow_values[map->overflow_count] = value;
+  map->overflow_count++;
+}
+
+// Move the oldest ring entry to the overflow array.
+static void evict_oldest(grpc_chttp2_stream_map* map) {
+  const size_t slot = map->base & (map->capacity - 1);
+  overflow_append(map, map->keys[slot], map->values[slot]);
+  map->values[slot] = nullptr;
+  map->count--;
+  if (map->count > 0) advance_base(map);
+}
+
+// Make the ring window wide enough to hold index idx.
+static void make_room(grpc_chttp2_stream_map* map, uint32_t idx) {
+  while (map->count > 0 && idx - map->base >= map->capacity) {
+    if (map->count >= map->capacity / 2) {
+      // dense: the window is mostly live streams, so grow
+      rebuild_ring(map, 2 * map->capacity, map->shift);
+    } else {
+      // sparse: a few old streams are pinning the window open
+      evict_oldest(map);
+    }
+  }
+  if (map->count == 0) map->base = idx;
+}
+
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
+  const bool empty = grpc_chttp2_stream_map_size(map) == 0;
   // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  GPR_ASSERT(empty || map->last_key < key);
   GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
+  // Asserting that the key is not already in the map can be a debug assertion:
+  // monotonicity already rules out re-adding a key.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      // resize when less than 25% of the table is free, because compaction
-      // won't help much
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
+  if (empty) {
+    map->overflow_count = map->overflow_free = 0;
+    map->shift = 1;
+  } else if (map->shift == 1 && ((key ^ map->last_key) & 1) != 0) {
+    // Keys of both parities: index by the full key instead. This at most
+    // doubles the width of the live window, so one doubling keeps it in range.
+    size_t new_capacity = map->capacity;
+    if (map->count > 0 &&
+        map->last_key - map->keys[map->base & (map->capacity - 1)] >=
+            new_capacity) {
+      new_capacity *= 2;
     }
+    rebuild_ring(map, new_capacity, 0);
   }
 
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  const uint32_t idx = key >> map->shift;
+  if (map->count == 0) {
+    map->base = idx;
+  } else if (idx - map->base >= map->capacity) {
+    make_room(map, idx);
+  }
+
+  const size_t slot = slot_of(map, key);
+  GPR_DEBUG_ASSERT(map->values[slot] == nullptr);
+  map->keys[slot] = key;
+  map->values[slot] = value;
+  map->count++;
+  map->last_key = key;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
+static void** overflow_find(grpc_chttp2_stream_map* map, uint32_t key) {
   size_t min_idx = 0;
-  size_t max_idx = map->count;
+  size_t max_idx = map->overflow_count;
   size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
+  uint32_t* keys = map->overflow_keys;
   uint32_t mid_key;
 
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
   while (min_idx < max_idx) {
     // find the midpoint, avoiding overflow
     mid_idx = min_idx + ((max_idx - min_idx) / 2);
@@ -118,60 +221,96 @@ static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
       max_idx = mid_idx;
     } else  // mid_key == key
     {
-      return &values[mid_idx];
+      return map->overflow_values[mid_idx] != nullptr
+                 ? &map->overflow_values[mid_idx]
+                 : nullptr;
     }
   }
 
-  GPR_DEBUG_ASSERT(!strict_find);
   return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  // recognize complete emptyness and ensure we can skip
-  // defragmentation later
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  const size_t slot = slot_of(map, key);
+  void* out = map->values[slot];
+  if (out != nullptr && map->keys[slot] == key) {
+    map->values[slot] = nullptr;
+    map->count--;
+    if (map->count > 0 && (key >> map->shift) == map->base) advance_base(map);
+  } else {
+    void** pvalue = overflow_find(map, key);
+    GPR_DEBUG_ASSERT(pvalue != nullptr);
+    out = *pvalue;
+    *pvalue = nullptr;
+    map->overflow_free++;
+    // recognize complete emptyness and ensure we can skip
+    // defragmentation later
+    if (map->overflow_free == map->overflow_count) {
+      map->overflow_free = map->overflow_count = 0;
+    }
   }
+  GPR_DEBUG_ASSERT(out != nullptr);
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
+  const size_t slot = slot_of(map, key);
+  void* value = map->values[slot];
+  if (GPR_LIKELY(value != nullptr && map->keys[slot] == key)) return value;
+  if (map->overflow_count == map->overflow_free) return nullptr;
+  void** pvalue = overflow_find(map, key);
   return pvalue != nullptr ? *pvalue : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count + map->overflow_count - map->overflow_free;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  const size_t overflow_live = map->overflow_count - map->overflow_free;
+  const size_t n = map->count + overflow_live;
+  if (n == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  size_t r = static_cast<size_t>(rand()) % n;
+  if (r < overflow_live) {
+    if (map->overflow_free != 0) {
+      map->overflow_count = compact(map->overflow_keys, map->overflow_values,
+                                    map->overflow_count);
+      map->overflow_free = 0;
+    }
+    return map->overflow_values[r];
+  }
+  // pick a random point in the ring window and take the next live entry
+  const size_t mask = map->capacity - 1;
+  const size_t width = (map->last_key >> map->shift) - map->base + 1;
+  size_t off = static_cast<size_t>(rand()) % width;
+  for (;;) {
+    void* value = map->values[(map->base + off) & mask];
+    if (value != nullptr) return value;
+    if (++off == width) off = 0;
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  // Callbacks may delete entries (including the one being visited), so
+  // re-read the map state on every step rather than caching pointers.
+  for (size_t i = 0; i < map->overflow_count; i++) {
+    if (map->overflow_values[i]) {
+      f(user_data, map->overflow_keys[i], map->overflow_values[i]);
+    }
+  }
+  if (map->count == 0) return;
+  for (uint32_t idx = map->base; idx <= (map->last_key >> map->shift); idx++) {
+    const size_t slot = idx & (map->capacity - 1);
+    void* value = map->values[slot];
+    if (value != nullptr && (map->keys[slot] >> map->shift) == idx) {
+      f(user_data, map->keys[slot], value);
     }
+    if (map->count == 0) return;
   }
 }
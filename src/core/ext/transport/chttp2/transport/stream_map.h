@@ -26,16 +26,38 @@
 
 // Data structure to map a uint32_t to a data object (represented by a void*)
 
-// Represented as a sorted array of keys, and a corresponding array of values.
-// Lookups are performed with binary search.
-// Adds are restricted to strictly higher keys than previously seen (this is
-// guaranteed by http2).
+// Optimized for http2 stream ids: adds are restricted to strictly higher keys
+// than previously seen (this is guaranteed by http2), and all ids on one
+// connection share a parity (odd for client initiated streams).
+//
+// Entries live in a power-of-two ring of slots indexed by
+// (key >> shift) & (capacity - 1). The ring covers the window of keys between
+// the oldest live entry and the most recently added one, so consecutive ids
+// land in consecutive slots and lookups are a single probe. When the window
+// outgrows the ring we either double the ring (if it is densely populated) or
+// move the oldest entries (typically long lived streams) to a small sorted
+// overflow array that is searched with binary search.
 struct grpc_chttp2_stream_map {
+  // ring of slots: a slot is occupied iff its value is non-null
   uint32_t* keys;
   void** values;
+  // number of occupied slots in the ring
   size_t count;
-  size_t free;
+  // number of slots in the ring (a power of two)
   size_t capacity;
+  // (key >> shift) of the oldest entry in the ring
+  uint32_t base;
+  // most recently added key
+  uint32_t last_key;
+  // 1 while every key shares a parity, 0 otherwise
+  uint32_t shift;
+  // entries evicted from the ring, sorted by key; deleted entries are nulled
+  // and compacted lazily
+  uint32_t* overflow_keys;
+  void** overflow_values;
+  size_t overflow_count;
+  size_t overflow_free;
+  size_t overflow_capacity;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -242,6 +242,21 @@ static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
   return 1024 * 1024;
 }
 
+// How many DATA bytes a stream may send each time the writer visits it before
+// yielding to the next writable stream: one maximally sized frame, so that
+// queued messages are coalesced into full frames while streams sharing the
+// connection are served round robin by bytes rather than by messages.
+static int64_t write_quantum(grpc_chttp2_transport* t,
+                             grpc_chttp2_stream* s) {
+  // One frame per visit at the default weight, scaled by the stream's weight;
+  // never less than a single (small) frame so light streams still progress.
+  const int64_t frame_size =
+      t->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE];
+  return std::max(frame_size * s->write_weight /
+                      grpc_core::GrpcStreamWeight::kDefault,
+                  int64_t{1024});
+}
+
 namespace {
 
 class CountDefaultMetadataEncoder {
@@ -414,6 +429,7 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     sfc_upd_.SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    s_->write_credit -= send_bytes;
   }
 
   bool is_last_frame() const { return is_last_frame_; }
@@ -463,6 +479,12 @@ class StreamWriteContext {
         is_default_initial_metadata(s_->send_initial_metadata)) {
       ConvertInitialMetadataToTrailingMetadata();
     } else {
+      // Only clients advertise a weight; servers follow the client's.
+      const uint32_t stream_weight =
+          t_->is_client &&
+                  s_->write_weight != grpc_core::GrpcStreamWeight::kDefault
+              ? s_->write_weight
+              : 0;
       t_->hpack_compressor.EncodeHeaders(
           grpc_core::HPackCompressor::EncodeHeaderOptions{
               s_->id,  // stream_id
@@ -474,7 +496,8 @@ class StreamWriteContext {
               t_->settings
                   [GRPC_PEER_SETTINGS]
                   [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],  // max_frame_size
-              &s_->stats.outgoing                         // stats
+              &s_->stats.outgoing,                        // stats
+              stream_weight                               // stream_weight
           },
           *s_->send_initial_metadata, &t_->outbuf);
       grpc_chttp2_reset_ping_clock(t_);
@@ -525,10 +548,13 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
+    s_->write_credit += write_quantum(t_, s_);
     while (s_->flow_controlled_buffer.length > 0 &&
-           data_send_context.max_outgoing() > 0) {
+           data_send_context.max_outgoing() > 0 && s_->write_credit > 0) {
       data_send_context.FlushBytes();
     }
+    // Idle streams don't get to bank credit for later.
+    if (s_->flow_controlled_buffer.length == 0) s_->write_credit = 0;
     grpc_chttp2_reset_ping_clock(t_);
     if (data_send_context.is_last_frame()) {
       SentLastFrame();
@@ -0,0 +1,67 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     envoy/extensions/load_balancing_policies/least_request/v3/least_request.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#include <stddef.h>
+#include "upb/collections/array_internal.h"
+#include "upb/message/internal.h"
+#include "upb/mini_table/enum_internal.h"
+#include "envoy/extensions/load_balancing_policies/least_request/v3/least_request.upb.h"
+#include "envoy/config/core/v3/base.upb.h"
+#include "envoy/extensions/load_balancing_policies/common/v3/common.upb.h"
+#include "google/protobuf/wrappers.upb.h"
+#include "udpa/annotations/status.upb.h"
+#include "validate/validate.upb.h"
+
+// Must be last.
+#include "upb/port/def.inc"
+
+static const upb_MiniTableSub envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_submsgs[4] = {
+  {.submsg = &google_protobuf_UInt32Value_msg_init},
+  {.submsg = &envoy_config_core_v3_RuntimeDouble_msg_init},
+  {.submsg = &envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig_msg_init},
+  {.submsg = &envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig_msg_init},
+};
+
+static const upb_MiniTableField envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest__fields[4] = {
+  {1, UPB_SIZE(4, 8), 1, 0, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)},
+  {2, UPB_SIZE(8, 16), 2, 1, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)},
+  {3, UPB_SIZE(12, 24), 3, 2, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)},
+  {4, UPB_SIZE(16, 32), 4, 3, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)},
+};
+
+const upb_MiniTable envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init = {
+  &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_submsgs[0],
+  &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest__fields[0],
+  UPB_SIZE(24, 40), 4, kUpb_ExtMode_NonExtendable, 4, UPB_FASTTABLE_MASK(56), 0,
+  UPB_FASTTABLE_INIT({
+    {0x0000000000000000, &_upb_FastDecoder_DecodeGeneric},
+    {0x000800000100000a, &upb_psm_1bt_maxmaxb},
+    {0x0010000002010012, &upb_psm_1bt_maxmaxb},
+    {0x001800000302001a, &upb_psm_1bt_maxmaxb},
+    {0x0020000004030022, &upb_psm_1bt_maxmaxb},
+    {0x0000000000000000, &_upb_FastDecoder_DecodeGeneric},
+    {0x0000000000000000, &_upb_FastDecoder_DecodeGeneric},
+    {0x0000000000000000, &_upb_FastDecoder_DecodeGeneric},
+  })
+};
+
+static const upb_MiniTable *messages_layout[1] = {
+  &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init,
+};
+
+const upb_MiniTableFile envoy_extensions_load_balancing_policies_least_request_v3_least_request_proto_upb_file_layout = {
+  messages_layout,
+  NULL,
+  NULL,
+  1,
+  0,
+  0,
+};
+
+#include "upb/port/undef.inc"
+
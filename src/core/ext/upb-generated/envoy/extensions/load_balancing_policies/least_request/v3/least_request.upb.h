@@ -0,0 +1,194 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     envoy/extensions/load_balancing_policies/least_request/v3/least_request.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#ifndef ENVOY_EXTENSIONS_LOAD_BALANCING_POLICIES_LEAST_REQUEST_V3_LEAST_REQUEST_PROTO_UPB_H_
+#define ENVOY_EXTENSIONS_LOAD_BALANCING_POLICIES_LEAST_REQUEST_V3_LEAST_REQUEST_PROTO_UPB_H_
+
+#include "upb/collections/array_internal.h"
+#include "upb/collections/map_gencode_util.h"
+#include "upb/message/accessors.h"
+#include "upb/message/internal.h"
+#include "upb/mini_table/enum_internal.h"
+#include "upb/wire/decode.h"
+#include "upb/wire/decode_fast.h"
+#include "upb/wire/encode.h"
+
+// Must be last. 
+#include "upb/port/def.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest;
+extern const upb_MiniTable envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init;
+struct envoy_config_core_v3_RuntimeDouble;
+struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig;
+struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig;
+struct google_protobuf_UInt32Value;
+extern const upb_MiniTable envoy_config_core_v3_RuntimeDouble_msg_init;
+extern const upb_MiniTable envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig_msg_init;
+extern const upb_MiniTable envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig_msg_init;
+extern const upb_MiniTable google_protobuf_UInt32Value_msg_init;
+
+
+
+/* envoy.extensions.load_balancing_policies.least_request.v3.LeastRequest */
+
+UPB_INLINE envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_new(upb_Arena* arena) {
+  return (envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest*)_upb_Message_New(&envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init, arena);
+}
+UPB_INLINE envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_parse(const char* buf, size_t size, upb_Arena* arena) {
+  envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* ret = envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_new(arena);
+  if (!ret) return NULL;
+  if (upb_Decode(buf, size, ret, &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init, NULL, 0, arena) != kUpb_DecodeStatus_Ok) {
+    return NULL;
+  }
+  return ret;
+}
+UPB_INLINE envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_parse_ex(const char* buf, size_t size,
+                           const upb_ExtensionRegistry* extreg,
+                           int options, upb_Arena* arena) {
+  envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* ret = envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_new(arena);
+  if (!ret) return NULL;
+  if (upb_Decode(buf, size, ret, &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init, extreg, options, arena) !=
+      kUpb_DecodeStatus_Ok) {
+    return NULL;
+  }
+  return ret;
+}
+UPB_INLINE char* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_serialize(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, upb_Arena* arena, size_t* len) {
+  char* ptr;
+  (void)upb_Encode(msg, &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init, 0, arena, &ptr, len);
+  return ptr;
+}
+UPB_INLINE char* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_serialize_ex(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, int options,
+                                 upb_Arena* arena, size_t* len) {
+  char* ptr;
+  (void)upb_Encode(msg, &envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_msg_init, options, arena, &ptr, len);
+  return ptr;
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_clear_choice_count(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {1, UPB_SIZE(4, 8), 1, 0, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_ClearNonExtensionField(msg, &field);
+}
+UPB_INLINE const struct google_protobuf_UInt32Value* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_choice_count(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const struct google_protobuf_UInt32Value* default_val = NULL;
+  const struct google_protobuf_UInt32Value* ret;
+  const upb_MiniTableField field = {1, UPB_SIZE(4, 8), 1, 0, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_GetNonExtensionField(msg, &field, &default_val, &ret);
+  return ret;
+}
+UPB_INLINE bool envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_has_choice_count(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {1, UPB_SIZE(4, 8), 1, 0, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  return _upb_Message_HasNonExtensionField(msg, &field);
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_clear_active_request_bias(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {2, UPB_SIZE(8, 16), 2, 1, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_ClearNonExtensionField(msg, &field);
+}
+UPB_INLINE const struct envoy_config_core_v3_RuntimeDouble* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_active_request_bias(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const struct envoy_config_core_v3_RuntimeDouble* default_val = NULL;
+  const struct envoy_config_core_v3_RuntimeDouble* ret;
+  const upb_MiniTableField field = {2, UPB_SIZE(8, 16), 2, 1, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_GetNonExtensionField(msg, &field, &default_val, &ret);
+  return ret;
+}
+UPB_INLINE bool envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_has_active_request_bias(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {2, UPB_SIZE(8, 16), 2, 1, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  return _upb_Message_HasNonExtensionField(msg, &field);
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_clear_slow_start_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {3, UPB_SIZE(12, 24), 3, 2, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_ClearNonExtensionField(msg, &field);
+}
+UPB_INLINE const struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_slow_start_config(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* default_val = NULL;
+  const struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* ret;
+  const upb_MiniTableField field = {3, UPB_SIZE(12, 24), 3, 2, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_GetNonExtensionField(msg, &field, &default_val, &ret);
+  return ret;
+}
+UPB_INLINE bool envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_has_slow_start_config(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {3, UPB_SIZE(12, 24), 3, 2, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  return _upb_Message_HasNonExtensionField(msg, &field);
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_clear_locality_lb_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {4, UPB_SIZE(16, 32), 4, 3, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_ClearNonExtensionField(msg, &field);
+}
+UPB_INLINE const struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_locality_lb_config(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* default_val = NULL;
+  const struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* ret;
+  const upb_MiniTableField field = {4, UPB_SIZE(16, 32), 4, 3, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_GetNonExtensionField(msg, &field, &default_val, &ret);
+  return ret;
+}
+UPB_INLINE bool envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_has_locality_lb_config(const envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg) {
+  const upb_MiniTableField field = {4, UPB_SIZE(16, 32), 4, 3, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  return _upb_Message_HasNonExtensionField(msg, &field);
+}
+
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_choice_count(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest *msg, struct google_protobuf_UInt32Value* value) {
+  const upb_MiniTableField field = {1, UPB_SIZE(4, 8), 1, 0, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_SetNonExtensionField(msg, &field, &value);
+}
+UPB_INLINE struct google_protobuf_UInt32Value* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_mutable_choice_count(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, upb_Arena* arena) {
+  struct google_protobuf_UInt32Value* sub = (struct google_protobuf_UInt32Value*)envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_choice_count(msg);
+  if (sub == NULL) {
+    sub = (struct google_protobuf_UInt32Value*)_upb_Message_New(&google_protobuf_UInt32Value_msg_init, arena);
+    if (sub) envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_choice_count(msg, sub);
+  }
+  return sub;
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_active_request_bias(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest *msg, struct envoy_config_core_v3_RuntimeDouble* value) {
+  const upb_MiniTableField field = {2, UPB_SIZE(8, 16), 2, 1, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_SetNonExtensionField(msg, &field, &value);
+}
+UPB_INLINE struct envoy_config_core_v3_RuntimeDouble* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_mutable_active_request_bias(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, upb_Arena* arena) {
+  struct envoy_config_core_v3_RuntimeDouble* sub = (struct envoy_config_core_v3_RuntimeDouble*)envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_active_request_bias(msg);
+  if (sub == NULL) {
+    sub = (struct envoy_config_core_v3_RuntimeDouble*)_upb_Message_New(&envoy_config_core_v3_RuntimeDouble_msg_init, arena);
+    if (sub) envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_active_request_bias(msg, sub);
+  }
+  return sub;
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_slow_start_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest *msg, struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* value) {
+  const upb_MiniTableField field = {3, UPB_SIZE(12, 24), 3, 2, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_SetNonExtensionField(msg, &field, &value);
+}
+UPB_INLINE struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_mutable_slow_start_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, upb_Arena* arena) {
+  struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig* sub = (struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig*)envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_slow_start_config(msg);
+  if (sub == NULL) {
+    sub = (struct envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig*)_upb_Message_New(&envoy_extensions_load_balancing_policies_common_v3_SlowStartConfig_msg_init, arena);
+    if (sub) envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_slow_start_config(msg, sub);
+  }
+  return sub;
+}
+UPB_INLINE void envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_locality_lb_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest *msg, struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* value) {
+  const upb_MiniTableField field = {4, UPB_SIZE(16, 32), 4, 3, 11, kUpb_FieldMode_Scalar | (UPB_SIZE(kUpb_FieldRep_4Byte, kUpb_FieldRep_8Byte) << kUpb_FieldRep_Shift)};
+  _upb_Message_SetNonExtensionField(msg, &field, &value);
+}
+UPB_INLINE struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_mutable_locality_lb_config(envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest* msg, upb_Arena* arena) {
+  struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig* sub = (struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig*)envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_locality_lb_config(msg);
+  if (sub == NULL) {
+    sub = (struct envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig*)_upb_Message_New(&envoy_extensions_load_balancing_policies_common_v3_LocalityLbConfig_msg_init, arena);
+    if (sub) envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_set_locality_lb_config(msg, sub);
+  }
+  return sub;
+}
+
+extern const upb_MiniTableFile envoy_extensions_load_balancing_policies_least_request_v3_least_request_proto_upb_file_layout;
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#include "upb/port/undef.inc"
+
+#endif  /* ENVOY_EXTENSIONS_LOAD_BALANCING_POLICIES_LEAST_REQUEST_V3_LEAST_REQUEST_PROTO_UPB_H_ */
@@ -79,6 +79,15 @@ bool XdsOverrideHostEnabled() {
   return parse_succeeded && parsed_value;
 }
 
+// Remove once least_request is no longer experimental.
+bool XdsLeastRequestEnabled() {
+  auto value = GetEnv("GRPC_EXPERIMENTAL_ENABLE_LEAST_REQUEST");
+  if (!value.has_value()) return false;
+  bool parsed_value;
+  bool parse_succeeded = gpr_parse_bool_value(value->c_str(), &parsed_value);
+  return parse_succeeded && parsed_value;
+}
+
 //
 // XdsClusterResource
 //
@@ -362,6 +371,40 @@ void ParseLbPolicyConfig(const XdsResourceType::DecodeContext& context,
              })},
         }),
     };
+  } else if (XdsLeastRequestEnabled() &&
+             envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
+                 envoy_config_cluster_v3_Cluster_LEAST_REQUEST) {
+    // Record least request lb config
+    auto* least_request_config =
+        envoy_config_cluster_v3_Cluster_least_request_lb_config(cluster);
+    uint32_t choice_count = 2;
+    if (least_request_config != nullptr) {
+      const google_protobuf_UInt32Value* uint32_value =
+          envoy_config_cluster_v3_Cluster_LeastRequestLbConfig_choice_count(
+              least_request_config);
+      if (uint32_value != nullptr) {
+        ValidationErrors::ScopedField field(
+            errors, ".least_request_lb_config.choice_count");
+        choice_count = google_protobuf_UInt32Value_value(uint32_value);
+        if (choice_count < 2) errors->AddError("must be at least 2");
+      }
+    }
+    cds_update->lb_policy_config = {
+        Json::FromObject({
+            {"xds_wrr_locality_experimental",
+             Json::FromObject({
+                 {"childPolicy",
+                  Json::FromArray({
+                      Json::FromObject({
+                          {"least_request",
+                           Json::FromObject({
+                               {"choiceCount", Json::FromNumber(choice_count)},
+                           })},
+                      }),
+                  })},
+             })},
+        }),
+    };
   } else if (envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
              envoy_config_cluster_v3_Cluster_RING_HASH) {
     // Record ring hash lb config
@@ -49,6 +49,9 @@ namespace grpc_core {
 
 bool XdsOverrideHostEnabled();
 
+// Remove once least_request is no longer experimental.
+bool XdsLeastRequestEnabled();
+
 struct XdsClusterResource : public XdsResourceType::ResourceData {
   struct Eds {
     // If empty, defaults to the cluster name.
@@ -219,6 +219,11 @@ const grpc_channel_filter* XdsHttpFaultFilter::channel_filter() const {
   return &FaultInjectionFilter::kFilter;
 }
 
+XdsHttpFilterImpl::NoopCheck
+XdsHttpFaultFilter::channel_filter_noop_check() const {
+  return &FaultInjectionFilter::IsNoopForMethod;
+}
+
 ChannelArgs XdsHttpFaultFilter::ModifyChannelArgs(
     const ChannelArgs& args) const {
   return args.Set(GRPC_ARG_PARSE_FAULT_INJECTION_METHOD_CONFIG, 1);
@@ -19,6 +19,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -39,6 +41,7 @@
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/json/json_writer.h"
+#include "src/core/lib/service_config/service_config_parser.h"
 
 namespace grpc_core {
 
@@ -98,6 +101,17 @@ class XdsHttpFilterImpl {
   // C-core channel filter implementation.
   virtual const grpc_channel_filter* channel_filter() const = 0;
 
+  // Tells whether an instance of the channel filter has nothing to do for
+  // calls with the given method config. The instance is the filter's
+  // grpc_channel_stack_filter_instance_number() in the stack.
+  using NoopCheck = bool (*)(
+      const ServiceConfigParser::ParsedConfigVector* method_configs,
+      size_t instance);
+
+  // Returns the filter's NoopCheck, which lets a client leave the filter out
+  // of calls it has nothing to do for, or null if it always has work to do.
+  virtual NoopCheck channel_filter_noop_check() const { return nullptr; }
+
   // Modifies channel args that may affect service config parsing (not
   // visible to the channel as a whole).
   virtual ChannelArgs ModifyChannelArgs(const ChannelArgs& args) const {
@@ -203,6 +203,11 @@ const grpc_channel_filter* XdsHttpStatefulSessionFilter::channel_filter()
   return &StatefulSessionFilter::kFilter;
 }
 
+XdsHttpFilterImpl::NoopCheck
+XdsHttpStatefulSessionFilter::channel_filter_noop_check() const {
+  return &StatefulSessionFilter::IsNoopForMethod;
+}
+
 ChannelArgs XdsHttpStatefulSessionFilter::ModifyChannelArgs(
     const ChannelArgs& args) const {
   return args.Set(GRPC_ARG_PARSE_STATEFUL_SESSION_METHOD_CONFIG, 1);
@@ -29,12 +29,14 @@
 #include "absl/types/variant.h"
 #include "envoy/config/core/v3/extension.upb.h"
 #include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.upb.h"
+#include "envoy/extensions/load_balancing_policies/least_request/v3/least_request.upb.h"
 #include "envoy/extensions/load_balancing_policies/ring_hash/v3/ring_hash.upb.h"
 #include "envoy/extensions/load_balancing_policies/wrr_locality/v3/wrr_locality.upb.h"
 #include "google/protobuf/wrappers.upb.h"
 
 #include <grpc/support/json.h>
 
+#include "src/core/ext/xds/xds_cluster.h"
 #include "src/core/ext/xds/xds_common_types.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/gprpp/time.h"
@@ -63,6 +65,46 @@ class RoundRobinLbPolicyConfigFactory
   }
 };
 
+class LeastRequestLbPolicyConfigFactory
+    : public XdsLbPolicyRegistry::ConfigFactory {
+ public:
+  Json::Object ConvertXdsLbPolicyConfig(
+      const XdsLbPolicyRegistry* /*registry*/,
+      const XdsResourceType::DecodeContext& context,
+      absl::string_view configuration, ValidationErrors* errors,
+      int /*recursion_depth*/) override {
+    const auto* resource =
+        envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_parse(
+            configuration.data(), configuration.size(), context.arena);
+    if (resource == nullptr) {
+      errors->AddError("can't decode LeastRequest LB policy config");
+      return {};
+    }
+    // choice_count
+    uint32_t choice_count = 2;
+    const auto* choice_count_wrapper =
+        envoy_extensions_load_balancing_policies_least_request_v3_LeastRequest_choice_count(
+            resource);
+    if (choice_count_wrapper != nullptr) {
+      choice_count = google_protobuf_UInt32Value_value(choice_count_wrapper);
+      if (choice_count < 2) {
+        ValidationErrors::ScopedField field(errors, ".choice_count");
+        errors->AddError("must be at least 2");
+      }
+    }
+    return Json::Object{
+        {"least_request",
+         Json::FromObject({{"choiceCount", Json::FromNumber(choice_count)}})}};
+  }
+
+  absl::string_view type() override { return Type(); }
+
+  static absl::string_view Type() {
+    return "envoy.extensions.load_balancing_policies.least_request.v3."
+           "LeastRequest";
+  }
+};
+
 class ClientSideWeightedRoundRobinLbPolicyConfigFactory
     : public XdsLbPolicyRegistry::ConfigFactory {
  public:
@@ -267,6 +309,11 @@ XdsLbPolicyRegistry::XdsLbPolicyRegistry() {
   policy_config_factories_.emplace(
       RoundRobinLbPolicyConfigFactory::Type(),
       std::make_unique<RoundRobinLbPolicyConfigFactory>());
+  if (XdsLeastRequestEnabled()) {
+    policy_config_factories_.emplace(
+        LeastRequestLbPolicyConfigFactory::Type(),
+        std::make_unique<LeastRequestLbPolicyConfigFactory>());
+  }
   policy_config_factories_.emplace(
       ClientSideWeightedRoundRobinLbPolicyConfigFactory::Type(),
       std::make_unique<ClientSideWeightedRoundRobinLbPolicyConfigFactory>());
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <string>
 
 #include "absl/status/status.h"
@@ -84,6 +86,46 @@ class CallTracerInterface : public CallTracerAnnotationInterface {
   virtual void RecordReceivedDecompressedMessage(
       const SliceBuffer& recv_decompressed_message) = 0;
   virtual void RecordCancel(grpc_error_handle cancel_error) = 0;
+
+  // Entry points used by the call stack for per-message events. Message
+  // counts are always kept here, but the virtual Record*Message() methods
+  // above are only invoked if the tracer has asked for message events (see
+  // set_message_events_enabled()), so unsampled calls skip the virtual
+  // dispatch for each message.
+  void OnSendMessage(const SliceBuffer& send_message) {
+    ++sent_message_count_;
+    if (message_events_enabled_) RecordSendMessage(send_message);
+  }
+  void OnSendCompressedMessage(const SliceBuffer& send_compressed_message) {
+    if (message_events_enabled_) {
+      RecordSendCompressedMessage(send_compressed_message);
+    }
+  }
+  void OnReceivedMessage(const SliceBuffer& recv_message) {
+    ++recv_message_count_;
+    if (message_events_enabled_) RecordReceivedMessage(recv_message);
+  }
+  void OnReceivedDecompressedMessage(
+      const SliceBuffer& recv_decompressed_message) {
+    if (message_events_enabled_) {
+      RecordReceivedDecompressedMessage(recv_decompressed_message);
+    }
+  }
+
+  uint64_t sent_message_count() const { return sent_message_count_; }
+  uint64_t recv_message_count() const { return recv_message_count_; }
+
+ protected:
+  // Implementations that make a head-based sampling decision at the start of
+  // the call can disable message events for calls that are not being traced.
+  void set_message_events_enabled(bool enabled) {
+    message_events_enabled_ = enabled;
+  }
+
+ private:
+  bool message_events_enabled_ = true;
+  uint64_t sent_message_count_ = 0;
+  uint64_t recv_message_count_ = 0;
 };
 
 // Interface for a tracer that records activities on a call. Actual attempts for
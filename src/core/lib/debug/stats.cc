@@ -27,6 +27,10 @@
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/string_util.h>
 
 namespace grpc_core {
 
@@ -41,6 +45,12 @@ std::string ArrayToJson(absl::Span<const I> values) {
   }
   return absl::StrCat("[", absl::StrJoin(parts, ","), "]");
 }
+
+// HELP lines in the Prometheus text format escape backslashes and line
+// feeds.
+std::string PrometheusHelp(absl::string_view doc) {
+  return absl::StrReplaceAll(doc, {{"\\", "\\\\"}, {"\n", "\\n"}});
+}
 }  // namespace
 
 std::string StatsAsJson(absl::Span<const uint64_t> counters,
@@ -64,5 +74,49 @@ std::string StatsAsJson(absl::Span<const uint64_t> counters,
   return absl::StrCat("{", absl::StrJoin(parts, ", "), "}");
 }
 
+std::string StatsAsPrometheus(
+    absl::Span<const uint64_t> counters,
+    absl::Span<const absl::string_view> counter_name,
+    absl::Span<const absl::string_view> counter_doc,
+    absl::Span<const HistogramView> histograms,
+    absl::Span<const absl::string_view> histogram_name,
+    absl::Span<const absl::string_view> histogram_doc) {
+  std::string out;
+  for (size_t i = 0; i < counters.size(); i++) {
+    absl::StrAppend(&out, "# HELP grpc_", counter_name[i], "_total ",
+                    PrometheusHelp(counter_doc[i]), "\n# TYPE grpc_",
+                    counter_name[i], "_total counter\ngrpc_", counter_name[i],
+                    "_total ", counters[i], "\n");
+  }
+  for (size_t i = 0; i < histograms.size(); i++) {
+    const HistogramView& h = histograms[i];
+    absl::StrAppend(&out, "# HELP grpc_", histogram_name[i], " ",
+                    PrometheusHelp(histogram_doc[i]), "\n# TYPE grpc_",
+                    histogram_name[i], " histogram\n");
+    // Bucket j holds integer values in [bucket_boundaries[j],
+    // bucket_boundaries[j + 1]); the last bucket is open ended.
+    uint64_t cumulative = 0;
+    for (int j = 0; j < h.num_buckets; j++) {
+      cumulative += h.buckets[j];
+      if (j == h.num_buckets - 1) {
+        absl::StrAppend(&out, "grpc_", histogram_name[i],
+                        "_bucket{le=\"+Inf\"} ", cumulative, "\n");
+      } else {
+        absl::StrAppend(&out, "grpc_", histogram_name[i], "_bucket{le=\"",
+                        h.bucket_boundaries[j + 1] - 1, "\"} ", cumulative,
+                        "\n");
+      }
+    }
+    absl::StrAppend(&out, "grpc_", histogram_name[i], "_count ", cumulative,
+                    "\n");
+  }
+  return out;
+}
+
 }  // namespace stats_detail
 }  // namespace grpc_core
+
+char* grpc_stats_get_prometheus_text(void) {
+  auto stats = grpc_core::global_stats().Collect();
+  return gpr_strdup(grpc_core::StatsAsPrometheus(stats.get()).c_str());
+}
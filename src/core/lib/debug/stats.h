@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,12 +40,45 @@ inline GlobalStatsCollector& global_stats() {
   return *NoDestructSingleton<GlobalStatsCollector>::Get();
 }
 
+// A point-in-time view of global_stats() that can report what changed since
+// it was taken.  Taking a snapshot sums the per-cpu shards with relaxed
+// loads, so it never blocks (or is blocked by) threads updating the stats;
+// counters racing with the read land in either this interval or the next.
+class GlobalStatsSnapshot {
+ public:
+  GlobalStatsSnapshot() : begin_(global_stats().Collect()) {}
+
+  // Stats accumulated since the snapshot was taken.
+  std::unique_ptr<GlobalStats> Delta() const {
+    return global_stats().Collect()->Diff(*begin_);
+  }
+
+  // Stats accumulated since the snapshot was taken or since the previous
+  // call to NextInterval(); the snapshot then moves forward to now.
+  std::unique_ptr<GlobalStats> NextInterval() {
+    auto now = global_stats().Collect();
+    auto delta = now->Diff(*begin_);
+    begin_ = std::move(now);
+    return delta;
+  }
+
+ private:
+  std::unique_ptr<GlobalStats> begin_;
+};
+
 namespace stats_detail {
 std::string StatsAsJson(absl::Span<const uint64_t> counters,
                         absl::Span<const absl::string_view> counter_name,
                         absl::Span<const HistogramView> histograms,
                         absl::Span<const absl::string_view> histogram_name);
-}
+std::string StatsAsPrometheus(
+    absl::Span<const uint64_t> counters,
+    absl::Span<const absl::string_view> counter_name,
+    absl::Span<const absl::string_view> counter_doc,
+    absl::Span<const HistogramView> histograms,
+    absl::Span<const absl::string_view> histogram_name,
+    absl::Span<const absl::string_view> histogram_doc);
+}  // namespace stats_detail
 
 template <typename T>
 std::string StatsAsJson(T* data) {
@@ -59,6 +93,22 @@ std::string StatsAsJson(T* data) {
       T::counter_name, histograms, T::histogram_name);
 }
 
+// Renders data in the Prometheus text exposition format: counters as
+// grpc_<name>_total and histograms as cumulative grpc_<name>_bucket series.
+template <typename T>
+std::string StatsAsPrometheus(T* data) {
+  std::vector<HistogramView> histograms;
+  for (int i = 0; i < static_cast<int>(T::Histogram::COUNT); i++) {
+    histograms.push_back(
+        data->histogram(static_cast<typename T::Histogram>(i)));
+  }
+  return stats_detail::StatsAsPrometheus(
+      absl::Span<const uint64_t>(data->counters,
+                                 static_cast<int>(T::Counter::COUNT)),
+      T::counter_name, T::counter_doc, histograms, T::histogram_name,
+      T::histogram_doc);
+}
+
 }  // namespace grpc_core
 
 #endif  // GRPC_SRC_CORE_LIB_DEBUG_STATS_H
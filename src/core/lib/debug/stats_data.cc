@@ -69,15 +69,17 @@ Histogram_80_10 operator-(const Histogram_80_10& left,
 }
 const absl::string_view
     GlobalStats::counter_name[static_cast<int>(Counter::COUNT)] = {
-        "client_calls_created",    "server_calls_created",
-        "client_channels_created", "client_subchannels_created",
-        "server_channels_created", "insecure_connections_created",
-        "syscall_write",           "syscall_read",
-        "tcp_read_alloc_8k",       "tcp_read_alloc_64k",
-        "http2_settings_writes",   "http2_pings_sent",
-        "http2_writes_begun",      "http2_transport_stalls",
-        "http2_stream_stalls",     "cq_pluck_creates",
-        "cq_next_creates",         "cq_callback_creates",
+        "client_calls_created",           "server_calls_created",
+        "client_channels_created",        "client_subchannels_created",
+        "server_channels_created",        "insecure_connections_created",
+        "syscall_write",                  "syscall_read",
+        "tcp_read_alloc_8k",              "tcp_read_alloc_64k",
+        "http2_settings_writes",          "http2_pings_sent",
+        "http2_writes_begun",             "http2_transport_stalls",
+        "http2_stream_stalls",            "cq_pluck_creates",
+        "cq_next_creates",                "cq_callback_creates",
+        "work_serializer_items_enqueued", "work_serializer_drain_handoffs",
+        "handshake_offloads",
 };
 const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     Counter::COUNT)] = {
@@ -105,12 +107,21 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     "usage)",
     "Number of completion queues created for cq_callback (indicates callback "
     "api usage)",
+    "Number of callbacks queued on a work serializer instead of run inline",
+    "Number of times a work serializer drain ran past its time slice and was "
+    "handed to the EventEngine",
+    "Number of TSI handshaker steps queued on a handshake offload pool",
 };
 const absl::string_view GlobalStats::histogram_name[static_cast<int>(
     Histogram::COUNT)] = {
-    "call_initial_size",       "tcp_write_size",      "tcp_write_iov_size",
-    "tcp_read_size",           "tcp_read_offer",      "tcp_read_offer_iov_size",
-    "http2_send_message_size", "http2_metadata_size",
+    "call_initial_size",               "tcp_write_size",
+    "tcp_write_iov_size",              "tcp_read_size",
+    "tcp_read_offer",                  "tcp_read_offer_iov_size",
+    "http2_send_message_size",         "http2_metadata_size",
+    "work_serializer_queue_depth",     "work_serializer_queue_time_us",
+    "work_serializer_items_per_drain", "work_serializer_drain_time_us",
+    "handshake_offload_queue_depth",   "handshake_offload_queue_time_us",
+    "handshake_offload_run_time_us",
 };
 const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     Histogram::COUNT)] = {
@@ -122,6 +133,16 @@ const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     "Number of byte segments offered to each syscall_read",
     "Size of messages received by HTTP2 transport",
     "Number of bytes consumed by metadata, according to HPACK accounting rules",
+    "Number of callbacks already pending on a work serializer when a callback "
+    "is queued",
+    "Microseconds a queued callback waited before running on a work serializer",
+    "Number of callbacks run each time a thread drains a work serializer",
+    "Microseconds spent each time a thread drains a work serializer",
+    "Number of handshaker steps already waiting on a handshake offload pool "
+    "when a step is queued",
+    "Microseconds a handshaker step waited for a handshake offload pool thread",
+    "Microseconds a handshake offload pool thread spent running a handshaker "
+    "step",
 };
 namespace {
 const int kStatsTable0[27] = {0,    1,     2,     4,     7,     11,   17,
@@ -220,7 +241,10 @@ GlobalStats::GlobalStats()
       http2_stream_stalls{0},
       cq_pluck_creates{0},
       cq_next_creates{0},
-      cq_callback_creates{0} {}
+      cq_callback_creates{0},
+      work_serializer_items_enqueued{0},
+      work_serializer_drain_handoffs{0},
+      handshake_offloads{0} {}
 HistogramView GlobalStats::histogram(Histogram which) const {
   switch (which) {
     default:
@@ -249,6 +273,27 @@ HistogramView GlobalStats::histogram(Histogram which) const {
     case Histogram::kHttp2MetadataSize:
       return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
                            http2_metadata_size.buckets()};
+    case Histogram::kWorkSerializerQueueDepth:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
+                           work_serializer_queue_depth.buckets()};
+    case Histogram::kWorkSerializerQueueTimeUs:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           work_serializer_queue_time_us.buckets()};
+    case Histogram::kWorkSerializerItemsPerDrain:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
+                           work_serializer_items_per_drain.buckets()};
+    case Histogram::kWorkSerializerDrainTimeUs:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           work_serializer_drain_time_us.buckets()};
+    case Histogram::kHandshakeOffloadQueueDepth:
+      return HistogramView{&Histogram_65536_26::BucketFor, kStatsTable0, 26,
+                           handshake_offload_queue_depth.buckets()};
+    case Histogram::kHandshakeOffloadQueueTimeUs:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           handshake_offload_queue_time_us.buckets()};
+    case Histogram::kHandshakeOffloadRunTimeUs:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           handshake_offload_run_time_us.buckets()};
   }
 }
 std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
@@ -288,6 +333,12 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.cq_next_creates.load(std::memory_order_relaxed);
     result->cq_callback_creates +=
         data.cq_callback_creates.load(std::memory_order_relaxed);
+    result->work_serializer_items_enqueued +=
+        data.work_serializer_items_enqueued.load(std::memory_order_relaxed);
+    result->work_serializer_drain_handoffs +=
+        data.work_serializer_drain_handoffs.load(std::memory_order_relaxed);
+    result->handshake_offloads +=
+        data.handshake_offloads.load(std::memory_order_relaxed);
     data.call_initial_size.Collect(&result->call_initial_size);
     data.tcp_write_size.Collect(&result->tcp_write_size);
     data.tcp_write_iov_size.Collect(&result->tcp_write_iov_size);
@@ -296,6 +347,20 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
     data.tcp_read_offer_iov_size.Collect(&result->tcp_read_offer_iov_size);
     data.http2_send_message_size.Collect(&result->http2_send_message_size);
     data.http2_metadata_size.Collect(&result->http2_metadata_size);
+    data.work_serializer_queue_depth.Collect(
+        &result->work_serializer_queue_depth);
+    data.work_serializer_queue_time_us.Collect(
+        &result->work_serializer_queue_time_us);
+    data.work_serializer_items_per_drain.Collect(
+        &result->work_serializer_items_per_drain);
+    data.work_serializer_drain_time_us.Collect(
+        &result->work_serializer_drain_time_us);
+    data.handshake_offload_queue_depth.Collect(
+        &result->handshake_offload_queue_depth);
+    data.handshake_offload_queue_time_us.Collect(
+        &result->handshake_offload_queue_time_us);
+    data.handshake_offload_run_time_us.Collect(
+        &result->handshake_offload_run_time_us);
   }
   return result;
 }
@@ -327,6 +392,11 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->cq_pluck_creates = cq_pluck_creates - other.cq_pluck_creates;
   result->cq_next_creates = cq_next_creates - other.cq_next_creates;
   result->cq_callback_creates = cq_callback_creates - other.cq_callback_creates;
+  result->work_serializer_items_enqueued =
+      work_serializer_items_enqueued - other.work_serializer_items_enqueued;
+  result->work_serializer_drain_handoffs =
+      work_serializer_drain_handoffs - other.work_serializer_drain_handoffs;
+  result->handshake_offloads = handshake_offloads - other.handshake_offloads;
   result->call_initial_size = call_initial_size - other.call_initial_size;
   result->tcp_write_size = tcp_write_size - other.tcp_write_size;
   result->tcp_write_iov_size = tcp_write_iov_size - other.tcp_write_iov_size;
@@ -337,6 +407,20 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->http2_send_message_size =
       http2_send_message_size - other.http2_send_message_size;
   result->http2_metadata_size = http2_metadata_size - other.http2_metadata_size;
+  result->work_serializer_queue_depth =
+      work_serializer_queue_depth - other.work_serializer_queue_depth;
+  result->work_serializer_queue_time_us =
+      work_serializer_queue_time_us - other.work_serializer_queue_time_us;
+  result->work_serializer_items_per_drain =
+      work_serializer_items_per_drain - other.work_serializer_items_per_drain;
+  result->work_serializer_drain_time_us =
+      work_serializer_drain_time_us - other.work_serializer_drain_time_us;
+  result->handshake_offload_queue_depth =
+      handshake_offload_queue_depth - other.handshake_offload_queue_depth;
+  result->handshake_offload_queue_time_us =
+      handshake_offload_queue_time_us - other.handshake_offload_queue_time_us;
+  result->handshake_offload_run_time_us =
+      handshake_offload_run_time_us - other.handshake_offload_run_time_us;
   return result;
 }
 }  // namespace grpc_core
@@ -119,6 +119,9 @@ struct GlobalStats {
     kCqPluckCreates,
     kCqNextCreates,
     kCqCallbackCreates,
+    kWorkSerializerItemsEnqueued,
+    kWorkSerializerDrainHandoffs,
+    kHandshakeOffloads,
     COUNT
   };
   enum class Histogram {
@@ -130,6 +133,13 @@ struct GlobalStats {
     kTcpReadOfferIovSize,
     kHttp2SendMessageSize,
     kHttp2MetadataSize,
+    kWorkSerializerQueueDepth,
+    kWorkSerializerQueueTimeUs,
+    kWorkSerializerItemsPerDrain,
+    kWorkSerializerDrainTimeUs,
+    kHandshakeOffloadQueueDepth,
+    kHandshakeOffloadQueueTimeUs,
+    kHandshakeOffloadRunTimeUs,
     COUNT
   };
   GlobalStats();
@@ -159,6 +169,9 @@ struct GlobalStats {
       uint64_t cq_pluck_creates;
       uint64_t cq_next_creates;
       uint64_t cq_callback_creates;
+      uint64_t work_serializer_items_enqueued;
+      uint64_t work_serializer_drain_handoffs;
+      uint64_t handshake_offloads;
     };
     uint64_t counters[static_cast<int>(Counter::COUNT)];
   };
@@ -170,6 +183,13 @@ struct GlobalStats {
   Histogram_80_10 tcp_read_offer_iov_size;
   Histogram_16777216_20 http2_send_message_size;
   Histogram_65536_26 http2_metadata_size;
+  Histogram_65536_26 work_serializer_queue_depth;
+  Histogram_16777216_20 work_serializer_queue_time_us;
+  Histogram_65536_26 work_serializer_items_per_drain;
+  Histogram_16777216_20 work_serializer_drain_time_us;
+  Histogram_65536_26 handshake_offload_queue_depth;
+  Histogram_16777216_20 handshake_offload_queue_time_us;
+  Histogram_16777216_20 handshake_offload_run_time_us;
   HistogramView histogram(Histogram which) const;
   std::unique_ptr<GlobalStats> Diff(const GlobalStats& other) const;
 };
@@ -240,6 +260,17 @@ class GlobalStatsCollector {
     data_.this_cpu().cq_callback_creates.fetch_add(1,
                                                    std::memory_order_relaxed);
   }
+  void IncrementWorkSerializerItemsEnqueued() {
+    data_.this_cpu().work_serializer_items_enqueued.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementWorkSerializerDrainHandoffs() {
+    data_.this_cpu().work_serializer_drain_handoffs.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementHandshakeOffloads() {
+    data_.this_cpu().handshake_offloads.fetch_add(1, std::memory_order_relaxed);
+  }
   void IncrementCallInitialSize(int value) {
     data_.this_cpu().call_initial_size.Increment(value);
   }
@@ -264,6 +295,27 @@ class GlobalStatsCollector {
   void IncrementHttp2MetadataSize(int value) {
     data_.this_cpu().http2_metadata_size.Increment(value);
   }
+  void IncrementWorkSerializerQueueDepth(int value) {
+    data_.this_cpu().work_serializer_queue_depth.Increment(value);
+  }
+  void IncrementWorkSerializerQueueTimeUs(int value) {
+    data_.this_cpu().work_serializer_queue_time_us.Increment(value);
+  }
+  void IncrementWorkSerializerItemsPerDrain(int value) {
+    data_.this_cpu().work_serializer_items_per_drain.Increment(value);
+  }
+  void IncrementWorkSerializerDrainTimeUs(int value) {
+    data_.this_cpu().work_serializer_drain_time_us.Increment(value);
+  }
+  void IncrementHandshakeOffloadQueueDepth(int value) {
+    data_.this_cpu().handshake_offload_queue_depth.Increment(value);
+  }
+  void IncrementHandshakeOffloadQueueTimeUs(int value) {
+    data_.this_cpu().handshake_offload_queue_time_us.Increment(value);
+  }
+  void IncrementHandshakeOffloadRunTimeUs(int value) {
+    data_.this_cpu().handshake_offload_run_time_us.Increment(value);
+  }
 
  private:
   struct Data {
@@ -285,6 +337,9 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> cq_pluck_creates{0};
     std::atomic<uint64_t> cq_next_creates{0};
     std::atomic<uint64_t> cq_callback_creates{0};
+    std::atomic<uint64_t> work_serializer_items_enqueued{0};
+    std::atomic<uint64_t> work_serializer_drain_handoffs{0};
+    std::atomic<uint64_t> handshake_offloads{0};
     HistogramCollector_65536_26 call_initial_size;
     HistogramCollector_16777216_20 tcp_write_size;
     HistogramCollector_80_10 tcp_write_iov_size;
@@ -293,6 +348,13 @@ class GlobalStatsCollector {
     HistogramCollector_80_10 tcp_read_offer_iov_size;
     HistogramCollector_16777216_20 http2_send_message_size;
     HistogramCollector_65536_26 http2_metadata_size;
+    HistogramCollector_65536_26 work_serializer_queue_depth;
+    HistogramCollector_16777216_20 work_serializer_queue_time_us;
+    HistogramCollector_65536_26 work_serializer_items_per_drain;
+    HistogramCollector_16777216_20 work_serializer_drain_time_us;
+    HistogramCollector_65536_26 handshake_offload_queue_depth;
+    HistogramCollector_16777216_20 handshake_offload_queue_time_us;
+    HistogramCollector_16777216_20 handshake_offload_run_time_us;
   };
   PerCpu<Data> data_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
 };
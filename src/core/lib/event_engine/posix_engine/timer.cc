@@ -25,6 +25,8 @@
 #include <limits>
 #include <utility>
 
+#include "absl/numeric/bits.h"
+
 #include <grpc/support/cpu.h>
 
 #include "src/core/lib/event_engine/posix_engine/timer_heap.h"
@@ -307,5 +309,221 @@ TimerList::TimerCheck(grpc_core::Timestamp* next) {
   return std::move(run);
 }
 
+//
+// TimerWheel
+//
+
+namespace {
+// Returns the index of the lowest set bit in bits that is above index
+// after, or -1 if there is none.
+int NextSetBit(uint64_t bits, size_t after) {
+  if (after + 1 >= 64) return -1;
+  bits &= ~uint64_t{0} << (after + 1);
+  return bits == 0 ? -1 : absl::countr_zero(bits);
+}
+}  // namespace
+
+TimerWheel::Shard::Shard() : current_tick(0), occupied{} {
+  for (auto& level : slots) {
+    for (Timer& head : level) head.next = head.prev = &head;
+  }
+  overflow.next = overflow.prev = &overflow;
+}
+
+void TimerWheel::Shard::Place(Timer* timer) {
+  // Timers that are already due go in the current slot.
+  const int64_t deadline = std::max(timer->deadline, current_tick);
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    // A timer belongs at the lowest level whose current rotation contains
+    // its deadline; cascading moves it down as time advances.
+    const int shift = kLevelBits * (level + 1);
+    if ((deadline >> shift) == (current_tick >> shift)) {
+      const size_t idx =
+          (deadline >> (kLevelBits * level)) & (kSlotsPerLevel - 1);
+      ListJoin(&slots[level][idx], timer);
+      occupied[level] |= uint64_t{1} << idx;
+      timer->heap_index = level * kSlotsPerLevel + idx;
+      return;
+    }
+  }
+  ListJoin(&overflow, timer);
+  timer->heap_index = kOverflowSlot;
+}
+
+void TimerWheel::Shard::Redistribute(Timer* head) {
+  Timer* timer = head->next;
+  head->next = head->prev = head;
+  while (timer != head) {
+    Timer* next = timer->next;
+    Place(timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::Shard::EnterTick(int64_t tick) {
+  const int64_t prev_tick = std::exchange(current_tick, tick);
+  constexpr int kWheelBits = kLevelBits * kNumLevels;
+  if (overflow.next != &overflow &&
+      (tick >> kWheelBits) != (prev_tick >> kWheelBits)) {
+    Redistribute(&overflow);
+  }
+  // We never skip past the start of an occupied slot, so any occupied slot
+  // that covers tick at a higher level starts exactly at tick.  Cascade from
+  // the top down, since each cascade may fill the current slot below it.
+  for (size_t level = kNumLevels - 1; level > 0; --level) {
+    const size_t idx = (tick >> (kLevelBits * level)) & (kSlotsPerLevel - 1);
+    if (occupied[level] & (uint64_t{1} << idx)) {
+      occupied[level] &= ~(uint64_t{1} << idx);
+      Redistribute(&slots[level][idx]);
+    }
+  }
+}
+
+int64_t TimerWheel::Shard::NextTickAfterCurrent() {
+  int64_t next = std::numeric_limits<int64_t>::max();
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    const int shift = kLevelBits * level;
+    const int bit = NextSetBit(occupied[level],
+                               (current_tick >> shift) & (kSlotsPerLevel - 1));
+    if (bit >= 0) {
+      const int64_t rotation_start = (current_tick >> (shift + kLevelBits))
+                                     << (shift + kLevelBits);
+      next = std::min(next, rotation_start + (int64_t{bit} << shift));
+    }
+  }
+  if (overflow.next != &overflow) {
+    constexpr int kWheelBits = kLevelBits * kNumLevels;
+    next = std::min(next, ((current_tick >> kWheelBits) + 1) << kWheelBits);
+  }
+  return next;
+}
+
+int64_t TimerWheel::Shard::NextDeadline() {
+  if (occupied[0] & (uint64_t{1} << (current_tick & (kSlotsPerLevel - 1)))) {
+    return current_tick;
+  }
+  return NextTickAfterCurrent();
+}
+
+void TimerWheel::Shard::Advance(
+    int64_t now, std::vector<experimental::EventEngine::Closure*>* out) {
+  while (current_tick <= now) {
+    const size_t idx = current_tick & (kSlotsPerLevel - 1);
+    if (occupied[0] & (uint64_t{1} << idx)) {
+      occupied[0] &= ~(uint64_t{1} << idx);
+      Timer* head = &slots[0][idx];
+      for (Timer* timer = head->next; timer != head; timer = timer->next) {
+        timer->pending = false;
+        out->push_back(timer->closure);
+      }
+      head->next = head->prev = head;
+    }
+    // Skip straight to the next slot that needs attention, or to just past
+    // now if there is nothing to do before then.
+    EnterTick(std::min(NextTickAfterCurrent(), now + 1));
+  }
+}
+
+TimerWheel::TimerWheel(TimerListHost* host)
+    : host_(host),
+      num_shards_(grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u)),
+      min_timer_(host_->Now().milliseconds_after_process_epoch()),
+      shards_(new Shard[num_shards_]) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    grpc_core::MutexLock lock(&shards_[i].mu);
+    shards_[i].current_tick = min_timer_.load(std::memory_order_relaxed);
+  }
+}
+
+void TimerWheel::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                           experimental::EventEngine::Closure* closure) {
+  Shard* shard = &shards_[grpc_core::HashPointer(timer, num_shards_)];
+  const int64_t deadline_ms = deadline.milliseconds_after_process_epoch();
+  timer->closure = closure;
+  timer->deadline = deadline_ms;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  {
+    grpc_core::MutexLock lock(&shard->mu);
+    timer->pending = true;
+    shard->Place(timer);
+  }
+  // If this timer is due before the timer thread next plans to wake up,
+  // lower the bound and kick it.  Note that the timer may already have
+  // fired and been freed by now, so we must not touch it here.
+  int64_t min_timer = min_timer_.load(std::memory_order_relaxed);
+  while (deadline_ms < min_timer) {
+    if (min_timer_.compare_exchange_weak(min_timer, deadline_ms,
+                                         std::memory_order_relaxed)) {
+      host_->Kick();
+      break;
+    }
+  }
+}
+
+bool TimerWheel::TimerCancel(Timer* timer) {
+  Shard* shard = &shards_[grpc_core::HashPointer(timer, num_shards_)];
+  grpc_core::MutexLock lock(&shard->mu);
+  if (!timer->pending) return false;
+  timer->pending = false;
+  ListRemove(timer);
+  if (timer->heap_index != kOverflowSlot) {
+    const size_t level = timer->heap_index / kSlotsPerLevel;
+    const size_t idx = timer->heap_index % kSlotsPerLevel;
+    Timer* head = &shard->slots[level][idx];
+    if (head->next == head) shard->occupied[level] &= ~(uint64_t{1} << idx);
+  }
+  return true;
+}
+
+absl::optional<std::vector<experimental::EventEngine::Closure*>>
+TimerWheel::TimerCheck(grpc_core::Timestamp* next) {
+  const int64_t now = host_->Now().milliseconds_after_process_epoch();
+  int64_t min_timer = min_timer_.load(std::memory_order_relaxed);
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next,
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+    }
+    return std::vector<experimental::EventEngine::Closure*>();
+  }
+  if (!checker_mu_.TryLock()) return absl::nullopt;
+  // The bound is stale from here until the scan below publishes a new one.
+  // Park it at "never" meanwhile: a TimerInit() that lands in a shard we have
+  // already scanned then always lowers it and kicks, rather than comparing
+  // against the old bound (which may be far below its deadline) and leaving
+  // us to publish a bound past its deadline.
+  min_timer = std::numeric_limits<int64_t>::max();
+  min_timer_.store(min_timer, std::memory_order_relaxed);
+  std::vector<experimental::EventEngine::Closure*> done;
+  int64_t new_min_timer = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard& shard = shards_[i];
+    grpc_core::MutexLock lock(&shard.mu);
+    shard.Advance(now, &done);
+    new_min_timer = std::min(new_min_timer, shard.NextDeadline());
+  }
+  // A concurrent TimerInit() may have lowered the bound during the scan; if
+  // so, keep whichever of the two is earlier.
+  while (!min_timer_.compare_exchange_weak(min_timer, new_min_timer,
+                                           std::memory_order_relaxed)) {
+    if (min_timer < new_min_timer) {
+      new_min_timer = min_timer;
+      break;
+    }
+  }
+  checker_mu_.Unlock();
+  if (next != nullptr) {
+    *next = std::min(
+        *next,
+        grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(new_min_timer));
+  }
+  return std::move(done);
+}
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
@@ -43,7 +43,8 @@ namespace experimental {
 
 struct Timer {
   int64_t deadline;
-  // kInvalidHeapIndex if not in heap.
+  // kInvalidHeapIndex if not in heap.  TimerWheel stores the timer's slot
+  // here instead.
   size_t heap_index;
   bool pending;
   struct Timer* next;
@@ -70,26 +71,24 @@ class TimerListHost {
   ~TimerListHost() = default;
 };
 
-class TimerList {
+// A collection of timers that TimerManager can drive.
+class TimerListInterface {
  public:
-  explicit TimerList(TimerListHost* host);
-
-  TimerList(const TimerList&) = delete;
-  TimerList& operator=(const TimerList&) = delete;
+  virtual ~TimerListInterface() = default;
 
   // Initialize a Timer.
   // When expired, the closure will be run. If the timer is canceled, the
   // closure will not be run. Behavior is undefined for a deadline of
   // grpc_core::Timestamp::InfFuture().
-  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
-                 experimental::EventEngine::Closure* closure);
+  virtual void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                         experimental::EventEngine::Closure* closure) = 0;
 
   // Cancel a Timer.
   // Returns false if the timer cannot be canceled. This will happen if the
   // timer has already fired, or if its closure is currently running. The
   // closure is guaranteed to run eventually if this method returns false.
   // Otherwise, this returns true, and the closure will not be run.
-  bool TimerCancel(Timer* timer) GRPC_MUST_USE_RESULT;
+  virtual bool TimerCancel(Timer* timer) GRPC_MUST_USE_RESULT = 0;
 
   // Check for timers to be run, and return them.
   // Return nullopt if timers could not be checked due to contention with
@@ -100,8 +99,22 @@ class TimerList {
   // *next is never guaranteed to be updated on any given execution; however,
   // with high probability at least one thread in the system will see an update
   // at any time slice.
+  virtual absl::optional<std::vector<experimental::EventEngine::Closure*>>
+  TimerCheck(grpc_core::Timestamp* next) = 0;
+};
+
+class TimerList final : public TimerListInterface {
+ public:
+  explicit TimerList(TimerListHost* host);
+
+  TimerList(const TimerList&) = delete;
+  TimerList& operator=(const TimerList&) = delete;
+
+  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                 experimental::EventEngine::Closure* closure) override;
+  GRPC_MUST_USE_RESULT bool TimerCancel(Timer* timer) override;
   absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
-      grpc_core::Timestamp* next);
+      grpc_core::Timestamp* next) override;
 
  private:
   // A "timer shard". Contains a 'heap' and a 'list' of timers. All timers with
@@ -161,6 +174,74 @@ class TimerList {
   const std::unique_ptr<Shard*[]> shard_queue_ ABSL_GUARDED_BY(mu_);
 };
 
+// A hierarchical timing wheel.  Timers are bucketed by deadline into slots
+// of increasing width, so TimerInit() and TimerCancel() are O(1) regardless
+// of how many timers are pending, and expired timers are collected a whole
+// slot at a time.  This suits workloads such as per-call deadlines, where
+// almost every timer is cancelled long before it would fire.  Deadlines
+// are tracked at millisecond granularity.
+class TimerWheel final : public TimerListInterface {
+ public:
+  explicit TimerWheel(TimerListHost* host);
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  void TimerInit(Timer* timer, grpc_core::Timestamp deadline,
+                 experimental::EventEngine::Closure* closure) override;
+  GRPC_MUST_USE_RESULT bool TimerCancel(Timer* timer) override;
+  absl::optional<std::vector<experimental::EventEngine::Closure*>> TimerCheck(
+      grpc_core::Timestamp* next) override;
+
+ private:
+  // Each level has 64 slots, and each slot at level L spans 64^L
+  // milliseconds, so four levels cover a little over four and a half hours.
+  // Timers further out than that wait in an overflow list.
+  static constexpr int kLevelBits = 6;
+  static constexpr size_t kSlotsPerLevel = size_t{1} << kLevelBits;
+  static constexpr size_t kNumLevels = 4;
+  static constexpr size_t kOverflowSlot = kNumLevels * kSlotsPerLevel;
+
+  struct Shard {
+    Shard();
+
+    // Adds timer to the slot that covers its deadline.
+    void Place(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Moves every timer in the list headed by head back through Place().
+    void Redistribute(Timer* head) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Sets current_tick, cascading any slots that start at tick down to
+    // lower levels.
+    void EnterTick(int64_t tick) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Returns the first tick after current_tick at which a slot needs to be
+    // expired or cascaded.
+    int64_t NextTickAfterCurrent() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Returns a lower bound on the deadline of the next timer to fire.
+    int64_t NextDeadline() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+    // Collects the closures of all timers with deadlines <= now.
+    void Advance(int64_t now,
+                 std::vector<experimental::EventEngine::Closure*>* out)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+
+    grpc_core::Mutex mu;
+    // Every tick before this one has been expired.
+    int64_t current_tick ABSL_GUARDED_BY(mu);
+    // Bit i of occupied[l] is set iff slots[l][i] is non-empty.
+    uint64_t occupied[kNumLevels] ABSL_GUARDED_BY(mu);
+    // Circular list heads for each slot.
+    Timer slots[kNumLevels][kSlotsPerLevel] ABSL_GUARDED_BY(mu);
+    // Timers whose deadlines are beyond the reach of the wheel.
+    Timer overflow ABSL_GUARDED_BY(mu);
+  };
+
+  TimerListHost* const host_;
+  const size_t num_shards_;
+  // A lower bound on the deadline of the next timer due across all shards.
+  std::atomic<int64_t> min_timer_;
+  // Allow only one TimerCheck at once.
+  grpc_core::Mutex checker_mu_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
 
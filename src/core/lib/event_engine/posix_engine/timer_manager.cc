@@ -30,6 +30,7 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/thd.h"
 
 static thread_local bool g_timer_thread;
@@ -99,7 +100,12 @@ void TimerManager::StartMainLoopThread() {
 TimerManager::TimerManager(
     std::shared_ptr<grpc_event_engine::experimental::ThreadPool> thread_pool)
     : host_(this), thread_pool_(std::move(thread_pool)) {
-  timer_list_ = std::make_unique<TimerList>(&host_);
+  // The backend is fixed for the life of the EventEngine that owns us.
+  if (grpc_core::IsTimerWheelEnabled()) {
+    timer_list_ = std::make_unique<TimerWheel>(&host_);
+  } else {
+    timer_list_ = std::make_unique<TimerList>(&host_);
+  }
   main_loop_exit_signal_.emplace();
   StartMainLoopThread();
 }
@@ -86,6 +86,14 @@ const char* const description_canary_client_privacy =
 const char* const additional_constraints_canary_client_privacy = "{}";
 const char* const description_server_privacy = "If set, server privacy";
 const char* const additional_constraints_server_privacy = "{}";
+const char* const description_timer_wheel =
+    "If set, the posix EventEngine tracks timers in a hierarchical timing "
+    "wheel instead of the sharded heap.";
+const char* const additional_constraints_timer_wheel = "{}";
+const char* const description_work_serializer_time_slice =
+    "If set, a thread draining a WorkSerializer hands the rest of the queue to "
+    "the EventEngine once it has run callbacks for more than a millisecond.";
+const char* const additional_constraints_work_serializer_time_slice = "{}";
 }  // namespace
 
 namespace grpc_core {
@@ -132,6 +140,10 @@ const ExperimentMetadata g_experiment_metadata[] = {
      additional_constraints_canary_client_privacy, false, false},
     {"server_privacy", description_server_privacy,
      additional_constraints_server_privacy, false, false},
+    {"timer_wheel", description_timer_wheel,
+     additional_constraints_timer_wheel, false, false},
+    {"work_serializer_time_slice", description_work_serializer_time_slice,
+     additional_constraints_work_serializer_time_slice, false, true},
 };
 
 }  // namespace grpc_core
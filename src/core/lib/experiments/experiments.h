@@ -77,6 +77,8 @@ inline bool IsWorkStealingEnabled() { return false; }
 inline bool IsClientPrivacyEnabled() { return false; }
 inline bool IsCanaryClientPrivacyEnabled() { return false; }
 inline bool IsServerPrivacyEnabled() { return false; }
+inline bool IsTimerWheelEnabled() { return false; }
+inline bool IsWorkSerializerTimeSliceEnabled() { return false; }
 #else
 #define GRPC_EXPERIMENT_IS_INCLUDED_TCP_FRAME_SIZE_TUNING
 inline bool IsTcpFrameSizeTuningEnabled() { return IsExperimentEnabled(0); }
@@ -124,8 +126,14 @@ inline bool IsClientPrivacyEnabled() { return IsExperimentEnabled(16); }
 inline bool IsCanaryClientPrivacyEnabled() { return IsExperimentEnabled(17); }
 #define GRPC_EXPERIMENT_IS_INCLUDED_SERVER_PRIVACY
 inline bool IsServerPrivacyEnabled() { return IsExperimentEnabled(18); }
+#define GRPC_EXPERIMENT_IS_INCLUDED_TIMER_WHEEL
+inline bool IsTimerWheelEnabled() { return IsExperimentEnabled(19); }
+#define GRPC_EXPERIMENT_IS_INCLUDED_WORK_SERIALIZER_TIME_SLICE
+inline bool IsWorkSerializerTimeSliceEnabled() {
+  return IsExperimentEnabled(20);
+}
 
-constexpr const size_t kNumExperiments = 19;
+constexpr const size_t kNumExperiments = 21;
 extern const ExperimentMetadata g_experiment_metadata[kNumExperiments];
 
 #endif
@@ -25,23 +25,52 @@
 #include <memory>
 #include <utility>
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
+namespace {
+
+// With the work_serializer_time_slice experiment, a thread that has been
+// draining a WorkSerializer for longer than this hands the rest of the
+// queue to the EventEngine rather than keep running other callers' work.
+constexpr int64_t kDrainTimeSliceUs = 1000;
+
+int64_t MicrosSince(gpr_timespec start) {
+  return static_cast<int64_t>(gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+}
+
+// The stats are sharded per CPU by way of the ExecCtx, which callers
+// normally have but aren't required to.
+bool StatsAvailable() { return ExecCtx::Get() != nullptr; }
+
+}  // namespace
+
 //
 // WorkSerializer::WorkSerializerImpl
 //
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
+  explicit WorkSerializerImpl(
+      std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+          event_engine)
+      : event_engine_(std::move(event_engine)) {}
+
   void Run(std::function<void()> callback, const DebugLocation& location);
   void Schedule(std::function<void()> callback, const DebugLocation& location);
   void DrainQueue();
@@ -50,13 +79,20 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
  private:
   struct CallbackWrapper {
     CallbackWrapper(std::function<void()> cb, const DebugLocation& loc)
-        : callback(std::move(cb)), location(loc) {}
+        : callback(std::move(cb)),
+          location(loc),
+          enqueue_time(gpr_now(GPR_CLOCK_MONOTONIC)) {}
 
     MultiProducerSingleConsumerQueue::Node mpscq_node;
     const std::function<void()> callback;
     const DebugLocation location;
+    const gpr_timespec enqueue_time;
   };
 
+  // Pushes a callback that could not run inline.  prev_ref_pair is the value
+  // of refs_ before the callback was counted.
+  void Enqueue(CallbackWrapper* cb_wrapper, uint64_t prev_ref_pair);
+
   // Callers of DrainQueueOwned should make sure to grab the lock on the
   // workserializer with
   //
@@ -69,6 +105,10 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // the lock to the work serializer.
   void DrainQueueOwned();
 
+  // Continues DrainQueueOwned() on an EventEngine thread, keeping ownership
+  // of the WorkSerializer in the meantime.
+  void HandOffDrain();
+
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
   static uint64_t MakeRefPair(uint16_t owners, uint64_t size) {
@@ -86,6 +126,9 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  // Where a long drain is handed off to.  May be null.
+  const std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+      event_engine_;
 };
 
 void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
@@ -116,7 +159,7 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Scheduling on queue : item %p", cb_wrapper);
     }
-    queue_.Push(&cb_wrapper->mpscq_node);
+    Enqueue(cb_wrapper, prev_ref_pair);
   }
 }
 
@@ -129,7 +172,19 @@ void WorkSerializer::WorkSerializerImpl::Schedule(
             "WorkSerializer::Schedule() %p Scheduling callback %p [%s:%d]",
             this, cb_wrapper, location.file(), location.line());
   }
-  refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  const uint64_t prev_ref_pair =
+      refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  Enqueue(cb_wrapper, prev_ref_pair);
+}
+
+void WorkSerializer::WorkSerializerImpl::Enqueue(CallbackWrapper* cb_wrapper,
+                                                 uint64_t prev_ref_pair) {
+  if (StatsAvailable()) {
+    global_stats().IncrementWorkSerializerItemsEnqueued();
+    // Don't count the extra ref that tracks orphaning.
+    global_stats().IncrementWorkSerializerQueueDepth(
+        static_cast<int>(GetSize(prev_ref_pair) - 1));
+  }
   queue_.Push(&cb_wrapper->mpscq_node);
 }
 
@@ -173,6 +228,16 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
+  const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  int items = 0;
+  // Called whenever this thread stops draining, before `this` may be gone.
+  auto record_drain = [start, &items]() {
+    if (StatsAvailable()) {
+      global_stats().IncrementWorkSerializerItemsPerDrain(items);
+      global_stats().IncrementWorkSerializerDrainTimeUs(
+          static_cast<int>(MicrosSince(start)));
+    }
+  };
   while (true) {
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
@@ -181,6 +246,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
         gpr_log(GPR_INFO, "  Queue Drained. Destroying");
       }
+      record_drain();
       delete this;
       return;
     }
@@ -190,6 +256,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
                                         std::memory_order_acq_rel)) {
         // Queue is drained.
+        record_drain();
         return;
       }
       if (GetSize(expected) == 0) {
@@ -197,6 +264,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
         if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
           gpr_log(GPR_INFO, "  Queue Drained. Destroying");
         }
+        record_drain();
         delete this;
         return;
       }
@@ -218,17 +286,47 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
+    if (StatsAvailable()) {
+      global_stats().IncrementWorkSerializerQueueTimeUs(
+          static_cast<int>(MicrosSince(cb_wrapper->enqueue_time)));
+    }
     cb_wrapper->callback();
     delete cb_wrapper;
+    ++items;
+    // Only hand off if there's more work queued behind the callback that
+    // just ran; otherwise finishing up here is cheaper than a thread hop.
+    if (event_engine_ != nullptr && IsWorkSerializerTimeSliceEnabled() &&
+        GetSize(refs_.load(std::memory_order_acquire)) > 2 &&
+        MicrosSince(start) > kDrainTimeSliceUs) {
+      record_drain();
+      HandOffDrain();
+      return;
+    }
+  }
+}
+
+void WorkSerializer::WorkSerializerImpl::HandOffDrain() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO, "  Time slice used up, handing off to EventEngine");
   }
+  if (StatsAvailable()) global_stats().IncrementWorkSerializerDrainHandoffs();
+  // The ref for the callback that just ran is still held, as
+  // DrainQueueOwned() expects on entry, so the WorkSerializer can't be
+  // destroyed before the EventEngine picks it up.
+  event_engine_->Run([this]() {
+    ApplicationCallbackExecCtx app_exec_ctx;
+    ExecCtx exec_ctx;
+    DrainQueueOwned();
+  });
 }
 
 //
 // WorkSerializer
 //
 
-WorkSerializer::WorkSerializer()
-    : impl_(MakeOrphanable<WorkSerializerImpl>()) {}
+WorkSerializer::WorkSerializer(
+    std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine)
+    : impl_(MakeOrphanable<WorkSerializerImpl>(std::move(event_engine))) {}
 
 WorkSerializer::~WorkSerializer() {}
 
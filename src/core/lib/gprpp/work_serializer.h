@@ -20,9 +20,12 @@
 #include <grpc/support/port_platform.h>
 
 #include <functional>
+#include <memory>
 
 #include "absl/base/thread_annotations.h"
 
+#include <grpc/event_engine/event_engine.h>
+
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 
@@ -42,9 +45,16 @@ namespace grpc_core {
 // inline in Run() (for example, if a mutex lock is held and executing callbacks
 // inline would cause a deadlock), it should use Schedule() instead and then
 // invoke DrainQueue() when it is safe to invoke the callback.
+// If the WorkSerializer is given an EventEngine and the
+// work_serializer_time_slice experiment is on, a borrowed thread that has been
+// running callbacks for more than a millisecond hands the remaining ones to
+// the EventEngine and returns, so no caller is held up for long by a burst of
+// work from other threads.
 class ABSL_LOCKABLE WorkSerializer {
  public:
-  WorkSerializer();
+  explicit WorkSerializer(
+      std::shared_ptr<grpc_event_engine::experimental::EventEngine>
+          event_engine = nullptr);
 
   ~WorkSerializer();
 
@@ -19,7 +19,11 @@
 
 #include <stddef.h>
 
+#include <stdint.h>
+
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -27,6 +31,8 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -42,11 +48,35 @@ namespace mpscpipe_detail {
 
 // "Center" of the communication pipe.
 // Contains sent but not received messages, and open/close state.
+//
+// Sent items are kept in a bounded lock-free ring (after Dmitry Vyukov's
+// bounded MPMC queue, with a single consumer): sending and receiving are a
+// handful of atomic operations, and nothing is allocated after
+// construction. The mutex is only taken when the receiver or a sender has to
+// park, and wakeups are batched: senders wake the receiver only if it is
+// parked, and the receiver wakes pending senders once per batch it takes.
 template <typename T>
 class Center : public RefCounted<Center<T>> {
  public:
   // Construct the center with a maximum queue size.
-  explicit Center(size_t max_queued) : max_queued_(max_queued) {}
+  explicit Center(size_t max_queued)
+      : max_queued_(max_queued),
+        // The ring needs at least two cells to tell a full cell from an empty
+        // one; the exact bound is enforced against head_ in TryPush.
+        mask_(std::max<size_t>(2, RoundUpToPowerOf2(
+                                      static_cast<uint32_t>(max_queued))) -
+              1),
+        cells_(new Cell[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~Center() {
+    // Destroy anything that was sent but never received.
+    while (TryPop(nullptr)) {
+    }
+  }
 
   // Poll for new items.
   // - Returns true if new items were obtained, in which case they are contained
@@ -60,16 +90,35 @@ class Center : public RefCounted<Center<T>> {
   // That said, some senders may have been cancelled by the time we wake them,
   // and so waking a subset could cause starvation.
   bool PollReceiveBatch(std::vector<T>& dest) {
-    ReleasableMutexLock lock(&mu_);
-    if (queue_.empty()) {
-      receive_waker_ = Activity::current()->MakeNonOwningWaker();
-      return false;
+    if (!ItemReady()) {
+      {
+        MutexLock lock(&mu_);
+        receive_waker_ = Activity::current()->MakeNonOwningWaker();
+      }
+      receiver_parked_.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in PollSend: either the sender sees the receiver
+      // parked, or we see the item it pushed.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!ItemReady()) return false;
+      receiver_parked_.store(false, std::memory_order_relaxed);
+      MutexLock lock(&mu_);
+      receive_waker_ = Waker();
+    }
+    // Only now reuse dest: the caller may still be iterating over it if we
+    // return false.
+    dest.clear();
+    // Cap the batch so that dest stays bounded while senders keep up.
+    for (size_t i = 0; i < max_queued_ && TryPop(&dest); i++) {
+    }
+    // Pairs with the fence in PollSend: either we see the sender waiting, or
+    // it sees the space we just made.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (senders_waiting_.exchange(false, std::memory_order_relaxed)) {
+      ReleasableMutexLock lock(&mu_);
+      auto wakeups = send_wakers_.TakeWakeupSet();
+      lock.Release();
+      wakeups.Wakeup();
     }
-    dest.swap(queue_);
-    queue_.clear();
-    auto wakeups = send_wakers_.TakeWakeupSet();
-    lock.Release();
-    wakeups.Wakeup();
     return true;
   }
 
@@ -78,30 +127,113 @@ class Center : public RefCounted<Center<T>> {
   // Returns true if the item was sent.
   // Returns false if the receiver has been closed.
   Poll<bool> PollSend(T& t) {
-    ReleasableMutexLock lock(&mu_);
-    if (receiver_closed_) return Poll<bool>(false);
-    if (queue_.size() < max_queued_) {
-      queue_.push_back(std::move(t));
+    if (receiver_closed_.load(std::memory_order_acquire)) {
+      return Poll<bool>(false);
+    }
+    if (!TryPush(t)) {
+      {
+        MutexLock lock(&mu_);
+        send_wakers_.AddPending(Activity::current()->MakeNonOwningWaker());
+      }
+      senders_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // The receiver may have drained the queue before it could see us
+      // waiting: try again before giving up.
+      if (!TryPush(t)) return Pending{};
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (receiver_parked_.load(std::memory_order_relaxed) &&
+        receiver_parked_.exchange(false, std::memory_order_relaxed)) {
+      ReleasableMutexLock lock(&mu_);
       auto receive_waker = std::move(receive_waker_);
       lock.Release();
       receive_waker.Wakeup();
-      return Poll<bool>(true);
     }
-    send_wakers_.AddPending(Activity::current()->MakeNonOwningWaker());
-    return Pending{};
+    return Poll<bool>(true);
   }
 
   // Mark that the receiver is closed.
   void ReceiverClosed() {
-    MutexLock lock(&mu_);
-    receiver_closed_ = true;
+    receiver_closed_.store(true, std::memory_order_release);
   }
 
  private:
-  Mutex mu_;
+  struct Cell {
+    // Equal to the position of the cell while it is free for that position to
+    // be pushed, and to position + 1 once the item is ready to be popped.
+    std::atomic<size_t> sequence;
+    ManualConstructor<T> value;
+  };
+
+  // Try to push one item; t is left untouched if there's no room.
+  bool TryPush(T& t) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      const intptr_t queued = static_cast<intptr_t>(
+          pos - head_.load(std::memory_order_acquire));
+      if (queued < 0) {
+        // pos is stale: the receiver has already popped past it.
+        pos = tail_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (static_cast<size_t>(queued) >= max_queued_) return false;
+      Cell& cell = cells_[pos & mask_];
+      const intptr_t diff = static_cast<intptr_t>(
+          cell.sequence.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          cell.value.Init(std::move(t));
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The receiver hasn't finished with this cell yet.
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Is the item at the head of the queue ready to be popped? Only ever
+  // called by the receiver.
+  bool ItemReady() const {
+    const size_t pos = head_.load(std::memory_order_relaxed);
+    return cells_[pos & mask_].sequence.load(std::memory_order_acquire) ==
+           pos + 1;
+  }
+
+  // Try to pop one item into dest (or drop it if dest is null). Only ever
+  // called by the receiver.
+  bool TryPop(std::vector<T>* dest) {
+    if (!ItemReady()) return false;
+    const size_t pos = head_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    if (dest != nullptr) dest->push_back(std::move(*cell.value));
+    cell.value.Destroy();
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    head_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
   const size_t max_queued_;
-  std::vector<T> queue_ ABSL_GUARDED_BY(mu_);
-  bool receiver_closed_ ABSL_GUARDED_BY(mu_) = false;
+  const size_t mask_;
+  const std::unique_ptr<Cell[]> cells_;
+  // Make sure the producers' tail_ and the consumer's head_ don't share a
+  // cacheline.
+  union {
+    char tail_padding_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> tail_{0};
+  };
+  union {
+    char head_padding_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> head_{0};
+  };
+  std::atomic<bool> receiver_closed_{false};
+  std::atomic<bool> receiver_parked_{false};
+  std::atomic<bool> senders_waiting_{false};
+  Mutex mu_;
   Waker receive_waker_ ABSL_GUARDED_BY(mu_);
   WaitSet send_wakers_ ABSL_GUARDED_BY(mu_);
 };
@@ -229,6 +229,11 @@ void grpc_ssl_server_credentials::set_max_tls_version(
   config_.max_tls_version = max_tls_version;
 }
 
+void grpc_ssl_server_credentials::set_session_ticket_key_provider(
+    grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider> provider) {
+  config_.session_ticket_key_provider = std::move(provider);
+}
+
 grpc_ssl_server_certificate_config* grpc_ssl_server_certificate_config_create(
     const char* pem_root_certs,
     const grpc_ssl_pem_key_cert_pair* pem_key_cert_pairs,
@@ -112,6 +112,11 @@ class grpc_ssl_server_credentials final : public grpc_server_credentials {
   void set_min_tls_version(grpc_tls_version min_tls_version);
   void set_max_tls_version(grpc_tls_version max_tls_version);
 
+  // Sets the source of the keys that session tickets are encrypted with.
+  // Servers sharing a provider resume each other's sessions.
+  void set_session_ticket_key_provider(
+      grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider> provider);
+
   const grpc_ssl_server_config& config() const { return config_; }
 
  private:
@@ -32,6 +32,7 @@
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_verifier.h"
 #include "src/core/lib/security/security_connector/ssl_utils.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 
 // Contains configurable options specified by callers to configure their certain
 // security features supported in TLS.
@@ -61,6 +62,9 @@ struct grpc_tls_credentials_options
   const std::string& identity_cert_name() const { return identity_cert_name_; }
   const std::string& tls_session_key_log_file_path() const { return tls_session_key_log_file_path_; }
   const std::string& crl_directory() const { return crl_directory_; }
+  tsi::SslSessionTicketKeyProvider* session_ticket_key_provider() const {
+    return session_ticket_key_provider_.get();
+  }
 
   // Setters for member fields.
   void set_cert_request_type(grpc_ssl_client_certificate_request_type cert_request_type) { cert_request_type_ = cert_request_type; }
@@ -81,6 +85,8 @@ struct grpc_tls_credentials_options
   void set_tls_session_key_log_file_path(std::string tls_session_key_log_file_path) { tls_session_key_log_file_path_ = std::move(tls_session_key_log_file_path); }
   //  gRPC will enforce CRLs on all handshakes from all hashed CRL files inside of the crl_directory. If not set, an empty string will be used, which will not enable CRL checking. Only supported for OpenSSL version > 1.1.
   void set_crl_directory(std::string crl_directory) { crl_directory_ = std::move(crl_directory); }
+  // Sets the source of the keys that a server encrypts its session tickets with. Servers sharing a provider resume each other's sessions. If not set, each server uses a key of its own that never rotates. Ignored on the client side.
+  void set_session_ticket_key_provider(grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider> session_ticket_key_provider) { session_ticket_key_provider_ = std::move(session_ticket_key_provider); }
 
   bool operator==(const grpc_tls_credentials_options& other) const {
     return cert_request_type_ == other.cert_request_type_ &&
@@ -95,7 +101,8 @@ struct grpc_tls_credentials_options
       watch_identity_pair_ == other.watch_identity_pair_ &&
       identity_cert_name_ == other.identity_cert_name_ &&
       tls_session_key_log_file_path_ == other.tls_session_key_log_file_path_ &&
-      crl_directory_ == other.crl_directory_;
+      crl_directory_ == other.crl_directory_ &&
+      session_ticket_key_provider_ == other.session_ticket_key_provider_;
   }
 
  private:
@@ -112,6 +119,7 @@ struct grpc_tls_credentials_options
   std::string identity_cert_name_;
   std::string tls_session_key_log_file_path_;
   std::string crl_directory_;
+  grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider> session_ticket_key_provider_;
 };
 
 #endif  // GRPC_SRC_CORE_LIB_SECURITY_CREDENTIALS_TLS_GRPC_TLS_CREDENTIALS_OPTIONS_H
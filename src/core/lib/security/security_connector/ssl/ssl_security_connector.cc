@@ -232,6 +232,12 @@ class grpc_ssl_server_security_connector
     return server_handshaker_factory_;
   }
 
+  void GetSessionStats(tsi_ssl_server_session_stats* stats) {
+    grpc_core::MutexLock lock(&mu_);
+    tsi_ssl_server_handshaker_factory_get_session_stats(
+        server_handshaker_factory_, stats);
+  }
+
   grpc_security_status InitializeHandshakerFactory() {
     if (has_cert_config_fetcher()) {
       // Load initial credentials from certificate_config_fetcher:
@@ -263,6 +269,8 @@ class grpc_ssl_server_security_connector
           server_credentials->config().min_tls_version);
       options.max_tls_version = grpc_get_tsi_tls_version(
           server_credentials->config().max_tls_version);
+      options.session_ticket_key_provider =
+          server_credentials->config().session_ticket_key_provider.get();
       const tsi_result result =
           tsi_create_ssl_server_handshaker_factory_with_options(
               &options, &server_handshaker_factory_);
@@ -376,6 +384,10 @@ class grpc_ssl_server_security_connector
     options.cipher_suites = grpc_get_ssl_cipher_suites();
     options.alpn_protocols = alpn_protocol_strings;
     options.num_alpn_protocols = static_cast<uint16_t>(num_alpn_protocols);
+    // Tickets issued under the previous config stay valid, as long as the
+    // provider still accepts their key.
+    options.session_ticket_key_provider =
+        server_creds->config().session_ticket_key_provider.get();
     tsi_result result = tsi_create_ssl_server_handshaker_factory_with_options(
         &options, &new_handshaker_factory);
     grpc_tsi_ssl_pem_key_cert_pairs_destroy(
@@ -457,3 +469,8 @@ grpc_ssl_server_security_connector_create(
   }
   return c;
 }
+
+void grpc_ssl_server_security_connector_get_session_stats(
+    grpc_server_security_connector* sc, tsi_ssl_server_session_stats* stats) {
+  static_cast<grpc_ssl_server_security_connector*>(sc)->GetSessionStats(stats);
+}
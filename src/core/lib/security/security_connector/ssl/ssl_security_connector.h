@@ -28,6 +28,7 @@
 
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 #include "src/core/tsi/ssl_transport_security.h"
 
 struct grpc_ssl_config {
@@ -68,6 +69,8 @@ struct grpc_ssl_server_config {
       GRPC_SSL_DONT_REQUEST_CLIENT_CERTIFICATE;
   grpc_tls_version min_tls_version = grpc_tls_version::TLS1_2;
   grpc_tls_version max_tls_version = grpc_tls_version::TLS1_3;
+  grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider>
+      session_ticket_key_provider;
 };
 // Creates an SSL server_security_connector.
 // - config is the SSL config to be used for the SSL channel establishment.
@@ -79,4 +82,10 @@ grpc_core::RefCountedPtr<grpc_server_security_connector>
 grpc_ssl_server_security_connector_create(
     grpc_core::RefCountedPtr<grpc_server_credentials> server_credentials);
 
+// Gets the session stats of the handshaker factory that sc, created by
+// grpc_ssl_server_security_connector_create(), currently uses. A certificate
+// config reload replaces the factory, and so starts the counts over.
+void grpc_ssl_server_security_connector_get_session_stats(
+    grpc_server_security_connector* sc, tsi_ssl_server_session_stats* stats);
+
 #endif  // GRPC_SRC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_SSL_SSL_SECURITY_CONNECTOR_H
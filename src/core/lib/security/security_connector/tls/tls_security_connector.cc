@@ -803,6 +803,17 @@ void TlsServerSecurityConnector::ServerPendingVerifierRequest::OnVerifyDone(
   delete this;
 }
 
+void TlsServerSecurityConnector::GetSessionStats(
+    tsi_ssl_server_session_stats* stats) {
+  MutexLock lock(&mu_);
+  if (server_handshaker_factory_ == nullptr) {
+    *stats = tsi_ssl_server_session_stats();
+    return;
+  }
+  tsi_ssl_server_handshaker_factory_get_session_stats(
+      server_handshaker_factory_, stats);
+}
+
 // TODO(ZhenLian): implement the logic to signal waiting handshakers once
 // BlockOnInitialCredentialHandshaker is implemented.
 grpc_security_status
@@ -830,7 +841,7 @@ TlsServerSecurityConnector::UpdateHandshakerFactoryLocked() {
       grpc_get_tsi_tls_version(options_->min_tls_version()),
       grpc_get_tsi_tls_version(options_->max_tls_version()),
       tls_session_key_logger_.get(), options_->crl_directory().c_str(),
-      &server_handshaker_factory_);
+      options_->session_ticket_key_provider(), &server_handshaker_factory_);
   // Free memory.
   grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pairs,
                                           num_key_cert_pairs);
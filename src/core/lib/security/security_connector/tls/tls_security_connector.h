@@ -215,6 +215,11 @@ class TlsServerSecurityConnector final : public grpc_server_security_connector {
     return pem_key_cert_pair_list_;
   }
 
+  // Gets the session stats of the current handshaker factory, which is
+  // replaced, starting the counts over, whenever the certificates change.
+  // All counts are zero until the first certificates arrive.
+  void GetSessionStats(tsi_ssl_server_session_stats* stats);
+
  private:
   // A watcher that watches certificate updates from
   // grpc_tls_certificate_distributor. It will never outlive
@@ -0,0 +1,172 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+
+int MicrosSince(gpr_timespec start) {
+  return static_cast<int>(gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+}
+
+}  // namespace
+
+struct HandshakeOffloadPool::State {
+  struct QueuedStep {
+    absl::AnyInvocable<void()> step;
+    gpr_timespec enqueue_time;
+  };
+
+  Mutex mu;
+  CondVar step_queued;
+  CondVar threads_exited;
+  std::deque<QueuedStep> queue ABSL_GUARDED_BY(mu);
+  size_t in_flight ABSL_GUARDED_BY(mu) = 0;
+  size_t living_threads ABSL_GUARDED_BY(mu) = 0;
+  bool shutdown ABSL_GUARDED_BY(mu) = false;
+
+  static void ThreadMain(std::shared_ptr<State> state);
+};
+
+namespace {
+
+// The state of the pool that the current thread belongs to, if any.
+thread_local const void* g_current_pool_state = nullptr;
+
+}  // namespace
+
+void HandshakeOffloadPool::State::ThreadMain(std::shared_ptr<State> state) {
+  g_current_pool_state = state.get();
+  bool ran_step = false;
+  while (true) {
+    QueuedStep queued;
+    {
+      MutexLock lock(&state->mu);
+      if (ran_step) --state->in_flight;
+      while (state->queue.empty() && !state->shutdown) {
+        state->step_queued.Wait(&state->mu);
+      }
+      if (state->queue.empty()) {
+        if (--state->living_threads == 0) state->threads_exited.SignalAll();
+        return;
+      }
+      queued = std::move(state->queue.front());
+      state->queue.pop_front();
+      ++state->in_flight;
+    }
+    ExecCtx exec_ctx;
+    global_stats().IncrementHandshakeOffloadQueueTimeUs(
+        MicrosSince(queued.enqueue_time));
+    gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    queued.step();
+    // Destroy the step, and whatever it holds, before the time is taken.
+    queued.step = nullptr;
+    global_stats().IncrementHandshakeOffloadRunTimeUs(MicrosSince(start));
+    ran_step = true;
+  }
+}
+
+HandshakeOffloadPool::HandshakeOffloadPool(size_t max_concurrency)
+    : max_concurrency_(std::max<size_t>(1, max_concurrency)),
+      state_(std::make_shared<State>()) {
+  {
+    MutexLock lock(&state_->mu);
+    state_->living_threads = max_concurrency_;
+  }
+  for (size_t i = 0; i < max_concurrency_; ++i) {
+    Thread(
+        "handshake_offload",
+        [state = state_]() mutable { State::ThreadMain(std::move(state)); },
+        nullptr, Thread::Options().set_tracked(false).set_joinable(false))
+        .Start();
+  }
+}
+
+HandshakeOffloadPool::~HandshakeOffloadPool() {
+  MutexLock lock(&state_->mu);
+  state_->shutdown = true;
+  state_->step_queued.SignalAll();
+  // A thread can't wait for itself to exit. It will exit once it is done with
+  // the step that dropped the last reference to the pool.
+  if (g_current_pool_state == state_.get()) return;
+  while (state_->living_threads > 0) {
+    state_->threads_exited.Wait(&state_->mu);
+  }
+}
+
+std::shared_ptr<HandshakeOffloadPool> HandshakeOffloadPool::Default() {
+  static NoDestruct<std::shared_ptr<HandshakeOffloadPool>> pool(
+      std::make_shared<HandshakeOffloadPool>(
+          std::max(1u, gpr_cpu_num_cores() / 2)));
+  return *pool;
+}
+
+void HandshakeOffloadPool::Run(absl::AnyInvocable<void()> step) {
+  size_t queue_depth;
+  {
+    MutexLock lock(&state_->mu);
+    GPR_ASSERT(!state_->shutdown);
+    queue_depth = state_->queue.size();
+    state_->queue.push_back(
+        State::QueuedStep{std::move(step), gpr_now(GPR_CLOCK_MONOTONIC)});
+    state_->step_queued.Signal();
+  }
+  // The stats are sharded per CPU by way of the ExecCtx, which callers
+  // normally have but aren't required to.
+  if (ExecCtx::Get() != nullptr) {
+    global_stats().IncrementHandshakeOffloads();
+    global_stats().IncrementHandshakeOffloadQueueDepth(
+        static_cast<int>(queue_depth));
+  }
+}
+
+size_t HandshakeOffloadPool::queue_depth() const {
+  MutexLock lock(&state_->mu);
+  return state_->queue.size();
+}
+
+size_t HandshakeOffloadPool::in_flight() const {
+  MutexLock lock(&state_->mu);
+  return state_->in_flight;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,80 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_SRC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H
+#define GRPC_SRC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+
+namespace grpc_core {
+
+// A fixed set of threads that security handshakers hand their TSI handshaker
+// steps to, so that the crypto of a handshake (e.g. the TLS key exchange and
+// signatures) does not hold up the thread that read the handshake bytes. With
+// many connections handshaking at once, steps queue up here instead of
+// competing with established connections for the I/O threads.
+//
+// A security handshaker uses the pool found in its channel args, if any, or
+// the default pool if GRPC_ARG_TSI_HANDSHAKE_OFFLOAD is set.
+class HandshakeOffloadPool
+    : public std::enable_shared_from_this<HandshakeOffloadPool> {
+ public:
+  // Starts max_concurrency threads, which is how many steps run at a time.
+  explicit HandshakeOffloadPool(size_t max_concurrency);
+  // Steps that are still queued are run before the threads exit. Waits for
+  // the threads unless called from one of them.
+  ~HandshakeOffloadPool();
+
+  HandshakeOffloadPool(const HandshakeOffloadPool&) = delete;
+  HandshakeOffloadPool& operator=(const HandshakeOffloadPool&) = delete;
+
+  // The process-wide pool, with a thread for every two cores.
+  static std::shared_ptr<HandshakeOffloadPool> Default();
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.handshake_offload_pool";
+  }
+
+  // Queues step to run on one of the threads, with an ExecCtx.
+  void Run(absl::AnyInvocable<void()> step);
+
+  size_t max_concurrency() const { return max_concurrency_; }
+  // Number of steps waiting for a thread.
+  size_t queue_depth() const;
+  // Number of steps running.
+  size_t in_flight() const;
+
+ private:
+  struct State;
+
+  const size_t max_concurrency_;
+  // Shared with the threads, which may outlive the pool when it is destroyed
+  // from one of them.
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_LIB_SECURITY_TRANSPORT_HANDSHAKE_OFFLOAD_POOL_H
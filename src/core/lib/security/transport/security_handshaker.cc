@@ -58,6 +58,7 @@
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/tcp_server.h"
 #include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice.h"
@@ -88,6 +89,8 @@ class SecurityHandshaker : public Handshaker {
  private:
   grpc_error_handle DoHandshakerNextLocked(const unsigned char* bytes_received,
                                            size_t bytes_received_size);
+  void DoHandshakerNextOnOffloadPool(const unsigned char* bytes_received,
+                                     size_t bytes_received_size);
 
   grpc_error_handle OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -113,10 +116,16 @@ class SecurityHandshaker : public Handshaker {
   // State set at creation time.
   tsi_handshaker* handshaker_;
   RefCountedPtr<grpc_security_connector> connector_;
+  // Where TSI handshaker steps run, if not inline.
+  std::shared_ptr<HandshakeOffloadPool> offload_pool_;
 
   Mutex mu_;
 
   bool is_shutdown_ = false;
+  // Number of TSI handshaker steps running on the offload pool. An
+  // asynchronous TSI handshaker can get to the next step before the pool
+  // thread is done with the previous one.
+  int offloaded_steps_running_ = 0;
   // Endpoint and read buffer to destroy after a shutdown.
   grpc_endpoint* endpoint_to_destroy_ = nullptr;
   grpc_slice_buffer* read_buffer_to_destroy_ = nullptr;
@@ -142,11 +151,16 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
                                        const ChannelArgs& args)
     : handshaker_(handshaker),
       connector_(connector->Ref(DEBUG_LOCATION, "handshake")),
+      offload_pool_(args.GetObjectRef<HandshakeOffloadPool>()),
       handshake_buffer_size_(GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE),
       handshake_buffer_(
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(
           std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))) {
+  if (offload_pool_ == nullptr &&
+      args.GetBool(GRPC_ARG_TSI_HANDSHAKE_OFFLOAD).value_or(false)) {
+    offload_pool_ = HandshakeOffloadPool::Default();
+  }
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -455,6 +469,16 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
 
 grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  if (offload_pool_ != nullptr) {
+    // The step finishes the way an asynchronous TSI handshaker's would, by
+    // way of OnHandshakeNextDoneGrpcWrapper().
+    ++offloaded_steps_running_;
+    offload_pool_->Run([self = Ref(), bytes_received, bytes_received_size]() {
+      static_cast<SecurityHandshaker*>(self.get())
+          ->DoHandshakerNextOnOffloadPool(bytes_received, bytes_received_size);
+    });
+    return absl::OkStatus();
+  }
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
@@ -474,6 +498,29 @@ grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
                                    hs_result);
 }
 
+// Runs without the mutex, which is fine since nothing else touches the TSI
+// handshaker or the bytes received until the step is done.
+void SecurityHandshaker::DoHandshakerNextOnOffloadPool(
+    const unsigned char* bytes_received, size_t bytes_received_size) {
+  const unsigned char* bytes_to_send = nullptr;
+  size_t bytes_to_send_size = 0;
+  tsi_handshaker_result* hs_result = nullptr;
+  tsi_result result = tsi_handshaker_next(
+      handshaker_, bytes_received, bytes_received_size, &bytes_to_send,
+      &bytes_to_send_size, &hs_result, &OnHandshakeNextDoneGrpcWrapper, this,
+      &tsi_handshake_error_);
+  {
+    MutexLock lock(&mu_);
+    // Shutdown() leaves the TSI handshaker alone while steps are running.
+    if (--offloaded_steps_running_ == 0 && is_shutdown_) {
+      tsi_handshaker_shutdown(handshaker_);
+    }
+  }
+  if (result == TSI_ASYNC) return;
+  OnHandshakeNextDoneGrpcWrapper(result, this, bytes_to_send,
+                                 bytes_to_send_size, hs_result);
+}
+
 // This callback might be run inline while we are still holding on to the mutex,
 // so schedule OnHandshakeDataReceivedFromPeerFn on ExecCtx to avoid a deadlock.
 void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFnScheduler(
@@ -557,7 +604,7 @@ void SecurityHandshaker::Shutdown(grpc_error_handle why) {
   if (!is_shutdown_) {
     is_shutdown_ = true;
     connector_->cancel_check_peer(&on_peer_checked_, why);
-    tsi_handshaker_shutdown(handshaker_);
+    if (offloaded_steps_running_ == 0) tsi_handshaker_shutdown(handshaker_);
     grpc_endpoint_shutdown(args_->endpoint, why);
     CleanupArgsForFailureLocked();
   }
@@ -66,6 +66,10 @@ class ServiceConfigCallData {
 
   ServiceConfig* service_config() { return service_config_.get(); }
 
+  const ServiceConfigParser::ParsedConfigVector* method_configs() const {
+    return method_configs_;
+  }
+
   ServiceConfigParser::ParsedConfig* GetMethodParsedConfig(size_t index) const {
     if (method_configs_ == nullptr) return nullptr;
     return (*method_configs_)[index].get();
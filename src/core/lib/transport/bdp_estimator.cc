@@ -24,20 +24,36 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <iterator>
+
+#include "src/core/lib/gpr/useful.h"
 
 grpc_core::TraceFlag grpc_bdp_estimator_trace(false, "bdp_estimator");
 
 namespace grpc_core {
 
-BdpEstimator::BdpEstimator(absl::string_view name)
+namespace {
+// The estimate never drops below the HTTP/2 default window.
+constexpr int64_t kMinEstimate = 65536;
+// How long a min RTT sample stays valid for.
+constexpr Duration kMinRttWindow = Duration::Seconds(10);
+// Ping spacing once the delivery rate has stopped growing starts here and
+// backs off up to kMinRttWindow.
+constexpr Duration kMinFullPipePingInterval = Duration::Seconds(1);
+// Growth in delivery rate that counts as the pipe still filling up.
+constexpr double kFullBandwidthGrowth = 1.25;
+}  // namespace
+
+BdpEstimator::BdpEstimator(absl::string_view name, bool delivery_rate_model)
     : ping_state_(PingState::UNSCHEDULED),
       accumulator_(0),
-      estimate_(65536),
+      estimate_(kMinEstimate),
       ping_start_time_(gpr_time_0(GPR_CLOCK_MONOTONIC)),
       inter_ping_delay_(Duration::Milliseconds(100)),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
-      name_(name) {}
+      name_(name),
+      delivery_rate_model_(delivery_rate_model) {}
 
 Timestamp BdpEstimator::CompletePing() {
   gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
@@ -54,6 +70,12 @@ Timestamp BdpEstimator::CompletePing() {
             bw / 125000.0, bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
+  if (delivery_rate_model_) {
+    UpdateDeliveryRateModel(dt, bw);
+    ping_state_ = PingState::UNSCHEDULED;
+    accumulator_ = 0;
+    return Timestamp::Now() + inter_ping_delay_;
+  }
   if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
     estimate_ = std::max(accumulator_, estimate_ * 2);
     bw_est_ = bw;
@@ -83,4 +105,43 @@ Timestamp BdpEstimator::CompletePing() {
   return Timestamp::Now() + inter_ping_delay_;
 }
 
+void BdpEstimator::UpdateDeliveryRateModel(double rtt, double bw) {
+  const Timestamp now = Timestamp::Now();
+  // Windowed min of the round trip time: a new low always wins, and a stale
+  // min is replaced by whatever the current sample is.
+  if (rtt <= min_rtt_ || now - min_rtt_stamp_ > kMinRttWindow) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+  // Windowed max of the delivery rate over the last few rounds.
+  bw_samples_[bw_round_++ % kBandwidthWindowRounds] = bw;
+  bw_est_ = *std::max_element(std::begin(bw_samples_), std::end(bw_samples_));
+  estimate_ =
+      std::max(kMinEstimate, static_cast<int64_t>(bw_est_ * min_rtt_));
+  // While the delivery rate keeps growing, sample it every round trip so the
+  // window can follow; once it plateaus, back off to infrequent pings that
+  // just keep the estimates fresh.
+  if (bw_est_ >= full_bw_ * kFullBandwidthGrowth) {
+    full_bw_ = bw_est_;
+    full_bw_rounds_ = 0;
+  } else if (full_bw_rounds_ < kFullBandwidthRounds) {
+    ++full_bw_rounds_;
+  }
+  if (FillingPipe()) {
+    inter_ping_delay_ =
+        Clamp(Duration::FromSecondsAsDouble(min_rtt_), Duration::Milliseconds(1),
+              kMinFullPipePingInterval);
+  } else {
+    inter_ping_delay_ = Clamp(inter_ping_delay_ * 2, kMinFullPipePingInterval,
+                              kMinRttWindow);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+    gpr_log(GPR_INFO,
+            "bdp[%s]:model min_rtt=%lfms bw_est=%lfMbs est=%" PRId64
+            " next_ping=%" PRId64 "ms",
+            std::string(name_).c_str(), min_rtt_ * 1000.0, bw_est_ / 125000.0,
+            estimate_, inter_ping_delay_.millis());
+  }
+}
+
 }  // namespace grpc_core
@@ -22,7 +22,9 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <stddef.h>
 
+#include <limits>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -39,11 +41,24 @@ namespace grpc_core {
 
 class BdpEstimator {
  public:
-  explicit BdpEstimator(absl::string_view name);
+  // If \a delivery_rate_model is set, the estimate is built BBR-style as the
+  // product of the windowed max delivery rate and the windowed min ping round
+  // trip time, instead of only ever growing when a ping sees more data than
+  // the previous estimate.
+  explicit BdpEstimator(absl::string_view name,
+                        bool delivery_rate_model = false);
   ~BdpEstimator() {}
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  // Min round trip time in seconds seen by recent pings (delivery rate model
+  // only), or infinity if no ping has completed yet.
+  double MinRttSeconds() const { return min_rtt_; }
+  // True while the delivery rate model still sees the delivery rate growing
+  // from round to round, i.e. the receive window is what limits the sender.
+  bool FillingPipe() const {
+    return delivery_rate_model_ && full_bw_rounds_ < kFullBandwidthRounds;
+  }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -81,6 +96,14 @@ class BdpEstimator {
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
+  // Number of ping rounds the max delivery rate is taken over.
+  static constexpr size_t kBandwidthWindowRounds = 10;
+  // Number of rounds without significant growth in the delivery rate after
+  // which the pipe is considered full.
+  static constexpr int kFullBandwidthRounds = 3;
+
+  void UpdateDeliveryRateModel(double rtt, double bw);
+
   PingState ping_state_;
   int64_t accumulator_;
   int64_t estimate_;
@@ -90,6 +113,17 @@ class BdpEstimator {
   int stable_estimate_count_;
   double bw_est_;
   absl::string_view name_;
+  // Delivery rate model state.
+  const bool delivery_rate_model_;
+  double min_rtt_ = std::numeric_limits<double>::infinity();
+  Timestamp min_rtt_stamp_;
+  double bw_samples_[kBandwidthWindowRounds] = {};
+  size_t bw_round_ = 0;
+  // Bandwidth at the last round that grew it by at least 25%, and the number
+  // of rounds since: once a few rounds go by without such growth the pipe is
+  // considered full and pings slow down.
+  double full_bw_ = 0;
+  int full_bw_rounds_ = 0;
 };
 
 }  // namespace grpc_core
@@ -487,6 +487,18 @@ struct GrpcTrailersOnly {
   static absl::string_view DisplayValue(bool x) { return x ? "true" : "false"; }
 };
 
+// Relative share of connection bandwidth a transport should give this stream
+// when several streams have data to send (an HTTP/2 stream weight, 1..256).
+struct GrpcStreamWeight {
+  static absl::string_view DebugKey() { return "GrpcStreamWeight"; }
+  static constexpr bool kRepeatable = false;
+  using ValueType = uint32_t;
+  static constexpr uint32_t kDefault = 16;
+  static constexpr uint32_t kMin = 1;
+  static constexpr uint32_t kMax = 256;
+  static uint32_t DisplayValue(uint32_t x) { return x; }
+};
+
 namespace metadata_detail {
 
 // Build a key/value formatted debug string.
@@ -1451,7 +1463,8 @@ using grpc_metadata_batch_base = grpc_core::MetadataMap<
     grpc_core::GrpcStreamNetworkState, grpc_core::PeerString,
     grpc_core::GrpcStatusContext, grpc_core::GrpcStatusFromWire,
     grpc_core::GrpcCallWasCancelled, grpc_core::WaitForReady,
-    grpc_core::GrpcTrailersOnly GRPC_CUSTOM_CLIENT_METADATA
+    grpc_core::GrpcTrailersOnly, grpc_core::GrpcStreamWeight
+        GRPC_CUSTOM_CLIENT_METADATA
         GRPC_CUSTOM_SERVER_METADATA>;
 
 struct grpc_metadata_batch : public grpc_metadata_batch_base {
@@ -20,6 +20,10 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_privacy_integrity_record_protocol.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -117,10 +121,139 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
   return TSI_OK;
 }
 
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_size, grpc_slice_buffer* protected_slices) {
+  // Input sanity check.
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_frame_size == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol protect_frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  // Frames are sealed straight from the input slices, each into its own
+  // buffer, rather than first moving each frame's data into a slice buffer of
+  // its own as protect would need.
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  size_t remaining = unprotected_slices->length;
+  size_t slice_index = 0;
+  size_t slice_offset = 0;
+  // Like protect, empty input still produces one (empty) frame.
+  do {
+    size_t data_length = std::min(remaining, max_unprotected_frame_size);
+    grpc_slice protected_slice =
+        GRPC_SLICE_MALLOC(data_length + frame_overhead);
+    iovec_t protected_iovec = {GRPC_SLICE_START_PTR(protected_slice),
+                               GRPC_SLICE_LENGTH(protected_slice)};
+    size_t iovec_count =
+        alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+            rp, unprotected_slices, data_length, &slice_index, &slice_offset);
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, rp->iovec_buf, iovec_count, protected_iovec,
+            &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_core::CSliceUnref(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    grpc_slice_buffer_add(protected_slices, protected_slice);
+    remaining -= data_length;
+    // Releases the input slices used up so far.
+    for (; slice_index > 0; slice_index--) {
+      grpc_core::CSliceUnref(grpc_slice_buffer_take_first(unprotected_slices));
+    }
+  } while (remaining > 0);
+  grpc_slice_buffer_reset_and_unref(unprotected_slices);
+  return TSI_OK;
+}
+
+static tsi_result alts_grpc_privacy_integrity_unprotect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  // Input sanity check.
+  if (rp == nullptr || protected_slices == nullptr ||
+      unprotected_slices == nullptr) {
+    gpr_log(GPR_ERROR,
+            "Invalid nullptr arguments to alts_grpc_record_protocol "
+            "unprotect_frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  // As in protect_frames, frames are opened straight from the input slices,
+  // each into its own buffer.
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  size_t protected_length = protected_slices->length;
+  size_t consumed = 0;
+  size_t slice_index = 0;
+  size_t slice_offset = 0;
+  while (consumed < protected_length) {
+    if (protected_length - consumed < frame_overhead) {
+      gpr_log(GPR_ERROR, "Protected slices do not have sufficient data.");
+      return TSI_INVALID_ARGUMENT;
+    }
+    // Copies the frame header to a flat buffer, as it may span slices.
+    size_t iovec_count =
+        alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+            rp, protected_slices, rp->header_length, &slice_index,
+            &slice_offset);
+    unsigned char* header = rp->header_buf;
+    for (size_t i = 0; i < iovec_count; i++) {
+      memcpy(header, rp->iovec_buf[i].iov_base, rp->iovec_buf[i].iov_len);
+      header += rp->iovec_buf[i].iov_len;
+    }
+    // The frame header starts with the little-endian length of the rest of
+    // the frame. The rest of the header is verified by the iovec record
+    // protocol.
+    size_t frame_size =
+        ((static_cast<size_t>(rp->header_buf[3]) << 24) |
+         (static_cast<size_t>(rp->header_buf[2]) << 16) |
+         (static_cast<size_t>(rp->header_buf[1]) << 8) |
+         static_cast<size_t>(rp->header_buf[0])) +
+        kZeroCopyFrameLengthFieldSize;
+    if (frame_size < frame_overhead ||
+        frame_size > protected_length - consumed) {
+      gpr_log(GPR_ERROR, "Protected slices do not hold full frames.");
+      return TSI_INVALID_ARGUMENT;
+    }
+    iovec_t header_iovec = {rp->header_buf, rp->header_length};
+    iovec_count = alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+        rp, protected_slices, frame_size - rp->header_length, &slice_index,
+        &slice_offset);
+    grpc_slice unprotected_slice =
+        GRPC_SLICE_MALLOC(frame_size - frame_overhead);
+    iovec_t unprotected_iovec = {GRPC_SLICE_START_PTR(unprotected_slice),
+                                 GRPC_SLICE_LENGTH(unprotected_slice)};
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_unprotect(
+            rp->iovec_rp, header_iovec, rp->iovec_buf, iovec_count,
+            unprotected_iovec, &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to unprotect, %s", error_details);
+      gpr_free(error_details);
+      grpc_core::CSliceUnref(unprotected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    grpc_slice_buffer_add(unprotected_slices, unprotected_slice);
+    consumed += frame_size;
+    // Releases the input slices used up so far.
+    for (; slice_index > 0; slice_index--) {
+      grpc_core::CSliceUnref(grpc_slice_buffer_take_first(protected_slices));
+    }
+  }
+  grpc_slice_buffer_reset_and_unref(protected_slices);
+  return TSI_OK;
+}
+
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect,
+        nullptr,
+        alts_grpc_privacy_integrity_protect_frames,
+        alts_grpc_privacy_integrity_unprotect_frames};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
@@ -68,6 +68,47 @@ tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices);
 
+///
+/// This method protects all of the unprotected data, splitting it into as many
+/// frames as needed with at most max_unprotected_frame_size bytes of data each,
+/// and appends the protected frames to protected_slices. The frames are sealed
+/// straight from the input slices, without splitting them into a slice buffer
+/// per frame first. The input unprotected data slice buffer will be cleared,
+/// although the actual unprotected data bytes are not modified.
+///
+///- self: an alts_grpc_record_protocol instance.
+///- unprotected_slices: the unprotected data to be protected.
+///- max_unprotected_frame_size: maximum size of unprotected data per frame.
+///- protected_slices: slice buffer where the protected frames are appended.
+///
+/// This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+/// record protocol can only protect one frame at a time, or a specific error
+/// code in case of failure.
+///
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_size, grpc_slice_buffer* protected_slices);
+
+///
+/// This method performs unprotect operation on one or more full frames of
+/// protected data, stored back to back, and appends the unprotected data of all
+/// of them to unprotected_slices. It is the caller's responsibility to make
+/// sure protected_slices holds only full frames. The input protected frames
+/// slice buffer will be cleared, although the actual protected data bytes are
+/// not modified.
+///
+///- self: an alts_grpc_record_protocol instance.
+///- protected_slices: full frames of protected data in grpc slices.
+///- unprotected_slices: slice buffer where unprotected data is appended.
+///
+/// This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+/// record protocol can only unprotect one frame at a time, or a specific error
+/// code in case of failure.
+///
+tsi_result alts_grpc_record_protocol_unprotect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices);
+
 ///
 /// This method returns maximum allowed unprotected data size, given maximum
 /// protected frame size.
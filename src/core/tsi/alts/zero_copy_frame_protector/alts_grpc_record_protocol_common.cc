@@ -58,6 +58,31 @@ void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
   }
 }
 
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t length,
+    size_t* slice_index, size_t* slice_offset) {
+  GPR_ASSERT(rp != nullptr && sb != nullptr && slice_index != nullptr &&
+             slice_offset != nullptr);
+  ensure_iovec_buf_size(rp, sb);
+  size_t iovec_count = 0;
+  while (length > 0) {
+    GPR_ASSERT(*slice_index < sb->count);
+    size_t slice_length = GRPC_SLICE_LENGTH(sb->slices[*slice_index]);
+    size_t bytes = std::min(slice_length - *slice_offset, length);
+    rp->iovec_buf[iovec_count].iov_base =
+        GRPC_SLICE_START_PTR(sb->slices[*slice_index]) + *slice_offset;
+    rp->iovec_buf[iovec_count].iov_len = bytes;
+    iovec_count++;
+    length -= bytes;
+    *slice_offset += bytes;
+    if (*slice_offset == slice_length) {
+      (*slice_index)++;
+      *slice_offset = 0;
+    }
+  }
+  return iovec_count;
+}
+
 void alts_grpc_record_protocol_copy_slice_buffer(const grpc_slice_buffer* src,
                                                  unsigned char* dst) {
   GPR_ASSERT(src != nullptr && dst != nullptr);
@@ -149,6 +174,37 @@ tsi_result alts_grpc_record_protocol_unprotect(
   return self->vtable->unprotect(self, protected_slices, unprotected_slices);
 }
 
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_size, grpc_slice_buffer* protected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_frame_size == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->protect_frames == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->protect_frames(self, unprotected_slices,
+                                      max_unprotected_frame_size,
+                                      protected_slices);
+}
+
+tsi_result alts_grpc_record_protocol_unprotect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || protected_slices == nullptr ||
+      unprotected_slices == nullptr) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->unprotect_frames == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->unprotect_frames(self, protected_slices,
+                                        unprotected_slices);
+}
+
 void alts_grpc_record_protocol_destroy(alts_grpc_record_protocol* self) {
   if (self == nullptr) {
     return;
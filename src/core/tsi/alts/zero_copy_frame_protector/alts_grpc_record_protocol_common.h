@@ -39,6 +39,13 @@ struct alts_grpc_record_protocol_vtable {
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_frame_size,
+                               grpc_slice_buffer* protected_slices);
+  tsi_result (*unprotect_frames)(alts_grpc_record_protocol* self,
+                                 grpc_slice_buffer* protected_slices,
+                                 grpc_slice_buffer* unprotected_slices);
 };
 // Main struct for alts_grpc_record_protocol implementation, shared by both
 // integrity-only record protocol and privacy-integrity record protocol.
@@ -63,6 +70,18 @@ struct alts_grpc_record_protocol {
 void alts_grpc_record_protocol_convert_slice_buffer_to_iovec(
     alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb);
 
+///
+/// Converts length bytes of the input sb, starting at offset *slice_offset of
+/// slice *slice_index, into iovec_t's and puts the result into rp->iovec_buf.
+/// The position is advanced past those bytes, so that consecutive calls walk
+/// the slice buffer. Returns the number of iovec_t's. As above, the actual data
+/// are not copied. Caller needs to make sure sb holds at least length bytes
+/// past the position.
+///
+size_t alts_grpc_record_protocol_convert_slice_buffer_range_to_iovec(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb, size_t length,
+    size_t* slice_index, size_t* slice_offset);
+
 ///
 /// Copies bytes from slice buffer to destination buffer. Caller is responsible
 /// for allocating enough memory of destination buffer. This method is used for
@@ -57,31 +57,39 @@ typedef struct alts_zero_copy_grpc_protector {
   grpc_slice_buffer protected_sb;
   grpc_slice_buffer protected_staging_sb;
   uint32_t parsed_frame_size;
+  bool is_integrity_only;
 } alts_zero_copy_grpc_protector;
 
 ///
-/// Given a slice buffer, parses the first 4 bytes little-endian unsigned frame
-/// size and returns the total frame size including the frame field. Caller
-/// needs to make sure the input slice buffer has at least 4 bytes. Returns true
-/// on success and false on failure.
+/// Given a slice buffer, parses the 4 bytes little-endian unsigned frame size
+/// starting at the given offset and returns the total frame size including the
+/// frame field. Caller needs to make sure the input slice buffer has at least 4
+/// bytes past the offset. Returns true on success and false on failure.
 ///
-static bool read_frame_size(const grpc_slice_buffer* sb,
+static bool read_frame_size(const grpc_slice_buffer* sb, size_t offset,
                             uint32_t* total_frame_size) {
-  if (sb == nullptr || sb->length < kZeroCopyFrameLengthFieldSize) {
+  if (sb == nullptr || sb->length < offset + kZeroCopyFrameLengthFieldSize) {
     return false;
   }
   uint8_t frame_size_buffer[kZeroCopyFrameLengthFieldSize];
   uint8_t* buf = frame_size_buffer;
-  // Copies the first 4 bytes to a temporary buffer.
+  // Copies the 4 bytes at the offset to a temporary buffer.
   size_t remaining = kZeroCopyFrameLengthFieldSize;
   for (size_t i = 0; i < sb->count; i++) {
     size_t slice_length = GRPC_SLICE_LENGTH(sb->slices[i]);
+    if (offset >= slice_length) {
+      offset -= slice_length;
+      continue;
+    }
+    const uint8_t* start = GRPC_SLICE_START_PTR(sb->slices[i]) + offset;
+    slice_length -= offset;
+    offset = 0;
     if (remaining <= slice_length) {
-      memcpy(buf, GRPC_SLICE_START_PTR(sb->slices[i]), remaining);
+      memcpy(buf, start, remaining);
       remaining = 0;
       break;
     } else {
-      memcpy(buf, GRPC_SLICE_START_PTR(sb->slices[i]), slice_length);
+      memcpy(buf, start, slice_length);
       buf += slice_length;
       remaining -= slice_length;
     }
@@ -157,6 +165,13 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
+  // In privacy-integrity mode, the record protocol seals all the frames in
+  // one pass.
+  if (!protector->is_integrity_only) {
+    return alts_grpc_record_protocol_protect_frames(
+        protector->record_protocol, unprotected_slices,
+        protector->max_unprotected_data_size, protected_slices);
+  }
   // Calls alts_grpc_record_protocol protect repeatly.
   while (unprotected_slices->length > protector->max_unprotected_data_size) {
     grpc_slice_buffer_move_first(unprotected_slices,
@@ -185,17 +200,28 @@ static tsi_result alts_zero_copy_grpc_protector_unprotect(
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
   grpc_slice_buffer_move_into(protected_slices, &protector->protected_sb);
-  // Keep unprotecting each frame if possible.
-  while (protector->protected_sb.length >= kZeroCopyFrameLengthFieldSize) {
+  // Keep unprotecting each frame if possible. In privacy-integrity mode, the
+  // full frames are only counted here, and then unprotected in one pass.
+  size_t batch_length = 0;
+  while (protector->protected_sb.length - batch_length >=
+         kZeroCopyFrameLengthFieldSize) {
     if (protector->parsed_frame_size == 0) {
       // We have not parsed frame size yet. Parses frame size.
-      if (!read_frame_size(&protector->protected_sb,
+      if (!read_frame_size(&protector->protected_sb, batch_length,
                            &protector->parsed_frame_size)) {
         grpc_slice_buffer_reset_and_unref(&protector->protected_sb);
         return TSI_DATA_CORRUPTED;
       }
     }
-    if (protector->protected_sb.length < protector->parsed_frame_size) break;
+    if (protector->protected_sb.length - batch_length <
+        protector->parsed_frame_size) {
+      break;
+    }
+    if (!protector->is_integrity_only) {
+      batch_length += protector->parsed_frame_size;
+      protector->parsed_frame_size = 0;
+      continue;
+    }
     // At this point, protected_sb contains at least one frame of data.
     tsi_result status;
     if (protector->protected_sb.length == protector->parsed_frame_size) {
@@ -216,6 +242,28 @@ static tsi_result alts_zero_copy_grpc_protector_unprotect(
       return status;
     }
   }
+  if (batch_length > 0) {
+    // The frame parsed last, if any, starts right after the batch, so it will
+    // be at the start of protected_sb once the batch is taken out.
+    tsi_result status;
+    if (protector->protected_sb.length == batch_length) {
+      status = alts_grpc_record_protocol_unprotect_frames(
+          protector->unrecord_protocol, &protector->protected_sb,
+          unprotected_slices);
+    } else {
+      grpc_slice_buffer_move_first(&protector->protected_sb, batch_length,
+                                   &protector->protected_staging_sb);
+      status = alts_grpc_record_protocol_unprotect_frames(
+          protector->unrecord_protocol, &protector->protected_staging_sb,
+          unprotected_slices);
+    }
+    if (status != TSI_OK) {
+      protector->parsed_frame_size = 0;
+      grpc_slice_buffer_reset_and_unref(&protector->protected_staging_sb);
+      grpc_slice_buffer_reset_and_unref(&protector->protected_sb);
+      return status;
+    }
+  }
   if (min_progress_size != nullptr) {
     if (protector->parsed_frame_size > kZeroCopyFrameLengthFieldSize) {
       *min_progress_size =
@@ -302,6 +350,7 @@ tsi_result alts_zero_copy_grpc_protector_create(
       grpc_slice_buffer_init(&impl->protected_sb);
       grpc_slice_buffer_init(&impl->protected_staging_sb);
       impl->parsed_frame_size = 0;
+      impl->is_integrity_only = is_integrity_only;
       impl->base.vtable = &alts_zero_copy_grpc_protector_vtable;
       *protector = &impl->base;
       return TSI_OK;
@@ -0,0 +1,83 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
+
+#include <string.h>
+
+#include <openssl/rand.h>
+
+#include <grpc/support/log.h>
+
+namespace tsi {
+
+namespace {
+
+void GenerateKey(SslSessionTicketKey* key) {
+  GPR_ASSERT(RAND_bytes(key->name, sizeof(key->name)) == 1);
+  GPR_ASSERT(RAND_bytes(key->aes_key, sizeof(key->aes_key)) == 1);
+  GPR_ASSERT(RAND_bytes(key->hmac_key, sizeof(key->hmac_key)) == 1);
+}
+
+}  // namespace
+
+RotatingSslSessionTicketKeyProvider::RotatingSslSessionTicketKeyProvider(
+    grpc_core::Duration rotation_interval, size_t num_keys)
+    : rotation_interval_(rotation_interval), num_keys_(num_keys) {
+  GPR_ASSERT(rotation_interval_ > grpc_core::Duration::Zero());
+  GPR_ASSERT(num_keys_ > 0);
+  keys_.emplace_front();
+  GenerateKey(&keys_.front());
+  next_rotation_ = grpc_core::Timestamp::Now() + rotation_interval_;
+}
+
+bool RotatingSslSessionTicketKeyProvider::GetEncryptionKey(
+    SslSessionTicketKey* key) {
+  grpc_core::MutexLock lock(&mu_);
+  MaybeRotateLocked();
+  *key = keys_.front();
+  return true;
+}
+
+bool RotatingSslSessionTicketKeyProvider::GetDecryptionKey(
+    const uint8_t* name, SslSessionTicketKey* key) {
+  grpc_core::MutexLock lock(&mu_);
+  MaybeRotateLocked();
+  for (const SslSessionTicketKey& candidate : keys_) {
+    if (memcmp(candidate.name, name, sizeof(candidate.name)) == 0) {
+      *key = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+void RotatingSslSessionTicketKeyProvider::MaybeRotateLocked() {
+  const grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+  // After a long enough pause, all the keys are out of date: there's no point
+  // in generating more than num_keys_ new ones.
+  for (size_t i = 0; i < num_keys_ && now >= next_rotation_; ++i) {
+    keys_.emplace_front();
+    GenerateKey(&keys_.front());
+    if (keys_.size() > num_keys_) keys_.pop_back();
+    next_rotation_ += rotation_interval_;
+  }
+  if (now >= next_rotation_) next_rotation_ = now + rotation_interval_;
+}
+
+}  // namespace tsi
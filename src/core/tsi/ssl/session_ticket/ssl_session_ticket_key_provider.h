@@ -0,0 +1,96 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_SRC_CORE_TSI_SSL_SESSION_TICKET_SSL_SESSION_TICKET_KEY_PROVIDER_H
+#define GRPC_SRC_CORE_TSI_SSL_SESSION_TICKET_SSL_SESSION_TICKET_KEY_PROVIDER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace tsi {
+
+// The keys that a server encrypts and authenticates its session tickets with
+// (RFC 5077), along with the name by which tickets refer to them. Tickets are
+// encrypted with AES-128-CBC and authenticated with HMAC-SHA256.
+struct SslSessionTicketKey {
+  static constexpr size_t kNameSize = 16;
+  static constexpr size_t kAesKeySize = 16;
+  static constexpr size_t kHmacKeySize = 16;
+
+  uint8_t name[kNameSize];
+  uint8_t aes_key[kAesKeySize];
+  uint8_t hmac_key[kHmacKeySize];
+};
+
+// Supplies the session ticket keys of a server handshaker factory. Servers
+// that get their keys from the same source resume each other's sessions, so
+// that clients moving between them (e.g. on failover) skip the full
+// handshake. Methods may be called concurrently from several handshakes.
+class SslSessionTicketKeyProvider
+    : public grpc_core::RefCounted<SslSessionTicketKeyProvider> {
+ public:
+  // Gets the key to encrypt a new ticket with. Returns false if no ticket
+  // should be issued.
+  virtual bool GetEncryptionKey(SslSessionTicketKey* key) = 0;
+
+  // Gets the key named name, which a ticket presented by a client was
+  // encrypted with. Returns false if that key is no longer accepted, in which
+  // case the client goes through a full handshake.
+  virtual bool GetDecryptionKey(const uint8_t* name,
+                                SslSessionTicketKey* key) = 0;
+};
+
+// Generates a random key every rotation_interval, and keeps accepting tickets
+// encrypted with each of the last num_keys keys. A ticket is thus accepted for
+// between (num_keys - 1) and num_keys rotation intervals after it was issued.
+// Keys are kept in memory only: for servers to share them, they have to share
+// the provider.
+class RotatingSslSessionTicketKeyProvider final
+    : public SslSessionTicketKeyProvider {
+ public:
+  RotatingSslSessionTicketKeyProvider(grpc_core::Duration rotation_interval,
+                                      size_t num_keys);
+
+  bool GetEncryptionKey(SslSessionTicketKey* key) override;
+  bool GetDecryptionKey(const uint8_t* name,
+                        SslSessionTicketKey* key) override;
+
+ private:
+  // Adds a new key if the current one is due for rotation, dropping the oldest
+  // one if there are more than num_keys_.
+  void MaybeRotateLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const grpc_core::Duration rotation_interval_;
+  const size_t num_keys_;
+  grpc_core::Mutex mu_;
+  // The newest key, which new tickets are encrypted with, comes first.
+  std::deque<SslSessionTicketKey> keys_ ABSL_GUARDED_BY(mu_);
+  grpc_core::Timestamp next_rotation_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace tsi
+
+#endif  // GRPC_SRC_CORE_TSI_SSL_SESSION_TICKET_SSL_SESSION_TICKET_KEY_PROVIDER_H
@@ -33,16 +33,25 @@
 #include <sys/socket.h>
 #endif
 
+#include <atomic>
 #include <string>
 
 #include <openssl/bio.h>
 #include <openssl/crypto.h>  // For OPENSSL_free
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -59,6 +68,7 @@
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 #include "src/core/tsi/ssl_transport_security_utils.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
@@ -113,6 +123,14 @@ struct tsi_ssl_server_handshaker_factory {
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider>
+      session_ticket_key_provider;
+  // See tsi_ssl_server_session_stats.
+  std::atomic<uint64_t> full_handshakes;
+  std::atomic<uint64_t> resumed_handshakes;
+  std::atomic<uint64_t> tickets_issued;
+  std::atomic<uint64_t> tickets_renewed;
+  std::atomic<uint64_t> tickets_rejected;
 };
 
 struct tsi_ssl_handshaker {
@@ -1574,12 +1592,23 @@ static tsi_result ssl_handshaker_next(tsi_handshaker* self,
       if (error != nullptr) *error = "More unused bytes than received bytes.";
       return TSI_INTERNAL_ERROR;
     }
+    // The handshaker result takes over impl->ssl.
+    const bool is_server = SSL_is_server(impl->ssl) != 0;
+    const bool session_reused = SSL_session_reused(impl->ssl) != 0;
     status = ssl_handshaker_result_create(impl, unused_bytes, unused_bytes_size,
                                           handshaker_result, error);
     if (status == TSI_OK) {
       // Indicates that the handshake has completed and that a handshaker_result
       // has been created.
       self->handshaker_result_created = true;
+      if (is_server) {
+        tsi_ssl_server_handshaker_factory* factory =
+            reinterpret_cast<tsi_ssl_server_handshaker_factory*>(
+                impl->factory_ref);
+        (session_reused ? factory->resumed_handshakes
+                        : factory->full_handshakes)
+            .fetch_add(1, std::memory_order_relaxed);
+      }
     }
   }
   return status;
@@ -1789,9 +1818,25 @@ static void tsi_ssl_server_handshaker_factory_destroy(
   }
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->key_logger.reset();
+  self->session_ticket_key_provider.reset();
   gpr_free(self);
 }
 
+void tsi_ssl_server_handshaker_factory_get_session_stats(
+    tsi_ssl_server_handshaker_factory* factory,
+    tsi_ssl_server_session_stats* stats) {
+  stats->full_handshakes =
+      factory->full_handshakes.load(std::memory_order_relaxed);
+  stats->resumed_handshakes =
+      factory->resumed_handshakes.load(std::memory_order_relaxed);
+  stats->tickets_issued =
+      factory->tickets_issued.load(std::memory_order_relaxed);
+  stats->tickets_renewed =
+      factory->tickets_renewed.load(std::memory_order_relaxed);
+  stats->tickets_rejected =
+      factory->tickets_rejected.load(std::memory_order_relaxed);
+}
+
 static int does_entry_match_name(absl::string_view entry,
                                  absl::string_view name) {
   if (entry.empty()) return 0;
@@ -1901,6 +1946,78 @@ static int server_handshaker_factory_new_session_callback(
   return 1;
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static bool init_session_ticket_mac(EVP_MAC_CTX* mac_ctx,
+                                    tsi::SslSessionTicketKey* key) {
+  OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key->hmac_key,
+                                        sizeof(key->hmac_key)),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                       const_cast<char*>("SHA256"), 0),
+      OSSL_PARAM_construct_end()};
+  return EVP_MAC_CTX_set_params(mac_ctx, params) == 1;
+}
+#else
+static bool init_session_ticket_mac(HMAC_CTX* mac_ctx,
+                                    tsi::SslSessionTicketKey* key) {
+  return HMAC_Init_ex(mac_ctx, key->hmac_key, sizeof(key->hmac_key),
+                      EVP_sha256(), nullptr) == 1;
+}
+#endif
+
+/// This callback is called on servers with a session ticket key provider,
+/// to set up \a cipher_ctx and \a mac_ctx with the key to encrypt a new
+/// session ticket with if \a encrypt is set, and otherwise with the key named
+/// \a key_name that a ticket presented by the client was encrypted with.
+/// It's intended to be used with SSL_CTX_set_tlsext_ticket_key_cb (or
+/// SSL_CTX_set_tlsext_ticket_key_evp_cb in OpenSSL 3, hence \a MacCtx).
+///
+/// It returns 1 on success, 2 if the ticket should be renewed, 0 if no ticket
+/// is issued or the presented ticket is not accepted, and -1 on error.
+template <typename MacCtx>
+static int server_handshaker_factory_session_ticket_key_callback(
+    SSL* ssl, unsigned char* key_name, unsigned char* iv,
+    EVP_CIPHER_CTX* cipher_ctx, MacCtx* mac_ctx, int encrypt) {
+  SSL_CTX* ssl_context = SSL_get_SSL_CTX(ssl);
+  if (ssl_context == nullptr) return -1;
+  tsi_ssl_server_handshaker_factory* factory =
+      static_cast<tsi_ssl_server_handshaker_factory*>(
+          SSL_CTX_get_ex_data(ssl_context, g_ssl_ctx_ex_factory_index));
+  tsi::SslSessionTicketKeyProvider* provider =
+      factory->session_ticket_key_provider.get();
+  tsi::SslSessionTicketKey key;
+  if (encrypt) {
+    if (!provider->GetEncryptionKey(&key)) return 0;
+    memcpy(key_name, key.name, sizeof(key.name));
+    if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_128_cbc())) != 1 ||
+        EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr,
+                           key.aes_key, iv) != 1 ||
+        !init_session_ticket_mac(mac_ctx, &key)) {
+      return -1;
+    }
+    factory->tickets_issued.fetch_add(1, std::memory_order_relaxed);
+    return 1;
+  }
+  if (!provider->GetDecryptionKey(key_name, &key)) {
+    factory->tickets_rejected.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+  }
+  if (EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr, key.aes_key,
+                         iv) != 1 ||
+      !init_session_ticket_mac(mac_ctx, &key)) {
+    return -1;
+  }
+  // A ticket under an older key is replaced with one under the current key,
+  // which will be accepted for longer.
+  tsi::SslSessionTicketKey current_key;
+  if (provider->GetEncryptionKey(&current_key) &&
+      memcmp(current_key.name, key.name, sizeof(key.name)) != 0) {
+    factory->tickets_renewed.fetch_add(1, std::memory_order_relaxed);
+    return 2;
+  }
+  return 1;
+}
+
 /// This callback is invoked at client or server when ssl/tls handshakes
 /// complete and keylogging is enabled.
 template <typename T>
@@ -2151,6 +2268,17 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
     impl->key_logger = options->key_logger->Ref();
   }
 
+  if (options->session_ticket_key_provider != nullptr) {
+    if (options->session_ticket_key != nullptr) {
+      gpr_log(GPR_ERROR,
+              "Both a session ticket key and a provider of them are set.");
+      tsi_ssl_handshaker_factory_unref(&impl->base);
+      return TSI_INVALID_ARGUMENT;
+    }
+    impl->session_ticket_key_provider =
+        options->session_ticket_key_provider->Ref();
+  }
+
   for (i = 0; i < options->num_key_cert_pairs; i++) {
     do {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -2198,6 +2326,21 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
         }
       }
 
+      if (impl->session_ticket_key_provider != nullptr) {
+        SSL_CTX_set_ex_data(impl->ssl_contexts[i], g_ssl_ctx_ex_factory_index,
+                            impl);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(
+            impl->ssl_contexts[i],
+            server_handshaker_factory_session_ticket_key_callback<
+                EVP_MAC_CTX>);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(
+            impl->ssl_contexts[i],
+            server_handshaker_factory_session_ticket_key_callback<HMAC_CTX>);
+#endif
+      }
+
       if (options->pem_client_root_certs != nullptr) {
         STACK_OF(X509_NAME)* root_names = nullptr;
         result = ssl_ctx_load_verification_certs(
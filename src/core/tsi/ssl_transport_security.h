@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <openssl/x509.h>
 
 #include "absl/strings/string_view.h"
@@ -28,6 +30,7 @@
 #include <grpc/grpc_security_constants.h>
 
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 #include "src/core/tsi/ssl_transport_security_utils.h"
 #include "src/core/tsi/transport_security_interface.h"
 
@@ -313,6 +316,10 @@ struct tsi_ssl_server_handshaker_options {
   const char* session_ticket_key;
   // session_ticket_key_size is a size of session ticket encryption key.
   size_t session_ticket_key_size;
+  // session_ticket_key_provider is an optional source of rotating session
+  // ticket keys, used instead of a fixed session_ticket_key. It must be
+  // nullptr if session_ticket_key is set.
+  tsi::SslSessionTicketKeyProvider* session_ticket_key_provider;
   // The min and max TLS versions that will be negotiated by the handshaker.
   tsi_tls_version min_tls_version;
   tsi_tls_version max_tls_version;
@@ -335,6 +342,7 @@ struct tsi_ssl_server_handshaker_options {
         num_alpn_protocols(0),
         session_ticket_key(nullptr),
         session_ticket_key_size(0),
+        session_ticket_key_provider(nullptr),
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
         key_logger(nullptr),
@@ -368,6 +376,30 @@ tsi_result tsi_ssl_server_handshaker_factory_create_handshaker(
 void tsi_ssl_server_handshaker_factory_unref(
     tsi_ssl_server_handshaker_factory* factory);
 
+// Counts of the handshakes completed by the handshakers of a server factory.
+struct tsi_ssl_server_session_stats {
+  // Handshakes that established a new session.
+  uint64_t full_handshakes;
+  // Handshakes that resumed a session, from a ticket or from the server's
+  // session cache.
+  uint64_t resumed_handshakes;
+  // The following only count tickets handled by a session ticket key
+  // provider.
+  // Session tickets issued to clients.
+  uint64_t tickets_issued;
+  // Tickets accepted under a key that was no longer the current one, and so
+  // re-issued under the current key.
+  uint64_t tickets_renewed;
+  // Tickets whose key was no longer accepted, leading to a full handshake.
+  uint64_t tickets_rejected;
+};
+
+// Gets the session stats of a server handshaker factory, as of the time of the
+// call.
+void tsi_ssl_server_handshaker_factory_get_session_stats(
+    tsi_ssl_server_handshaker_factory* factory,
+    tsi_ssl_server_session_stats* stats);
+
 // Util that checks that an ssl peer matches a specific name.
 // Still TODO(jboeuf):
 // - handle mixed case.
@@ -129,6 +129,9 @@ OpenCensusCallTracer::OpenCensusCallAttemptTracer::OpenCensusCallAttemptTracer(
     context_.AddSpanAttribute("previous-rpc-attempts", attempt_num);
     context_.AddSpanAttribute("transparent-retry", is_transparent_retry);
   }
+  // Per-message annotations are only useful on sampled spans.
+  set_message_events_enabled(parent_->tracing_enabled_ &&
+                             context_.Span().IsSampled());
   if (OpenCensusStatsEnabled()) {
     std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
         context_.tags().tags();
@@ -164,7 +167,6 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordSendMessage(
     const grpc_core::SliceBuffer& send_message) {
   RecordAnnotation(
       absl::StrFormat("Send message: %ld bytes", send_message.Length()));
-  ++sent_message_count_;
 }
 
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::
@@ -178,7 +180,6 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordReceivedMessage(
     const grpc_core::SliceBuffer& recv_message) {
   RecordAnnotation(
       absl::StrFormat("Received message: %ld bytes", recv_message.Length()));
-  ++recv_message_count_;
 }
 
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::
@@ -259,8 +260,8 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordEnd(
     tags.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
     tags.emplace_back(ClientStatusTagKey(), StatusCodeToString(status_code_));
     ::opencensus::stats::Record(
-        {{RpcClientSentMessagesPerRpc(), sent_message_count_},
-         {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
+        {{RpcClientSentMessagesPerRpc(), sent_message_count()},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count()}},
         tags);
     grpc_core::MutexLock lock(&parent_->mu_);
     if (--parent_->num_active_rpcs_ == 0) {
@@ -112,9 +112,6 @@ class OpenCensusCallTracer : public grpc_core::ClientCallTracer {
     experimental::CensusContext context_;
     // Start time (for measuring latency).
     absl::Time start_time_;
-    // Number of messages in this RPC.
-    uint64_t recv_message_count_ = 0;
-    uint64_t sent_message_count_ = 0;
     // End status code
     absl::StatusCode status_code_;
   };
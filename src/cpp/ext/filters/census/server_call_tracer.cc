@@ -100,10 +100,7 @@ class OpenCensusServerCallTracer : public grpc_core::ServerCallTracer {
   // Maximum size of server stats that are sent on the wire.
   static constexpr uint32_t kMaxServerStatsLen = 16;
 
-  OpenCensusServerCallTracer()
-      : start_time_(absl::Now()),
-        recv_message_count_(0),
-        sent_message_count_(0) {}
+  OpenCensusServerCallTracer() : start_time_(absl::Now()) {}
 
   std::string TraceId() override {
     return context_.Context().trace_id().ToHex();
@@ -124,7 +121,6 @@ class OpenCensusServerCallTracer : public grpc_core::ServerCallTracer {
   void RecordSendMessage(const grpc_core::SliceBuffer& send_message) override {
     RecordAnnotation(
         absl::StrFormat("Send message: %ld bytes", send_message.Length()));
-    ++sent_message_count_;
   }
   void RecordSendCompressedMessage(
       const grpc_core::SliceBuffer& send_compressed_message) override {
@@ -139,7 +135,6 @@ class OpenCensusServerCallTracer : public grpc_core::ServerCallTracer {
       const grpc_core::SliceBuffer& recv_message) override {
     RecordAnnotation(
         absl::StrFormat("Received message: %ld bytes", recv_message.Length()));
-    ++recv_message_count_;
   }
   void RecordReceivedDecompressedMessage(
       const grpc_core::SliceBuffer& recv_decompressed_message) override {
@@ -168,8 +163,6 @@ class OpenCensusServerCallTracer : public grpc_core::ServerCallTracer {
   // recv message
   absl::Time start_time_;
   absl::Duration elapsed_time_;
-  uint64_t recv_message_count_;
-  uint64_t sent_message_count_;
   // Buffer needed for grpc_slice to reference it when adding metatdata to
   // response.
   char stats_buf_[kMaxServerStatsLen];
@@ -185,6 +178,8 @@ void OpenCensusServerCallTracer::RecordReceivedInitialMetadata(
   GenerateServerContext(
       tracing_enabled ? sml.tracing_slice.as_string_view() : "",
       absl::StrCat("Recv.", method_), &context_);
+  // Per-message annotations are only useful on sampled spans.
+  set_message_events_enabled(tracing_enabled && context_.Span().IsSampled());
   if (tracing_enabled) {
     auto* call_context = grpc_core::GetContext<grpc_call_context_element>();
     call_context[GRPC_CONTEXT_TRACING].value = &context_;
@@ -229,8 +224,8 @@ void OpenCensusServerCallTracer::RecordEnd(
         {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
          {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
          {RpcServerServerLatency(), elapsed_time_ms},
-         {RpcServerSentMessagesPerRpc(), sent_message_count_},
-         {RpcServerReceivedMessagesPerRpc(), recv_message_count_}},
+         {RpcServerSentMessagesPerRpc(), sent_message_count()},
+         {RpcServerReceivedMessagesPerRpc(), recv_message_count()}},
         tags);
   }
   if (OpenCensusTracingEnabled()) {
@@ -20,8 +20,11 @@
 
 #include "src/cpp/ext/gcp/observability_logging_sink.h"
 
+#include <inttypes.h>
+
 #include <algorithm>
 #include <initializer_list>
+#include <iterator>
 #include <map>
 #include <utility>
 
@@ -237,6 +240,16 @@ void EntryToJsonStructProto(LoggingSink::Entry entry,
 
 namespace {
 
+// Once this much is buffered, new entries are dropped (and counted) rather
+// than logged, so that a slow or unreachable logging backend cannot grow
+// memory without bound or push work onto the RPC path.
+constexpr uint64_t kMaxEntriesBeforeDrop = 100000;
+constexpr uint64_t kMaxMemoryFootprintBeforeDrop = 10 * 1024 * 1024;
+// Once this much is buffered, a flush is started right away instead of
+// waiting for the flush timer.
+constexpr uint64_t kMinEntriesBeforeFlush = 1000;
+constexpr uint64_t kMinMemoryFootprintBeforeFlush = 1 * 1024 * 1024;
+
 uint64_t EstimateEntrySize(const LoggingSink::Entry& entry) {
   uint64_t size = sizeof(entry);
   for (const auto& pair : entry.payload.metadata) {
@@ -254,12 +267,68 @@ uint64_t EstimateEntrySize(const LoggingSink::Entry& entry) {
 }  // namespace
 
 void ObservabilityLoggingSink::LogEntry(Entry entry) {
-  auto entry_size = EstimateEntrySize(entry);
-  grpc_core::MutexLock lock(&mu_);
-  if (sink_closed_) return;
-  entries_.push_back(std::move(entry));
-  entries_memory_footprint_ += entry_size;
-  MaybeTriggerFlushLocked();
+  // Announce this call before looking at sink_closed_, so that FlushAndClose()
+  // either sees it and waits for its entry, or is seen here.
+  active_loggers_.fetch_add(1);
+  if (!sink_closed_.load()) AddEntry(std::move(entry));
+  if (active_loggers_.fetch_sub(1) == 1 && sink_closed_.load()) {
+    grpc_core::MutexLock lock(&mu_);
+    sink_flushed_after_close_.SignalAll();
+  }
+}
+
+void ObservabilityLoggingSink::AddEntry(Entry entry) {
+  const uint64_t entry_size = EstimateEntrySize(entry);
+  if (pending_entries_.load(std::memory_order_relaxed) >=
+          kMaxEntriesBeforeDrop ||
+      pending_memory_footprint_.load(std::memory_order_relaxed) >=
+          kMaxMemoryFootprintBeforeDrop) {
+    if (dropped_entries_.fetch_add(1, std::memory_order_relaxed) == 0) {
+      gpr_log(GPR_ERROR, "Buffer limit reached. Dropping log entries.");
+    }
+    return;
+  }
+  // Count the entry before it becomes visible to the flusher so that the
+  // counters never underflow.
+  const uint64_t pending = pending_entries_.fetch_add(1) + 1;
+  const uint64_t footprint =
+      pending_memory_footprint_.fetch_add(entry_size) + entry_size;
+  {
+    Shard& shard = shards_.this_cpu();
+    grpc_core::MutexLock lock(&shard.mu);
+    shard.entries.push_back(std::move(entry));
+    shard.memory_footprint += entry_size;
+  }
+  if (!flush_scheduled_.load() ||
+      ((pending >= kMinEntriesBeforeFlush ||
+        footprint >= kMinMemoryFootprintBeforeFlush) &&
+       !flush_triggered_.load(std::memory_order_relaxed))) {
+    MaybeTriggerFlush();
+  }
+}
+
+std::vector<LoggingSink::Entry> ObservabilityLoggingSink::TakeEntries() {
+  std::vector<Entry> entries;
+  for (Shard& shard : shards_) {
+    std::vector<Entry> shard_entries;
+    uint64_t shard_footprint;
+    {
+      grpc_core::MutexLock lock(&shard.mu);
+      shard_entries.swap(shard.entries);
+      shard_footprint = shard.memory_footprint;
+      shard.memory_footprint = 0;
+    }
+    pending_entries_.fetch_sub(shard_entries.size());
+    pending_memory_footprint_.fetch_sub(shard_footprint);
+    if (entries.empty()) {
+      entries = std::move(shard_entries);
+    } else {
+      entries.insert(entries.end(),
+                     std::make_move_iterator(shard_entries.begin()),
+                     std::make_move_iterator(shard_entries.end()));
+    }
+  }
+  return entries;
 }
 
 void ObservabilityLoggingSink::RegisterEnvironmentResource(
@@ -271,24 +340,56 @@ void ObservabilityLoggingSink::RegisterEnvironmentResource(
 
 void ObservabilityLoggingSink::FlushAndClose() {
   grpc_core::MutexLock lock(&mu_);
-  sink_closed_ = true;
-  if (entries_.empty()) return;
+  sink_closed_.store(true);
+  // LogEntry() calls that got in before the sink was closed may still be
+  // adding their entries; those have to make it into the final flush.
+  while (active_loggers_.load() != 0) {
+    sink_flushed_after_close_.Wait(&mu_);
+  }
   MaybeTriggerFlushLocked();
-  sink_flushed_after_close_.Wait(&mu_);
+  // Nothing may still be queued to call back into the sink once this returns.
+  if (flush_timer_in_progress_ && event_engine_->Cancel(flush_timer_handle_)) {
+    flush_timer_in_progress_ = false;
+  }
+  while (pending_entries_.load() != 0 || flush_in_progress_ ||
+         flush_timer_in_progress_ ||
+         flush_triggered_.load(std::memory_order_relaxed)) {
+    sink_flushed_after_close_.Wait(&mu_);
+  }
 }
 
-void ObservabilityLoggingSink::Flush() {
+void ObservabilityLoggingSink::SetStubForTesting(
+    std::unique_ptr<google::logging::v2::LoggingServiceV2::StubInterface> stub,
+    const EnvironmentAutoDetect::ResourceType* resource) {
+  grpc_core::MutexLock lock(&mu_);
+  stub_ = std::move(stub);
+  resource_ = resource;
+  event_engine_ = grpc_event_engine::experimental::GetDefaultEventEngine();
+}
+
+void ObservabilityLoggingSink::Flush(bool timed_flush) {
   std::vector<Entry> entries;
   google::logging::v2::LoggingServiceV2::StubInterface* stub = nullptr;
   const EnvironmentAutoDetect::ResourceType* resource = nullptr;
   {
     grpc_core::MutexLock lock(&mu_);
-    if (flush_in_progress_) {
+    // Each kind of trigger only clears its own flag: a triggered flush must
+    // not forget about a timer that is still armed, or a second one would be
+    // started next to it.
+    if (timed_flush) {
+      flush_timer_in_progress_ = false;
+    } else {
+      flush_triggered_.store(false, std::memory_order_relaxed);
+    }
+    // The in-progress flush re-evaluates once it is done.
+    if (flush_in_progress_) return;
+    if (sink_closed_.load() && pending_entries_.load() == 0) {
+      // A trigger left over from before the sink was closed; the final flush
+      // has already been done.
+      sink_flushed_after_close_.SignalAll();
       return;
     }
     flush_in_progress_ = true;
-    flush_timer_in_progress_ = false;
-    flush_triggered_ = false;
     if (stub_ == nullptr) {
       std::string endpoint;
       absl::optional<std::string> endpoint_env =
@@ -310,13 +411,33 @@ void ObservabilityLoggingSink::Flush() {
           CreateCustomChannel(endpoint, GoogleDefaultCredentials(), args));
     }
     stub = stub_.get();
-    entries = std::move(entries_);
-    entries_memory_footprint_ = 0;
     resource = resource_;
   }
+  entries = TakeEntries();
+  const uint64_t dropped = dropped_entries_.exchange(0);
+  if (dropped > 0) {
+    gpr_log(GPR_ERROR,
+            "GCP Observability Logging buffer was full. Dropped %" PRIu64
+            " log entries.",
+            dropped);
+  }
+  if (entries.empty()) {
+    OnFlushDone();
+    return;
+  }
   FlushEntriesHelper(stub, std::move(entries), resource);
 }
 
+void ObservabilityLoggingSink::OnFlushDone() {
+  grpc_core::MutexLock lock(&mu_);
+  flush_in_progress_ = false;
+  if (sink_closed_.load() && pending_entries_.load() == 0) {
+    sink_flushed_after_close_.SignalAll();
+  } else {
+    MaybeTriggerFlushLocked();
+  }
+}
+
 void ObservabilityLoggingSink::FlushEntriesHelper(
     google::logging::v2::LoggingServiceV2::StubInterface* stub,
     std::vector<Entry> entries,
@@ -380,13 +501,7 @@ void ObservabilityLoggingSink::FlushEntriesHelper(
           }
         }
         delete call;
-        grpc_core::MutexLock lock(&mu_);
-        flush_in_progress_ = false;
-        if (sink_closed_ && entries_.empty()) {
-          sink_flushed_after_close_.SignalAll();
-        } else {
-          MaybeTriggerFlushLocked();
-        }
+        OnFlushDone();
       });
 }
 
@@ -396,10 +511,6 @@ void ObservabilityLoggingSink::MaybeTriggerFlush() {
 }
 
 void ObservabilityLoggingSink::MaybeTriggerFlushLocked() {
-  constexpr int kMaxEntriesBeforeDump = 100000;
-  constexpr int kMaxMemoryFootprintBeforeDump = 10 * 1024 * 1024;
-  constexpr int kMinEntriesBeforeFlush = 1000;
-  constexpr int kMinMemoryFootprintBeforeFlush = 1 * 1024 * 1024;
   // Use this opportunity to fetch environment resource if not fetched already
   if (resource_ == nullptr && !registered_env_fetch_notification_) {
     auto& env_autodetect = EnvironmentAutoDetect::Get();
@@ -412,37 +523,33 @@ void ObservabilityLoggingSink::MaybeTriggerFlushLocked() {
       });
     }
   }
-  if (entries_.empty()) return;
-  if (entries_.size() > kMaxEntriesBeforeDump ||
-      entries_memory_footprint_ > kMaxMemoryFootprintBeforeDump) {
-    // Buffer limits have been reached. Dump entries with gpr_log
-    gpr_log(GPR_INFO, "Buffer limit reached. Dumping log entries.");
-    for (auto& entry : entries_) {
-      google::protobuf::Struct proto;
-      std::string timestamp = entry.timestamp.ToString();
-      EntryToJsonStructProto(std::move(entry), &proto);
-      std::string output;
-      ::google::protobuf::TextFormat::PrintToString(proto, &output);
-      gpr_log(GPR_INFO, "Log Entry recorded at time: %s : %s",
-              timestamp.c_str(), output.c_str());
-    }
-    entries_.clear();
-    entries_memory_footprint_ = 0;
-  } else if (resource_ != nullptr && !flush_in_progress_) {
+  // Publish that nothing is scheduled before looking at the pending count:
+  // a concurrent LogEntry() either sees this and comes back here, or has
+  // already counted its entry and is seen below.
+  if (!flush_in_progress_ && !flush_timer_in_progress_ &&
+      !flush_triggered_.load(std::memory_order_relaxed)) {
+    flush_scheduled_.store(false);
+  }
+  const uint64_t pending = pending_entries_.load();
+  if (pending == 0) return;
+  if (resource_ != nullptr && !flush_in_progress_) {
     // Environment resource has been detected. Trigger flush if conditions
     // suffice.
-    if ((entries_.size() >= kMinEntriesBeforeFlush ||
-         entries_memory_footprint_ >= kMinMemoryFootprintBeforeFlush ||
-         sink_closed_) &&
-        !flush_triggered_) {
+    if ((pending >= kMinEntriesBeforeFlush ||
+         pending_memory_footprint_.load() >= kMinMemoryFootprintBeforeFlush ||
+         sink_closed_.load()) &&
+        !flush_triggered_.load(std::memory_order_relaxed)) {
       // It is fine even if there were a flush with a timer in progress. What is
       // important is that a flush is triggered.
-      flush_triggered_ = true;
-      event_engine_->Run([this]() { Flush(); });
+      flush_triggered_.store(true, std::memory_order_relaxed);
+      flush_scheduled_.store(true);
+      event_engine_->Run([this]() { Flush(/*timed_flush=*/false); });
     } else if (!flush_timer_in_progress_) {
       flush_timer_in_progress_ = true;
-      event_engine_->RunAfter(grpc_core::Duration::Seconds(1),
-                              [this]() { Flush(); });
+      flush_scheduled_.store(true);
+      flush_timer_handle_ = event_engine_->RunAfter(
+          grpc_core::Duration::Seconds(1),
+          [this]() { Flush(/*timed_flush=*/true); });
     }
   }
 }
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -38,6 +39,7 @@
 #include <grpc/event_engine/event_engine.h>
 
 #include "src/core/ext/filters/logging/logging_sink.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/cpp/ext/gcp/environment_autodetect.h"
 #include "src/cpp/ext/gcp/observability_config.h"
@@ -63,6 +65,19 @@ class ObservabilityLoggingSink : public grpc_core::LoggingSink {
   // closes the sink preventing any more entries to be logged.
   void FlushAndClose();
 
+  // Exposed for testing purposes. Makes the sink write to \a stub, and use
+  // \a resource instead of detecting the environment.
+  void SetStubForTesting(
+      std::unique_ptr<google::logging::v2::LoggingServiceV2::StubInterface>
+          stub,
+      const EnvironmentAutoDetect::ResourceType* resource);
+  uint64_t pending_entries_for_testing() const {
+    return pending_entries_.load();
+  }
+  uint64_t dropped_entries_for_testing() const {
+    return dropped_entries_.load();
+  }
+
  private:
   struct Configuration {
     explicit Configuration(
@@ -83,15 +98,33 @@ class ObservabilityLoggingSink : public grpc_core::LoggingSink {
 
   // Flushes the currently stored entries. \a timed_flush denotes whether this
   // Flush was triggered from a timer.
-  void Flush();
+  void Flush(bool timed_flush);
   void FlushEntriesHelper(
       google::logging::v2::LoggingServiceV2::StubInterface* stub,
       std::vector<Entry> entries,
       const EnvironmentAutoDetect::ResourceType* resource);
 
+  // Buffers \a entry, or drops it if the buffer is full.
+  void AddEntry(Entry entry);
+
   void MaybeTriggerFlush();
   void MaybeTriggerFlushLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Marks the current flush as finished and schedules the next one, or wakes
+  // up FlushAndClose() once everything has been written.
+  void OnFlushDone();
+
+  // Moves all buffered entries out of the per-cpu shards.
+  std::vector<Entry> TakeEntries();
+
+  // Entries are buffered per cpu so that logging threads only ever contend
+  // with the flusher, never with each other.
+  struct Shard {
+    grpc_core::Mutex mu;
+    std::vector<Entry> entries ABSL_GUARDED_BY(mu);
+    uint64_t memory_footprint ABSL_GUARDED_BY(mu) = 0;
+  };
+
   std::vector<Configuration> client_configs_;
   std::vector<Configuration> server_configs_;
   const std::string project_id_;
@@ -103,14 +136,29 @@ class ObservabilityLoggingSink : public grpc_core::LoggingSink {
       mu_) event_engine_;
   std::unique_ptr<google::logging::v2::LoggingServiceV2::StubInterface> stub_
       ABSL_GUARDED_BY(mu_);
-  std::vector<Entry> entries_ ABSL_GUARDED_BY(mu_);
-  uint64_t entries_memory_footprint_ ABSL_GUARDED_BY(mu_) = 0;
+  grpc_core::PerCpu<Shard> shards_{
+      grpc_core::PerCpuOptions().SetCpusPerShard(2).SetMaxShards(32)};
+  // Totals across shards.  Read on the logging path without taking mu_ to
+  // decide whether to drop an entry or to schedule a flush.
+  std::atomic<uint64_t> pending_entries_{0};
+  std::atomic<uint64_t> pending_memory_footprint_{0};
+  // Entries dropped because the buffer was full; reported by the flusher.
+  std::atomic<uint64_t> dropped_entries_{0};
   const EnvironmentAutoDetect::ResourceType* resource_ ABSL_GUARDED_BY(mu_) =
       nullptr;
-  bool flush_triggered_ ABSL_GUARDED_BY(mu_) = false;
+  // Written under mu_, but also read on the logging path as a hint to skip
+  // taking mu_ when a flush is already on its way.
+  std::atomic<bool> flush_triggered_{false};
+  std::atomic<bool> flush_scheduled_{false};
   bool flush_in_progress_ ABSL_GUARDED_BY(mu_) = false;
   bool flush_timer_in_progress_ ABSL_GUARDED_BY(mu_) = false;
-  bool sink_closed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_event_engine::experimental::EventEngine::TaskHandle flush_timer_handle_
+      ABSL_GUARDED_BY(mu_);
+  std::atomic<bool> sink_closed_{false};
+  // Number of LogEntry() calls currently running.
+  std::atomic<uint64_t> active_loggers_{0};
+  // Signalled when the last active logger leaves a closed sink, and when the
+  // final flush is done.
   grpc_core::CondVar sink_flushed_after_close_;
 };
 
@@ -16,6 +16,8 @@
 //
 //
 
+#include <stdint.h>
+
 #include <vector>
 
 #include <grpc/byte_buffer.h>
@@ -27,6 +29,8 @@
 #include <grpcpp/support/slice.h>
 #include <grpcpp/support/status.h>
 
+#include "src/core/lib/slice/slice_refcount.h"
+
 namespace grpc {
 
 Status ByteBuffer::TrySingleSlice(Slice* slice) const {
@@ -78,4 +82,67 @@ Status ByteBuffer::Dump(std::vector<Slice>* slices) const {
   return Status::OK;
 }
 
+namespace internal {
+
+namespace {
+
+// Contents of every message reference slice: a lone zero byte (field number
+// zero), which protobuf parsers reject.
+const uint8_t kMessageReferenceBytes[1] = {0};
+
+// Refcount of a message reference slice; owns the message.
+class MessageReferenceRefcount : public grpc_slice_refcount {
+ public:
+  MessageReferenceRefcount(void* message, const void* type_tag,
+                           void (*destroy)(void*))
+      : grpc_slice_refcount(Destroy),
+        message_(message),
+        type_tag_(type_tag),
+        destroy_(destroy) {}
+
+  void* message() const { return message_; }
+  const void* type_tag() const { return type_tag_; }
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* self = static_cast<MessageReferenceRefcount*>(p);
+    self->destroy_(self->message_);
+    delete self;
+  }
+
+  void* const message_;
+  const void* const type_tag_;
+  void (*const destroy_)(void*);
+};
+
+}  // namespace
+
+void MakeMessageReference(void* message, const void* type_tag,
+                          void (*destroy)(void*), ByteBuffer* bb) {
+  grpc_slice slice;
+  slice.refcount = new MessageReferenceRefcount(message, type_tag, destroy);
+  slice.data.refcounted.bytes = const_cast<uint8_t*>(kMessageReferenceBytes);
+  slice.data.refcounted.length = sizeof(kMessageReferenceBytes);
+  Slice owned(slice, Slice::STEAL_REF);
+  ByteBuffer tmp(&owned, 1);
+  bb->Swap(&tmp);
+}
+
+void* GetMessageReference(const ByteBuffer& bb, const void* type_tag) {
+  Slice slice;
+  // Only slices made above point at kMessageReferenceBytes, so the refcount
+  // of one that does is known to be a MessageReferenceRefcount.
+  if (!bb.TrySingleSlice(&slice).ok() ||
+      slice.begin() != kMessageReferenceBytes) {
+    return nullptr;
+  }
+  grpc_slice c_slice = slice.c_slice();
+  auto* refcount = static_cast<MessageReferenceRefcount*>(c_slice.refcount);
+  grpc_slice_unref(c_slice);
+  if (refcount->type_tag() != type_tag) return nullptr;
+  return refcount->message();
+}
+
+}  // namespace internal
+
 }  // namespace grpc
@@ -0,0 +1,128 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/channel/call_tracer.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+namespace {
+
+// Counts the per-message Record*() calls it receives.
+class FakeServerCallTracer : public ServerCallTracer {
+ public:
+  void RecordAnnotation(absl::string_view /*annotation*/) override {}
+  std::string TraceId() override { return ""; }
+  std::string SpanId() override { return ""; }
+  bool IsSampled() override { return false; }
+  void RecordSendInitialMetadata(
+      grpc_metadata_batch* /*send_initial_metadata*/) override {}
+  void RecordSendTrailingMetadata(
+      grpc_metadata_batch* /*send_trailing_metadata*/) override {}
+  void RecordSendMessage(const SliceBuffer& /*send_message*/) override {
+    ++record_send_message_calls;
+  }
+  void RecordSendCompressedMessage(
+      const SliceBuffer& /*send_compressed_message*/) override {
+    ++record_send_compressed_message_calls;
+  }
+  void RecordReceivedInitialMetadata(
+      grpc_metadata_batch* /*recv_initial_metadata*/) override {}
+  void RecordReceivedMessage(const SliceBuffer& /*recv_message*/) override {
+    ++record_received_message_calls;
+  }
+  void RecordReceivedDecompressedMessage(
+      const SliceBuffer& /*recv_decompressed_message*/) override {
+    ++record_received_decompressed_message_calls;
+  }
+  void RecordCancel(grpc_error_handle /*cancel_error*/) override {}
+  void RecordReceivedTrailingMetadata(
+      grpc_metadata_batch* /*recv_trailing_metadata*/) override {}
+  void RecordEnd(const grpc_call_final_info* /*final_info*/) override {}
+
+  using ServerCallTracer::set_message_events_enabled;
+
+  int record_send_message_calls = 0;
+  int record_send_compressed_message_calls = 0;
+  int record_received_message_calls = 0;
+  int record_received_decompressed_message_calls = 0;
+};
+
+// Sends and receives two messages, one of them compressed each way.
+void ExchangeMessages(CallTracerInterface* tracer) {
+  SliceBuffer message;
+  tracer->OnSendMessage(message);
+  tracer->OnSendMessage(message);
+  tracer->OnSendCompressedMessage(message);
+  tracer->OnReceivedMessage(message);
+  tracer->OnReceivedMessage(message);
+  tracer->OnReceivedDecompressedMessage(message);
+}
+
+TEST(CallTracerTest, MessageEventsEnabledByDefault) {
+  FakeServerCallTracer tracer;
+  ExchangeMessages(&tracer);
+  EXPECT_EQ(tracer.record_send_message_calls, 2);
+  EXPECT_EQ(tracer.record_send_compressed_message_calls, 1);
+  EXPECT_EQ(tracer.record_received_message_calls, 2);
+  EXPECT_EQ(tracer.record_received_decompressed_message_calls, 1);
+  EXPECT_EQ(tracer.sent_message_count(), 2u);
+  EXPECT_EQ(tracer.recv_message_count(), 2u);
+}
+
+TEST(CallTracerTest, MessageEventsDisabledStillCountsMessages) {
+  FakeServerCallTracer tracer;
+  tracer.set_message_events_enabled(false);
+  ExchangeMessages(&tracer);
+  EXPECT_EQ(tracer.record_send_message_calls, 0);
+  EXPECT_EQ(tracer.record_send_compressed_message_calls, 0);
+  EXPECT_EQ(tracer.record_received_message_calls, 0);
+  EXPECT_EQ(tracer.record_received_decompressed_message_calls, 0);
+  EXPECT_EQ(tracer.sent_message_count(), 2u);
+  EXPECT_EQ(tracer.recv_message_count(), 2u);
+}
+
+TEST(CallTracerTest, MessageEventsReenabled) {
+  FakeServerCallTracer tracer;
+  tracer.set_message_events_enabled(false);
+  ExchangeMessages(&tracer);
+  tracer.set_message_events_enabled(true);
+  ExchangeMessages(&tracer);
+  EXPECT_EQ(tracer.record_send_message_calls, 2);
+  EXPECT_EQ(tracer.record_send_compressed_message_calls, 1);
+  EXPECT_EQ(tracer.record_received_message_calls, 2);
+  EXPECT_EQ(tracer.record_received_decompressed_message_calls, 1);
+  EXPECT_EQ(tracer.sent_message_count(), 4u);
+  EXPECT_EQ(tracer.recv_message_count(), 4u);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -0,0 +1,122 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace internal {
+namespace {
+
+class ServerAdaptiveThrottleDataTest : public ::testing::Test {
+ protected:
+  ServerAdaptiveThrottleDataTest() { SetNow(now_); }
+
+  void SetNow(Timestamp now) { ExecCtx::Get()->TestOnlySetNow(now); }
+
+  void AdvanceClock(Duration duration) {
+    now_ = now_ + duration;
+    SetNow(now_);
+  }
+
+  ExecCtx exec_ctx_;
+  Timestamp now_ = Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+};
+
+TEST_F(ServerAdaptiveThrottleDataTest, DoesNotRejectWhileServerAccepts) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(Duration::Seconds(10), 2);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(throttle_data->RecordRequest());
+    throttle_data->RecordAccept();
+    AdvanceClock(Duration::Milliseconds(1));
+  }
+  EXPECT_EQ(throttle_data->reject_probability(), 0);
+}
+
+TEST_F(ServerAdaptiveThrottleDataTest, RejectionProbability) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(Duration::Seconds(10), 2);
+  // The server accepts 25 out of 100 requests.
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(throttle_data->RecordRequest());
+    if (i % 4 == 0) throttle_data->RecordAccept();
+  }
+  // The probability is recomputed on the next request once it's due.
+  AdvanceClock(Duration::Milliseconds(100));
+  throttle_data->RecordRequest();
+  EXPECT_DOUBLE_EQ(throttle_data->reject_probability(),
+                   (100.0 - 2 * 25) / (100 + 1));
+}
+
+TEST_F(ServerAdaptiveThrottleDataTest, RejectsWhenServerRejects) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(Duration::Seconds(10), 2);
+  for (int i = 0; i < 1000; ++i) throttle_data->RecordRequest();
+  AdvanceClock(Duration::Milliseconds(100));
+  int sent = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (throttle_data->RecordRequest()) ++sent;
+  }
+  // Almost everything is rejected, but a trickle of requests still goes
+  // through to find out when the server recovers.
+  EXPECT_GT(throttle_data->reject_probability(), 0.99);
+  EXPECT_LT(sent, 50);
+}
+
+TEST_F(ServerAdaptiveThrottleDataTest, RecoversAfterWindow) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(Duration::Seconds(10), 2);
+  for (int i = 0; i < 100; ++i) throttle_data->RecordRequest();
+  AdvanceClock(Duration::Milliseconds(100));
+  throttle_data->RecordRequest();
+  EXPECT_GT(throttle_data->reject_probability(), 0.9);
+  // Once the failed requests fall out of the window, nothing is rejected.
+  AdvanceClock(Duration::Seconds(11));
+  EXPECT_TRUE(throttle_data->RecordRequest());
+  EXPECT_EQ(throttle_data->reject_probability(), 0);
+}
+
+TEST(ServerAdaptiveThrottleMap, Replacement) {
+  const std::string kServerName = "server_name";
+  ExecCtx exec_ctx;
+  auto throttle_data = ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+      kServerName, Duration::Seconds(10), 2);
+  // Same parameters return the same data.
+  EXPECT_EQ(throttle_data, ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+                               kServerName, Duration::Seconds(10), 2));
+  // Different parameters start afresh.
+  auto throttle_data2 = ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+      kServerName, Duration::Seconds(10), 1.5);
+  EXPECT_NE(throttle_data, throttle_data2);
+  EXPECT_EQ(throttle_data2->accepts_multiplier(), 1.5);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,212 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/dynamic_filters.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// The filters that channel stacks were built with since the last
+// TakeBuiltFilters(), as "name/instance".
+std::vector<std::string>* g_built_filters;
+
+std::vector<std::string> TakeBuiltFilters() {
+  return std::exchange(*g_built_filters, {});
+}
+
+grpc_error_handle InitChannelElem(grpc_channel_element* elem,
+                                  grpc_channel_element_args* args) {
+  g_built_filters->push_back(absl::StrCat(
+      elem->filter->name, "/",
+      grpc_channel_stack_filter_instance_number(args->channel_stack, elem)));
+  return absl::OkStatus();
+}
+
+grpc_error_handle InitCallElem(grpc_call_element* /*elem*/,
+                               const grpc_call_element_args* /*args*/) {
+  return absl::OkStatus();
+}
+
+void DestroyCallElem(grpc_call_element* /*elem*/,
+                     const grpc_call_final_info* /*final_info*/,
+                     grpc_closure* /*then_schedule_closure*/) {}
+
+void DestroyChannelElem(grpc_channel_element* /*elem*/) {}
+
+grpc_channel_filter MakeFilter(const char* name) {
+  return {grpc_call_next_op,
+          nullptr,
+          grpc_channel_next_op,
+          0,
+          InitCallElem,
+          grpc_call_stack_ignore_set_pollset_or_pollset_set,
+          DestroyCallElem,
+          0,
+          InitChannelElem,
+          grpc_channel_stack_no_post_init,
+          DestroyChannelElem,
+          grpc_channel_next_get_info,
+          name};
+}
+
+const grpc_channel_filter kFilterA = MakeFilter("a");
+const grpc_channel_filter kFilterB = MakeFilter("b");
+const grpc_channel_filter kTerminalFilter = MakeFilter("terminal");
+
+class DynamicFiltersTest : public ::testing::Test {
+ protected:
+  DynamicFiltersTest() { g_built_filters = new std::vector<std::string>(); }
+  ~DynamicFiltersTest() override {
+    delete g_built_filters;
+    g_built_filters = nullptr;
+  }
+
+  static ChannelArgs Args() {
+    return CoreConfiguration::Get()
+        .channel_args_preconditioning()
+        .PreconditionChannelArgs(nullptr);
+  }
+
+  ExecCtx exec_ctx_;
+  ServiceConfigParser::ParsedConfigVector method_configs_1_;
+  ServiceConfigParser::ParsedConfigVector method_configs_2_;
+  ServiceConfigParser::ParsedConfigVector method_configs_3_;
+};
+
+TEST_F(DynamicFiltersTest, NoPredicateAlwaysUsesFullStack) {
+  auto dynamic_filters =
+      DynamicFilters::Create(Args(), {&kFilterA, &kTerminalFilter});
+  EXPECT_EQ(TakeBuiltFilters(),
+            std::vector<std::string>({"a/0", "terminal/0"}));
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_1_), dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(nullptr), dynamic_filters);
+  EXPECT_TRUE(TakeBuiltFilters().empty());
+}
+
+TEST_F(DynamicFiltersTest, LeavesOutNoopFilters) {
+  const auto* method_configs_1 = &method_configs_1_;
+  auto dynamic_filters = DynamicFilters::Create(
+      Args(), {&kFilterA, &kFilterB, &kTerminalFilter},
+      {[method_configs_1](
+           size_t index,
+           const ServiceConfigParser::ParsedConfigVector* method_configs) {
+         return index == 1 && method_configs == method_configs_1;
+       },
+       {{nullptr, &method_configs_1_}, {nullptr, &method_configs_2_}}});
+  // The specialized stack is built up front.
+  EXPECT_EQ(TakeBuiltFilters(),
+            std::vector<std::string>(
+                {"a/0", "b/0", "terminal/0", "a/0", "terminal/0"}));
+  auto specialized = dynamic_filters->ForMethod(&method_configs_1_);
+  EXPECT_NE(specialized, dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_1_), specialized);
+  // Other method configs keep every filter.
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_2_), dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(nullptr), dynamic_filters);
+  EXPECT_TRUE(TakeBuiltFilters().empty());
+}
+
+TEST_F(DynamicFiltersTest, UnlistedMethodConfigsUseFullStack) {
+  auto dynamic_filters = DynamicFilters::Create(
+      Args(), {&kFilterA, &kFilterB, &kTerminalFilter},
+      {[](size_t index,
+          const ServiceConfigParser::ParsedConfigVector* /*method_configs*/) {
+         return index == 1;
+       },
+       {{nullptr, &method_configs_1_}}});
+  TakeBuiltFilters();
+  EXPECT_NE(dynamic_filters->ForMethod(&method_configs_1_), dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_2_), dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(nullptr), dynamic_filters);
+  EXPECT_TRUE(TakeBuiltFilters().empty());
+}
+
+TEST_F(DynamicFiltersTest, MethodConfigsLeavingOutSameFiltersShareStack) {
+  const auto* method_configs_3 = &method_configs_3_;
+  auto dynamic_filters = DynamicFilters::Create(
+      Args(), {&kFilterA, &kFilterB, &kTerminalFilter},
+      {[method_configs_3](
+           size_t index,
+           const ServiceConfigParser::ParsedConfigVector* method_configs) {
+         return index == 0 && method_configs != method_configs_3;
+       },
+       {{nullptr, &method_configs_1_},
+        {nullptr, &method_configs_2_},
+        {nullptr, &method_configs_3_}}});
+  EXPECT_EQ(TakeBuiltFilters(),
+            std::vector<std::string>(
+                {"a/0", "b/0", "terminal/0", "b/0", "terminal/0"}));
+  auto specialized = dynamic_filters->ForMethod(&method_configs_1_);
+  EXPECT_NE(specialized, dynamic_filters);
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_2_), specialized);
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_3_), dynamic_filters);
+}
+
+TEST_F(DynamicFiltersTest, KeepsInstanceNumbersOfRemainingFilters) {
+  const auto* method_configs_1 = &method_configs_1_;
+  // The first instance of filter a is a no-op for method_configs_1_ and the
+  // second one is a no-op for the other method configs.
+  auto dynamic_filters = DynamicFilters::Create(
+      Args(), {&kFilterA, &kFilterA, &kTerminalFilter},
+      {[method_configs_1](
+           size_t index,
+           const ServiceConfigParser::ParsedConfigVector* method_configs) {
+         return index == (method_configs == method_configs_1 ? 0 : 1);
+       },
+       {{nullptr, &method_configs_1_}, {nullptr, &method_configs_2_}}});
+  // Leaving out the first instance would make the second one use the first
+  // one's config, so only the stack for method_configs_2_, without the last
+  // instance, is built.
+  EXPECT_EQ(TakeBuiltFilters(),
+            std::vector<std::string>(
+                {"a/0", "a/1", "terminal/0", "a/0", "terminal/0"}));
+  EXPECT_EQ(dynamic_filters->ForMethod(&method_configs_1_), dynamic_filters);
+  EXPECT_NE(dynamic_filters->ForMethod(&method_configs_2_), dynamic_filters);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,239 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the cost of a pick, including the call tracker's Start() and
+// Finish(), for least_request compared to round_robin.
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
+#include "absl/types/variant.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+#include <grpc/support/json.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/security/credentials/credentials.h"
+#include "src/core/lib/uri/uri_parser.h"
+
+namespace grpc_core {
+namespace {
+
+// A subchannel that reports whatever state the benchmark tells it to.
+class FakeSubchannel : public SubchannelInterface {
+ public:
+  void WatchConnectivityState(
+      std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+    watcher_ = std::move(watcher);
+  }
+
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface* watcher) override {
+    if (watcher_.get() == watcher) watcher_.reset();
+  }
+
+  void RequestConnection() override {}
+  void ResetBackoff() override {}
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface>) override {}
+  void CancelDataWatcher(DataWatcherInterface*) override {}
+
+  void SetConnectivityState(grpc_connectivity_state state) {
+    if (watcher_ != nullptr) {
+      watcher_->OnConnectivityStateChange(state, absl::OkStatus());
+    }
+  }
+
+ private:
+  std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+};
+
+// Creates fake subchannels and keeps the latest READY picker.
+class FakeHelper : public LoadBalancingPolicy::ChannelControlHelper {
+ public:
+  FakeHelper(std::vector<RefCountedPtr<FakeSubchannel>>* subchannels,
+             RefCountedPtr<LoadBalancingPolicy::SubchannelPicker>* picker)
+      : subchannels_(subchannels), picker_(picker) {}
+
+  RefCountedPtr<SubchannelInterface> CreateSubchannel(
+      ServerAddress /*address*/, const ChannelArgs& /*args*/) override {
+    auto subchannel = MakeRefCounted<FakeSubchannel>();
+    subchannels_->push_back(subchannel);
+    return subchannel;
+  }
+
+  void UpdateState(
+      grpc_connectivity_state state, const absl::Status& /*status*/,
+      RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker) override {
+    if (state == GRPC_CHANNEL_READY) *picker_ = std::move(picker);
+  }
+
+  void RequestReresolution() override {}
+  absl::string_view GetAuthority() override { return "server.example.com"; }
+  RefCountedPtr<grpc_channel_credentials> GetChannelCredentials() override {
+    return nullptr;
+  }
+  RefCountedPtr<grpc_channel_credentials> GetUnsafeChannelCredentials()
+      override {
+    return nullptr;
+  }
+  grpc_event_engine::experimental::EventEngine* GetEventEngine() override {
+    return event_engine_.get();
+  }
+  void AddTraceEvent(TraceSeverity, absl::string_view) override {}
+
+ private:
+  std::vector<RefCountedPtr<FakeSubchannel>>* subchannels_;
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker>* picker_;
+  std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine_ =
+      grpc_event_engine::experimental::GetDefaultEventEngine();
+};
+
+// An LB policy with num_subchannels READY subchannels.
+class Fixture {
+ public:
+  Fixture(absl::string_view policy_name, int num_subchannels) {
+    ExecCtx exec_ctx;
+    LoadBalancingPolicy::Args args = {
+        work_serializer_,
+        std::make_unique<FakeHelper>(&subchannels_, &picker_), ChannelArgs()};
+    lb_policy_ =
+        CoreConfiguration::Get().lb_policy_registry().CreateLoadBalancingPolicy(
+            policy_name, std::move(args));
+    GPR_ASSERT(lb_policy_ != nullptr);
+    auto config =
+        CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+            Json::FromArray({Json::FromObject(
+                {{std::string(policy_name), Json::FromObject({})}})}));
+    GPR_ASSERT(config.ok());
+    LoadBalancingPolicy::UpdateArgs update;
+    update.addresses.emplace();
+    for (int i = 0; i < num_subchannels; ++i) {
+      auto uri = URI::Parse(absl::StrCat("ipv4:127.0.0.1:", 1000 + i));
+      GPR_ASSERT(uri.ok());
+      grpc_resolved_address address;
+      GPR_ASSERT(grpc_parse_uri(*uri, &address));
+      update.addresses->emplace_back(address, ChannelArgs());
+    }
+    update.config = std::move(*config);
+    RunInWorkSerializer([&]() {
+      GPR_ASSERT(lb_policy_->UpdateLocked(std::move(update)).ok());
+    });
+    RunInWorkSerializer([&]() {
+      for (auto& subchannel : subchannels_) {
+        subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+        subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+      }
+    });
+    GPR_ASSERT(picker_ != nullptr);
+  }
+
+  ~Fixture() {
+    ExecCtx exec_ctx;
+    picker_.reset();
+    RunInWorkSerializer([&]() { lb_policy_.reset(); });
+  }
+
+  LoadBalancingPolicy::SubchannelPicker* picker() const {
+    return picker_.get();
+  }
+
+ private:
+  void RunInWorkSerializer(std::function<void()> fn) {
+    absl::Notification done;
+    work_serializer_->Run(
+        [&]() {
+          fn();
+          done.Notify();
+        },
+        DEBUG_LOCATION);
+    done.WaitForNotification();
+  }
+
+  std::shared_ptr<WorkSerializer> work_serializer_ =
+      std::make_shared<WorkSerializer>();
+  std::vector<RefCountedPtr<FakeSubchannel>> subchannels_;
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker_;
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+};
+
+void BM_Pick(benchmark::State& state, absl::string_view policy_name) {
+  Fixture fixture(policy_name, state.range(0));
+  LoadBalancingPolicy::SubchannelPicker* picker = fixture.picker();
+  for (auto _ : state) {
+    auto result = picker->Pick({"/service/method", nullptr, nullptr});
+    auto* complete = absl::get_if<LoadBalancingPolicy::PickResult::Complete>(
+        &result.result);
+    GPR_ASSERT(complete != nullptr);
+    if (complete->subchannel_call_tracker != nullptr) {
+      complete->subchannel_call_tracker->Start();
+      complete->subchannel_call_tracker->Finish(
+          {"", absl::OkStatus(), nullptr, nullptr});
+    }
+  }
+}
+
+void BM_LeastRequestPick(benchmark::State& state) {
+  BM_Pick(state, "least_request");
+}
+BENCHMARK(BM_LeastRequestPick)->RangeMultiplier(10)->Range(2, 1000);
+
+void BM_RoundRobinPick(benchmark::State& state) {
+  BM_Pick(state, "round_robin");
+}
+BENCHMARK(BM_RoundRobinPick)->RangeMultiplier(10)->Range(2, 1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,155 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/json.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+#include "test/core/client_channel/lb_policy/power_of_choices_test_lib.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class LeastRequestTest : public PowerOfChoicesTest {
+ protected:
+  LeastRequestTest() : PowerOfChoicesTest("least_request") {}
+
+  static RefCountedPtr<LoadBalancingPolicy::Config> MakeLeastRequestConfig(
+      uint32_t choice_count = 2) {
+    return MakeConfig(Json::FromArray({Json::FromObject(
+        {{"least_request",
+          Json::FromObject(
+              {{"choiceCount", Json::FromNumber(choice_count)}})}})}));
+  }
+};
+
+TEST_F(LeastRequestTest, Basic) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = ExpectStartup(kAddresses, MakeLeastRequestConfig());
+  ASSERT_NE(picker, nullptr);
+  // With no calls in flight, picks are spread over all addresses.
+  auto counts = PickCounts(picker.get(), 300);
+  EXPECT_EQ(counts.size(), kAddresses.size());
+}
+
+TEST_F(LeastRequestTest, AvoidsLoadedSubchannel) {
+  const std::array<absl::string_view, 2> kAddresses = {"ipv4:127.0.0.1:441",
+                                                       "ipv4:127.0.0.1:442"};
+  auto picker = ExpectStartup(kAddresses, MakeLeastRequestConfig());
+  ASSERT_NE(picker, nullptr);
+  // Leave one call outstanding on whichever address is picked.
+  std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface> tracker;
+  auto loaded = ExpectPickComplete(picker.get(), {}, &tracker);
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_NE(tracker, nullptr);
+  tracker->Start();
+  // The loaded address now only wins when both choices land on it, which
+  // happens for a quarter of the picks.
+  auto counts = PickCounts(picker.get(), 1000);
+  EXPECT_LT(counts[*loaded], 400u);
+  // Once the call finishes, both addresses are equally likely again.
+  FakeMetadata metadata({});
+  FakeBackendMetricAccessor backend_metric_accessor({});
+  tracker->Finish({*loaded, absl::OkStatus(), &metadata,
+                   &backend_metric_accessor});
+  counts = PickCounts(picker.get(), 1000);
+  EXPECT_GT(counts[*loaded], 350u);
+}
+
+TEST_F(LeastRequestTest, BalancesOutstandingCalls) {
+  const std::array<absl::string_view, 4> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443",
+      "ipv4:127.0.0.1:444"};
+  auto picker =
+      ExpectStartup(kAddresses, MakeLeastRequestConfig(/*choice_count=*/3));
+  ASSERT_NE(picker, nullptr);
+  // Start a batch of calls without finishing any of them: each new call
+  // should go to one of the least loaded addresses sampled, which keeps
+  // the outstanding counts close together.
+  std::vector<
+      std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>>
+      trackers;
+  std::map<std::string, size_t> outstanding;
+  for (size_t i = 0; i < 400; ++i) {
+    std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+        tracker;
+    auto address = ExpectPickComplete(picker.get(), {}, &tracker);
+    ASSERT_TRUE(address.has_value());
+    ASSERT_NE(tracker, nullptr);
+    tracker->Start();
+    ++outstanding[*address];
+    trackers.push_back(std::move(tracker));
+  }
+  ASSERT_EQ(outstanding.size(), kAddresses.size());
+  for (const auto& p : outstanding) {
+    EXPECT_GT(p.second, 80u) << p.first;
+    EXPECT_LT(p.second, 120u) << p.first;
+  }
+  FakeMetadata metadata({});
+  FakeBackendMetricAccessor backend_metric_accessor({});
+  for (auto& tracker : trackers) {
+    tracker->Finish(
+        {"", absl::OkStatus(), &metadata, &backend_metric_accessor});
+  }
+}
+
+TEST(LeastRequestConfigTest, InvalidChoiceCount) {
+  auto config =
+      CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+          Json::FromArray({Json::FromObject(
+              {{"least_request",
+                Json::FromObject({{"choiceCount", Json::FromNumber(1)}})}})}));
+  ASSERT_FALSE(config.ok());
+  EXPECT_EQ(config.status().message(),
+            "errors validating least_request LB policy config: "
+            "[field:choiceCount error:must be at least 2]")
+      << config.status();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
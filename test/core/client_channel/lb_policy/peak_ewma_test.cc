@@ -0,0 +1,154 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/json.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+#include "test/core/client_channel/lb_policy/power_of_choices_test_lib.h"
+#include "test/core/util/test_config.h"
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// The policy measures call latency with gpr_now(), so the tests add a
+// controllable offset to the real clock to simulate slow calls.
+gpr_timespec (*g_real_now_impl)(gpr_clock_type);
+std::atomic<int64_t> g_clock_offset_ms{0};
+
+gpr_timespec now_impl(gpr_clock_type clock_type) {
+  gpr_timespec now = g_real_now_impl(clock_type);
+  if (clock_type == GPR_TIMESPAN) return now;
+  return gpr_time_add(now, gpr_time_from_millis(g_clock_offset_ms.load(),
+                                                GPR_TIMESPAN));
+}
+
+void AdvanceClock(int64_t ms) { g_clock_offset_ms.fetch_add(ms); }
+
+class PeakEwmaTest : public PowerOfChoicesTest {
+ protected:
+  PeakEwmaTest() : PowerOfChoicesTest("peak_ewma") {}
+
+  static RefCountedPtr<LoadBalancingPolicy::Config> MakePeakEwmaConfig() {
+    return MakeConfig(Json::FromArray({Json::FromObject(
+        {{"peak_ewma",
+          Json::FromObject({{"decayTime", Json::FromString("10s")},
+                            {"defaultRtt", Json::FromString("0.030s")}})}})}));
+  }
+
+  // Sends one call through picker that takes latency_ms to complete, and
+  // returns the address it went to.
+  absl::optional<std::string> DoCall(
+      LoadBalancingPolicy::SubchannelPicker* picker, int64_t latency_ms) {
+    std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+        tracker;
+    auto address = ExpectPickComplete(picker, {}, &tracker);
+    EXPECT_TRUE(address.has_value());
+    EXPECT_NE(tracker, nullptr);
+    if (!address.has_value() || tracker == nullptr) return absl::nullopt;
+    tracker->Start();
+    AdvanceClock(latency_ms);
+    FakeMetadata metadata({});
+    FakeBackendMetricAccessor backend_metric_accessor({});
+    tracker->Finish(
+        {*address, absl::OkStatus(), &metadata, &backend_metric_accessor});
+    return address;
+  }
+};
+
+TEST_F(PeakEwmaTest, Basic) {
+  const std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  auto picker = ExpectStartup(kAddresses, MakePeakEwmaConfig());
+  ASSERT_NE(picker, nullptr);
+  // Without latency samples, picks are spread over all addresses.
+  auto counts = PickCounts(picker.get(), 300);
+  EXPECT_EQ(counts.size(), kAddresses.size());
+}
+
+TEST_F(PeakEwmaTest, AvoidsSlowSubchannel) {
+  const std::array<absl::string_view, 2> kAddresses = {"ipv4:127.0.0.1:441",
+                                                       "ipv4:127.0.0.1:442"};
+  auto picker = ExpectStartup(kAddresses, MakePeakEwmaConfig());
+  ASSERT_NE(picker, nullptr);
+  // A single slow response is enough to move traffic away from an address,
+  // since the estimate jumps straight to a sample above it.
+  auto slow = DoCall(picker.get(), 1000);
+  ASSERT_TRUE(slow.has_value());
+  // The slow address now only wins when both choices land on it, which
+  // happens for a quarter of the picks.
+  auto counts = PickCounts(picker.get(), 1000);
+  EXPECT_LT(counts[*slow], 400u);
+  // Without further samples the estimate decays, and after a few decay
+  // times the address is cheaper than one that was never measured.
+  AdvanceClock(100000);
+  counts = PickCounts(picker.get(), 1000);
+  EXPECT_GT(counts[*slow], 600u);
+}
+
+TEST(PeakEwmaConfigTest, InvalidConfig) {
+  auto config =
+      CoreConfiguration::Get().lb_policy_registry().ParseLoadBalancingConfig(
+          Json::FromArray({Json::FromObject(
+              {{"peak_ewma",
+                Json::FromObject({{"choiceCount", Json::FromNumber(1)},
+                                  {"decayTime", Json::FromString("0s")}})}})}));
+  ASSERT_FALSE(config.ok());
+  EXPECT_EQ(config.status().message(),
+            "errors validating peak_ewma LB policy config: ["
+            "field:choiceCount error:must be at least 2; "
+            "field:decayTime error:must be greater than 0]")
+      << config.status();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::testing::g_real_now_impl = gpr_now_impl;
+  gpr_now_impl = grpc_core::testing::now_impl;
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,111 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_TEST_CORE_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_TEST_LIB_H
+#define GRPC_TEST_CORE_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_TEST_LIB_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "test/core/client_channel/lb_policy/lb_policy_test_lib.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Fixture for policies that pick the least loaded of a few READY
+// subchannels sampled at random (least_request, peak_ewma).
+class PowerOfChoicesTest : public LoadBalancingPolicyTest {
+ protected:
+  explicit PowerOfChoicesTest(absl::string_view policy_name)
+      : lb_policy_(MakeLbPolicy(policy_name)) {}
+
+  // Returns the number of picks that went to each address.
+  std::map<std::string, size_t> PickCounts(
+      LoadBalancingPolicy::SubchannelPicker* picker, size_t num_picks) {
+    std::map<std::string, size_t> counts;
+    auto picks = GetCompletePicks(picker, num_picks);
+    EXPECT_TRUE(picks.has_value());
+    if (!picks.has_value()) return counts;
+    for (const auto& address : *picks) ++counts[address];
+    return counts;
+  }
+
+  // Brings up the addresses one at a time, and returns a picker that
+  // uses all of them.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> ExpectStartup(
+      absl::Span<const absl::string_view> addresses,
+      RefCountedPtr<LoadBalancingPolicy::Config> config) {
+    EXPECT_EQ(ApplyUpdate(BuildUpdate(addresses, std::move(config)),
+                          lb_policy_.get()),
+              absl::OkStatus());
+    ExpectConnectingUpdate();
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker;
+    for (size_t i = 0; i < addresses.size(); ++i) {
+      auto* subchannel = FindSubchannel(addresses[i]);
+      EXPECT_NE(subchannel, nullptr) << "Address: " << addresses[i];
+      if (subchannel == nullptr) return nullptr;
+      EXPECT_TRUE(subchannel->ConnectionRequested());
+      subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+      subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+      if (i == 0) {
+        picker = WaitForConnected();
+        ExpectRoundRobinPicks(picker.get(), {addresses[0]});
+        continue;
+      }
+      // Accept any number of READY updates that don't yet use the newly
+      // connected subchannel, followed by one that does.
+      const std::set<std::string> expected(addresses.begin(),
+                                           addresses.begin() + i + 1);
+      WaitForStateUpdate([&](FakeHelper::StateUpdate update) {
+        EXPECT_EQ(update.state, GRPC_CHANNEL_READY);
+        if (update.state != GRPC_CHANNEL_READY) return false;
+        std::set<std::string> actual;
+        for (const auto& p : PickCounts(update.picker.get(), 50 * (i + 1))) {
+          actual.insert(p.first);
+        }
+        if (actual.size() < expected.size()) return true;
+        EXPECT_EQ(actual, expected) << absl::StrJoin(actual, ", ");
+        picker = std::move(update.picker);
+        return false;
+      });
+    }
+    return picker;
+  }
+
+  OrphanablePtr<LoadBalancingPolicy> lb_policy_;
+};
+
+}  // namespace testing
+}  // namespace grpc_core
+
+#endif  // GRPC_TEST_CORE_CLIENT_CHANNEL_LB_POLICY_POWER_OF_CHOICES_TEST_LIB_H
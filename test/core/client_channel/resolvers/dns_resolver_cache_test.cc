@@ -0,0 +1,244 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/notification.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_factory.h"
+#include "src/core/lib/resolver/resolver_registry.h"
+#include "src/core/lib/uri/uri_parser.h"
+#include "test/core/util/test_config.h"
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
+namespace grpc_core {
+namespace {
+
+// The cache reads the time with gpr_now(), so the tests add a controllable
+// offset to the real clock instead of waiting for entries to age.
+gpr_timespec (*g_real_now_impl)(gpr_clock_type);
+std::atomic<int64_t> g_clock_offset_ms{0};
+
+gpr_timespec NowImpl(gpr_clock_type clock_type) {
+  gpr_timespec now = g_real_now_impl(clock_type);
+  if (clock_type == GPR_TIMESPAN) return now;
+  return gpr_time_add(now, gpr_time_from_millis(g_clock_offset_ms.load(),
+                                                GPR_TIMESPAN));
+}
+
+void AdvanceClock(int64_t ms) { g_clock_offset_ms.fetch_add(ms); }
+
+grpc_ares_request* (*g_default_dns_lookup_ares)(
+    const char* dns_server, const char* name, const char* default_port,
+    grpc_pollset_set* interested_parties, grpc_closure* on_done,
+    std::unique_ptr<ServerAddressList>* addresses, int query_timeout_ms);
+
+// Number of hostname lookups that actually reached c-ares.
+std::atomic<int> g_resolution_count{0};
+
+grpc_ares_request* TestDnsLookupAres(
+    const char* dns_server, const char* name, const char* default_port,
+    grpc_pollset_set* interested_parties, grpc_closure* on_done,
+    std::unique_ptr<ServerAddressList>* addresses, int query_timeout_ms) {
+  g_resolution_count.fetch_add(1);
+  return g_default_dns_lookup_ares(dns_server, name, default_port,
+                                   interested_parties, on_done, addresses,
+                                   query_timeout_ms);
+}
+
+class ResultHandler : public Resolver::ResultHandler {
+ public:
+  explicit ResultHandler(Notification* done) : done_(done) {}
+
+  void ReportResult(Resolver::Result result) override {
+    EXPECT_TRUE(result.addresses.ok()) << result.addresses.status();
+    if (result.addresses.ok()) {
+      EXPECT_EQ(result.addresses->size(), 1);
+    }
+    if (result.result_health_callback != nullptr) {
+      result.result_health_callback(absl::OkStatus());
+    }
+    done_->Notify();
+  }
+
+ private:
+  Notification* done_;
+};
+
+class DnsResolverCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override { g_resolution_count.store(0); }
+
+  // Creates and starts a dns resolver for target.  Must be called from
+  // within work_serializer_.
+  OrphanablePtr<Resolver> StartResolver(const char* target, Notification* done,
+                                        int cache_ttl_ms = 60 * 1000) {
+    ResolverFactory* factory = CoreConfiguration::Get()
+                                   .resolver_registry()
+                                   .LookupResolverFactory("dns");
+    absl::StatusOr<URI> uri = URI::Parse(target);
+    EXPECT_TRUE(uri.ok()) << uri.status();
+    ResolverArgs args;
+    args.uri = std::move(*uri);
+    args.work_serializer = work_serializer_;
+    args.result_handler = std::make_unique<ResultHandler>(done);
+    args.args =
+        ChannelArgs()
+            .Set(GRPC_ARG_DNS_CACHE_TTL_MS, cache_ttl_ms)
+            .SetObject(grpc_event_engine::experimental::GetDefaultEventEngine());
+    OrphanablePtr<Resolver> resolver = factory->CreateResolver(std::move(args));
+    resolver->StartLocked();
+    return resolver;
+  }
+
+  // Resolves target with a fresh resolver and waits for the result.
+  void Resolve(const char* target, int cache_ttl_ms) {
+    // The cache reads the time from the ExecCtx.
+    ExecCtx::Get()->InvalidateNow();
+    Notification done;
+    OrphanablePtr<Resolver> resolver;
+    work_serializer_->Run(
+        [&]() { resolver = StartResolver(target, &done, cache_ttl_ms); },
+        DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+    done.WaitForNotification();
+    work_serializer_->Run([&]() { resolver.reset(); }, DEBUG_LOCATION);
+    ExecCtx::Get()->Flush();
+  }
+
+  std::shared_ptr<WorkSerializer> work_serializer_ =
+      std::make_shared<WorkSerializer>();
+};
+
+TEST_F(DnsResolverCacheTest, ConcurrentLookupsShareOneQuery) {
+  ExecCtx exec_ctx;
+  Notification done[2];
+  OrphanablePtr<Resolver> resolvers[2];
+  work_serializer_->Run(
+      [&]() {
+        resolvers[0] = StartResolver("dns:127.0.0.1:1001", &done[0]);
+        resolvers[1] = StartResolver("dns:127.0.0.1:1001", &done[1]);
+      },
+      DEBUG_LOCATION);
+  ExecCtx::Get()->Flush();
+  done[0].WaitForNotification();
+  done[1].WaitForNotification();
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  work_serializer_->Run(
+      [&]() {
+        resolvers[0].reset();
+        resolvers[1].reset();
+      },
+      DEBUG_LOCATION);
+  ExecCtx::Get()->Flush();
+}
+
+TEST_F(DnsResolverCacheTest, LaterLookupIsServedFromCache) {
+  ExecCtx exec_ctx;
+  Notification first_done;
+  OrphanablePtr<Resolver> first;
+  work_serializer_->Run(
+      [&]() { first = StartResolver("dns:127.0.0.1:1002", &first_done); },
+      DEBUG_LOCATION);
+  ExecCtx::Get()->Flush();
+  first_done.WaitForNotification();
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  // A second channel to the same name after the first lookup has finished
+  // must not go back to DNS.
+  Notification second_done;
+  OrphanablePtr<Resolver> second;
+  work_serializer_->Run(
+      [&]() { second = StartResolver("dns:127.0.0.1:1002", &second_done); },
+      DEBUG_LOCATION);
+  ExecCtx::Get()->Flush();
+  second_done.WaitForNotification();
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  work_serializer_->Run(
+      [&]() {
+        first.reset();
+        second.reset();
+      },
+      DEBUG_LOCATION);
+  ExecCtx::Get()->Flush();
+}
+
+TEST_F(DnsResolverCacheTest, ExpiredEntryIsLookedUpAgain) {
+  constexpr int kTtlMs = 10000;
+  ExecCtx exec_ctx;
+  Resolve("dns:127.0.0.1:1003", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  Resolve("dns:127.0.0.1:1003", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  AdvanceClock(kTtlMs + 1000);
+  Resolve("dns:127.0.0.1:1003", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 2);
+}
+
+TEST_F(DnsResolverCacheTest, RefreshesInBackgroundNearExpiry) {
+  constexpr int kTtlMs = 10000;
+  ExecCtx exec_ctx;
+  Resolve("dns:127.0.0.1:1004", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  // Before 75% of the TTL, the cache is used as is.
+  AdvanceClock(kTtlMs / 2);
+  Resolve("dns:127.0.0.1:1004", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 1);
+  // Past 75% but before expiry, the cached result is still returned right
+  // away, and a new lookup starts behind it.
+  AdvanceClock(kTtlMs * 3 / 10);
+  Resolve("dns:127.0.0.1:1004", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 2);
+  // After the original expiry, the refreshed entry is served without going
+  // back to DNS.
+  AdvanceClock(kTtlMs * 4 / 10);
+  Resolve("dns:127.0.0.1:1004", kTtlMs);
+  EXPECT_EQ(g_resolution_count.load(), 2);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::g_real_now_impl = gpr_now_impl;
+  gpr_now_impl = grpc_core::NowImpl;
+  grpc_init();
+  grpc_core::g_default_dns_lookup_ares = grpc_dns_lookup_hostname_ares;
+  grpc_dns_lookup_hostname_ares = grpc_core::TestDnsLookupAres;
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -32,24 +33,70 @@
 namespace grpc_core {
 namespace testing {
 
-class Snapshot {
- public:
-  std::unique_ptr<GlobalStats> delta() {
-    auto now = global_stats().Collect();
-    return now->Diff(*begin_);
-  }
-
- private:
-  std::unique_ptr<GlobalStats> begin_ = global_stats().Collect();
-};
-
 TEST(StatsTest, IncSpecificCounter) {
-  std::unique_ptr<Snapshot> snapshot(new Snapshot);
+  GlobalStatsSnapshot snapshot;
 
   ExecCtx exec_ctx;
   global_stats().IncrementClientCallsCreated();
 
-  EXPECT_EQ(snapshot->delta()->client_calls_created, 1);
+  EXPECT_EQ(snapshot.Delta()->client_calls_created, 1);
+}
+
+TEST(StatsTest, NextIntervalAdvancesSnapshot) {
+  GlobalStatsSnapshot snapshot;
+
+  ExecCtx exec_ctx;
+  global_stats().IncrementSyscallWrite();
+  global_stats().IncrementSyscallWrite();
+  EXPECT_EQ(snapshot.NextInterval()->syscall_write, 2);
+  global_stats().IncrementSyscallWrite();
+  EXPECT_EQ(snapshot.NextInterval()->syscall_write, 1);
+  EXPECT_EQ(snapshot.Delta()->syscall_write, 0);
+}
+
+TEST(StatsTest, PrometheusText) {
+  GlobalStats stats;
+  stats.syscall_write = 7;
+  auto text = StatsAsPrometheus(&stats);
+  EXPECT_NE(text.find("# TYPE grpc_syscall_write_total counter\n"
+                      "grpc_syscall_write_total 7\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("# TYPE grpc_tcp_write_size histogram\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("grpc_tcp_write_size_bucket{le=\"+Inf\"} 0\n"
+                      "grpc_tcp_write_size_count 0\n"),
+            std::string::npos)
+      << text;
+}
+
+TEST(StatsTest, PrometheusHelpIsEscaped) {
+  const uint64_t counters[] = {1};
+  const absl::string_view counter_name[] = {"foo"};
+  const absl::string_view counter_doc[] = {"a\\b\nc"};
+  auto text = stats_detail::StatsAsPrometheus(counters, counter_name,
+                                              counter_doc, {}, {}, {});
+  EXPECT_EQ(text,
+            "# HELP grpc_foo_total a\\\\b\\nc\n"
+            "# TYPE grpc_foo_total counter\n"
+            "grpc_foo_total 1\n");
+}
+
+TEST(StatsTest, PrometheusHistogramBucketsAreCumulative) {
+  ExecCtx exec_ctx;
+  GlobalStatsSnapshot snapshot;
+  global_stats().IncrementTcpWriteIovSize(0);
+  global_stats().IncrementTcpWriteIovSize(1000);
+  auto text = StatsAsPrometheus(snapshot.Delta().get());
+  // Bucket 0 holds only the value 0; everything lands in +Inf.
+  EXPECT_NE(text.find("grpc_tcp_write_iov_size_bucket{le=\"0\"} 1\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("grpc_tcp_write_iov_size_bucket{le=\"+Inf\"} 2\n"
+                      "grpc_tcp_write_iov_size_count 2\n"),
+            std::string::npos)
+      << text;
 }
 
 TEST(StatsTest, IncrementHttp2MetadataSize) {
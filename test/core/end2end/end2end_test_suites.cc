@@ -196,6 +196,20 @@ class FakesecFixture : public SecureFixture {
   }
 };
 
+class SslHandshakeOffloadFixture : public SslTlsFixture {
+ public:
+  SslHandshakeOffloadFixture() : SslTlsFixture(grpc_tls_version::TLS1_3) {}
+
+ private:
+  ChannelArgs MutateClientArgs(ChannelArgs args) override {
+    return SslTlsFixture::MutateClientArgs(args).Set(
+        GRPC_ARG_TSI_HANDSHAKE_OFFLOAD, true);
+  }
+  ChannelArgs MutateServerArgs(ChannelArgs args) override {
+    return args.Set(GRPC_ARG_TSI_HANDSHAKE_OFFLOAD, true);
+  }
+};
+
 class InsecureCredsFixture : public InsecureFixture {
  private:
   grpc_server_credentials* MakeServerCreds(const ChannelArgs& args) override {
@@ -290,6 +304,18 @@ class NoRetryFixture : public InsecureFixture {
   }
 };
 
+class WriteCoalescingFixture : public InsecureFixture {
+ private:
+  ChannelArgs MutateClientArgs(ChannelArgs args) override {
+    return args.Set(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES, 64 * 1024)
+        .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US, 1000);
+  }
+  ChannelArgs MutateServerArgs(ChannelArgs args) override {
+    return args.Set(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES, 64 * 1024)
+        .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US, 1000);
+  }
+};
+
 class HttpProxyFilter : public CoreTestFixture {
  public:
   explicit HttpProxyFilter(const ChannelArgs& client_args)
@@ -656,6 +682,15 @@ std::vector<CoreTestConfiguration> AllConfigs() {
                                  const ChannelArgs& /*server_args*/) {
                                 return std::make_unique<NoRetryFixture>();
                               }},
+        CoreTestConfiguration{"Chttp2FullstackWriteCoalescing",
+                              FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL |
+                                  FEATURE_MASK_IS_HTTP2 |
+                                  FEATURE_MASK_DO_NOT_FUZZ,
+                              nullptr,
+                              [](const ChannelArgs&, const ChannelArgs&) {
+                                return std::make_unique<
+                                    WriteCoalescingFixture>();
+                              }},
         CoreTestConfiguration{
             "Chttp2FullstackWithCensus",
             FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL | FEATURE_MASK_IS_HTTP2,
@@ -739,6 +774,17 @@ std::vector<CoreTestConfiguration> AllConfigs() {
             [](const ChannelArgs&, const ChannelArgs&) {
               return std::make_unique<SslTlsFixture>(grpc_tls_version::TLS1_3);
             }},
+        CoreTestConfiguration{
+            "Chttp2SimplSslFullstackHandshakeOffload",
+            FEATURE_MASK_IS_SECURE |
+                FEATURE_MASK_SUPPORTS_PER_CALL_CREDENTIALS |
+                FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL |
+                FEATURE_MASK_DOES_NOT_SUPPORT_CLIENT_HANDSHAKE_COMPLETE_FIRST |
+                FEATURE_MASK_IS_HTTP2 | FEATURE_MASK_DO_NOT_FUZZ,
+            "foo.test.google.fr",
+            [](const ChannelArgs&, const ChannelArgs&) {
+              return std::make_unique<SslHandshakeOffloadFixture>();
+            }},
         CoreTestConfiguration{
             "Chttp2SocketPair",
             FEATURE_MASK_IS_HTTP2 | FEATURE_MASK_DO_NOT_FUZZ, nullptr,
@@ -44,12 +44,13 @@ class SslTlsFixture : public SecureFixture {
     return "src/core/tsi/test_creds/server1.key";
   }
 
- private:
+ protected:
   grpc_core::ChannelArgs MutateClientArgs(
       grpc_core::ChannelArgs args) override {
     return args.Set(GRPC_SSL_TARGET_NAME_OVERRIDE_ARG, "foo.test.google.fr");
   }
 
+ private:
   grpc_channel_credentials* MakeClientCreds(
       const grpc_core::ChannelArgs&) override {
     grpc_channel_credentials* ssl_creds =
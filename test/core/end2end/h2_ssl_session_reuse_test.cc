@@ -37,9 +37,13 @@
 #include "src/core/lib/config/config_vars.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/load_file.h"
+#include "src/core/lib/security/credentials/ssl/ssl_credentials.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 #include "test/core/end2end/cq_verifier.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -56,7 +60,10 @@ namespace {
 
 gpr_timespec five_seconds_time() { return grpc_timeout_seconds_to_deadline(5); }
 
-grpc_server* server_create(grpc_completion_queue* cq, const char* server_addr) {
+grpc_server* server_create(
+    grpc_completion_queue* cq, const char* server_addr,
+    grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider>
+        session_ticket_key_provider = nullptr) {
   grpc_slice ca_slice, cert_slice, key_slice;
   GPR_ASSERT(GRPC_LOG_IF_ERROR("load_file",
                                grpc_load_file(CA_CERT_PATH, 1, &ca_slice)));
@@ -74,6 +81,11 @@ grpc_server* server_create(grpc_completion_queue* cq, const char* server_addr) {
   grpc_server_credentials* server_creds = grpc_ssl_server_credentials_create_ex(
       ca_cert, &pem_cert_key_pair, 1,
       GRPC_SSL_REQUEST_CLIENT_CERTIFICATE_AND_VERIFY, nullptr);
+  if (session_ticket_key_provider != nullptr) {
+    static_cast<grpc_ssl_server_credentials*>(server_creds)
+        ->set_session_ticket_key_provider(
+            std::move(session_ticket_key_provider));
+  }
 
   grpc_server* server = grpc_server_create(nullptr, nullptr);
   grpc_server_register_completion_queue(server, cq, nullptr);
@@ -252,6 +264,17 @@ void drain_cq(grpc_completion_queue* cq) {
   } while (ev.type != GRPC_QUEUE_SHUTDOWN);
 }
 
+void server_shutdown(grpc_completion_queue* cq, grpc_server* server) {
+  grpc_server_shutdown_and_notify(server, cq, grpc_core::CqVerifier::tag(1000));
+  grpc_event ev;
+  do {
+    ev = grpc_completion_queue_next(cq, grpc_timeout_seconds_to_deadline(5),
+                                    nullptr);
+  } while (ev.type != GRPC_OP_COMPLETE ||
+           ev.tag != grpc_core::CqVerifier::tag(1000));
+  grpc_server_destroy(server);
+}
+
 TEST(H2SessionReuseTest, SingleReuse) {
   int port = grpc_pick_unused_port_or_die();
 
@@ -272,14 +295,44 @@ TEST(H2SessionReuseTest, SingleReuse) {
                  cq, grpc_timeout_milliseconds_to_deadline(100), nullptr)
                  .type == GRPC_QUEUE_TIMEOUT);
 
-  grpc_server_shutdown_and_notify(server, cq, grpc_core::CqVerifier::tag(1000));
-  grpc_event ev;
-  do {
-    ev = grpc_completion_queue_next(cq, grpc_timeout_seconds_to_deadline(5),
-                                    nullptr);
-  } while (ev.type != GRPC_OP_COMPLETE ||
-           ev.tag != grpc_core::CqVerifier::tag(1000));
-  grpc_server_destroy(server);
+  server_shutdown(cq, server);
+
+  grpc_completion_queue_shutdown(cq);
+  drain_cq(cq);
+  grpc_completion_queue_destroy(cq);
+}
+
+// A client moving to another server resumes its session there only if both
+// servers get their session ticket keys from the same provider.
+TEST(H2SessionReuseTest, ReuseAcrossServersSharingTicketKeys) {
+  std::string server_addr_1 =
+      grpc_core::JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+  std::string server_addr_2 =
+      grpc_core::JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+  std::string server_addr_3 =
+      grpc_core::JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_ssl_session_cache* cache = grpc_ssl_session_cache_create_lru(16);
+
+  auto provider =
+      grpc_core::MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(
+          grpc_core::Duration::Hours(1), 2);
+  grpc_server* server_1 = server_create(cq, server_addr_1.c_str(), provider);
+  grpc_server* server_2 = server_create(cq, server_addr_2.c_str(), provider);
+  grpc_server* server_3 = server_create(cq, server_addr_3.c_str());
+
+  // The client caches sessions by target name, which is overridden to be the
+  // same for all servers.
+  do_round_trip(cq, server_1, server_addr_1.c_str(), cache, false);
+  do_round_trip(cq, server_2, server_addr_2.c_str(), cache, true);
+  do_round_trip(cq, server_3, server_addr_3.c_str(), cache, false);
+
+  grpc_ssl_session_cache_destroy(cache);
+
+  server_shutdown(cq, server_1);
+  server_shutdown(cq, server_2);
+  server_shutdown(cq, server_3);
 
   grpc_completion_queue_shutdown(cq);
   drain_cq(cq);
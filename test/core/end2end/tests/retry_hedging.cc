@@ -0,0 +1,105 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/end2end_tests.h"
+
+namespace grpc_core {
+namespace {
+
+// Tests a basic hedging scenario:
+// - 2 attempts allowed with no hedging delay, UNAVAILABLE is non-fatal
+// - both attempts are started right away
+// - one attempt returns UNAVAILABLE
+// - the other attempt returns OK
+CORE_END2END_TEST(RetryTest, RetryHedging) {
+  InitServer(ChannelArgs());
+  InitClient(
+      ChannelArgs()
+          .Set(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING, true)
+          .Set(GRPC_ARG_SERVICE_CONFIG,
+               "{\n"
+               "  \"methodConfig\": [ {\n"
+               "    \"name\": [\n"
+               "      { \"service\": \"service\", \"method\": \"method\" }\n"
+               "    ],\n"
+               "    \"hedgingPolicy\": {\n"
+               "      \"maxAttempts\": 2,\n"
+               "      \"hedgingDelay\": \"0s\",\n"
+               "      \"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ]\n"
+               "    }\n"
+               "  } ]\n"
+               "}"));
+  auto c =
+      NewClientCall("/service/method").Timeout(Duration::Seconds(5)).Create();
+  IncomingStatusOnClient server_status;
+  IncomingMetadata server_initial_metadata;
+  IncomingMessage server_message;
+  c.NewBatch(1)
+      .SendInitialMetadata({})
+      .SendMessage("foo")
+      .RecvMessage(server_message)
+      .SendCloseFromClient()
+      .RecvInitialMetadata(server_initial_metadata)
+      .RecvStatusOnClient(server_status);
+  // Both attempts reach the server without waiting for either to fail.
+  auto s = RequestCall(101);
+  Expect(101, true);
+  Step();
+  auto s2 = RequestCall(201);
+  Expect(201, true);
+  Step();
+  // Each attempt carries its own position in the hedge.
+  EXPECT_NE(s.GetInitialMetadata("grpc-previous-rpc-attempts"),
+            s2.GetInitialMetadata("grpc-previous-rpc-attempts"));
+  IncomingCloseOnServer client_close;
+  s.NewBatch(102)
+      .SendInitialMetadata({})
+      .SendStatusFromServer(GRPC_STATUS_UNAVAILABLE, "xyz", {})
+      .RecvCloseOnServer(client_close);
+  Expect(102, true);
+  Step();
+  IncomingMessage client_message2;
+  s2.NewBatch(202)
+      .SendInitialMetadata({})
+      .RecvMessage(client_message2)
+      .SendMessage("bar");
+  IncomingCloseOnServer client_close2;
+  s2.NewBatch(203)
+      .SendStatusFromServer(GRPC_STATUS_OK, "xyz", {})
+      .RecvCloseOnServer(client_close2);
+  Expect(202, true);
+  Expect(203, true);
+  Expect(1, true);
+  Step();
+  EXPECT_EQ(server_status.status(), GRPC_STATUS_OK);
+  EXPECT_EQ(server_status.message(), "xyz");
+  EXPECT_EQ(client_message2.payload(), "foo");
+  EXPECT_EQ(server_message.payload(), "bar");
+  EXPECT_FALSE(client_close2.was_cancelled());
+}
+
+}  // namespace
+}  // namespace grpc_core
@@ -30,6 +30,7 @@
 #include "src/core/lib/event_engine/posix_engine/timer.h"
 #include "src/core/lib/gprpp/time.h"
 
+using testing::AnyNumber;
 using testing::Mock;
 using testing::Return;
 using testing::StrictMock;
@@ -239,6 +240,169 @@ TEST(TimerListTest, LongRunningServiceCleanup) {
   EXPECT_TRUE(timer_list.TimerCancel(&timers[3]));
 }
 
+TEST(TimerWheelTest, Add) {
+  Timer timers[20];
+  StrictMock<MockClosure> closures[20];
+
+  const auto kStart =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(100);
+
+  StrictMock<MockHost> host;
+  EXPECT_CALL(host, Kick()).Times(AnyNumber());
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
+  TimerWheel timer_wheel(&host);
+
+  // 10 ms timers.  land in the innermost level
+  for (int i = 0; i < 10; i++) {
+    timer_wheel.TimerInit(&timers[i],
+                          kStart + grpc_core::Duration::Milliseconds(10),
+                          &closures[i]);
+  }
+
+  // 1010 ms timers.  have to cascade down from an outer level
+  for (int i = 10; i < 20; i++) {
+    timer_wheel.TimerInit(&timers[i],
+                          kStart + grpc_core::Duration::Milliseconds(1010),
+                          &closures[i]);
+  }
+
+  // collect timers.  Only the first batch should be ready.
+  EXPECT_CALL(host, Now())
+      .WillOnce(Return(kStart + grpc_core::Duration::Milliseconds(500)));
+  for (int i = 0; i < 10; i++) {
+    EXPECT_CALL(closures[i], Run());
+  }
+  grpc_core::Timestamp next = grpc_core::Timestamp::InfFuture();
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(&next)),
+            CheckResult::kTimersFired);
+  // The wheel may ask to be woken early to cascade the outer slot, but never
+  // after the earliest pending deadline.
+  EXPECT_GT(next, kStart + grpc_core::Duration::Milliseconds(500));
+  EXPECT_LE(next, kStart + grpc_core::Duration::Milliseconds(1010));
+  for (int i = 0; i < 10; i++) {
+    Mock::VerifyAndClearExpectations(&closures[i]);
+  }
+
+  EXPECT_CALL(host, Now())
+      .WillOnce(Return(kStart + grpc_core::Duration::Milliseconds(1009)));
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kCheckedAndEmpty);
+
+  // collect the rest of the timers
+  EXPECT_CALL(host, Now())
+      .WillOnce(Return(kStart + grpc_core::Duration::Milliseconds(1010)));
+  for (int i = 10; i < 20; i++) {
+    EXPECT_CALL(closures[i], Run());
+  }
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kTimersFired);
+  for (int i = 10; i < 20; i++) {
+    Mock::VerifyAndClearExpectations(&closures[i]);
+  }
+
+  EXPECT_CALL(host, Now())
+      .WillOnce(Return(kStart + grpc_core::Duration::Milliseconds(1600)));
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kCheckedAndEmpty);
+}
+
+// Timers spread over every level of the wheel, plus one far enough out to sit
+// in the overflow list, must each fire on the first check at or after their
+// deadline and never before.
+TEST(TimerWheelTest, CascadesAcrossLevels) {
+  const grpc_core::Duration kDelays[] = {
+      grpc_core::Duration::Milliseconds(3),
+      grpc_core::Duration::Milliseconds(70),
+      grpc_core::Duration::Seconds(5),
+      grpc_core::Duration::Minutes(10),
+      grpc_core::Duration::Hours(2),
+      grpc_core::Duration::Hours(30),
+  };
+  constexpr size_t kNumTimers = sizeof(kDelays) / sizeof(kDelays[0]);
+  Timer timers[kNumTimers];
+  StrictMock<MockClosure> closures[kNumTimers];
+
+  const auto kStart =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(12345);
+
+  StrictMock<MockHost> host;
+  EXPECT_CALL(host, Kick()).Times(AnyNumber());
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
+  TimerWheel timer_wheel(&host);
+  for (size_t i = 0; i < kNumTimers; i++) {
+    timer_wheel.TimerInit(&timers[i], kStart + kDelays[i], &closures[i]);
+  }
+
+  for (size_t i = 0; i < kNumTimers; i++) {
+    EXPECT_CALL(host, Now())
+        .WillOnce(Return(kStart + kDelays[i] -
+                         grpc_core::Duration::Milliseconds(1)));
+    EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+              CheckResult::kCheckedAndEmpty);
+    EXPECT_CALL(host, Now()).WillOnce(Return(kStart + kDelays[i]));
+    EXPECT_CALL(closures[i], Run());
+    EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+              CheckResult::kTimersFired);
+    Mock::VerifyAndClearExpectations(&closures[i]);
+  }
+}
+
+TEST(TimerWheelTest, Cancel) {
+  Timer timers[4];
+  StrictMock<MockClosure> closures[4];
+
+  const auto kStart = grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(0);
+
+  StrictMock<MockHost> host;
+  EXPECT_CALL(host, Kick()).Times(AnyNumber());
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
+  TimerWheel timer_wheel(&host);
+  timer_wheel.TimerInit(
+      &timers[0], kStart + grpc_core::Duration::Milliseconds(1), &closures[0]);
+  timer_wheel.TimerInit(
+      &timers[1], kStart + grpc_core::Duration::Milliseconds(1), &closures[1]);
+  timer_wheel.TimerInit(
+      &timers[2], kStart + grpc_core::Duration::Seconds(100), &closures[2]);
+  timer_wheel.TimerInit(&timers[3], kStart + k25Days, &closures[3]);
+
+  EXPECT_TRUE(timer_wheel.TimerCancel(&timers[1]));
+  EXPECT_FALSE(timer_wheel.TimerCancel(&timers[1]));
+
+  EXPECT_CALL(host, Now())
+      .WillOnce(Return(kStart + grpc_core::Duration::Milliseconds(2)));
+  EXPECT_CALL(closures[0], Run());
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kTimersFired);
+  EXPECT_FALSE(timer_wheel.TimerCancel(&timers[0]));
+  EXPECT_TRUE(timer_wheel.TimerCancel(&timers[2]));
+  EXPECT_TRUE(timer_wheel.TimerCancel(&timers[3]));
+
+  // Nothing is left to fire once the cancelled deadlines have passed.
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart + k25Days));
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kCheckedAndEmpty);
+}
+
+// Deadlines that are already in the past fire on the next check.
+TEST(TimerWheelTest, PastDeadline) {
+  Timer timer;
+  StrictMock<MockClosure> closure;
+
+  const auto kStart =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+
+  StrictMock<MockHost> host;
+  EXPECT_CALL(host, Kick()).Times(AnyNumber());
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
+  TimerWheel timer_wheel(&host);
+  timer_wheel.TimerInit(&timer, kStart - grpc_core::Duration::Milliseconds(500),
+                        &closure);
+  EXPECT_CALL(host, Now()).WillOnce(Return(kStart));
+  EXPECT_CALL(closure, Run());
+  EXPECT_EQ(FinishCheck(timer_wheel.TimerCheck(nullptr)),
+            CheckResult::kTimersFired);
+}
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
 
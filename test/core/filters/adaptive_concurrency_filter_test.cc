@@ -0,0 +1,232 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/adaptive_concurrency/adaptive_concurrency_filter.h"
+
+#include <stdint.h>
+
+#include <chrono>
+
+#include "absl/status/status.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/filters/filter_test.h"
+
+using ::testing::_;
+
+namespace grpc_core {
+namespace {
+
+constexpr int64_t kNsPerMs = 1000000;
+
+AdaptiveConcurrencyLimiter::Options TestOptions() {
+  AdaptiveConcurrencyLimiter::Options options;
+  options.initial_limit = 20;
+  options.min_limit = 5;
+  options.max_limit = 200;
+  // Close a window on every completed call.
+  options.min_window_samples = 1;
+  options.window_duration = Duration::Zero();
+  return options;
+}
+
+// Fills the limiter up to its limit, then completes all of the calls with
+// the given latency.  Returns the limit afterwards.
+uint32_t RunWindow(AdaptiveConcurrencyLimiter* limiter, int64_t* now_ns,
+                   int64_t latency_ns) {
+  uint32_t admitted = 0;
+  while (limiter->TryAcquire()) ++admitted;
+  EXPECT_EQ(admitted, limiter->limit());
+  for (uint32_t i = 0; i < admitted; ++i) {
+    *now_ns += kNsPerMs;
+    limiter->Release(*now_ns, latency_ns);
+  }
+  EXPECT_EQ(limiter->in_flight(), 0u);
+  return limiter->limit();
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, RejectsCallsOverLimit) {
+  AdaptiveConcurrencyLimiter limiter(TestOptions());
+  for (uint32_t i = 0; i < 20; ++i) EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_FALSE(limiter.TryAcquire());
+  EXPECT_DOUBLE_EQ(limiter.utilization(), 1.0);
+  // A cancelled call frees its slot without affecting the limit.
+  limiter.Release(0, -1);
+  EXPECT_EQ(limiter.limit(), 20u);
+  EXPECT_TRUE(limiter.TryAcquire());
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, GrowsWhileLatencyIsStable) {
+  AdaptiveConcurrencyLimiter limiter(TestOptions());
+  int64_t now_ns = 0;
+  uint32_t limit = limiter.limit();
+  for (int i = 0; i < 20; ++i) {
+    const uint32_t new_limit = RunWindow(&limiter, &now_ns, kNsPerMs);
+    EXPECT_GE(new_limit, limit);
+    limit = new_limit;
+  }
+  EXPECT_GT(limit, 40u);
+  EXPECT_LE(limit, 200u);
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, ShrinksWhenLatencyRises) {
+  AdaptiveConcurrencyLimiter limiter(TestOptions());
+  int64_t now_ns = 0;
+  for (int i = 0; i < 10; ++i) RunWindow(&limiter, &now_ns, kNsPerMs);
+  const uint32_t stable_limit = limiter.limit();
+  // Calls queue up behind each other, and take ten times as long.
+  RunWindow(&limiter, &now_ns, 10 * kNsPerMs);
+  EXPECT_LT(limiter.limit(), stable_limit / 2);
+  EXPECT_GE(limiter.limit(), 5u);
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, DoesNotGrowWhenUnderused) {
+  AdaptiveConcurrencyLimiter limiter(TestOptions());
+  int64_t now_ns = 0;
+  // Only ever one call in flight: there's no evidence the server could
+  // take more than the initial limit.
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(limiter.TryAcquire());
+    now_ns += kNsPerMs;
+    limiter.Release(now_ns, kNsPerMs);
+  }
+  EXPECT_EQ(limiter.limit(), 20u);
+}
+
+using AdaptiveConcurrencyFilterTest = FilterTest<AdaptiveConcurrencyFilter>;
+
+TEST_F(AdaptiveConcurrencyFilterTest, RejectsCallsOverLimit) {
+  auto channel =
+      MakeChannel(ChannelArgs()
+                      .Set(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MIN_LIMIT, 1)
+                      .Set(GRPC_ARG_SERVER_ADAPTIVE_CONCURRENCY_MAX_LIMIT, 1));
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  Call first(*channel);
+  EXPECT_EVENT(Started(&first, _));
+  first.Start(first.NewClientMetadata());
+  // The second call is turned away without reaching the next filter.
+  Call second(*channel);
+  second.Start(second.NewClientMetadata());
+  EXPECT_EVENT(Finished(&second, HasMetadataResult(absl::ResourceExhaustedError(
+                                     "Server concurrency limit reached"))));
+  Step();
+  // Once the first call finishes, there's room for another.
+  first.FinishNextFilter(first.NewServerMetadata());
+  EXPECT_EVENT(Finished(&first, _));
+  Step();
+  Call third(*channel);
+  EXPECT_EVENT(Started(&third, _));
+  third.Start(third.NewClientMetadata());
+}
+
+// Runs calls through the filter with all but one of the slots needed for
+// the limit to be re-evaluated already held, and with the long term
+// latency settled at 1ms.  A single sample then decides the new limit.
+class AdaptiveConcurrencyFilterLatencyTest
+    : public AdaptiveConcurrencyFilterTest {
+ protected:
+  AdaptiveConcurrencyFilterLatencyTest() {
+    AdaptiveConcurrencyLimiter::Options options = TestOptions();
+    options.min_limit = 1;
+    options.max_limit = 20;
+    options.smoothing = 1;
+    limiter_ = MakeRefCounted<AdaptiveConcurrencyLimiter>(options);
+    for (int i = 0; i < 10; ++i) EXPECT_TRUE(limiter_->TryAcquire());
+    for (int i = 0; i < 10; ++i) limiter_->Release(i * kNsPerMs, kNsPerMs);
+    EXPECT_EQ(limiter_->limit(), 20u);
+    for (int i = 0; i < 9; ++i) EXPECT_TRUE(limiter_->TryAcquire());
+  }
+
+  ~AdaptiveConcurrencyFilterLatencyTest() override {
+    for (int i = 0; i < 9; ++i) limiter_->Release(0, -1);
+  }
+
+  absl::StatusOr<Channel> MakeChannel() {
+    return AdaptiveConcurrencyFilterTest::MakeChannel(
+        ChannelArgs().SetObject(limiter_));
+  }
+
+  // Lets time pass on the test's clock.
+  void AdvanceTime(std::chrono::milliseconds duration) {
+    event_engine()->RunAfter(duration, []() {});
+    Step();
+  }
+
+  RefCountedPtr<AdaptiveConcurrencyLimiter> limiter_;
+};
+
+TEST_F(AdaptiveConcurrencyFilterLatencyTest, SlowResponseShrinksLimit) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  Call call(*channel);
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata());
+  AdvanceTime(std::chrono::seconds(1));
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  Step();
+  call.FinishNextFilter(call.NewServerMetadata());
+  EXPECT_EVENT(Finished(&call, _));
+  Step();
+  EXPECT_LT(limiter_->limit(), 20u);
+}
+
+TEST_F(AdaptiveConcurrencyFilterLatencyTest,
+       SlowTrailersOnlyResponseShrinksLimit) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  Call call(*channel);
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata());
+  AdvanceTime(std::chrono::seconds(1));
+  call.FinishNextFilter(call.NewServerMetadata());
+  EXPECT_EVENT(Finished(&call, _));
+  Step();
+  EXPECT_LT(limiter_->limit(), 20u);
+}
+
+// A long-lived stream that started responding right away isn't a sign of
+// overload.
+TEST_F(AdaptiveConcurrencyFilterLatencyTest, LongStreamKeepsLimit) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  Call call(*channel);
+  EXPECT_EVENT(Started(&call, _));
+  call.Start(call.NewClientMetadata());
+  call.ForwardServerInitialMetadata(call.NewServerMetadata());
+  EXPECT_EVENT(ForwardedServerInitialMetadata(&call, _));
+  Step();
+  AdvanceTime(std::chrono::seconds(1));
+  call.FinishNextFilter(call.NewServerMetadata());
+  EXPECT_EVENT(Finished(&call, _));
+  Step();
+  EXPECT_EQ(limiter_->limit(), 20u);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
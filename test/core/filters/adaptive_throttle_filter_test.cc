@@ -0,0 +1,225 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
+
+#include <chrono>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle.h"
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/filters/filter_test.h"
+
+using ::testing::_;
+
+namespace grpc_core {
+namespace {
+
+//
+// AdaptiveThrottleServiceConfigParser
+//
+
+TEST(AdaptiveThrottleServiceConfigParserTest, Defaults) {
+  auto service_config =
+      ServiceConfigImpl::Create(ChannelArgs(), "{\"adaptiveThrottling\": {}}");
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* config =
+      static_cast<const internal::AdaptiveThrottleGlobalConfig*>(
+          (*service_config)
+              ->GetGlobalParsedConfig(
+                  internal::AdaptiveThrottleServiceConfigParser::
+                      ParserIndex()));
+  ASSERT_NE(config, nullptr);
+  EXPECT_EQ(config->window(), Duration::Minutes(2));
+  EXPECT_EQ(config->accepts_multiplier(), 2);
+}
+
+TEST(AdaptiveThrottleServiceConfigParserTest, NotSet) {
+  auto service_config = ServiceConfigImpl::Create(ChannelArgs(), "{}");
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  EXPECT_EQ((*service_config)
+                ->GetGlobalParsedConfig(
+                    internal::AdaptiveThrottleServiceConfigParser::
+                        ParserIndex()),
+            nullptr);
+}
+
+TEST(AdaptiveThrottleServiceConfigParserTest, Valid) {
+  auto service_config = ServiceConfigImpl::Create(
+      ChannelArgs(),
+      "{\"adaptiveThrottling\": {\"window\": \"30s\", "
+      "\"acceptsMultiplier\": 1}}");
+  ASSERT_TRUE(service_config.ok()) << service_config.status();
+  const auto* config =
+      static_cast<const internal::AdaptiveThrottleGlobalConfig*>(
+          (*service_config)
+              ->GetGlobalParsedConfig(
+                  internal::AdaptiveThrottleServiceConfigParser::
+                      ParserIndex()));
+  ASSERT_NE(config, nullptr);
+  EXPECT_EQ(config->window(), Duration::Seconds(30));
+  EXPECT_EQ(config->accepts_multiplier(), 1);
+}
+
+TEST(AdaptiveThrottleServiceConfigParserTest, WindowNotPositive) {
+  auto service_config = ServiceConfigImpl::Create(
+      ChannelArgs(), "{\"adaptiveThrottling\": {\"window\": \"0s\"}}");
+  EXPECT_EQ(service_config.status().message(),
+            "errors validating service config: ["
+            "field:adaptiveThrottling.window error:must be greater than 0]")
+      << service_config.status();
+}
+
+TEST(AdaptiveThrottleServiceConfigParserTest, AcceptsMultiplierBelowOne) {
+  auto service_config = ServiceConfigImpl::Create(
+      ChannelArgs(), "{\"adaptiveThrottling\": {\"acceptsMultiplier\": 0.5}}");
+  EXPECT_EQ(service_config.status().message(),
+            "errors validating service config: ["
+            "field:adaptiveThrottling.acceptsMultiplier "
+            "error:must be at least 1]")
+      << service_config.status();
+}
+
+TEST(AdaptiveThrottleServiceConfigParserTest, WrongTypes) {
+  auto service_config = ServiceConfigImpl::Create(
+      ChannelArgs(),
+      "{\"adaptiveThrottling\": {\"window\": 1, "
+      "\"acceptsMultiplier\": \"two\"}}");
+  EXPECT_EQ(service_config.status().message(),
+            "errors validating service config: ["
+            "field:adaptiveThrottling.acceptsMultiplier "
+            "error:failed to parse floating-point number; "
+            "field:adaptiveThrottling.window "
+            "error:is not a string]")
+      << service_config.status();
+}
+
+//
+// AdaptiveThrottleFilter
+//
+
+class AdaptiveThrottleFilterTest : public FilterTest<AdaptiveThrottleFilter> {
+ protected:
+  // Each test uses its own server name, so that the tests don't share
+  // throttling data.
+  AdaptiveThrottleFilterTest()
+      : server_name_(absl::StrCat(
+            ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+            ".example.com")) {}
+
+  absl::StatusOr<Channel> MakeChannel() {
+    auto service_config = ServiceConfigImpl::Create(
+        ChannelArgs(),
+        "{\"adaptiveThrottling\": {\"window\": \"10s\", "
+        "\"acceptsMultiplier\": 2}}");
+    if (!service_config.ok()) return service_config.status();
+    return FilterTest::MakeChannel(
+        ChannelArgs()
+            .SetObject<ServiceConfig>(std::move(*service_config))
+            .Set(GRPC_ARG_SERVER_URI, absl::StrCat("dns:///", server_name_)));
+  }
+
+  RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data() {
+    return internal::ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+        server_name_, Duration::Seconds(10), 2);
+  }
+
+  // Runs num_calls calls through the filter, each of which the next filter
+  // finishes with status.  from_wire says whether the status came from the
+  // server.
+  void RunCalls(const Channel& channel, int num_calls, grpc_status_code status,
+                bool from_wire) {
+    for (int i = 0; i < num_calls; ++i) {
+      Call call(channel);
+      EXPECT_EVENT(Started(&call, _));
+      call.Start(call.NewClientMetadata());
+      auto md = call.NewServerMetadata();
+      md->Set(GrpcStatusMetadata(), status);
+      if (from_wire) md->Set(GrpcStatusFromWire(), true);
+      call.FinishNextFilter(std::move(md));
+      EXPECT_EVENT(Finished(&call, _));
+      Step();
+    }
+  }
+
+  // Returns the rejection probability once it has caught up with the calls
+  // run so far.  This adds one request of its own.
+  double RejectProbability() {
+    event_engine()->RunAfter(std::chrono::milliseconds(100), []() {});
+    Step();
+    throttle_data()->RecordRequest();
+    return throttle_data()->reject_probability();
+  }
+
+  const std::string server_name_;
+};
+
+TEST_F(AdaptiveThrottleFilterTest, ResourceExhaustedFromServerIsReject) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  RunCalls(*channel, 10, GRPC_STATUS_RESOURCE_EXHAUSTED, /*from_wire=*/true);
+  EXPECT_DOUBLE_EQ(RejectProbability(), 11.0 / 12);
+}
+
+TEST_F(AdaptiveThrottleFilterTest, UnavailableFromServerIsReject) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  RunCalls(*channel, 10, GRPC_STATUS_UNAVAILABLE, /*from_wire=*/true);
+  EXPECT_DOUBLE_EQ(RejectProbability(), 11.0 / 12);
+}
+
+TEST_F(AdaptiveThrottleFilterTest, OtherStatusesAreAccepts) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  for (grpc_status_code status :
+       {GRPC_STATUS_OK, GRPC_STATUS_NOT_FOUND, GRPC_STATUS_INTERNAL,
+        GRPC_STATUS_DEADLINE_EXCEEDED}) {
+    RunCalls(*channel, 10, status, /*from_wire=*/true);
+  }
+  EXPECT_EQ(RejectProbability(), 0);
+}
+
+TEST_F(AdaptiveThrottleFilterTest, LocalUnavailableIsNotReject) {
+  auto channel = MakeChannel();
+  ASSERT_TRUE(channel.ok()) << channel.status();
+  // E.g. no connection to the server could be established.
+  RunCalls(*channel, 10, GRPC_STATUS_UNAVAILABLE, /*from_wire=*/false);
+  RunCalls(*channel, 10, GRPC_STATUS_RESOURCE_EXHAUSTED, /*from_wire=*/false);
+  EXPECT_EQ(RejectProbability(), 0);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -0,0 +1,250 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
+#include "test/core/event_engine/fuzzing_event_engine/fuzzing_event_engine.h"
+#include "test/core/event_engine/fuzzing_event_engine/fuzzing_event_engine.pb.h"
+
+namespace grpc_core {
+namespace {
+
+using grpc_event_engine::experimental::FuzzingEventEngine;
+
+// A timer entry plus a record of how its closure ran.
+struct TestTimer {
+  TestTimer() { GRPC_CLOSURE_INIT(&closure, Run, this, nullptr); }
+
+  static void Run(void* arg, grpc_error_handle error) {
+    auto* self = static_cast<TestTimer*>(arg);
+    self->status = error;
+    self->runs.fetch_add(1);
+    if (self->on_run != nullptr) self->on_run();
+  }
+
+  grpc_timer timer;
+  grpc_closure closure;
+  std::atomic<int> runs{0};
+  absl::Status status;
+  std::function<void()> on_run;
+};
+
+class DeadlineTimerQueueTest : public ::testing::Test {
+ protected:
+  DeadlineTimerQueueTest()
+      : event_engine_(std::make_shared<FuzzingEventEngine>(
+            []() {
+              grpc_timer_manager_set_threading(false);
+              return FuzzingEventEngine::Options();
+            }(),
+            fuzzing_event_engine::Actions())) {}
+
+  ~DeadlineTimerQueueTest() override {
+    event_engine_->FuzzingDone();
+    event_engine_->TickUntilIdle();
+    event_engine_->UnsetGlobalHooks();
+  }
+
+  OrphanablePtr<DeadlineTimerQueue> MakeQueue() {
+    return MakeOrphanable<DeadlineTimerQueue>(
+        ChannelArgs().SetObject<grpc_event_engine::experimental::EventEngine>(
+            event_engine_));
+  }
+
+  // Runs every timer that is due in the fake time line.
+  void RunTimers() {
+    ExecCtx::Get()->Flush();
+    event_engine_->TickUntilIdle();
+  }
+
+  static Timestamp After(Duration duration) {
+    ExecCtx::Get()->InvalidateNow();
+    return Timestamp::Now() + duration;
+  }
+
+  ExecCtx exec_ctx_;
+  std::shared_ptr<FuzzingEventEngine> event_engine_;
+};
+
+TEST_F(DeadlineTimerQueueTest, FiresInDeadlineOrder) {
+  auto queue = MakeQueue();
+  TestTimer timers[3];
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i) {
+    timers[i].on_run = [&order, i]() { order.push_back(i); };
+  }
+  queue->TimerInit(&timers[0].timer, After(Duration::Milliseconds(300)),
+                   &timers[0].closure);
+  queue->TimerInit(&timers[1].timer, After(Duration::Milliseconds(100)),
+                   &timers[1].closure);
+  queue->TimerInit(&timers[2].timer, After(Duration::Milliseconds(200)),
+                   &timers[2].closure);
+  ExecCtx::Get()->Flush();
+  EXPECT_TRUE(order.empty());
+  RunTimers();
+  EXPECT_EQ(order, std::vector<int>({1, 2, 0}));
+  for (TestTimer& timer : timers) {
+    EXPECT_EQ(timer.runs.load(), 1);
+    EXPECT_EQ(timer.status, absl::OkStatus());
+  }
+}
+
+TEST_F(DeadlineTimerQueueTest, PastDeadlineFiresImmediately) {
+  auto queue = MakeQueue();
+  TestTimer timer;
+  queue->TimerInit(&timer.timer, After(Duration::Zero()), &timer.closure);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(timer.runs.load(), 1);
+  EXPECT_EQ(timer.status, absl::OkStatus());
+}
+
+TEST_F(DeadlineTimerQueueTest, CancelBeforeFire) {
+  auto queue = MakeQueue();
+  TestTimer cancelled;
+  TestTimer kept;
+  queue->TimerInit(&cancelled.timer, After(Duration::Milliseconds(100)),
+                   &cancelled.closure);
+  queue->TimerInit(&kept.timer, After(Duration::Milliseconds(200)),
+                   &kept.closure);
+  queue->TimerCancel(&cancelled.timer);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(cancelled.runs.load(), 1);
+  EXPECT_EQ(cancelled.status, absl::CancelledError());
+  EXPECT_EQ(kept.runs.load(), 0);
+  RunTimers();
+  EXPECT_EQ(cancelled.runs.load(), 1);
+  EXPECT_EQ(kept.runs.load(), 1);
+  EXPECT_EQ(kept.status, absl::OkStatus());
+}
+
+// A cancel that arrives once the deadline has been reached, but before the
+// closure has run, loses: the closure still runs just once, with OK.
+TEST_F(DeadlineTimerQueueTest, CancelRacingFire) {
+  auto queue = MakeQueue();
+  TestTimer first;
+  TestTimer second;
+  const Timestamp deadline = After(Duration::Milliseconds(100));
+  queue->TimerInit(&first.timer, deadline, &first.closure);
+  queue->TimerInit(&second.timer, deadline, &second.closure);
+  // Whichever closure runs first cancels the other one, which is due at the
+  // same time and so already on its way.
+  first.on_run = [&]() { queue->TimerCancel(&second.timer); };
+  second.on_run = [&]() { queue->TimerCancel(&first.timer); };
+  RunTimers();
+  for (TestTimer* timer : {&first, &second}) {
+    EXPECT_EQ(timer->runs.load(), 1);
+    EXPECT_EQ(timer->status, absl::OkStatus());
+  }
+  // Cancelling after the closure has run does nothing either.
+  queue->TimerCancel(&first.timer);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(first.runs.load(), 1);
+}
+
+TEST_F(DeadlineTimerQueueTest, OrphanWithPendingTimerStillFires) {
+  auto queue = MakeQueue();
+  TestTimer timer;
+  queue->TimerInit(&timer.timer, After(Duration::Milliseconds(100)),
+                   &timer.closure);
+  queue.reset();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(timer.runs.load(), 0);
+  RunTimers();
+  EXPECT_EQ(timer.runs.load(), 1);
+  EXPECT_EQ(timer.status, absl::OkStatus());
+}
+
+TEST_F(DeadlineTimerQueueTest, CancelAfterOrphan) {
+  auto queue = MakeQueue();
+  DeadlineTimerQueue* raw_queue = queue.get();
+  TestTimer timer;
+  queue->TimerInit(&timer.timer, After(Duration::Milliseconds(100)),
+                   &timer.closure);
+  queue.reset();
+  // The armed timer still holds a ref, so the queue is usable until then.
+  raw_queue->TimerCancel(&timer.timer);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(timer.runs.load(), 1);
+  EXPECT_EQ(timer.status, absl::CancelledError());
+  RunTimers();
+  EXPECT_EQ(timer.runs.load(), 1);
+}
+
+// Cancels timers from another thread while a real EventEngine fires them:
+// every closure must run exactly once, however the two interleave.
+TEST(DeadlineTimerQueueThreadTest, CancelRacingFire) {
+  constexpr int kNumTimers = 1000;
+  ExecCtx exec_ctx;
+  auto queue = MakeOrphanable<DeadlineTimerQueue>(ChannelArgs().SetObject(
+      grpc_event_engine::experimental::GetDefaultEventEngine()));
+  std::vector<std::unique_ptr<TestTimer>> timers;
+  for (int i = 0; i < kNumTimers; ++i) {
+    timers.push_back(std::make_unique<TestTimer>());
+    queue->TimerInit(&timers.back()->timer,
+                     Timestamp::Now() + Duration::Milliseconds(1 + i % 10),
+                     &timers.back()->closure);
+  }
+  ExecCtx::Get()->Flush();
+  std::thread canceller([&]() {
+    ExecCtx exec_ctx;
+    for (auto& timer : timers) {
+      queue->TimerCancel(&timer->timer);
+      ExecCtx::Get()->Flush();
+    }
+  });
+  canceller.join();
+  const absl::Time give_up = absl::Now() + absl::Seconds(30);
+  for (auto& timer : timers) {
+    while (timer->runs.load() == 0 && absl::Now() < give_up) {
+      absl::SleepFor(absl::Milliseconds(1));
+    }
+  }
+  // Give a duplicate run the chance to show up.
+  absl::SleepFor(absl::Milliseconds(50));
+  for (auto& timer : timers) EXPECT_EQ(timer->runs.load(), 1);
+  queue.reset();
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -28,12 +28,17 @@
 #include "absl/synchronization/barrier.h"
 #include "gtest/gtest.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/grpc.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/notification.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/test_config.h"
 
 namespace {
@@ -194,6 +199,49 @@ TEST(WorkSerializerTest, ExecuteManyMixedRunScheduleAndDrain) {
   }
 }
 
+TEST(WorkSerializerTest, RecordsStats) {
+  grpc_core::ExecCtx exec_ctx;
+  auto before = grpc_core::global_stats().Collect();
+  grpc_core::WorkSerializer lock;
+  int ran = 0;
+  for (int i = 0; i < 3; ++i) {
+    lock.Schedule([&ran]() { ++ran; }, DEBUG_LOCATION);
+  }
+  lock.DrainQueue();
+  EXPECT_EQ(ran, 3);
+  auto stats = grpc_core::global_stats().Collect()->Diff(*before);
+  EXPECT_EQ(stats->work_serializer_items_enqueued, 3u);
+  EXPECT_EQ(stats
+                ->histogram(grpc_core::GlobalStats::Histogram::
+                                kWorkSerializerItemsPerDrain)
+                .Count(),
+            1);
+}
+
+// Slow callbacks may be handed off to the EventEngine part way through a
+// drain; they must still run in order.
+TEST(WorkSerializerTest, SlowCallbacksRunInOrderWithEventEngine) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::WorkSerializer lock(
+      grpc_event_engine::experimental::GetDefaultEventEngine());
+  constexpr int kNumCallbacks = 10;
+  int next = 0;
+  grpc_core::Notification done;
+  for (int i = 0; i < kNumCallbacks; ++i) {
+    lock.Schedule(
+        [i, &next, &done]() {
+          EXPECT_EQ(next, i);
+          ++next;
+          gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(2));
+          if (next == kNumCallbacks) done.Notify();
+        },
+        DEBUG_LOCATION);
+  }
+  lock.DrainQueue();
+  done.WaitForNotification();
+  EXPECT_EQ(next, kNumCallbacks);
+}
+
 // Tests that work serializers allow destruction from the last callback
 TEST(WorkSerializerTest, CallbackDestroysWorkSerializer) {
   auto lock = std::make_shared<grpc_core::WorkSerializer>();
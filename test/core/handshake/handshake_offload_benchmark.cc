@@ -0,0 +1,311 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures how long work for established connections waits for an I/O thread
+// while TLS handshakes are in progress, with the handshakes' TSI steps run
+// either on the I/O threads themselves or on a HandshakeOffloadPool. This is
+// what SecurityHandshaker does without and with GRPC_ARG_TSI_HANDSHAKE_OFFLOAD.
+// Handshake bytes are passed between client and server in memory, and a
+// simple queue served by a few threads stands in for the EventEngine.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security_interface.h"
+#include "test/core/util/tls_utils.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr char kCaPemPath[] = "src/core/tsi/test_creds/ca.pem";
+constexpr char kServerKeyPath[] = "src/core/tsi/test_creds/server1.key";
+constexpr char kServerCertPath[] = "src/core/tsi/test_creds/server1.pem";
+constexpr char kServerName[] = "waterzooi.test.google.be";
+
+constexpr int kIoThreads = 2;
+constexpr size_t kOffloadThreads = 1;
+
+// Threads that run callbacks in the order they are queued.
+class IoThreads {
+ public:
+  explicit IoThreads(int num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      threads_.emplace_back([this]() { ThreadMain(); });
+    }
+  }
+
+  ~IoThreads() {
+    {
+      MutexLock lock(&mu_);
+      shutdown_ = true;
+      cv_.SignalAll();
+    }
+    for (auto& thread : threads_) thread.join();
+  }
+
+  void Run(absl::AnyInvocable<void()> callback) {
+    MutexLock lock(&mu_);
+    queue_.push_back(std::move(callback));
+    cv_.Signal();
+  }
+
+ private:
+  void ThreadMain() {
+    while (true) {
+      absl::AnyInvocable<void()> callback;
+      {
+        MutexLock lock(&mu_);
+        while (queue_.empty() && !shutdown_) cv_.Wait(&mu_);
+        if (queue_.empty()) return;
+        callback = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      callback();
+    }
+  }
+
+  Mutex mu_;
+  CondVar cv_;
+  std::deque<absl::AnyInvocable<void()>> queue_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<std::thread> threads_;
+};
+
+// A client and a server that handshake over and over until stopped. Each
+// time one side's bytes "arrive" at the other, an I/O thread picks them up
+// and runs the receiving side's TSI step, or hands it to the offload pool.
+class HandshakeLoop {
+ public:
+  HandshakeLoop(tsi_ssl_client_handshaker_factory* client_factory,
+                tsi_ssl_server_handshaker_factory* server_factory,
+                IoThreads* io_threads, HandshakeOffloadPool* offload_pool)
+      : client_factory_(client_factory),
+        server_factory_(server_factory),
+        io_threads_(io_threads),
+        offload_pool_(offload_pool) {}
+
+  ~HandshakeLoop() { Reset(); }
+
+  void Start() {
+    Reset();
+    io_threads_->Run([this]() { OnBytesReceived(); });
+  }
+
+  // Stops the loop once the step in progress is done.
+  void Stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    stopped_.WaitForNotification();
+  }
+
+  int64_t completed() const {
+    return completed_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void Reset() {
+    tsi_handshaker_result_destroy(client_result_);
+    tsi_handshaker_result_destroy(server_result_);
+    tsi_handshaker_destroy(client_);
+    tsi_handshaker_destroy(server_);
+    client_result_ = nullptr;
+    server_result_ = nullptr;
+    client_ = nullptr;
+    server_ = nullptr;
+    if (stop_.load(std::memory_order_relaxed)) return;
+    GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                   client_factory_, kServerName, 0, 0, &client_) == TSI_OK);
+    GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                   server_factory_, 0, 0, &server_) == TSI_OK);
+    to_client_.clear();
+    to_server_.clear();
+    client_turn_ = true;
+  }
+
+  // Runs on an I/O thread.
+  void OnBytesReceived() {
+    if (offload_pool_ != nullptr) {
+      offload_pool_->Run([this]() { Step(); });
+    } else {
+      Step();
+    }
+  }
+
+  void Step() {
+    if (stop_.load(std::memory_order_relaxed)) {
+      stopped_.Notify();
+      return;
+    }
+    if (client_turn_) {
+      if (client_result_ == nullptr) {
+        Next(client_, &to_client_, &to_server_, &client_result_);
+      }
+    } else if (server_result_ == nullptr) {
+      Next(server_, &to_server_, &to_client_, &server_result_);
+    }
+    client_turn_ = !client_turn_;
+    if (client_result_ != nullptr && server_result_ != nullptr) {
+      completed_.fetch_add(1, std::memory_order_relaxed);
+      Reset();
+    }
+    io_threads_->Run([this]() { OnBytesReceived(); });
+  }
+
+  static void Next(tsi_handshaker* handshaker, std::string* received_bytes,
+                   std::string* peer_bytes, tsi_handshaker_result** result) {
+    const unsigned char* bytes_to_send = nullptr;
+    size_t bytes_to_send_size = 0;
+    GPR_ASSERT(tsi_handshaker_next(handshaker,
+                                   reinterpret_cast<const unsigned char*>(
+                                       received_bytes->data()),
+                                   received_bytes->size(), &bytes_to_send,
+                                   &bytes_to_send_size, result, nullptr,
+                                   nullptr, nullptr) == TSI_OK);
+    received_bytes->clear();
+    peer_bytes->append(reinterpret_cast<const char*>(bytes_to_send),
+                       bytes_to_send_size);
+  }
+
+  tsi_ssl_client_handshaker_factory* const client_factory_;
+  tsi_ssl_server_handshaker_factory* const server_factory_;
+  IoThreads* const io_threads_;
+  HandshakeOffloadPool* const offload_pool_;
+  std::atomic<bool> stop_{false};
+  absl::Notification stopped_;
+  std::atomic<int64_t> completed_{0};
+  // Only touched by one step at a time.
+  tsi_handshaker* client_ = nullptr;
+  tsi_handshaker* server_ = nullptr;
+  tsi_handshaker_result* client_result_ = nullptr;
+  tsi_handshaker_result* server_result_ = nullptr;
+  std::string to_client_;
+  std::string to_server_;
+  bool client_turn_ = true;
+};
+
+double PercentileMicros(std::vector<absl::Duration>* latencies,
+                        double percentile) {
+  if (latencies->empty()) return 0;
+  size_t index = std::min(
+      latencies->size() - 1,
+      static_cast<size_t>(percentile / 100 * latencies->size()));
+  std::nth_element(latencies->begin(), latencies->begin() + index,
+                   latencies->end());
+  return absl::ToDoubleMicroseconds((*latencies)[index]);
+}
+
+// Arguments: whether handshake steps are offloaded, and the number of
+// handshakes in progress at any time. Each iteration is a callback for an
+// established connection, timed from when it is queued on the I/O threads
+// until it runs.
+void BM_EstablishedLatencyDuringHandshakes(benchmark::State& state) {
+  const bool offload = state.range(0) != 0;
+  const int concurrent_handshakes = state.range(1);
+  const std::string ca_pem = testing::GetFileContents(kCaPemPath);
+  const std::string server_key = testing::GetFileContents(kServerKeyPath);
+  const std::string server_cert = testing::GetFileContents(kServerCertPath);
+  tsi_ssl_client_handshaker_options client_options;
+  client_options.pem_root_certs = ca_pem.c_str();
+  tsi_ssl_client_handshaker_factory* client_factory = nullptr;
+  GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
+                 &client_options, &client_factory) == TSI_OK);
+  tsi_ssl_pem_key_cert_pair key_cert_pair = {server_key.c_str(),
+                                             server_cert.c_str()};
+  tsi_ssl_server_handshaker_options server_options;
+  server_options.pem_key_cert_pairs = &key_cert_pair;
+  server_options.num_key_cert_pairs = 1;
+  tsi_ssl_server_handshaker_factory* server_factory = nullptr;
+  GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
+                 &server_options, &server_factory) == TSI_OK);
+  std::vector<absl::Duration> latencies;
+  int64_t handshakes = 0;
+  {
+    IoThreads io_threads(kIoThreads);
+    std::unique_ptr<HandshakeOffloadPool> offload_pool;
+    if (offload) {
+      offload_pool = std::make_unique<HandshakeOffloadPool>(kOffloadThreads);
+    }
+    std::vector<std::unique_ptr<HandshakeLoop>> loops;
+    for (int i = 0; i < concurrent_handshakes; ++i) {
+      loops.push_back(std::make_unique<HandshakeLoop>(
+          client_factory, server_factory, &io_threads, offload_pool.get()));
+      loops.back()->Start();
+    }
+    for (auto _ : state) {
+      absl::Notification ran;
+      absl::Time queued = absl::Now();
+      absl::Duration latency;
+      io_threads.Run([&]() {
+        latency = absl::Now() - queued;
+        ran.Notify();
+      });
+      ran.WaitForNotification();
+      latencies.push_back(latency);
+    }
+    for (auto& loop : loops) {
+      loop->Stop();
+      handshakes += loop->completed();
+    }
+  }
+  state.counters["p50_us"] = PercentileMicros(&latencies, 50);
+  state.counters["p99_us"] = PercentileMicros(&latencies, 99);
+  state.counters["Handshakes"] =
+      benchmark::Counter(handshakes, benchmark::Counter::kIsRate);
+  tsi_ssl_server_handshaker_factory_unref(server_factory);
+  tsi_ssl_client_handshaker_factory_unref(client_factory);
+}
+BENCHMARK(BM_EstablishedLatencyDuringHandshakes)
+    ->ArgsProduct({{0, 1}, {0, 8, 64}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,187 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the rate of TLS handshakes that a server handshaker factory
+// completes, with full handshakes compared to sessions resumed from tickets.
+// Handshake bytes are passed between client and server in memory.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security_interface.h"
+#include "test/core/util/tls_utils.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr char kCaPemPath[] = "src/core/tsi/test_creds/ca.pem";
+constexpr char kServerKeyPath[] = "src/core/tsi/test_creds/server1.key";
+constexpr char kServerCertPath[] = "src/core/tsi/test_creds/server1.pem";
+constexpr char kServerName[] = "waterzooi.test.google.be";
+
+// Calls next on handshaker with the bytes received from its peer, and appends
+// the bytes to send to the peer to peer_bytes. Sets *result once the handshake
+// is done.
+void HandshakerNext(tsi_handshaker* handshaker, std::string* received_bytes,
+                    std::string* peer_bytes, tsi_handshaker_result** result) {
+  const unsigned char* bytes_to_send = nullptr;
+  size_t bytes_to_send_size = 0;
+  GPR_ASSERT(tsi_handshaker_next(
+                 handshaker,
+                 reinterpret_cast<const unsigned char*>(received_bytes->data()),
+                 received_bytes->size(), &bytes_to_send, &bytes_to_send_size,
+                 result, nullptr, nullptr, nullptr) == TSI_OK);
+  received_bytes->clear();
+  peer_bytes->append(reinterpret_cast<const char*>(bytes_to_send),
+                     bytes_to_send_size);
+}
+
+// Has the client read what the server sent after the handshake, which holds
+// the TLS 1.3 session tickets.
+void ClientReadPostHandshakeBytes(tsi_handshaker_result* client_result,
+                                  std::string* bytes) {
+  const unsigned char* unused_bytes = nullptr;
+  size_t unused_bytes_size = 0;
+  GPR_ASSERT(tsi_handshaker_result_get_unused_bytes(
+                 client_result, &unused_bytes, &unused_bytes_size) == TSI_OK);
+  bytes->insert(0, reinterpret_cast<const char*>(unused_bytes),
+                unused_bytes_size);
+  tsi_frame_protector* protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 client_result, nullptr, &protector) == TSI_OK);
+  const unsigned char* data =
+      reinterpret_cast<const unsigned char*>(bytes->data());
+  size_t remaining = bytes->size();
+  unsigned char unprotected[1024];
+  while (remaining > 0) {
+    size_t consumed = remaining;
+    size_t unprotected_size = sizeof(unprotected);
+    GPR_ASSERT(tsi_frame_protector_unprotect(protector, data, &consumed,
+                                             unprotected,
+                                             &unprotected_size) == TSI_OK);
+    data += consumed;
+    remaining -= consumed;
+  }
+  tsi_frame_protector_destroy(protector);
+}
+
+void DoHandshake(tsi_ssl_client_handshaker_factory* client_factory,
+                 tsi_ssl_server_handshaker_factory* server_factory) {
+  tsi_handshaker* client = nullptr;
+  tsi_handshaker* server = nullptr;
+  GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                 client_factory, kServerName, 0, 0, &client) == TSI_OK);
+  GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                 server_factory, 0, 0, &server) == TSI_OK);
+  std::string to_client;
+  std::string to_server;
+  tsi_handshaker_result* client_result = nullptr;
+  tsi_handshaker_result* server_result = nullptr;
+  while (client_result == nullptr || server_result == nullptr) {
+    if (client_result == nullptr) {
+      HandshakerNext(client, &to_client, &to_server, &client_result);
+    }
+    if (server_result == nullptr) {
+      HandshakerNext(server, &to_server, &to_client, &server_result);
+    }
+  }
+  ClientReadPostHandshakeBytes(client_result, &to_client);
+  tsi_handshaker_result_destroy(client_result);
+  tsi_handshaker_result_destroy(server_result);
+  tsi_handshaker_destroy(client);
+  tsi_handshaker_destroy(server);
+}
+
+// Arguments: the TLS version (2 or 3), and whether the client resumes
+// sessions.
+void BM_SslHandshake(benchmark::State& state) {
+  const tsi_tls_version tls_version =
+      state.range(0) == 2 ? tsi_tls_version::TSI_TLS1_2
+                          : tsi_tls_version::TSI_TLS1_3;
+  const bool resume = state.range(1) != 0;
+  const std::string ca_pem = testing::GetFileContents(kCaPemPath);
+  const std::string server_key = testing::GetFileContents(kServerKeyPath);
+  const std::string server_cert = testing::GetFileContents(kServerCertPath);
+  // Client.
+  tsi_ssl_session_cache* session_cache =
+      resume ? tsi_ssl_session_cache_create_lru(1) : nullptr;
+  tsi_ssl_client_handshaker_options client_options;
+  client_options.pem_root_certs = ca_pem.c_str();
+  client_options.session_cache = session_cache;
+  client_options.min_tls_version = tls_version;
+  client_options.max_tls_version = tls_version;
+  tsi_ssl_client_handshaker_factory* client_factory = nullptr;
+  GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
+                 &client_options, &client_factory) == TSI_OK);
+  // Server.
+  auto provider = MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(
+      Duration::Hours(1), /*num_keys=*/2);
+  tsi_ssl_pem_key_cert_pair key_cert_pair = {server_key.c_str(),
+                                             server_cert.c_str()};
+  tsi_ssl_server_handshaker_options server_options;
+  server_options.pem_key_cert_pairs = &key_cert_pair;
+  server_options.num_key_cert_pairs = 1;
+  server_options.session_ticket_key_provider = provider.get();
+  server_options.min_tls_version = tls_version;
+  server_options.max_tls_version = tls_version;
+  tsi_ssl_server_handshaker_factory* server_factory = nullptr;
+  GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
+                 &server_options, &server_factory) == TSI_OK);
+  // The first handshake, which gets the client its first ticket, is not
+  // measured.
+  DoHandshake(client_factory, server_factory);
+  for (auto _ : state) {
+    DoHandshake(client_factory, server_factory);
+  }
+  tsi_ssl_server_session_stats stats;
+  tsi_ssl_server_handshaker_factory_get_session_stats(server_factory, &stats);
+  state.counters["Handshakes"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+  state.counters["Resumed"] = static_cast<double>(stats.resumed_handshakes) /
+                              static_cast<double>(state.iterations() + 1);
+  tsi_ssl_server_handshaker_factory_unref(server_factory);
+  tsi_ssl_client_handshaker_factory_unref(client_factory);
+  if (session_cache != nullptr) tsi_ssl_session_cache_unref(session_cache);
+}
+BENCHMARK(BM_SslHandshake)->ArgsProduct({{2, 3}, {0, 1}});
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  grpc_init();
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,730 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Reports the memory footprint of gRPC objects: bytes per idle channel, per
+// connected subchannel, per server connection, per active unary call and per
+// open streaming call, for each of the chttp2 (insecure and TLS) and inproc
+// stacks. Each figure is broken down into:
+//  - rss: growth of the process' resident set
+//  - heap: growth of the bytes malloc reports as in use
+//  - quota: growth of the bytes reserved from the resource quota, which covers
+//    call arenas, transport read buffers and other slices allocated through
+//    memory allocators
+//  - arena: bytes used in the arenas of the calls themselves
+// Results are written as JSON so they can be tracked for regressions.
+//
+// chttp2 servers run in a child process so that client and server figures
+// can be told apart. The inproc transport needs both ends in one process, so
+// its server figures only contain the quota and arena columns, and its client
+// rss and heap columns include the server side too.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/json.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json_writer.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/surface/call.h"
+#include "test/core/end2end/data/ssl_test_data.h"
+#include "test/core/memory_usage/memstats.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+ABSL_FLAG(int, size, 100, "Number of channels/calls per scenario");
+ABSL_FLAG(std::string, stacks, "chttp2_insecure,chttp2_tls,inproc",
+          "Which stacks to measure");
+ABSL_FLAG(std::string, scenarios,
+          "idle_channel,idle_subchannel,unary_call,streaming_call",
+          "Which scenarios to measure");
+ABSL_FLAG(std::string, output, "",
+          "File to write the JSON report to (defaults to stdout)");
+
+namespace grpc_core {
+namespace {
+
+// Large enough never to push back, and to make the usage derived from the
+// instantaneous pressure exact.
+constexpr size_t kQuotaSize = size_t{1} << 40;
+constexpr const char* kMethod = "/footprint.Footprint/Hold";
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// Memory attributed to one side at a point in time.
+struct Footprint {
+  int64_t rss = 0;
+  int64_t heap = 0;
+  int64_t quota = 0;
+  int64_t arena = 0;
+  // Calls currently held (server side only).
+  int64_t calls = 0;
+
+  Footprint operator-(const Footprint& other) const {
+    return Footprint{rss - other.rss, heap - other.heap, quota - other.quota,
+                     arena - other.arena, calls - other.calls};
+  }
+
+  Json ToJsonPerItem(int n) const {
+    auto per_item = [n](int64_t v) {
+      return Json::FromNumber(static_cast<double>(v) / n);
+    };
+    return Json::FromObject({
+        {"rss_bytes", per_item(rss)},
+        {"heap_bytes", per_item(heap)},
+        {"quota_bytes", per_item(quota)},
+        {"arena_bytes", per_item(arena)},
+    });
+  }
+};
+
+Footprint MeasureProcess() {
+  Footprint f;
+  f.rss = GetMemUsage() * 1024;
+  f.heap = GetMallocInUseBytes();
+  return f;
+}
+
+grpc_resource_quota* CreateQuota(const char* name) {
+  grpc_resource_quota* quota = grpc_resource_quota_create(name);
+  grpc_resource_quota_resize(quota, kQuotaSize);
+  return quota;
+}
+
+int64_t QuotaUsage(grpc_resource_quota* quota) {
+  MemoryOwner probe = ResourceQuota::FromC(quota)->memory_quota()->
+                      CreateMemoryOwner("footprint_probe");
+  return static_cast<int64_t>(probe.GetPressureInfo().instantaneous_pressure *
+                              kQuotaSize);
+}
+
+int64_t ArenaUsage(grpc_call* call) {
+  return static_cast<int64_t>(grpc_call_get_arena(call)->TotalUsedBytes());
+}
+
+void Settle() { gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(500)); }
+
+// A server that holds on to every call it receives until Release().
+class Server {
+ public:
+  explicit Server(bool listen) : quota_(CreateQuota("footprint_server")) {
+    grpc_arg arg = grpc_channel_arg_pointer_create(
+        const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), quota_,
+        grpc_resource_quota_arg_vtable());
+    grpc_channel_args args = {1, &arg};
+    server_ = grpc_server_create(&args, nullptr);
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    if (listen) {
+      insecure_port_ = grpc_pick_unused_port_or_die();
+      grpc_server_credentials* insecure =
+          grpc_insecure_server_credentials_create();
+      GPR_ASSERT(grpc_server_add_http2_port(
+          server_, JoinHostPort("::", insecure_port_).c_str(), insecure));
+      grpc_server_credentials_release(insecure);
+      tls_port_ = grpc_pick_unused_port_or_die();
+      grpc_ssl_pem_key_cert_pair pem_key_cert_pair = {test_server1_key,
+                                                      test_server1_cert};
+      grpc_server_credentials* tls = grpc_ssl_server_credentials_create(
+          nullptr, &pem_key_cert_pair, 1, 0, nullptr);
+      GPR_ASSERT(grpc_server_add_http2_port(
+          server_, JoinHostPort("::", tls_port_).c_str(), tls));
+      grpc_server_credentials_release(tls);
+    }
+    grpc_server_start(server_);
+    {
+      MutexLock lock(&mu_);
+      RequestCallLocked();
+    }
+    thread_ = std::thread([this] { Run(); });
+  }
+
+  ~Server() {
+    Release();
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(0));
+    grpc_server_cancel_all_calls(server_);
+    thread_.join();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_destroy(cq_);
+    grpc_resource_quota_unref(quota_);
+  }
+
+  grpc_server* c_server() const { return server_; }
+  int insecure_port() const { return insecure_port_; }
+  int tls_port() const { return tls_port_; }
+
+  // The server's own quota and arena usage; process wide figures are left to
+  // the caller.
+  Footprint Measure() {
+    Footprint f;
+    f.quota = QuotaUsage(quota_);
+    MutexLock lock(&mu_);
+    for (ServerCall* call : held_) f.arena += ArenaUsage(call->call);
+    f.calls = static_cast<int64_t>(held_.size());
+    return f;
+  }
+
+  // Completes every held call, and waits until they're all done.
+  void Release() {
+    MutexLock lock(&mu_);
+    for (ServerCall* call : held_) {
+      grpc_op ops[3] = {};
+      ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+      ops[1].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+      ops[1].data.send_status_from_server.status = GRPC_STATUS_OK;
+      ops[2].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+      ops[2].data.recv_close_on_server.cancelled = &call->cancelled;
+      call->finishing = true;
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_call_start_batch(call->call, ops, 3, call, nullptr));
+      ++finishing_;
+    }
+    held_.clear();
+    while (finishing_ != 0) cv_.Wait(&mu_);
+  }
+
+ private:
+  struct ServerCall {
+    grpc_call* call = nullptr;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+    int cancelled = 0;
+    bool finishing = false;
+  };
+
+  void RequestCallLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto* call = new ServerCall;
+    grpc_call_details_init(&call->details);
+    grpc_metadata_array_init(&call->request_metadata);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(server_, &call->call, &call->details,
+                                        &call->request_metadata, cq_, cq_,
+                                        call));
+  }
+
+  static void DestroyCall(ServerCall* call) {
+    if (call->call != nullptr) grpc_call_unref(call->call);
+    grpc_call_details_destroy(&call->details);
+    grpc_metadata_array_destroy(&call->request_metadata);
+    delete call;
+  }
+
+  void Run() {
+    while (true) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq_, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      if (ev.type == GRPC_QUEUE_SHUTDOWN) return;
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      if (ev.tag == Tag(0)) {
+        grpc_completion_queue_shutdown(cq_);
+        continue;
+      }
+      auto* call = static_cast<ServerCall*>(ev.tag);
+      MutexLock lock(&mu_);
+      if (call->finishing) {
+        DestroyCall(call);
+        if (--finishing_ == 0) cv_.SignalAll();
+      } else if (!ev.success) {
+        // The server is shutting down.
+        DestroyCall(call);
+      } else {
+        held_.push_back(call);
+        RequestCallLocked();
+      }
+    }
+  }
+
+  grpc_resource_quota* const quota_;
+  grpc_server* server_;
+  grpc_completion_queue* cq_;
+  int insecure_port_ = 0;
+  int tls_port_ = 0;
+  std::thread thread_;
+  Mutex mu_;
+  CondVar cv_;
+  std::vector<ServerCall*> held_ ABSL_GUARDED_BY(mu_);
+  size_t finishing_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+// The parent's view of a server: either one running in this process (for
+// inproc), or one running in a child process driven over a pair of pipes.
+class ServerHandle {
+ public:
+  virtual ~ServerHandle() = default;
+  virtual Footprint Measure() = 0;
+  virtual void Release() = 0;
+};
+
+class LocalServer final : public ServerHandle {
+ public:
+  LocalServer() : server_(/*listen=*/false) {}
+  Footprint Measure() override { return server_.Measure(); }
+  void Release() override { server_.Release(); }
+  grpc_server* c_server() const { return server_.c_server(); }
+
+ private:
+  Server server_;
+};
+
+enum Command : char { kMeasure = 'm', kRelease = 'r', kQuit = 'q' };
+
+void WriteAll(int fd, const void* data, size_t size) {
+  const char* p = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, p, size);
+    GPR_ASSERT(n > 0);
+    p += n;
+    size -= n;
+  }
+}
+
+void ReadAll(int fd, void* data, size_t size) {
+  char* p = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, p, size);
+    GPR_ASSERT(n > 0);
+    p += n;
+    size -= n;
+  }
+}
+
+// Body of the child process: serves until told to quit.
+void RunServerProcess(int command_fd, int reply_fd) {
+  grpc_init();
+  {
+    Server server(/*listen=*/true);
+    int ports[2] = {server.insecure_port(), server.tls_port()};
+    WriteAll(reply_fd, ports, sizeof(ports));
+    while (true) {
+      char command;
+      ReadAll(command_fd, &command, 1);
+      if (command == kQuit) break;
+      if (command == kMeasure) {
+        Footprint f = server.Measure();
+        Footprint process = MeasureProcess();
+        f.rss = process.rss;
+        f.heap = process.heap;
+        WriteAll(reply_fd, &f, sizeof(f));
+      } else if (command == kRelease) {
+        server.Release();
+        WriteAll(reply_fd, &command, 1);
+      }
+    }
+  }
+  grpc_shutdown_blocking();
+}
+
+class RemoteServer final : public ServerHandle {
+ public:
+  // Must be called before grpc_init() in this process.
+  RemoteServer() {
+    int command_pipe[2];
+    int reply_pipe[2];
+    GPR_ASSERT(pipe(command_pipe) == 0);
+    GPR_ASSERT(pipe(reply_pipe) == 0);
+    pid_ = fork();
+    GPR_ASSERT(pid_ >= 0);
+    if (pid_ == 0) {
+      close(command_pipe[1]);
+      close(reply_pipe[0]);
+      RunServerProcess(command_pipe[0], reply_pipe[1]);
+      _exit(0);
+    }
+    close(command_pipe[0]);
+    close(reply_pipe[1]);
+    command_fd_ = command_pipe[1];
+    reply_fd_ = reply_pipe[0];
+    int ports[2];
+    ReadAll(reply_fd_, ports, sizeof(ports));
+    insecure_port_ = ports[0];
+    tls_port_ = ports[1];
+  }
+
+  ~RemoteServer() override {
+    char command = kQuit;
+    WriteAll(command_fd_, &command, 1);
+    int status;
+    waitpid(pid_, &status, 0);
+    close(command_fd_);
+    close(reply_fd_);
+  }
+
+  Footprint Measure() override {
+    char command = kMeasure;
+    WriteAll(command_fd_, &command, 1);
+    Footprint f;
+    ReadAll(reply_fd_, &f, sizeof(f));
+    return f;
+  }
+
+  void Release() override {
+    char command = kRelease;
+    WriteAll(command_fd_, &command, 1);
+    ReadAll(reply_fd_, &command, 1);
+  }
+
+  int insecure_port() const { return insecure_port_; }
+  int tls_port() const { return tls_port_; }
+
+ private:
+  pid_t pid_;
+  int command_fd_;
+  int reply_fd_;
+  int insecure_port_;
+  int tls_port_;
+};
+
+struct Stack {
+  std::string name;
+  bool inproc;
+  bool tls;
+};
+
+// Client side of one stack, along with the server it talks to.
+class Client {
+ public:
+  Client(const Stack& stack, RemoteServer* remote)
+      : stack_(stack), quota_(CreateQuota("footprint_client")) {
+    if (stack.inproc) {
+      local_ = std::make_unique<LocalServer>();
+      server_ = local_.get();
+    } else {
+      server_ = remote;
+      target_ = JoinHostPort("localhost", stack.tls ? remote->tls_port()
+                                                    : remote->insecure_port());
+    }
+  }
+
+  ~Client() { grpc_resource_quota_unref(quota_); }
+
+  ServerHandle* server() { return server_; }
+  bool inproc() const { return stack_.inproc; }
+
+  Footprint Measure(const std::vector<grpc_call*>& calls) {
+    Footprint f = MeasureProcess();
+    f.quota = QuotaUsage(quota_);
+    for (grpc_call* call : calls) f.arena += ArenaUsage(call);
+    return f;
+  }
+
+  // If own_subchannel is set the channel gets a subchannel pool of its own,
+  // so that it doesn't share a connection with other channels to the server.
+  grpc_channel* CreateChannel(bool own_subchannel) {
+    std::vector<grpc_arg> args;
+    args.push_back(grpc_channel_arg_pointer_create(
+        const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), quota_,
+        grpc_resource_quota_arg_vtable()));
+    if (own_subchannel) {
+      args.push_back(grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1));
+    }
+    if (stack_.tls) {
+      args.push_back(grpc_channel_arg_string_create(
+          const_cast<char*>(GRPC_SSL_TARGET_NAME_OVERRIDE_ARG),
+          const_cast<char*>("foo.test.google.fr")));
+    }
+    grpc_channel_args channel_args = {args.size(), args.data()};
+    if (stack_.inproc) {
+      return grpc_inproc_channel_create(local_->c_server(), &channel_args,
+                                        nullptr);
+    }
+    grpc_channel_credentials* creds =
+        stack_.tls
+            ? grpc_ssl_credentials_create(test_root_cert, nullptr, nullptr,
+                                          nullptr)
+            : grpc_insecure_credentials_create();
+    grpc_channel* channel =
+        grpc_channel_create(target_.c_str(), creds, &channel_args);
+    grpc_channel_credentials_release(creds);
+    return channel;
+  }
+
+ private:
+  const Stack stack_;
+  grpc_resource_quota* const quota_;
+  std::unique_ptr<LocalServer> local_;
+  ServerHandle* server_;
+  std::string target_;
+};
+
+void WaitForReady(grpc_channel* channel) {
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_connectivity_state state =
+      grpc_channel_check_connectivity_state(channel, 1);
+  while (state != GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(
+        channel, state, grpc_timeout_seconds_to_deadline(10), cq, Tag(1));
+    grpc_event ev = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE && ev.success);
+    state = grpc_channel_check_connectivity_state(channel, 0);
+  }
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+struct Result {
+  Footprint client;
+  Footprint server;
+};
+
+Result IdleChannel(Client* client, int n) {
+  std::vector<grpc_channel*> channels;
+  channels.reserve(n);
+  Settle();
+  Footprint c0 = client->Measure({});
+  Footprint s0 = client->server()->Measure();
+  for (int i = 0; i < n; i++) channels.push_back(client->CreateChannel(false));
+  Settle();
+  Result result{client->Measure({}) - c0, client->server()->Measure() - s0};
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  return result;
+}
+
+// Connects a set of channels that each have a subchannel of their own: the
+// client figures are per connected subchannel, and the server figures per
+// server connection.
+Result IdleSubchannel(Client* client, int n) {
+  std::vector<grpc_channel*> channels;
+  channels.reserve(n);
+  for (int i = 0; i < n; i++) channels.push_back(client->CreateChannel(true));
+  Settle();
+  Footprint c0 = client->Measure({});
+  Footprint s0 = client->server()->Measure();
+  for (grpc_channel* channel : channels) WaitForReady(channel);
+  Settle();
+  Result result{client->Measure({}) - c0, client->server()->Measure() - s0};
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  return result;
+}
+
+struct ClientCall {
+  grpc_call* call = nullptr;
+  grpc_metadata_array initial_metadata;
+  grpc_metadata_array trailing_metadata;
+  grpc_byte_buffer* response = nullptr;
+  grpc_status_code status;
+  grpc_slice details;
+};
+
+// Starts n calls on one channel and leaves them outstanding on the server.
+// Unary calls send their request and half close; streaming calls only send
+// initial metadata.
+Result ActiveCalls(Client* client, int n, bool unary) {
+  grpc_channel* channel = client->CreateChannel(false);
+  WaitForReady(channel);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_slice method = grpc_slice_from_static_string(kMethod);
+  grpc_slice request_payload = grpc_slice_from_static_string("hello world");
+  std::vector<ClientCall> calls(n);
+  std::vector<grpc_call*> c_calls;
+  c_calls.reserve(n);
+  auto start_calls = [&](size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      ClientCall& call = calls[i];
+      call.call = grpc_channel_create_call(
+          channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, method, nullptr,
+          gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      grpc_metadata_array_init(&call.initial_metadata);
+      grpc_metadata_array_init(&call.trailing_metadata);
+      grpc_byte_buffer* request =
+          grpc_raw_byte_buffer_create(&request_payload, 1);
+      grpc_op ops[6] = {};
+      grpc_op* op = ops;
+      op->op = GRPC_OP_SEND_INITIAL_METADATA;
+      op++;
+      if (unary) {
+        op->op = GRPC_OP_SEND_MESSAGE;
+        op->data.send_message.send_message = request;
+        op++;
+        op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+        op++;
+        op->op = GRPC_OP_RECV_INITIAL_METADATA;
+        op->data.recv_initial_metadata.recv_initial_metadata =
+            &call.initial_metadata;
+        op++;
+        op->op = GRPC_OP_RECV_MESSAGE;
+        op->data.recv_message.recv_message = &call.response;
+        op++;
+      }
+      op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+      op->data.recv_status_on_client.trailing_metadata =
+          &call.trailing_metadata;
+      op->data.recv_status_on_client.status = &call.status;
+      op->data.recv_status_on_client.status_details = &call.details;
+      op++;
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_call_start_batch(call.call, ops,
+                                       static_cast<size_t>(op - ops),
+                                       Tag(1), nullptr));
+      grpc_byte_buffer_destroy(request);
+      c_calls.push_back(call.call);
+    }
+  };
+  auto finish_calls = [&]() {
+    client->server()->Release();
+    for (size_t i = 0; i < c_calls.size(); i++) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    }
+    for (size_t i = 0; i < c_calls.size(); i++) {
+      ClientCall& call = calls[i];
+      grpc_call_unref(call.call);
+      grpc_metadata_array_destroy(&call.initial_metadata);
+      grpc_metadata_array_destroy(&call.trailing_metadata);
+      if (call.response != nullptr) grpc_byte_buffer_destroy(call.response);
+      call.response = nullptr;
+      grpc_slice_unref(call.details);
+    }
+    c_calls.clear();
+  };
+  // Warm up so that per-channel call size estimates and lazily created
+  // server state are in place before measuring.
+  start_calls(1);
+  while (client->server()->Measure().calls != 1) Settle();
+  finish_calls();
+  Settle();
+  Footprint c0 = client->Measure({});
+  Footprint s0 = client->server()->Measure();
+  start_calls(n);
+  while (client->server()->Measure().calls != n) Settle();
+  Settle();
+  Result result{client->Measure(c_calls) - c0,
+                client->server()->Measure() - s0};
+  finish_calls();
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+  grpc_channel_destroy(channel);
+  return result;
+}
+
+Json RunScenario(Client* client, const Stack& stack, absl::string_view scenario,
+                 int n) {
+  Result result;
+  if (scenario == "idle_channel") {
+    result = IdleChannel(client, n);
+  } else if (scenario == "idle_subchannel") {
+    // inproc channels have no subchannels.
+    if (client->inproc()) return Json();
+    result = IdleSubchannel(client, n);
+  } else if (scenario == "unary_call") {
+    result = ActiveCalls(client, n, /*unary=*/true);
+  } else if (scenario == "streaming_call") {
+    result = ActiveCalls(client, n, /*unary=*/false);
+  } else {
+    gpr_log(GPR_ERROR, "Unknown scenario: %s", std::string(scenario).c_str());
+    return Json();
+  }
+  gpr_log(GPR_INFO,
+          "%s/%s: client %.0f heap bytes, server %.0f heap bytes per item",
+          stack.name.c_str(), std::string(scenario).c_str(),
+          static_cast<double>(result.client.heap) / n,
+          static_cast<double>(result.server.heap) / n);
+  return Json::FromObject({
+      {"stack", Json::FromString(stack.name)},
+      {"scenario", Json::FromString(std::string(scenario))},
+      {"shared_process", Json::FromBool(stack.inproc)},
+      {"client", result.client.ToJsonPerItem(n)},
+      {"server", result.server.ToJsonPerItem(n)},
+  });
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  const std::vector<grpc_core::Stack> all_stacks = {
+      {"chttp2_insecure", /*inproc=*/false, /*tls=*/false},
+      {"chttp2_tls", /*inproc=*/false, /*tls=*/true},
+      {"inproc", /*inproc=*/true, /*tls=*/false},
+  };
+  std::vector<grpc_core::Stack> stacks;
+  for (absl::string_view name :
+       absl::StrSplit(absl::GetFlag(FLAGS_stacks), ',')) {
+    for (const auto& stack : all_stacks) {
+      if (stack.name == name) stacks.push_back(stack);
+    }
+  }
+  std::vector<std::string> scenarios =
+      absl::StrSplit(absl::GetFlag(FLAGS_scenarios), ',');
+  const int n = absl::GetFlag(FLAGS_size);
+  // The server process has to be forked before gRPC is initialized here.
+  auto remote = std::make_unique<grpc_core::RemoteServer>();
+  grpc_init();
+  grpc_core::Json::Array results;
+  for (const auto& stack : stacks) {
+    grpc_core::Client client(stack, remote.get());
+    for (const auto& scenario : scenarios) {
+      grpc_core::Json result = RunScenario(&client, stack, scenario, n);
+      if (result.type() != grpc_core::Json::Type::kNull) {
+        results.push_back(std::move(result));
+      }
+    }
+  }
+  std::string report = grpc_core::JsonDump(
+      grpc_core::Json::FromObject({
+          {"size", grpc_core::Json::FromNumber(n)},
+          {"results", grpc_core::Json::FromArray(std::move(results))},
+      }),
+      /*indent=*/2);
+  if (absl::GetFlag(FLAGS_output).empty()) {
+    printf("%s\n", report.c_str());
+  } else {
+    std::ofstream(absl::GetFlag(FLAGS_output)) << report << "\n";
+  }
+  grpc_shutdown_blocking();
+  remote.reset();
+  return 0;
+}
@@ -16,6 +16,10 @@
 
 #include <unistd.h>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 #include <fstream>
 #include <string>
 
@@ -55,3 +59,17 @@ long GetMemUsage(absl::optional<int> pid) {
   // Memory in KB
   return resident_set;
 }
+
+int64_t GetMallocInUseBytes() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+  return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#elif defined(__GLIBC__)
+  struct mallinfo info = mallinfo();
+  return static_cast<int64_t>(info.uordblks) +
+         static_cast<int64_t>(info.hblkhd);
+#else
+  return 0;
+#endif
+}
@@ -15,6 +15,8 @@
 #ifndef GRPC_TEST_CORE_MEMORY_USAGE_MEMSTATS_H
 #define GRPC_TEST_CORE_MEMORY_USAGE_MEMSTATS_H
 
+#include <stdint.h>
+
 #include "absl/types/optional.h"
 
 // IWYU pragma: no_include <bits/types/struct_rusage.h>
@@ -23,6 +25,10 @@
 // the pid
 long GetMemUsage(absl::optional<int> pid = absl::nullopt);
 
+// Get the number of bytes the calling process currently has allocated through
+// malloc, or 0 where the allocator doesn't report it
+int64_t GetMallocInUseBytes();
+
 struct MemStats {
   long rss;  // Resident set size, in kb
   static MemStats Snapshot() { return MemStats{GetMemUsage()}; }
@@ -16,13 +16,18 @@
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/activity.h"
 #include "src/core/lib/promise/promise.h"
 
@@ -140,6 +145,30 @@ TEST(MpscTest, BigBufferAllowsBurst) {
   }
 }
 
+TEST(MpscTest, OrderIsPreservedAcrossManyBatches) {
+  StrictMock<MockActivity> activity;
+  MpscReceiver<Payload> receiver(6);
+  MpscSender<Payload> sender1 = receiver.MakeSender();
+  MpscSender<Payload> sender2 = receiver.MakeSender();
+
+  activity.Activate();
+  EXPECT_CALL(activity, WakeupRequested()).Times(testing::AnyNumber());
+  int sent = 0;
+  int received = 0;
+  while (received < 100) {
+    // Fill the pipe, alternating senders, then drain some of it.
+    while (NowOrNever((sent % 2 == 0 ? sender1 : sender2)
+                          .Send(MakePayload(sent))) == true) {
+      sent++;
+    }
+    for (int i = 0; i < 2; i++) {
+      EXPECT_EQ(NowOrNever(receiver.Next()), MakePayload(received));
+      received++;
+    }
+  }
+  activity.Deactivate();
+}
+
 TEST(MpscTest, ClosureIsVisibleToSenders) {
   auto receiver = std::make_unique<MpscReceiver<Payload>>(1);
   MpscSender<Payload> sender = receiver->MakeSender();
@@ -147,6 +176,93 @@ TEST(MpscTest, ClosureIsVisibleToSenders) {
   EXPECT_EQ(NowOrNever(sender.Send(MakePayload(1))), false);
 }
 
+// An activity owned by a single thread, which polls a promise until it
+// resolves and sleeps in between until it is woken.  A wakeup that never
+// arrives makes RunUntilReady() fail instead of hang.
+class ThreadActivity : public Activity, public Wakeable {
+ public:
+  void ForceImmediateRepoll(WakeupMask) override { Wakeup(0); }
+  void Orphan() override {}
+  Waker MakeOwningWaker() override { return Waker(this, 0); }
+  Waker MakeNonOwningWaker() override { return Waker(this, 0); }
+  void Wakeup(WakeupMask) override {
+    MutexLock lock(&mu_);
+    woken_ = true;
+    cv_.Signal();
+  }
+  void WakeupAsync(WakeupMask) override { Wakeup(0); }
+  void Drop(WakeupMask) override {}
+  std::string DebugTag() const override { return "ThreadActivity"; }
+  std::string ActivityDebugTag(WakeupMask) const override { return DebugTag(); }
+
+  template <typename Promise>
+  auto RunUntilReady(Promise promise)
+      -> std::remove_reference_t<decltype(promise().value())> {
+    while (true) {
+      {
+        // A wakeup that arrives while polling must cause another poll.
+        MutexLock lock(&mu_);
+        woken_ = false;
+      }
+      {
+        ScopedActivity scoped_activity(this);
+        auto r = promise();
+        if (r.ready()) return std::move(r.value());
+      }
+      MutexLock lock(&mu_);
+      while (!woken_) {
+        if (cv_.WaitWithTimeout(&mu_, absl::Seconds(30))) {
+          ADD_FAILURE() << "lost wakeup";
+          woken_ = true;
+        }
+      }
+    }
+  }
+
+ private:
+  Mutex mu_;
+  CondVar cv_;
+  bool woken_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+// Several threads send concurrently into a small pipe that a receiver on
+// another thread drains: every item must arrive, in the order its sender
+// sent it, and no thread may be left waiting for a wakeup.
+TEST(MpscTest, ConcurrentSendersAndReceiver) {
+  constexpr int kNumSenders = 8;
+  constexpr int kItemsPerSender = 10000;
+  MpscReceiver<Payload> receiver(4);
+  std::vector<MpscSender<Payload>> senders;
+  for (int i = 0; i < kNumSenders; i++) {
+    senders.push_back(receiver.MakeSender());
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumSenders; i++) {
+    threads.emplace_back([i, sender = &senders[i]]() {
+      ThreadActivity activity;
+      for (int j = 0; j < kItemsPerSender; j++) {
+        EXPECT_TRUE(activity.RunUntilReady(
+            sender->Send(MakePayload(i * kItemsPerSender + j))));
+      }
+    });
+  }
+  std::vector<int> next_item(kNumSenders, 0);
+  ThreadActivity activity;
+  for (int n = 0; n < kNumSenders * kItemsPerSender; n++) {
+    Payload payload = activity.RunUntilReady(receiver.Next());
+    ASSERT_NE(payload.x, nullptr);
+    const int sender = *payload.x / kItemsPerSender;
+    ASSERT_GE(sender, 0);
+    ASSERT_LT(sender, kNumSenders);
+    EXPECT_EQ(*payload.x % kItemsPerSender, next_item[sender]);
+    next_item[sender] = *payload.x % kItemsPerSender + 1;
+  }
+  for (auto& thread : threads) thread.join();
+  for (int i = 0; i < kNumSenders; i++) {
+    EXPECT_EQ(next_item[i], kItemsPerSender);
+  }
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -161,6 +161,16 @@ TEST(TlsCredentialsOptionsComparatorTest, DifferentCrlDirectory) {
   delete options_1;
   delete options_2;
 }
+TEST(TlsCredentialsOptionsComparatorTest, DifferentSessionTicketKeyProvider) {
+  auto* options_1 = grpc_tls_credentials_options_create();
+  auto* options_2 = grpc_tls_credentials_options_create();
+  options_1->set_session_ticket_key_provider(MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(Duration::Hours(1), 2));
+  options_2->set_session_ticket_key_provider(MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(Duration::Hours(1), 2));
+  EXPECT_FALSE(*options_1 == *options_2);
+  EXPECT_FALSE(*options_2 == *options_1);
+  delete options_1;
+  delete options_2;
+}
 
 } // namespace
 } // namespace grpc_core
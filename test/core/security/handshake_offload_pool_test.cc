@@ -0,0 +1,133 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "src/core/lib/security/transport/handshake_offload_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(HandshakeOffloadPoolTest, RunsQueuedStepsBeforeExiting) {
+  std::atomic<int> steps_run{0};
+  {
+    HandshakeOffloadPool pool(2);
+    for (int i = 0; i < 100; ++i) {
+      pool.Run([&steps_run]() { steps_run.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(steps_run.load(), 100);
+}
+
+TEST(HandshakeOffloadPoolTest, LimitsConcurrency) {
+  HandshakeOffloadPool pool(2);
+  EXPECT_EQ(pool.max_concurrency(), 2u);
+  absl::Notification release;
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  for (int i = 0; i < 5; ++i) {
+    pool.Run([&]() {
+      int now_running = running.fetch_add(1) + 1;
+      int prev_max = max_running.load();
+      while (prev_max < now_running &&
+             !max_running.compare_exchange_weak(prev_max, now_running)) {
+      }
+      release.WaitForNotification();
+      running.fetch_sub(1);
+    });
+  }
+  while (pool.in_flight() < 2) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  EXPECT_EQ(pool.in_flight(), 2u);
+  EXPECT_EQ(pool.queue_depth(), 3u);
+  release.Notify();
+  while (pool.in_flight() > 0 || pool.queue_depth() > 0) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  EXPECT_EQ(max_running.load(), 2);
+}
+
+TEST(HandshakeOffloadPoolTest, StepsRunWithExecCtx) {
+  HandshakeOffloadPool pool(1);
+  absl::Notification done;
+  bool had_exec_ctx = false;
+  pool.Run([&]() {
+    had_exec_ctx = ExecCtx::Get() != nullptr;
+    done.Notify();
+  });
+  done.WaitForNotification();
+  EXPECT_TRUE(had_exec_ctx);
+}
+
+TEST(HandshakeOffloadPoolTest, DestroyedFromItsOwnThread) {
+  auto pool = std::make_shared<HandshakeOffloadPool>(1);
+  absl::Notification done;
+  HandshakeOffloadPool* pool_ptr = pool.get();
+  pool_ptr->Run([pool = std::move(pool), &done]() mutable {
+    pool.reset();
+    done.Notify();
+  });
+  done.WaitForNotification();
+}
+
+TEST(HandshakeOffloadPoolTest, RecordsStats) {
+  GlobalStatsSnapshot snapshot;
+  {
+    ExecCtx exec_ctx;
+    HandshakeOffloadPool pool(1);
+    for (int i = 0; i < 10; ++i) pool.Run([]() {});
+  }
+  auto delta = snapshot.Delta();
+  EXPECT_EQ(delta->handshake_offloads, 10u);
+  EXPECT_EQ(
+      delta->histogram(GlobalStats::Histogram::kHandshakeOffloadQueueDepth)
+          .Count(),
+      10);
+  // Pools from other tests may still be finishing up their last step.
+  EXPECT_GE(
+      delta->histogram(GlobalStats::Histogram::kHandshakeOffloadQueueTimeUs)
+          .Count(),
+      10);
+  EXPECT_GE(
+      delta->histogram(GlobalStats::Histogram::kHandshakeOffloadRunTimeUs)
+          .Count(),
+      10);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
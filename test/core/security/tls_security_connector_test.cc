@@ -31,12 +31,15 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/config_vars.h"
 #include "src/core/lib/gprpp/crash.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_credentials_options.h"
 #include "src/core/lib/security/credentials/tls/tls_credentials.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/tls_utils.h"
@@ -815,6 +818,45 @@ TEST_F(TlsSecurityConnectorTest,
   EXPECT_EQ(tls_connector->KeyCertPairListForTesting(), identity_pairs_1_);
 }
 
+TEST_F(TlsSecurityConnectorTest,
+       SessionStatsStartAtZeroWithSessionTicketKeyProvider) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  RefCountedPtr<grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  RefCountedPtr<grpc_tls_credentials_options> options =
+      MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_identity_pair(true);
+  options->set_identity_cert_name(kIdentityCertName);
+  options->set_session_ticket_key_provider(
+      MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(
+          Duration::Hours(1), 2));
+  RefCountedPtr<TlsServerCredentials> credential =
+      MakeRefCounted<TlsServerCredentials>(options);
+  RefCountedPtr<grpc_server_security_connector> connector =
+      credential->create_security_connector(ChannelArgs());
+  EXPECT_NE(connector, nullptr);
+  TlsServerSecurityConnector* tls_connector =
+      static_cast<TlsServerSecurityConnector*>(connector.get());
+  tsi_ssl_server_session_stats stats;
+  // No handshaker factory yet.
+  EXPECT_EQ(tls_connector->ServerHandshakerFactoryForTesting(), nullptr);
+  tls_connector->GetSessionStats(&stats);
+  EXPECT_EQ(stats.full_handshakes, 0);
+  EXPECT_EQ(stats.resumed_handshakes, 0);
+  EXPECT_EQ(stats.tickets_issued, 0);
+  distributor->SetKeyMaterials(kIdentityCertName, absl::nullopt,
+                               identity_pairs_0_);
+  EXPECT_NE(tls_connector->ServerHandshakerFactoryForTesting(), nullptr);
+  tls_connector->GetSessionStats(&stats);
+  EXPECT_EQ(stats.full_handshakes, 0);
+  EXPECT_EQ(stats.resumed_handshakes, 0);
+  EXPECT_EQ(stats.tickets_issued, 0);
+  EXPECT_EQ(stats.tickets_renewed, 0);
+  EXPECT_EQ(stats.tickets_rejected, 0);
+}
+
 // Note that on server side, we don't have tests watching root certs only,
 // because in TLS, the identity certs should always be presented. If we don't
 // provide, it will try to load certs from some default system locations, and
@@ -0,0 +1,210 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Simulates a single bulk stream over a fixed bandwidth, fixed delay link in
+// virtual time, and compares how quickly the two transport flow control
+// strategies open the receive window up to the link's capacity.
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/flow_control.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/bdp_estimator.h"
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
+namespace grpc_core {
+namespace chttp2 {
+namespace {
+
+gpr_timespec g_now;
+gpr_timespec now_impl(gpr_clock_type clock_type) {
+  GPR_ASSERT(clock_type != GPR_TIMESPAN);
+  gpr_timespec ts = g_now;
+  ts.clock_type = clock_type;
+  return ts;
+}
+
+void InitGlobals() {
+  g_now = {1, 0, GPR_CLOCK_MONOTONIC};
+  TestOnlySetProcessEpoch(g_now);
+  gpr_now_impl = now_impl;
+}
+
+struct Link {
+  // Bottleneck bandwidth.
+  int64_t bytes_per_ms;
+  // One way delay.
+  int64_t delay_ms;
+};
+
+struct SimulationResult {
+  // First time at which the stream achieved 90% of the link bandwidth,
+  // measured over a round trip, or -1 if it never did.
+  int64_t ms_to_90_percent = -1;
+  // Average utilization of the link over the second half of the run.
+  double steady_state_utilization = 0;
+  // Number of BDP pings the receiver sent.
+  int pings = 0;
+};
+
+// Runs a sender with an infinite amount of data to send, and a receiver that
+// reads everything as soon as it arrives, for the given number of
+// milliseconds. The sender is only limited by the link and by the initial
+// window the receiver advertises; window updates and settings take one way
+// delay to reach the sender, and BDP pings take a round trip.
+SimulationResult Simulate(const Link& link, bool delivery_rate_model,
+                          int64_t run_ms) {
+  ExecCtx exec_ctx;
+  MemoryOwner memory_owner = MemoryOwner(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryOwner("sim"));
+  TransportFlowControl tfc("sim", /*enable_bdp_probe=*/true, &memory_owner,
+                           delivery_rate_model);
+  BdpEstimator* bdp = tfc.bdp_estimator();
+  const int64_t rtt_ms = 2 * link.delay_ms;
+  // Receive window the sender currently knows about.
+  int64_t sender_window = kDefaultWindow;
+  // (time the bytes reach the receiver, bytes)
+  std::deque<std::pair<int64_t, int64_t>> in_flight;
+  // (time the receiver's window update reaches the sender, bytes)
+  std::deque<std::pair<int64_t, int64_t>> unacked;
+  int64_t unacked_bytes = 0;
+  // (time the setting reaches the sender, new initial window)
+  std::deque<std::pair<int64_t, int64_t>> settings;
+  std::deque<int64_t> delivered_per_ms;
+  int64_t delivered_last_rtt = 0;
+  int64_t delivered_second_half = 0;
+  int64_t ping_done_ms = -1;
+  Timestamp next_ping = Timestamp::Now();
+  SimulationResult result;
+  auto act = [&](FlowControlAction action, int64_t now_ms) {
+    if (action.send_initial_window_update() !=
+        FlowControlAction::Urgency::NO_ACTION_NEEDED) {
+      settings.emplace_back(now_ms + link.delay_ms,
+                            action.initial_window_size());
+    }
+  };
+  act(tfc.PeriodicUpdate(), 0);
+  for (int64_t now_ms = 0; now_ms < run_ms; now_ms++) {
+    g_now = gpr_time_add(g_now, gpr_time_from_millis(1, GPR_TIMESPAN));
+    ExecCtx::Get()->InvalidateNow();
+    // Sender side: apply settings and window updates that have arrived, then
+    // send as much as the link and the window allow.
+    while (!settings.empty() && settings.front().first <= now_ms) {
+      sender_window = settings.front().second;
+      settings.pop_front();
+    }
+    while (!unacked.empty() && unacked.front().first <= now_ms) {
+      unacked_bytes -= unacked.front().second;
+      unacked.pop_front();
+    }
+    const int64_t send = std::min(
+        link.bytes_per_ms, std::max(int64_t{0}, sender_window - unacked_bytes));
+    if (send > 0) {
+      in_flight.emplace_back(now_ms + link.delay_ms, send);
+      unacked.emplace_back(now_ms + rtt_ms, send);
+      unacked_bytes += send;
+    }
+    // Receiver side: account for data that has arrived, and drive BDP pings
+    // the way the transport does.
+    int64_t delivered = 0;
+    while (!in_flight.empty() && in_flight.front().first <= now_ms) {
+      delivered += in_flight.front().second;
+      in_flight.pop_front();
+    }
+    if (delivered > 0) bdp->AddIncomingBytes(delivered);
+    if (ping_done_ms == now_ms) {
+      ping_done_ms = -1;
+      next_ping = bdp->CompletePing();
+      act(tfc.PeriodicUpdate(), now_ms);
+    }
+    if (ping_done_ms == -1 && Timestamp::Now() >= next_ping &&
+        bdp->accumulator() > 0) {
+      bdp->SchedulePing();
+      bdp->StartPing();
+      ping_done_ms = now_ms + rtt_ms;
+      ++result.pings;
+    }
+    // Bookkeeping.
+    delivered_per_ms.push_back(delivered);
+    delivered_last_rtt += delivered;
+    if (static_cast<int64_t>(delivered_per_ms.size()) > rtt_ms) {
+      delivered_last_rtt -= delivered_per_ms.front();
+      delivered_per_ms.pop_front();
+    }
+    if (result.ms_to_90_percent == -1 &&
+        delivered_last_rtt * 10 >= link.bytes_per_ms * rtt_ms * 9) {
+      result.ms_to_90_percent = now_ms;
+    }
+    if (now_ms >= run_ms / 2) delivered_second_half += delivered;
+  }
+  result.steady_state_utilization =
+      static_cast<double>(delivered_second_half) /
+      static_cast<double>(link.bytes_per_ms * (run_ms - run_ms / 2));
+  gpr_log(GPR_INFO,
+          "%s: link=%" PRId64 "Mbps rtt=%" PRId64 "ms: 90%% after %" PRId64
+          "ms, steady state utilization %.1f%%, %d pings",
+          delivery_rate_model ? "delivery rate" : "pid",
+          link.bytes_per_ms * 8 / 1000, rtt_ms, result.ms_to_90_percent,
+          100 * result.steady_state_utilization, result.pings);
+  return result;
+}
+
+TEST(FlowControlSimulationTest, CrossContinentLink) {
+  // 1Gbps with a 150ms round trip: an 18.75MB bandwidth-delay product.
+  const Link link{125000, 75};
+  const int64_t kRunMs = 60000;
+  SimulationResult pid = Simulate(link, false, kRunMs);
+  SimulationResult delivery_rate = Simulate(link, true, kRunMs);
+  ASSERT_NE(delivery_rate.ms_to_90_percent, -1);
+  EXPECT_GT(delivery_rate.steady_state_utilization, 0.9);
+  if (pid.ms_to_90_percent != -1) {
+    EXPECT_LE(delivery_rate.ms_to_90_percent, pid.ms_to_90_percent);
+  }
+  EXPECT_GE(delivery_rate.steady_state_utilization,
+            pid.steady_state_utilization);
+  EXPECT_LE(delivery_rate.pings, pid.pings);
+}
+
+TEST(FlowControlSimulationTest, LowLatencyLink) {
+  // 10Gbps with a 2ms round trip.
+  const Link link{1250000, 1};
+  const int64_t kRunMs = 10000;
+  Simulate(link, false, kRunMs);
+  SimulationResult delivery_rate = Simulate(link, true, kRunMs);
+  ASSERT_NE(delivery_rate.ms_to_90_percent, -1);
+  EXPECT_GT(delivery_rate.steady_state_utilization, 0.9);
+}
+
+}  // namespace
+}  // namespace chttp2
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::chttp2::InitGlobals();
+  return RUN_ALL_TESTS();
+}
@@ -403,6 +403,52 @@ TEST(HpackEncoderTest, EncodeBinaryAsTrueBinary) {
   EXPECT_EQ(compressor.test_only_table_size(), 114);
 }
 
+TEST(HpackEncoderTest, EncodeStreamWeightAsPriority) {
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(1024, &memory_allocator);
+  grpc_metadata_batch b(arena.get());
+  b.Append("key", grpc_core::Slice::FromCopiedString(std::string(400, 'a')),
+           CrashOnAppendError);
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  grpc_core::HPackCompressor::EncodeHeaderOptions hopt = {
+      0xdeadbeef,  // stream_id
+      false,       // is_eof
+      false,       // use_true_binary_metadata
+      150,         // max_frame_size
+      &stats,      // stats
+      256};        // stream_weight
+  grpc_core::HPackCompressor compressor;
+  compressor.EncodeHeaders(hopt, b, &output);
+  const grpc_slice merged = grpc_slice_merge(output.slices, output.count);
+  grpc_slice_buffer_destroy(&output);
+
+  const uint8_t* p = GRPC_SLICE_START_PTR(merged);
+  const size_t length = GRPC_SLICE_LENGTH(merged);
+  // The HEADERS frame carries the PRIORITY block, and still fits the frame.
+  size_t frame_size = (p[0] << 16) | (p[1] << 8) | p[2];
+  EXPECT_LE(frame_size, 150);
+  EXPECT_EQ(p[3], GRPC_CHTTP2_FRAME_HEADER);
+  EXPECT_EQ(p[4], GRPC_CHTTP2_FLAG_HAS_PRIORITY);
+  EXPECT_EQ(p[9], 0);
+  EXPECT_EQ(p[10], 0);
+  EXPECT_EQ(p[11], 0);
+  EXPECT_EQ(p[12], 0);
+  EXPECT_EQ(p[13], 255);
+  // Only the first frame does.
+  size_t offset = 9 + frame_size;
+  ASSERT_LT(offset + 9, length);
+  EXPECT_EQ(p[offset + 3], GRPC_CHTTP2_FRAME_CONTINUATION);
+  EXPECT_EQ(p[offset + 4] & GRPC_CHTTP2_FLAG_HAS_PRIORITY, 0);
+  EXPECT_EQ(stats.framing_bytes, 9 * 2 + 5);
+  grpc_slice_unref(merged);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
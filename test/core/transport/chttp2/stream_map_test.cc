@@ -169,6 +169,53 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+// keep a few long lived streams open while many short lived ones (using only
+// odd ids, like a real connection) come and go: the long lived streams must
+// stay reachable and the ring must not grow
+static void test_long_lived_streams(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+  uint32_t for_each_count = 0;
+
+  LOG_TEST("test_long_lived_streams");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 16);
+  grpc_chttp2_stream_map_add(&map, 1, reinterpret_cast<void*>(1));
+  grpc_chttp2_stream_map_add(&map, 3, reinterpret_cast<void*>(3));
+  for (i = 5; i < 2 * n + 5; i += 2) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+    if (i > 5 + 2 * 4) {
+      ASSERT_EQ((void*)(uintptr_t)(i - 2 * 5),
+                grpc_chttp2_stream_map_delete(&map, i - 2 * 5));
+    }
+    ASSERT_EQ((void*)(uintptr_t)1, grpc_chttp2_stream_map_find(&map, 1));
+    ASSERT_EQ((void*)(uintptr_t)3, grpc_chttp2_stream_map_find(&map, 3));
+    ASSERT_EQ((void*)(uintptr_t)i, grpc_chttp2_stream_map_find(&map, i));
+    ASSERT_EQ(nullptr, grpc_chttp2_stream_map_find(&map, i + 2));
+    ASSERT_NE(nullptr, grpc_chttp2_stream_map_rand(&map));
+  }
+  ASSERT_EQ(map.capacity, 16);
+  grpc_chttp2_stream_map_for_each(
+      &map,
+      [](void* user_data, uint32_t key, void* value) {
+        uint32_t* count = static_cast<uint32_t*>(user_data);
+        ASSERT_EQ(key, reinterpret_cast<uintptr_t>(value));
+        ++*count;
+      },
+      &for_each_count);
+  ASSERT_EQ(for_each_count, grpc_chttp2_stream_map_size(&map));
+  ASSERT_EQ((void*)(uintptr_t)3, grpc_chttp2_stream_map_delete(&map, 3));
+  ASSERT_EQ((void*)(uintptr_t)1, grpc_chttp2_stream_map_delete(&map, 1));
+  ASSERT_EQ(nullptr, grpc_chttp2_stream_map_find(&map, 1));
+  // a peer may skip arbitrarily far ahead in the id space
+  grpc_chttp2_stream_map_add(&map, 0x7fffffff, reinterpret_cast<void*>(1));
+  ASSERT_EQ((void*)(uintptr_t)1,
+            grpc_chttp2_stream_map_find(&map, 0x7fffffff));
+  ASSERT_LE(map.capacity, 32);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 TEST(StreamMapTest, MainTest) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,6 +229,7 @@ TEST(StreamMapTest, MainTest) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_long_lived_streams(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,509 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Tests for how a chttp2 client transport gathers stream data into writes:
+// streams are served round robin by bytes, and small messages are held back
+// for coalescing when GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES is set.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// The peer's (default) max frame size, which is also the number of DATA bytes
+// a stream of default weight may send each time the writer visits it.
+constexpr size_t kMaxFrameSize = 16384;
+
+struct Frame {
+  uint8_t type;
+  uint8_t flags;
+  uint32_t stream_id;
+  uint32_t length;
+};
+
+// Splits the bytes of one write into frames, skipping the connection preface.
+std::vector<Frame> ParseFrames(absl::string_view bytes) {
+  if (absl::StartsWith(bytes, GRPC_CHTTP2_CLIENT_CONNECT_STRING)) {
+    bytes.remove_prefix(GRPC_CHTTP2_CLIENT_CONNECT_STRLEN);
+  }
+  std::vector<Frame> frames;
+  while (bytes.size() >= 9) {
+    const auto* p = reinterpret_cast<const uint8_t*>(bytes.data());
+    Frame frame;
+    frame.length = (uint32_t{p[0]} << 16) | (uint32_t{p[1]} << 8) | p[2];
+    frame.type = p[3];
+    frame.flags = p[4];
+    frame.stream_id = (uint32_t{p[5] & 0x7fu} << 24) | (uint32_t{p[6]} << 16) |
+                      (uint32_t{p[7]} << 8) | p[8];
+    frames.push_back(frame);
+    bytes.remove_prefix(std::min<size_t>(bytes.size(), 9 + frame.length));
+  }
+  return frames;
+}
+
+std::string FrameHeader(uint32_t length, uint8_t type, uint8_t flags,
+                        uint32_t stream_id) {
+  const char header[9] = {static_cast<char>(length >> 16),
+                          static_cast<char>(length >> 8),
+                          static_cast<char>(length),
+                          static_cast<char>(type),
+                          static_cast<char>(flags),
+                          static_cast<char>(stream_id >> 24),
+                          static_cast<char>(stream_id >> 16),
+                          static_cast<char>(stream_id >> 8),
+                          static_cast<char>(stream_id)};
+  return std::string(header, sizeof(header));
+}
+
+std::string BigEndian32(uint32_t value) {
+  const char bytes[4] = {
+      static_cast<char>(value >> 24), static_cast<char>(value >> 16),
+      static_cast<char>(value >> 8), static_cast<char>(value)};
+  return std::string(bytes, sizeof(bytes));
+}
+
+// What the server sends first: settings with large stream windows, a large
+// connection window, and the ack of the client's settings.
+std::string ServerPreface() {
+  return FrameHeader(6, GRPC_CHTTP2_FRAME_SETTINGS, 0, 0) +
+         std::string("\x00\x04", 2) + BigEndian32(1 << 24) +
+         FrameHeader(4, GRPC_CHTTP2_FRAME_WINDOW_UPDATE, 0, 0) +
+         BigEndian32(1 << 24) +
+         FrameHeader(0, GRPC_CHTTP2_FRAME_SETTINGS, GRPC_CHTTP2_FLAG_ACK, 0);
+}
+
+// The bytes of each write on an endpoint.
+class WriteLog {
+ public:
+  void Add(std::string bytes) {
+    MutexLock lock(&mu_);
+    writes_.push_back(std::move(bytes));
+  }
+
+  void Clear() {
+    MutexLock lock(&mu_);
+    writes_.clear();
+  }
+
+  size_t size() {
+    MutexLock lock(&mu_);
+    return writes_.size();
+  }
+
+  std::vector<Frame> FramesOfWrite(size_t index) {
+    MutexLock lock(&mu_);
+    return ParseFrames(writes_[index]);
+  }
+
+  std::vector<Frame> AllFrames() {
+    MutexLock lock(&mu_);
+    std::vector<Frame> frames;
+    for (const std::string& write : writes_) {
+      auto write_frames = ParseFrames(write);
+      frames.insert(frames.end(), write_frames.begin(), write_frames.end());
+    }
+    return frames;
+  }
+
+ private:
+  Mutex mu_;
+  std::vector<std::string> writes_ ABSL_GUARDED_BY(mu_);
+};
+
+// An endpoint that logs every write and completes it right away, and reads
+// whatever the test pushes to it.
+class LoggingEndpoint : public grpc_endpoint {
+ public:
+  explicit LoggingEndpoint(std::shared_ptr<WriteLog> write_log)
+      : write_log_(std::move(write_log)) {
+    static const grpc_endpoint_vtable vtable = {
+        Read,     Write,   AddToPollset, AddToPollsetSet, DeleteFromPollsetSet,
+        Shutdown, Destroy, GetPeer,      GetLocalAddress, GetFd,
+        CanTrackErr};
+    grpc_endpoint::vtable = &vtable;
+  }
+
+  void PushInput(std::string bytes) {
+    input_ += bytes;
+    MaybeFinishRead();
+  }
+
+ private:
+  void MaybeFinishRead() {
+    if (read_cb_ == nullptr || input_.empty()) return;
+    grpc_slice_buffer_add(read_slices_,
+                          grpc_slice_from_cpp_string(std::move(input_)));
+    input_.clear();
+    ExecCtx::Run(DEBUG_LOCATION, std::exchange(read_cb_, nullptr),
+                 absl::OkStatus());
+  }
+
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, bool /*urgent*/,
+                   int /*min_progress_size*/) {
+    auto* self = static_cast<LoggingEndpoint*>(ep);
+    self->read_slices_ = slices;
+    self->read_cb_ = cb;
+    self->MaybeFinishRead();
+  }
+
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* /*arg*/, int /*max_frame_size*/) {
+    std::string bytes;
+    for (size_t i = 0; i < slices->count; ++i) {
+      const grpc_slice& slice = slices->slices[i];
+      bytes.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                   GRPC_SLICE_LENGTH(slice));
+    }
+    static_cast<LoggingEndpoint*>(ep)->write_log_->Add(std::move(bytes));
+    ExecCtx::Run(DEBUG_LOCATION, cb, absl::OkStatus());
+  }
+
+  static void AddToPollset(grpc_endpoint* /*ep*/, grpc_pollset* /*pollset*/) {}
+  static void AddToPollsetSet(grpc_endpoint* /*ep*/,
+                              grpc_pollset_set* /*pollset_set*/) {}
+  static void DeleteFromPollsetSet(grpc_endpoint* /*ep*/,
+                                   grpc_pollset_set* /*pollset_set*/) {}
+
+  static void Shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+    auto* self = static_cast<LoggingEndpoint*>(ep);
+    if (self->read_cb_ != nullptr) {
+      ExecCtx::Run(DEBUG_LOCATION, std::exchange(self->read_cb_, nullptr),
+                   why);
+    }
+  }
+
+  static void Destroy(grpc_endpoint* ep) {
+    delete static_cast<LoggingEndpoint*>(ep);
+  }
+
+  static absl::string_view GetPeer(grpc_endpoint* /*ep*/) { return "test"; }
+  static absl::string_view GetLocalAddress(grpc_endpoint* /*ep*/) {
+    return "test";
+  }
+  static int GetFd(grpc_endpoint* /*ep*/) { return -1; }
+  static bool CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  std::shared_ptr<WriteLog> write_log_;
+  std::string input_;
+  grpc_slice_buffer* read_slices_ = nullptr;
+  grpc_closure* read_cb_ = nullptr;
+};
+
+// A client stream on the transport, driven with raw stream op batches.
+class TestStream {
+ public:
+  explicit TestStream(grpc_transport* transport)
+      : transport_(transport),
+        stream_(static_cast<grpc_stream*>(
+            gpr_malloc(grpc_transport_stream_size(transport)))),
+        arena_(Arena::Create(4096, &memory_allocator_)) {
+    GRPC_STREAM_REF_INIT(&refcount_, 1, FinishDestroy, this, "test_stream");
+    GRPC_CLOSURE_INIT(&destroyed_closure_, OnDestroyed, this, nullptr);
+    grpc_transport_init_stream(transport_, stream_, &refcount_, nullptr,
+                               arena_);
+  }
+
+  ~TestStream() {
+    Batch* batch = NewBatch();
+    batch->op.cancel_stream = true;
+    batch->payload.cancel_stream.cancel_error = absl::CancelledError();
+    grpc_transport_perform_stream_op(transport_, stream_, &batch->op);
+#ifndef NDEBUG
+    grpc_stream_unref(&refcount_, "test_stream");
+#else
+    grpc_stream_unref(&refcount_);
+#endif
+    ExecCtx::Get()->Flush();
+    destroyed_.WaitForNotification();
+    batches_.clear();
+    gpr_free(stream_);
+    arena_->Destroy();
+  }
+
+  void SendInitialMetadata() {
+    Batch* batch = NewBatch();
+    batch->metadata.emplace(arena_);
+    batch->metadata->Set(HttpSchemeMetadata(), HttpSchemeMetadata::kHttp);
+    batch->metadata->Set(HttpMethodMetadata(), HttpMethodMetadata::kPost);
+    batch->metadata->Set(HttpPathMetadata(),
+                         Slice::FromStaticString("/foo/bar"));
+    batch->metadata->Set(HttpAuthorityMetadata(),
+                         Slice::FromStaticString("foo.test"));
+    batch->metadata->Set(TeMetadata(), TeMetadata::kTrailers);
+    batch->metadata->Set(ContentTypeMetadata(),
+                         ContentTypeMetadata::kApplicationGrpc);
+    batch->op.send_initial_metadata = true;
+    batch->payload.send_initial_metadata.send_initial_metadata =
+        &*batch->metadata;
+    grpc_transport_perform_stream_op(transport_, stream_, &batch->op);
+  }
+
+  void SendMessage(size_t size) {
+    Batch* batch = NewBatch();
+    batch->message.Append(Slice::FromCopiedString(std::string(size, 'a')));
+    batch->op.send_message = true;
+    batch->payload.send_message.send_message = &batch->message;
+    grpc_transport_perform_stream_op(transport_, stream_, &batch->op);
+  }
+
+  // Only known once the initial metadata has been sent.
+  uint32_t id() const {
+    return reinterpret_cast<grpc_chttp2_stream*>(stream_)->id;
+  }
+
+ private:
+  struct Batch {
+    Batch() {
+      op.payload = &payload;
+      op.on_complete =
+          GRPC_CLOSURE_INIT(&on_complete, DoNothing, nullptr, nullptr);
+    }
+    static void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+    grpc_transport_stream_op_batch op;
+    grpc_transport_stream_op_batch_payload payload{nullptr};
+    grpc_closure on_complete;
+    SliceBuffer message;
+    absl::optional<grpc_metadata_batch> metadata;
+  };
+
+  Batch* NewBatch() {
+    batches_.push_back(std::make_unique<Batch>());
+    return batches_.back().get();
+  }
+
+  static void FinishDestroy(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<TestStream*>(arg);
+    grpc_transport_destroy_stream(self->transport_, self->stream_,
+                                  &self->destroyed_closure_);
+  }
+
+  static void OnDestroyed(void* arg, grpc_error_handle /*error*/) {
+    static_cast<TestStream*>(arg)->destroyed_.Notify();
+  }
+
+  grpc_transport* const transport_;
+  grpc_stream* const stream_;
+  MemoryAllocator memory_allocator_ = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  Arena* const arena_;
+  grpc_stream_refcount refcount_;
+  grpc_closure destroyed_closure_;
+  absl::Notification destroyed_;
+  std::vector<std::unique_ptr<Batch>> batches_;
+};
+
+class WriteSchedulingTest : public ::testing::Test {
+ protected:
+  ~WriteSchedulingTest() override {
+    streams_.clear();
+    if (transport_ != nullptr) grpc_transport_destroy(transport_);
+    ExecCtx::Get()->Flush();
+  }
+
+  void StartTransport(const ChannelArgs& args) {
+    auto* endpoint = new LoggingEndpoint(write_log_);
+    transport_ = grpc_create_chttp2_transport(
+        CoreConfiguration::Get()
+            .channel_args_preconditioning()
+            .PreconditionChannelArgs(args.ToC().get()),
+        endpoint, /*is_client=*/true);
+    grpc_chttp2_transport_start_reading(transport_, nullptr, nullptr, nullptr);
+    endpoint->PushInput(ServerPreface());
+    ExecCtx::Get()->Flush();
+  }
+
+  // Starts streams, and forgets the writes so far.
+  std::vector<TestStream*> StartStreams(size_t num_streams) {
+    std::vector<TestStream*> streams;
+    for (size_t i = 0; i < num_streams; ++i) {
+      streams_.push_back(std::make_unique<TestStream>(transport_));
+      streams_.back()->SendInitialMetadata();
+      streams.push_back(streams_.back().get());
+    }
+    ExecCtx::Get()->Flush();
+    write_log_->Clear();
+    return streams;
+  }
+
+  static std::set<uint32_t> StreamsWithData(const std::vector<Frame>& frames) {
+    std::set<uint32_t> ids;
+    for (const Frame& frame : frames) {
+      if (frame.type == GRPC_CHTTP2_FRAME_DATA) ids.insert(frame.stream_id);
+    }
+    return ids;
+  }
+
+  ExecCtx exec_ctx_;
+  std::shared_ptr<WriteLog> write_log_ = std::make_shared<WriteLog>();
+  grpc_transport* transport_ = nullptr;
+  std::vector<std::unique_ptr<TestStream>> streams_;
+};
+
+TEST_F(WriteSchedulingTest, StreamsTakeTurnsByBytes) {
+  constexpr size_t kMessageSize = 256 * 1024;
+  constexpr size_t kStreamBytes = kMessageSize + GRPC_HEADER_SIZE_IN_BYTES;
+  StartTransport(ChannelArgs());
+  std::vector<TestStream*> streams = StartStreams(3);
+  // Queue all the messages before the transport gets to write any of them.
+  for (TestStream* stream : streams) stream->SendMessage(kMessageSize);
+  ExecCtx::Get()->Flush();
+  std::map<uint32_t, size_t> sent;
+  for (TestStream* stream : streams) sent[stream->id()] = 0;
+  bool all_busy = true;
+  for (const Frame& frame : write_log_->AllFrames()) {
+    if (frame.type != GRPC_CHTTP2_FRAME_DATA) continue;
+    ASSERT_EQ(sent.count(frame.stream_id), 1u);
+    sent[frame.stream_id] += frame.length;
+    if (!all_busy) continue;
+    // As long as every stream has data to send, none gets more than a quantum
+    // ahead of another, no matter how much it has queued.
+    size_t least = kStreamBytes;
+    size_t most = 0;
+    for (const auto& p : sent) {
+      least = std::min(least, p.second);
+      most = std::max(most, p.second);
+    }
+    EXPECT_LE(most - least, kMaxFrameSize);
+    all_busy = most < kStreamBytes;
+  }
+  for (const auto& p : sent) {
+    EXPECT_EQ(p.second, kStreamBytes) << "stream " << p.first;
+  }
+}
+
+TEST_F(WriteSchedulingTest, SmallMessagesWaitForMinBytes) {
+  StartTransport(
+      ChannelArgs()
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES, 64 * 1024)
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US, 60 * 1000 * 1000));
+  std::vector<TestStream*> streams = StartStreams(3);
+  streams[0]->SendMessage(100);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(write_log_->size(), 0u);
+  streams[1]->SendMessage(100);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(write_log_->size(), 0u);
+  // Enough bytes are now pending: everything goes out in one write.
+  streams[2]->SendMessage(64 * 1024);
+  ExecCtx::Get()->Flush();
+  ASSERT_GE(write_log_->size(), 1u);
+  EXPECT_EQ(StreamsWithData(write_log_->FramesOfWrite(0)),
+            std::set<uint32_t>(
+                {streams[0]->id(), streams[1]->id(), streams[2]->id()}));
+}
+
+TEST_F(WriteSchedulingTest, OtherWritesFlushHeldBackMessages) {
+  StartTransport(
+      ChannelArgs()
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES, 64 * 1024)
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US, 60 * 1000 * 1000));
+  std::vector<TestStream*> streams = StartStreams(1);
+  streams[0]->SendMessage(100);
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(write_log_->size(), 0u);
+  // Starting another stream writes its headers right away, along with the
+  // message that was held back.
+  streams_.push_back(std::make_unique<TestStream>(transport_));
+  streams_.back()->SendInitialMetadata();
+  ExecCtx::Get()->Flush();
+  ASSERT_GE(write_log_->size(), 1u);
+  EXPECT_EQ(StreamsWithData(write_log_->FramesOfWrite(0)),
+            std::set<uint32_t>({streams[0]->id()}));
+}
+
+TEST_F(WriteSchedulingTest, DelayFlushesHeldBackMessages) {
+  StartTransport(
+      ChannelArgs()
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES, 64 * 1024)
+          .Set(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US, 200 * 1000));
+  std::vector<TestStream*> streams = StartStreams(1);
+  const absl::Time start = absl::Now();
+  streams[0]->SendMessage(100);
+  ExecCtx::Get()->Flush();
+  if (absl::Now() - start < absl::Milliseconds(200)) {
+    EXPECT_EQ(write_log_->size(), 0u);
+  }
+  // The coalescing timer writes the message out by itself.
+  while (write_log_->size() == 0 &&
+         absl::Now() - start < absl::Seconds(30)) {
+    absl::SleepFor(absl::Milliseconds(1));
+    ExecCtx::Get()->Flush();
+  }
+  ASSERT_GE(write_log_->size(), 1u);
+  EXPECT_GE(absl::Now() - start, absl::Milliseconds(200));
+  EXPECT_EQ(StreamsWithData(write_log_->FramesOfWrite(0)),
+            std::set<uint32_t>({streams[0]->id()}));
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -36,6 +36,7 @@ constexpr size_t kMaxSliceLength = 256;
 constexpr size_t kMaxSlices = 10;
 constexpr size_t kSealRepeatTimes = 5;
 constexpr size_t kTagLength = 16;
+constexpr size_t kMaxUnprotectedFrameSize = 64;
 
 // Test fixtures for each test cases.
 struct alts_grpc_record_protocol_test_fixture {
@@ -409,6 +410,114 @@ static void input_check(alts_grpc_record_protocol* rp) {
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static size_t frame_count(size_t data_length) {
+  if (data_length == 0) return 1;
+  return (data_length + kMaxUnprotectedFrameSize - 1) /
+         kMaxUnprotectedFrameSize;
+}
+
+static void random_seal_unseal_frames(alts_grpc_record_protocol* sender,
+                                      alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_grpc_record_protocol_test_var* var =
+        alts_grpc_record_protocol_test_var_create();
+    // Seals into frames and then unseals all of them at once.
+    size_t data_length = var->original_sb.length;
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        sender, &var->original_sb, kMaxUnprotectedFrameSize,
+        &var->protected_sb);
+    ASSERT_EQ(status, TSI_OK);
+    ASSERT_EQ(var->protected_sb.length,
+              data_length + frame_count(data_length) *
+                                (var->header_length + var->tag_length));
+    status = alts_grpc_record_protocol_unprotect_frames(
+        receiver, &var->protected_sb, &var->unprotected_sb);
+    ASSERT_EQ(status, TSI_OK);
+    ASSERT_TRUE(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    alts_grpc_record_protocol_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+static void empty_seal_unseal_frames(alts_grpc_record_protocol* sender,
+                                     alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  alts_grpc_record_protocol_test_var* var =
+      alts_grpc_record_protocol_test_var_create();
+  // Empty input still makes a single, empty frame.
+  grpc_slice_buffer_reset_and_unref(&var->original_sb);
+  grpc_slice_buffer_reset_and_unref(&var->duplicate_sb);
+  tsi_result status = alts_grpc_record_protocol_protect_frames(
+      sender, &var->original_sb, kMaxUnprotectedFrameSize, &var->protected_sb);
+  ASSERT_EQ(status, TSI_OK);
+  ASSERT_EQ(var->protected_sb.length, var->header_length + var->tag_length);
+  status = alts_grpc_record_protocol_unprotect_frames(
+      receiver, &var->protected_sb, &var->unprotected_sb);
+  ASSERT_EQ(status, TSI_OK);
+  ASSERT_EQ(var->unprotected_sb.length, 0u);
+  alts_grpc_record_protocol_test_var_destroy(var);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+static void short_frame_length_unseal_frames(
+    alts_grpc_record_protocol* sender, alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  alts_grpc_record_protocol_test_var* var =
+      alts_grpc_record_protocol_test_var_create();
+  tsi_result status = alts_grpc_record_protocol_protect_frames(
+      sender, &var->original_sb, kMaxUnprotectedFrameSize, &var->protected_sb);
+  ASSERT_EQ(status, TSI_OK);
+  // Sets the little-endian length field of the first frame to one byte less
+  // than the rest of the header plus the tag.
+  size_t length_field = var->header_length + var->tag_length - 4 - 1;
+  for (size_t i = 0; i < 4; i++) {
+    *pointer_to_nth_byte(&var->protected_sb, i) =
+        static_cast<uint8_t>(length_field >> (8 * i));
+  }
+  status = alts_grpc_record_protocol_unprotect_frames(
+      receiver, &var->protected_sb, &var->unprotected_sb);
+  ASSERT_EQ(status, TSI_INVALID_ARGUMENT);
+  alts_grpc_record_protocol_test_var_destroy(var);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+static void truncated_last_frame_unseal_frames(
+    alts_grpc_record_protocol* sender, alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  alts_grpc_record_protocol_test_var* var =
+      alts_grpc_record_protocol_test_var_create();
+  tsi_result status = alts_grpc_record_protocol_protect_frames(
+      sender, &var->original_sb, kMaxUnprotectedFrameSize, &var->protected_sb);
+  ASSERT_EQ(status, TSI_OK);
+  // Drops the last byte of the last frame.
+  grpc_slice_buffer_trim_end(&var->protected_sb, 1, nullptr);
+  status = alts_grpc_record_protocol_unprotect_frames(
+      receiver, &var->protected_sb, &var->unprotected_sb);
+  ASSERT_EQ(status, TSI_INVALID_ARGUMENT);
+  alts_grpc_record_protocol_test_var_destroy(var);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+static void frames_unimplemented(alts_grpc_record_protocol* sender,
+                                 alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  alts_grpc_record_protocol_test_var* var =
+      alts_grpc_record_protocol_test_var_create();
+  tsi_result status = alts_grpc_record_protocol_protect_frames(
+      sender, &var->original_sb, kMaxUnprotectedFrameSize, &var->protected_sb);
+  ASSERT_EQ(status, TSI_UNIMPLEMENTED);
+  status = alts_grpc_record_protocol_protect(sender, &var->original_sb,
+                                             &var->protected_sb);
+  ASSERT_EQ(status, TSI_OK);
+  status = alts_grpc_record_protocol_unprotect_frames(
+      receiver, &var->protected_sb, &var->unprotected_sb);
+  ASSERT_EQ(status, TSI_UNIMPLEMENTED);
+  alts_grpc_record_protocol_test_var_destroy(var);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 // --- Test cases. ---
 
 static void alts_grpc_record_protocol_random_seal_unseal_tests(
@@ -440,6 +549,40 @@ static void alts_grpc_record_protocol_input_check_tests(
   input_check(fixture->client_protect);
 }
 
+static void alts_grpc_record_protocol_frames_tests(
+    alts_grpc_record_protocol_test_fixture* (*fixture_create)()) {
+  auto* fixture_1 = fixture_create();
+  random_seal_unseal_frames(fixture_1->client_protect,
+                            fixture_1->server_unprotect);
+  random_seal_unseal_frames(fixture_1->server_protect,
+                            fixture_1->client_unprotect);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_1);
+
+  auto* fixture_2 = fixture_create();
+  empty_seal_unseal_frames(fixture_2->client_protect,
+                           fixture_2->server_unprotect);
+  empty_seal_unseal_frames(fixture_2->server_protect,
+                           fixture_2->client_unprotect);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_2);
+
+  auto* fixture_3 = fixture_create();
+  short_frame_length_unseal_frames(fixture_3->client_protect,
+                                   fixture_3->server_unprotect);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_3);
+
+  auto* fixture_4 = fixture_create();
+  truncated_last_frame_unseal_frames(fixture_4->client_protect,
+                                     fixture_4->server_unprotect);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_4);
+}
+
+static void alts_grpc_record_protocol_frames_unimplemented_tests(
+    alts_grpc_record_protocol_test_fixture* (*fixture_create)()) {
+  auto* fixture = fixture_create();
+  frames_unimplemented(fixture->client_protect, fixture->server_unprotect);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture);
+}
+
 static void alts_grpc_record_protocol_tests(
     alts_grpc_record_protocol_test_fixture* (*fixture_create)()) {
   auto* fixture_1 = fixture_create();
@@ -476,6 +619,24 @@ TEST(AltsGrpcRecordProtocolTest, MainTest) {
   grpc_shutdown();
 }
 
+TEST(AltsGrpcRecordProtocolTest, FramesTest) {
+  grpc_init();
+  alts_grpc_record_protocol_frames_tests(
+      &test_fixture_privacy_integrity_no_rekey_create);
+  alts_grpc_record_protocol_frames_tests(
+      &test_fixture_privacy_integrity_rekey_create);
+  grpc_shutdown();
+}
+
+TEST(AltsGrpcRecordProtocolTest, FramesUnimplementedForIntegrityOnly) {
+  grpc_init();
+  alts_grpc_record_protocol_frames_unimplemented_tests(
+      &test_fixture_integrity_only_no_rekey_no_extra_copy_create);
+  alts_grpc_record_protocol_frames_unimplemented_tests(
+      &test_fixture_integrity_only_extra_copy_create);
+  grpc_shutdown();
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -34,6 +34,8 @@
 
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/transport_security.h"
@@ -106,6 +108,7 @@ typedef struct ssl_tsi_test_fixture {
   bool session_reused;
   const char* session_ticket_key;
   size_t session_ticket_key_size;
+  tsi::SslSessionTicketKeyProvider* session_ticket_key_provider;
   size_t network_bio_buf_size;
   size_t ssl_bio_buf_size;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
@@ -181,6 +184,8 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   }
   server_options.session_ticket_key = ssl_fixture->session_ticket_key;
   server_options.session_ticket_key_size = ssl_fixture->session_ticket_key_size;
+  server_options.session_ticket_key_provider =
+      ssl_fixture->session_ticket_key_provider;
   server_options.min_tls_version = test_tls_version;
   server_options.max_tls_version = test_tls_version;
   ASSERT_EQ(tsi_create_ssl_server_handshaker_factory_with_options(
@@ -579,6 +584,7 @@ static tsi_test_fixture* ssl_tsi_test_fixture_create() {
   ssl_fixture->session_reused = false;
   ssl_fixture->session_ticket_key = nullptr;
   ssl_fixture->session_ticket_key_size = 0;
+  ssl_fixture->session_ticket_key_provider = nullptr;
   ssl_fixture->force_client_auth = false;
   ssl_fixture->network_bio_buf_size = 0;
   ssl_fixture->ssl_bio_buf_size = 0;
@@ -853,6 +859,68 @@ void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache_unref(session_cache);
 }
 
+// A clock that only moves when told to.
+class ManualTimeSource final : public grpc_core::Timestamp::ScopedSource {
+ public:
+  ManualTimeSource() : now_(previous()->Now()) {}
+
+  grpc_core::Timestamp Now() override { return now_; }
+  void InvalidateCache() override {}
+
+  void Advance(grpc_core::Duration duration) { now_ += duration; }
+
+ private:
+  grpc_core::Timestamp now_;
+};
+
+void ssl_tsi_test_do_handshake_session_ticket_key_provider() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_session_ticket_key_provider");
+  const grpc_core::Duration kRotationInterval = grpc_core::Duration::Hours(1);
+  ManualTimeSource time_source;
+  auto provider =
+      grpc_core::MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>(
+          kRotationInterval, /*num_keys=*/2);
+  tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
+  // Each handshake is with a new server factory, as if the client reconnected
+  // to another server sharing the provider.
+  auto do_handshake = [&provider, &session_cache](
+                          bool session_reused, uint64_t tickets_renewed,
+                          uint64_t tickets_rejected) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_fixture->server_name_indication =
+        const_cast<char*>("waterzooi.test.google.be");
+    ssl_fixture->session_ticket_key_provider = provider.get();
+    tsi_ssl_session_cache_ref(session_cache);
+    ssl_fixture->session_cache = session_cache;
+    ssl_fixture->session_reused = session_reused;
+    tsi_test_do_round_trip(&ssl_fixture->base);
+    tsi_ssl_server_session_stats stats;
+    tsi_ssl_server_handshaker_factory_get_session_stats(
+        ssl_fixture->server_handshaker_factory, &stats);
+    EXPECT_EQ(stats.full_handshakes, session_reused ? 0u : 1u);
+    EXPECT_EQ(stats.resumed_handshakes, session_reused ? 1u : 0u);
+    if (!session_reused) {
+      EXPECT_GT(stats.tickets_issued, 0u);
+    }
+    EXPECT_EQ(stats.tickets_renewed, tickets_renewed);
+    EXPECT_EQ(stats.tickets_rejected, tickets_rejected);
+    tsi_test_fixture_destroy(fixture);
+  };
+  do_handshake(false, 0, 0);
+  do_handshake(true, 0, 0);
+  // The previous key is still accepted after a rotation, and the ticket is
+  // renewed under the new one.
+  time_source.Advance(kRotationInterval);
+  do_handshake(true, 1, 0);
+  // Once its key is rotated out, the ticket is rejected.
+  time_source.Advance(kRotationInterval * 2);
+  do_handshake(false, 0, 1);
+  do_handshake(true, 0, 0);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
 void ssl_tsi_test_do_handshake_with_intermediate_ca() {
   gpr_log(
       GPR_INFO,
@@ -1191,6 +1259,7 @@ TEST(SslTransportSecurityTest, MainTest) {
     ssl_tsi_test_do_handshake_alpn_server_no_client();
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
     ssl_tsi_test_do_handshake_session_cache();
+    ssl_tsi_test_do_handshake_session_ticket_key_provider();
     ssl_tsi_test_do_round_trip_for_all_configs();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
@@ -16,6 +16,7 @@
 
 #include "src/core/ext/xds/xds_http_filters.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -29,6 +30,7 @@
 #include <google/protobuf/wrappers.pb.h>
 
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/strip.h"
 #include "absl/types/variant.h"
@@ -37,6 +39,7 @@
 #include "upb/upb.hpp"
 
 #include <grpc/grpc.h>
+#include <grpc/slice.h>
 #include <grpc/status.h>
 #include <grpc/support/json.h>
 #include <grpc/support/log.h>
@@ -50,11 +53,13 @@
 #include "src/core/ext/filters/stateful_session/stateful_session_service_config_parser.h"
 #include "src/core/ext/xds/xds_bootstrap_grpc.h"
 #include "src/core/ext/xds/xds_client.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/gprpp/env.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/json/json_writer.h"
+#include "src/core/lib/service_config/service_config_impl.h"
 #include "src/proto/grpc/testing/xds/v3/address.pb.h"
 #include "src/proto/grpc/testing/xds/v3/cookie.pb.h"
 #include "src/proto/grpc/testing/xds/v3/extension.pb.h"
@@ -146,6 +151,29 @@ class XdsHttpFilterTest : public ::testing::Test {
         absl::StripPrefix(type, "type.googleapis.com/"));
   }
 
+  // Builds a method config with the given list of per-instance filter
+  // configs, the way the xDS resolver does, and returns what the filter's
+  // noop check says about each of num_instances instances for it.
+  static std::vector<bool> NoopChecks(const XdsHttpFilterImpl* filter,
+                                      absl::string_view field_name,
+                                      absl::string_view elements,
+                                      size_t num_instances) {
+    XdsHttpFilterImpl::NoopCheck check = filter->channel_filter_noop_check();
+    GPR_ASSERT(check != nullptr);
+    auto service_config = ServiceConfigImpl::Create(
+        filter->ModifyChannelArgs(ChannelArgs()),
+        absl::StrCat("{\"methodConfig\": [{\"name\": [{}], \"", field_name,
+                     "\": [", elements, "]}]}"));
+    GPR_ASSERT(service_config.ok());
+    const auto* method_configs =
+        (*service_config)->GetMethodParsedConfigVector(grpc_empty_slice());
+    std::vector<bool> noop;
+    for (size_t i = 0; i < num_instances; ++i) {
+      noop.push_back(check(method_configs, i));
+    }
+    return noop;
+  }
+
   GrpcXdsBootstrap::GrpcXdsServer xds_server_;
   RefCountedPtr<XdsClient> xds_client_;
   upb::DefPool upb_def_pool_;
@@ -325,6 +353,35 @@ TEST_F(XdsFaultInjectionFilterTest, GenerateServiceConfigOverrideConfig) {
   EXPECT_EQ(service_config->element, "{\"baz\":\"quux\"}");
 }
 
+TEST_F(XdsFaultInjectionFilterTest, NoopCheck) {
+  EXPECT_EQ(filter_->channel_filter_noop_check(),
+            &FaultInjectionFilter::IsNoopForMethod);
+  // Without a method config, the filter may be configured some other way.
+  EXPECT_FALSE(FaultInjectionFilter::IsNoopForMethod(nullptr, 0));
+  // Only instances with a policy that can inject no fault are no-ops.
+  EXPECT_EQ(NoopChecks(filter_, "faultInjectionPolicy",
+                       "{}, "
+                       "{\"abortCode\": \"UNAVAILABLE\"}, "
+                       "{\"delay\": \"1s\"}, "
+                       "{\"abortPercentageNumerator\": 100}, "
+                       "{\"abortCode\": \"UNAVAILABLE\", "
+                       "\"abortPercentageNumerator\": 100}, "
+                       "{\"delay\": \"1s\", \"delayPercentageNumerator\": 1}",
+                       7),
+            std::vector<bool>({true, true, true, true, false, false, false}));
+}
+
+TEST_F(XdsFaultInjectionFilterTest, NoopCheckWithHeaders) {
+  // Headers can turn on faults for any call.
+  EXPECT_EQ(NoopChecks(filter_, "faultInjectionPolicy",
+                       "{\"abortCodeHeader\": \"abort-code\"}, "
+                       "{\"abortPercentageHeader\": \"abort-percentage\"}, "
+                       "{\"delayHeader\": \"delay\"}, "
+                       "{\"delayPercentageHeader\": \"delay-percentage\"}",
+                       4),
+            std::vector<bool>({false, false, false, false}));
+}
+
 // For the fault injection filter, GenerateFilterConfig() and
 // GenerateFilterConfigOverride() accept the same input, so we want to
 // run all tests for both.
@@ -1152,6 +1209,17 @@ TEST_F(XdsStatefulSessionFilterTest, ModifyChannelArgs) {
   EXPECT_EQ(*value, 1);
 }
 
+TEST_F(XdsStatefulSessionFilterTest, NoopCheck) {
+  EXPECT_EQ(filter_->channel_filter_noop_check(),
+            &StatefulSessionFilter::IsNoopForMethod);
+  EXPECT_FALSE(StatefulSessionFilter::IsNoopForMethod(nullptr, 0));
+  // Instances without a cookie name, e.g. disabled for the route, are
+  // no-ops. The one past the configured instances is not.
+  EXPECT_EQ(NoopChecks(filter_, "stateful_session",
+                       "{}, {\"name\": \"foo\"}", 3),
+            std::vector<bool>({true, false, false}));
+}
+
 TEST_F(XdsStatefulSessionFilterTest, OverrideConfigDisabled) {
   StatefulSessionPerRoute stateful_session_per_route;
   stateful_session_per_route.set_disabled(true);
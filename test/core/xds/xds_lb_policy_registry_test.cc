@@ -48,10 +48,12 @@
 #include "src/proto/grpc/testing/xds/v3/client_side_weighted_round_robin.pb.h"
 #include "src/proto/grpc/testing/xds/v3/cluster.pb.h"
 #include "src/proto/grpc/testing/xds/v3/extension.pb.h"
+#include "src/proto/grpc/testing/xds/v3/least_request.pb.h"
 #include "src/proto/grpc/testing/xds/v3/ring_hash.pb.h"
 #include "src/proto/grpc/testing/xds/v3/round_robin.pb.h"
 #include "src/proto/grpc/testing/xds/v3/typed_struct.pb.h"
 #include "src/proto/grpc/testing/xds/v3/wrr_locality.pb.h"
+#include "test/core/util/scoped_env_var.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_core {
@@ -62,6 +64,8 @@ using LoadBalancingPolicyProto =
     ::envoy::config::cluster::v3::LoadBalancingPolicy;
 using ::envoy::extensions::load_balancing_policies::
     client_side_weighted_round_robin::v3::ClientSideWeightedRoundRobin;
+using ::envoy::extensions::load_balancing_policies::least_request::v3::
+    LeastRequest;
 using ::envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash;
 using ::envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin;
 using ::envoy::extensions::load_balancing_policies::wrr_locality::v3::
@@ -125,6 +129,65 @@ TEST(RoundRobin, Basic) {
   EXPECT_EQ(*result, "{\"round_robin\":{}}");
 }
 
+//
+// LeastRequest
+//
+
+TEST(LeastRequest, DefaultConfig) {
+  ScopedEnvVar env_var("GRPC_EXPERIMENTAL_ENABLE_LEAST_REQUEST", "true");
+  LoadBalancingPolicyProto policy;
+  auto* lb_policy = policy.add_policies();
+  lb_policy->mutable_typed_extension_config()->mutable_typed_config()->PackFrom(
+      LeastRequest());
+  auto result = ConvertXdsPolicy(policy);
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(*result, "{\"least_request\":{\"choiceCount\":2}}");
+}
+
+TEST(LeastRequest, ChoiceCount) {
+  ScopedEnvVar env_var("GRPC_EXPERIMENTAL_ENABLE_LEAST_REQUEST", "true");
+  LeastRequest least_request;
+  least_request.mutable_choice_count()->set_value(5);
+  LoadBalancingPolicyProto policy;
+  auto* lb_policy = policy.add_policies();
+  lb_policy->mutable_typed_extension_config()->mutable_typed_config()->PackFrom(
+      least_request);
+  auto result = ConvertXdsPolicy(policy);
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(*result, "{\"least_request\":{\"choiceCount\":5}}");
+}
+
+TEST(LeastRequest, ChoiceCountTooLow) {
+  ScopedEnvVar env_var("GRPC_EXPERIMENTAL_ENABLE_LEAST_REQUEST", "true");
+  LeastRequest least_request;
+  least_request.mutable_choice_count()->set_value(1);
+  LoadBalancingPolicyProto policy;
+  auto* lb_policy = policy.add_policies();
+  lb_policy->mutable_typed_extension_config()->mutable_typed_config()->PackFrom(
+      least_request);
+  auto result = ConvertXdsPolicy(policy);
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(result.status().message(),
+            "validation errors: [field:load_balancing_policy.policies[0]"
+            ".typed_extension_config.typed_config.value[envoy.extensions"
+            ".load_balancing_policies.least_request.v3.LeastRequest]"
+            ".choice_count error:must be at least 2]")
+      << result.status();
+}
+
+TEST(LeastRequest, NotEnabled) {
+  LoadBalancingPolicyProto policy;
+  auto* lb_policy = policy.add_policies();
+  lb_policy->mutable_typed_extension_config()->mutable_typed_config()->PackFrom(
+      LeastRequest());
+  auto result = ConvertXdsPolicy(policy);
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(result.status().message(),
+            "validation errors: [field:load_balancing_policy "
+            "error:no supported load balancing policy config found]")
+      << result.status();
+}
+
 //
 // ClientSideWeightedRoundRobin
 //
@@ -203,6 +203,22 @@ TEST_P(NullAllocatorTest, SimpleRpc) {
   SendRpcs(1);
 }
 
+TEST_P(NullAllocatorTest, MessagesAllocatedOnArena) {
+  std::atomic_int arena_rpcs{0};
+  callback_service_.SetAllocatorMutator(
+      [&arena_rpcs](RpcAllocatorState* /*allocator_state*/,
+                    const EchoRequest* req, EchoResponse* resp) {
+        if (req->GetArena() != nullptr && resp->GetArena() == req->GetArena()) {
+          arena_rpcs++;
+        }
+      });
+  const int kRpcCount = 10;
+  CreateServer(nullptr);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, arena_rpcs.load());
+}
+
 class SimpleAllocatorTest : public MessageAllocatorEnd2endTestBase {
  public:
   class SimpleAllocator : public MessageAllocator<EchoRequest, EchoResponse> {
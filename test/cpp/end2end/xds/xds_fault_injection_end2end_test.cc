@@ -19,6 +19,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/lib/config/config_vars.h"
 #include "src/proto/grpc/testing/xds/v3/cluster.grpc.pb.h"
@@ -90,6 +92,49 @@ class FaultInjectionTest : public XdsEnd2endTest {
       }
     };
   }
+
+  // Like SetFilterConfig(), but with one fault injection filter for each of
+  // http_faults.
+  void SetFilterConfigs(const std::vector<HTTPFault>& http_faults) {
+    const bool config_in_route =
+        GetParam().filter_config_setup() ==
+        XdsTestType::HttpFilterConfigLocation::kHttpFilterConfigInRoute;
+    HttpConnectionManager http_connection_manager;
+    RouteConfiguration route = default_route_config_;
+    auto* config_map = route.mutable_virtual_hosts(0)
+                           ->mutable_routes(0)
+                           ->mutable_typed_per_filter_config();
+    for (size_t i = 0; i < http_faults.size(); ++i) {
+      std::string name = absl::StrCat("envoy.fault", i);
+      HttpFilter* fault_filter = http_connection_manager.add_http_filters();
+      fault_filter->set_name(name);
+      if (config_in_route) {
+        fault_filter->mutable_typed_config()->PackFrom(HTTPFault());
+        (*config_map)[name].PackFrom(http_faults[i]);
+      } else {
+        fault_filter->mutable_typed_config()->PackFrom(http_faults[i]);
+      }
+    }
+    HttpFilter* router_filter = http_connection_manager.add_http_filters();
+    router_filter->set_name("router");
+    router_filter->mutable_typed_config()->PackFrom(
+        envoy::extensions::filters::http::router::v3::Router());
+    Listener listener;
+    listener.set_name(kServerName);
+    listener.mutable_api_listener()->mutable_api_listener()->PackFrom(
+        http_connection_manager);
+    SetListenerAndRouteConfiguration(balancer_.get(), listener, route);
+  }
+
+  static HTTPFault AlwaysAbort() {
+    HTTPFault http_fault;
+    auto* abort_percentage = http_fault.mutable_abort()->mutable_percentage();
+    abort_percentage->set_numerator(100);
+    abort_percentage->set_denominator(FractionalPercent::HUNDRED);
+    http_fault.mutable_abort()->set_grpc_status(
+        static_cast<uint32_t>(StatusCode::ABORTED));
+    return http_fault;
+  }
 };
 
 // Run with all combinations of RDS disabled/enabled and the HTTP filter
@@ -529,6 +574,32 @@ TEST_P(FaultInjectionTest, XdsFaultInjectionBidiStreamDelayOk) {
                            << context.debug_error_string();
 }
 
+// The channel leaves fault injection filters that inject no faults out of
+// the calls. The filters that remain must still find their own configs.
+TEST_P(FaultInjectionTest, XdsFaultInjectionFirstOfTwoFiltersAborts) {
+  SetFilterConfigs({AlwaysAbort(), HTTPFault()});
+  for (size_t i = 0; i < 5; ++i) {
+    CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::ABORTED, "Fault injected",
+                        RpcOptions().set_wait_for_ready(true));
+  }
+}
+
+TEST_P(FaultInjectionTest, XdsFaultInjectionSecondOfTwoFiltersAborts) {
+  SetFilterConfigs({HTTPFault(), AlwaysAbort()});
+  for (size_t i = 0; i < 5; ++i) {
+    CheckRpcSendFailure(DEBUG_LOCATION, StatusCode::ABORTED, "Fault injected",
+                        RpcOptions().set_wait_for_ready(true));
+  }
+}
+
+TEST_P(FaultInjectionTest, XdsFaultInjectionNoFilterAborts) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  SetFilterConfigs({HTTPFault(), HTTPFault()});
+  CheckRpcSendOk(DEBUG_LOCATION, 5, RpcOptions().set_wait_for_ready(true));
+}
+
 // This case catches a bug in the retry code that was triggered by a bad
 // interaction with the FI code.  See https://github.com/grpc/grpc/pull/27217
 // for description.
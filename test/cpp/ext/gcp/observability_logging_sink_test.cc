@@ -16,12 +16,28 @@
 
 #include "src/cpp/ext/gcp/observability_logging_sink.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "gmock/gmock.h"
 #include "google/protobuf/text_format.h"
 #include "gtest/gtest.h"
 
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json_reader.h"
 #include "test/core/util/test_config.h"
 
@@ -1069,6 +1085,136 @@ TEST(EntryToJsonStructTest, Cancel) {
   EXPECT_EQ(output, pb_str);
 }
 
+// Stands in for Cloud Logging, counting the entries it is sent.
+class FakeLoggingService final
+    : public google::logging::v2::LoggingServiceV2::Service {
+ public:
+  // Holds every write until Unblock() is called.
+  void Block() { gate_ = std::make_unique<absl::Notification>(); }
+  void Unblock() { gate_->Notify(); }
+  void WaitForWrite() { first_write_.WaitForNotification(); }
+
+  uint64_t entries() {
+    grpc_core::MutexLock lock(&mu_);
+    return entries_;
+  }
+
+  Status WriteLogEntries(
+      ServerContext* /*context*/,
+      const google::logging::v2::WriteLogEntriesRequest* request,
+      google::logging::v2::WriteLogEntriesResponse* /*response*/) override {
+    {
+      grpc_core::MutexLock lock(&mu_);
+      entries_ += request->entries_size();
+    }
+    if (!first_write_.HasBeenNotified()) first_write_.Notify();
+    if (gate_ != nullptr) gate_->WaitForNotification();
+    return Status::OK;
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  uint64_t entries_ ABSL_GUARDED_BY(mu_) = 0;
+  absl::Notification first_write_;
+  std::unique_ptr<absl::Notification> gate_;
+};
+
+class ObservabilityLoggingSinkFlushTest : public ::testing::Test {
+ protected:
+  ObservabilityLoggingSinkFlushTest()
+      : sink_(GcpObservabilityConfig::CloudLogging(), "test", {}) {
+    int port = 0;
+    ServerBuilder builder;
+    builder.AddListeningPort("localhost:0", InsecureServerCredentials(),
+                             &port);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    sink_.SetStubForTesting(
+        google::logging::v2::LoggingServiceV2::NewStub(grpc::CreateChannel(
+            absl::StrCat("localhost:", port), InsecureChannelCredentials())),
+        &resource_);
+  }
+
+  ~ObservabilityLoggingSinkFlushTest() override { server_->Shutdown(); }
+
+  static LoggingSink::Entry MakeEntry(size_t message_size = 0) {
+    LoggingSink::Entry entry;
+    entry.type = LoggingSink::Entry::EventType::kClientMessage;
+    entry.logger = LoggingSink::Entry::Logger::kClient;
+    entry.service_name = "service_name";
+    entry.method_name = "method_name";
+    entry.payload.message = std::string(message_size, 'a');
+    return entry;
+  }
+
+  const EnvironmentAutoDetect::ResourceType resource_{"global", {}};
+  FakeLoggingService service_;
+  std::unique_ptr<Server> server_;
+  ObservabilityLoggingSink sink_;
+};
+
+TEST_F(ObservabilityLoggingSinkFlushTest, ConcurrentLogEntry) {
+  constexpr int kNumThreads = 8;
+  constexpr int kEntriesPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([this]() {
+      for (int j = 0; j < kEntriesPerThread; ++j) sink_.LogEntry(MakeEntry());
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  sink_.FlushAndClose();
+  EXPECT_EQ(sink_.pending_entries_for_testing(), 0);
+  EXPECT_EQ(sink_.dropped_entries_for_testing(), 0);
+  EXPECT_EQ(service_.entries(), kNumThreads * kEntriesPerThread);
+}
+
+TEST_F(ObservabilityLoggingSinkFlushTest, DropsEntriesOnceBufferIsFull) {
+  // Enough to start a flush right away, which the service then holds on to
+  // so that nothing else can be flushed.
+  constexpr uint64_t kFirstBatch = 1000;
+  // Well over the 10MB the sink buffers.
+  constexpr uint64_t kEntries = 20000;
+  constexpr size_t kMessageSize = 1024;
+  service_.Block();
+  for (uint64_t i = 0; i < kFirstBatch; ++i) sink_.LogEntry(MakeEntry());
+  service_.WaitForWrite();
+  for (uint64_t i = 0; i < kEntries; ++i) {
+    sink_.LogEntry(MakeEntry(kMessageSize));
+  }
+  const uint64_t dropped = sink_.dropped_entries_for_testing();
+  EXPECT_GT(dropped, 0);
+  EXPECT_EQ(sink_.pending_entries_for_testing() + dropped, kEntries);
+  service_.Unblock();
+  sink_.FlushAndClose();
+  EXPECT_EQ(service_.entries(), kFirstBatch + kEntries - dropped);
+}
+
+TEST_F(ObservabilityLoggingSinkFlushTest, CloseWhileLogging) {
+  constexpr int kNumThreads = 8;
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([this, &done]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        sink_.LogEntry(MakeEntry());
+      }
+    });
+  }
+  absl::SleepFor(absl::Milliseconds(100));
+  sink_.FlushAndClose();
+  // Everything logged before the sink was closed has been written, and
+  // nothing is buffered after it.
+  const uint64_t written = service_.entries();
+  EXPECT_GT(written, 0);
+  EXPECT_EQ(sink_.pending_entries_for_testing(), 0);
+  absl::SleepFor(absl::Milliseconds(100));
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(sink_.pending_entries_for_testing(), 0);
+  EXPECT_EQ(service_.entries(), written);
+}
+
 }  // namespace
 
 }  // namespace internal
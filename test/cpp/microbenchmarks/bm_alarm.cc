@@ -16,15 +16,20 @@
 //
 //
 
-// This benchmark exists to ensure that immediately-firing alarms are fast
+// This benchmark exists to ensure that immediately-firing alarms are fast,
+// and that arming and cancelling timers stays cheap under churn.
+
+#include <memory>
 
 #include <benchmark/benchmark.h>
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/grpc.h>
 #include <grpcpp/alarm.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/impl/grpc_library.h>
 
+#include "src/core/lib/event_engine/default_event_engine.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -45,6 +50,25 @@ static void BM_Alarm_Tag_Immediate(benchmark::State& state) {
 }
 BENCHMARK(BM_Alarm_Tag_Immediate);
 
+// Arms a timer that is far enough out never to fire and cancels it again, as
+// deadline and keepalive timers do on the happy path.
+static void BM_EventEngine_RunAfterCancel(benchmark::State& state) {
+  std::shared_ptr<grpc_event_engine::experimental::EventEngine> engine =
+      grpc_event_engine::experimental::GetDefaultEventEngine();
+  const auto delay = std::chrono::seconds(state.range(0));
+  for (auto _ : state) {
+    auto handle = engine->RunAfter(delay, [] {});
+    GPR_ASSERT(engine->Cancel(handle));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Args: timer delay in seconds; longer delays land in outer wheel levels.
+BENCHMARK(BM_EventEngine_RunAfterCancel)
+    ->Arg(1)
+    ->Arg(3600)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,141 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Microbenchmarks around the CHTTP2 stream map
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+void* ValueFor(uint32_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Client initiated stream ids: 1, 3, 5, ...
+uint32_t StreamId(int64_t n) { return static_cast<uint32_t>(2 * n + 1); }
+
+// Lookup of live streams, as done for every incoming frame header.
+void BM_StreamMapFind(benchmark::State& state) {
+  const int64_t live = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (int64_t i = 0; i < live; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), ValueFor(StreamId(i)));
+  }
+  int64_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(&map, StreamId(i)));
+    // stride through the map so we don't keep hitting the same cache line
+    i += 7919;
+    if (i >= live) i -= live;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapFind)->Arg(100)->Arg(10000)->Arg(100000);
+
+// Steady state stream churn: open a new stream and close the oldest one.
+void BM_StreamMapChurn(benchmark::State& state) {
+  const int64_t live = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  int64_t next = 0;
+  for (; next < live; next++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), ValueFor(StreamId(next)));
+  }
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), ValueFor(StreamId(next)));
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_delete(&map, StreamId(next - live)));
+    next++;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapChurn)->Arg(100)->Arg(10000)->Arg(100000);
+
+// As above, but with a handful of long lived streams (e.g. watches) pinning
+// the oldest ids open, and lookups interleaved as they would be while parsing.
+void BM_StreamMapChurnWithLongLivedStreams(benchmark::State& state) {
+  const int64_t live = state.range(0);
+  const int64_t long_lived = 4;
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  int64_t next = 0;
+  for (; next < live + long_lived; next++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), ValueFor(StreamId(next)));
+  }
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), ValueFor(StreamId(next)));
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, StreamId(next % long_lived)));
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_delete(&map, StreamId(next - live)));
+    next++;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapChurnWithLongLivedStreams)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Arg(100000);
+
+// Random stream selection, as done by the destructive memory reclaimer.
+void BM_StreamMapRand(benchmark::State& state) {
+  const int64_t live = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (int64_t i = 0; i < 2 * live; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), ValueFor(StreamId(i)));
+    // leave every other stream open so that the map has holes
+    if (i % 2 == 1) grpc_chttp2_stream_map_delete(&map, StreamId(i));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_rand(&map));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapRand)->Arg(100)->Arg(10000)->Arg(100000);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,154 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+// Benchmark unary latency while a bulk server-streaming call shares the same
+// HTTP/2 connection, with and without stream weights.
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Size of each message on the bulk stream.
+constexpr size_t kBulkMessageSize = 1024 * 1024;
+
+class BulkAndEchoService final : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  // Streams large messages until the client goes away.
+  Status ResponseStream(ServerContext* context, const EchoRequest* /*request*/,
+                        ServerWriter<EchoResponse>* writer) override {
+    EchoResponse response;
+    response.set_message(std::string(kBulkMessageSize, 'a'));
+    while (!context->IsCancelled() && writer->Write(response)) {
+    }
+    return Status::OK;
+  }
+};
+
+// Gives the unary and bulk methods the stream weights under test.
+class WeightedConfiguration : public FixtureConfiguration {
+ public:
+  WeightedConfiguration(int echo_weight, int bulk_weight)
+      : echo_weight_(echo_weight), bulk_weight_(bulk_weight) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetServiceConfigJSON(absl::StrCat(
+        "{\"methodConfig\": [{\"name\": [{\"service\": "
+        "\"grpc.testing.EchoTestService\", \"method\": \"Echo\"}], "
+        "\"streamWeight\": ",
+        echo_weight_,
+        "}, {\"name\": [{\"service\": \"grpc.testing.EchoTestService\", "
+        "\"method\": \"ResponseStream\"}], \"streamWeight\": ",
+        bulk_weight_, "}]}"));
+  }
+
+ private:
+  const int echo_weight_;
+  const int bulk_weight_;
+};
+
+static void BM_UnaryLatencyUnderBulkStream(benchmark::State& state) {
+  BulkAndEchoService service;
+  std::unique_ptr<TCP> fixture(new TCP(
+      &service, WeightedConfiguration(state.range(0), state.range(1))));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  // Keep a bulk download running for the duration of the benchmark.
+  ClientContext bulk_ctx;
+  std::atomic<int64_t> bulk_bytes{0};
+  std::thread bulk_reader([&stub, &bulk_ctx, &bulk_bytes] {
+    EchoRequest request;
+    EchoResponse response;
+    auto reader = stub->ResponseStream(&bulk_ctx, request);
+    while (reader->Read(&response)) {
+      bulk_bytes.fetch_add(response.message().size(),
+                           std::memory_order_relaxed);
+    }
+    reader->Finish().IgnoreError();
+  });
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("hello");
+  std::vector<double> latencies_us;
+  for (auto _ : state) {
+    ClientContext ctx;
+    const absl::Time start = absl::Now();
+    GPR_ASSERT(stub->Echo(&ctx, request, &response).ok());
+    latencies_us.push_back(absl::ToDoubleMicroseconds(absl::Now() - start));
+  }
+  bulk_ctx.TryCancel();
+  bulk_reader.join();
+  fixture.reset();
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [&latencies_us](double p) {
+    if (latencies_us.empty()) return 0.0;
+    return latencies_us[std::min(
+        latencies_us.size() - 1,
+        static_cast<size_t>(p * static_cast<double>(latencies_us.size())))];
+  };
+  state.counters["p50_us"] = percentile(0.5);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["bulk_bytes"] = benchmark::Counter(
+      static_cast<double>(bulk_bytes.load()), benchmark::Counter::kIsRate);
+}
+// Args: {unary weight, bulk weight}
+BENCHMARK(BM_UnaryLatencyUnderBulkStream)
+    ->Args({16, 16})
+    ->Args({256, 16})
+    ->Args({256, 1})
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
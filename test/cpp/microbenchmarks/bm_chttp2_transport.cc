@@ -20,9 +20,12 @@
 
 #include <string.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -32,6 +35,7 @@
 #include <grpcpp/support/channel_arguments.h>
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/gprpp/crash.h"
 #include "src/core/lib/iomgr/closure.h"
@@ -74,7 +78,10 @@ class PhonyEndpoint : public grpc_endpoint {
     read_cb_ = nullptr;
   }
 
+  size_t writes() const { return writes_.load(std::memory_order_relaxed); }
+
  private:
+  std::atomic<size_t> writes_{0};
   grpc_closure* read_cb_ = nullptr;
   grpc_slice_buffer* slices_ = nullptr;
   bool have_slice_ = false;
@@ -98,8 +105,10 @@ class PhonyEndpoint : public grpc_endpoint {
     static_cast<PhonyEndpoint*>(ep)->QueueRead(slices, cb);
   }
 
-  static void write(grpc_endpoint* /*ep*/, grpc_slice_buffer* /*slices*/,
+  static void write(grpc_endpoint* ep, grpc_slice_buffer* /*slices*/,
                     grpc_closure* cb, void* /*arg*/, int /*max_frame_size*/) {
+    static_cast<PhonyEndpoint*>(ep)->writes_.fetch_add(
+        1, std::memory_order_relaxed);
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb, absl::OkStatus());
   }
 
@@ -153,6 +162,9 @@ class Fixture {
 
   void PushInput(grpc_slice slice) { ep_->PushInput(slice); }
 
+  // Number of writes made to the endpoint so far.
+  size_t endpoint_writes() const { return ep_->writes(); }
+
  private:
   PhonyEndpoint* ep_;
   grpc_transport* t_;
@@ -409,6 +421,121 @@ static void BM_TransportEmptyOp(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportEmptyOp);
 
+static std::string FrameHeader(uint32_t length, uint8_t type, uint8_t flags,
+                               uint32_t stream_id) {
+  const char header[9] = {static_cast<char>(length >> 16),
+                          static_cast<char>(length >> 8),
+                          static_cast<char>(length),
+                          static_cast<char>(type),
+                          static_cast<char>(flags),
+                          static_cast<char>(stream_id >> 24),
+                          static_cast<char>(stream_id >> 16),
+                          static_cast<char>(stream_id >> 8),
+                          static_cast<char>(stream_id)};
+  return std::string(header, sizeof(header));
+}
+
+static std::string BigEndian32(uint32_t value) {
+  const char bytes[4] = {
+      static_cast<char>(value >> 24), static_cast<char>(value >> 16),
+      static_cast<char>(value >> 8), static_cast<char>(value)};
+  return std::string(bytes, sizeof(bytes));
+}
+
+static grpc_slice ConnectionWindowUpdate(uint32_t increment) {
+  return grpc_slice_from_cpp_string(
+      FrameHeader(4, GRPC_CHTTP2_FRAME_WINDOW_UPDATE, 0, 0) +
+      BigEndian32(increment));
+}
+
+// Sends a small message on each of 1000 streams, one at a time, and counts the
+// writes (each one a write syscall on a real endpoint) the transport makes.
+// state.range(0) is GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES.
+static void BM_TransportWritesManyStreams(benchmark::State& state) {
+  constexpr size_t kNumStreams = 1000;
+  constexpr size_t kMessageSize = 100;
+  constexpr uint32_t kWindow = 1u << 30;
+  grpc_core::ExecCtx exec_ctx;
+  grpc::ChannelArguments args;
+  args.SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_MIN_BYTES,
+              static_cast<int>(state.range(0)));
+  Fixture f(args, true);
+  // Let the peer grant enough flow control window to never block.
+  f.PushInput(grpc_slice_from_cpp_string(
+      FrameHeader(6, GRPC_CHTTP2_FRAME_SETTINGS, 0, 0) +
+      std::string("\x00\x04", 2) + BigEndian32(kWindow) +
+      FrameHeader(0, GRPC_CHTTP2_FRAME_SETTINGS, GRPC_CHTTP2_FLAG_ACK, 0)));
+  f.FlushExecCtx();
+  f.PushInput(ConnectionWindowUpdate(kWindow));
+  f.FlushExecCtx();
+
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(1024, &memory_allocator);
+  // Every batch owns its op and payload, and deletes itself once done.
+  struct Batch {
+    Batch() {
+      op.payload = &payload;
+      op.on_complete = MakeOnceClosure(
+          [this](grpc_error_handle /*error*/) { delete this; });
+    }
+    grpc_transport_stream_op_batch op;
+    grpc_transport_stream_op_batch_payload payload{nullptr};
+    grpc_core::SliceBuffer message;
+  };
+  std::vector<std::unique_ptr<grpc_metadata_batch>> initial_metadata;
+  std::vector<std::unique_ptr<Stream>> streams;
+  for (size_t i = 0; i < kNumStreams; ++i) {
+    streams.push_back(std::make_unique<Stream>(&f));
+    streams.back()->Init(state);
+    initial_metadata.push_back(
+        std::make_unique<grpc_metadata_batch>(arena.get()));
+    RepresentativeClientInitialMetadata::Prepare(initial_metadata.back().get());
+    auto* batch = new Batch;
+    batch->op.send_initial_metadata = true;
+    batch->payload.send_initial_metadata.send_initial_metadata =
+        initial_metadata.back().get();
+    streams.back()->Op(&batch->op);
+    f.FlushExecCtx();
+  }
+
+  const size_t writes_before = f.endpoint_writes();
+  const std::string payload(kMessageSize, 'a');
+  size_t unacked_bytes = 0;
+  for (auto _ : state) {
+    for (auto& stream : streams) {
+      auto* batch = new Batch;
+      batch->message.Append(grpc_core::Slice::FromCopiedString(payload));
+      batch->op.send_message = true;
+      batch->payload.send_message.send_message = &batch->message;
+      stream->Op(&batch->op);
+      f.FlushExecCtx();
+    }
+    unacked_bytes += kNumStreams * (kMessageSize + GRPC_HEADER_SIZE_IN_BYTES);
+    if (unacked_bytes > kWindow / 2) {
+      f.PushInput(ConnectionWindowUpdate(unacked_bytes));
+      f.FlushExecCtx();
+      unacked_bytes = 0;
+    }
+  }
+  state.counters["writes_per_message"] = benchmark::Counter(
+      static_cast<double>(f.endpoint_writes() - writes_before) /
+      static_cast<double>(state.iterations() * kNumStreams));
+
+  for (auto& stream : streams) {
+    auto* batch = new Batch;
+    batch->op.cancel_stream = true;
+    batch->payload.cancel_stream.cancel_error = absl::CancelledError();
+    stream->Op(&batch->op);
+    stream->DestroyThen(MakeOnceClosure([](grpc_error_handle /*error*/) {}));
+  }
+  f.FlushExecCtx();
+  streams.clear();
+}
+BENCHMARK(BM_TransportWritesManyStreams)->Arg(0)->Arg(16384)->Arg(65536);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
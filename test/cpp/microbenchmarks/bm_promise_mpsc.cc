@@ -0,0 +1,142 @@
+// Copyright 2023 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "absl/types/optional.h"
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/promise/activity.h"
+#include "src/core/lib/promise/mpsc.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+using ::grpc_core::Activity;
+using ::grpc_core::MpscReceiver;
+using ::grpc_core::MpscSender;
+using ::grpc_core::Waker;
+using ::grpc_core::WakeupMask;
+
+// An activity that is never scheduled: everything polled under it simply
+// spins (yielding) until it's ready, so the benchmark measures the pipe
+// itself rather than an activity scheduler. Wakeups are counted so that
+// their batching shows up in the results.
+class SpinActivity final : public Activity, public grpc_core::Wakeable {
+ public:
+  void ForceImmediateRepoll(WakeupMask) override {}
+  void Orphan() override {}
+  Waker MakeOwningWaker() override { return Waker(this, 0); }
+  Waker MakeNonOwningWaker() override { return Waker(this, 0); }
+  void Wakeup(WakeupMask) override {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void WakeupAsync(WakeupMask) override {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void Drop(WakeupMask) override {}
+  std::string DebugTag() const override { return "SpinActivity"; }
+  std::string ActivityDebugTag(WakeupMask) const override { return DebugTag(); }
+
+  // Run f with this as the current activity.
+  template <typename F>
+  void Run(F f) {
+    ScopedActivity scoped_activity(this);
+    f();
+  }
+
+  int64_t wakeups() const { return wakeups_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> wakeups_{0};
+};
+
+MpscReceiver<int>* g_receiver;
+std::thread* g_drainer;
+std::atomic<bool> g_done;
+int64_t g_receiver_wakeups;
+
+// Each benchmark thread is one sending party; a single extra thread drains
+// the pipe for as long as the benchmark runs.
+void BM_MpscSend(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    g_receiver = new MpscReceiver<int>(state.range(0));
+    g_done.store(false, std::memory_order_relaxed);
+    g_drainer = new std::thread([]() {
+      SpinActivity activity;
+      activity.Run([]() {
+        while (!g_done.load(std::memory_order_relaxed)) {
+          auto next = g_receiver->Next();
+          while (!g_done.load(std::memory_order_relaxed) &&
+                 next().pending()) {
+            std::this_thread::yield();
+          }
+        }
+      });
+      g_receiver_wakeups = activity.wakeups();
+    });
+  }
+  SpinActivity activity;
+  absl::optional<MpscSender<int>> sender;
+  activity.Run([&]() {
+    for (auto _ : state) {
+      // The receiver is only guaranteed to exist once all threads have
+      // started.
+      if (!sender.has_value()) sender.emplace(g_receiver->MakeSender());
+      auto send = sender->Send(1);
+      while (send().pending()) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  if (state.thread_index() == 0) {
+    g_done.store(true, std::memory_order_relaxed);
+    g_drainer->join();
+    delete g_drainer;
+    sender.reset();
+    delete g_receiver;
+    const double sent = static_cast<double>(state.iterations()) *
+                        static_cast<double>(state.threads());
+    state.counters["Send Rate"] =
+        benchmark::Counter(sent, benchmark::Counter::kIsRate);
+    state.counters["Receiver Wakeups"] =
+        static_cast<double>(g_receiver_wakeups);
+  }
+}
+BENCHMARK(BM_MpscSend)
+    ->RangeMultiplier(8)
+    ->Range(2, 128)
+    ->ThreadRange(1, 32)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -166,7 +166,7 @@ class Client {
   virtual ~Client() {}
 
   ClientStats Mark(bool reset) {
-    Histogram latencies;
+    Histogram latencies(histogram_params_);
     StatusHistogram statuses;
     UsageTimer::Result timer_result;
 
@@ -175,7 +175,11 @@ class Client {
     int cur_poll_count = GetPollCount();
     int poll_count = cur_poll_count - last_reset_poll_count_;
     if (reset) {
-      std::vector<Histogram> to_merge(threads_.size());
+      std::vector<Histogram> to_merge;
+      to_merge.reserve(threads_.size());
+      for (size_t i = 0; i < threads_.size(); i++) {
+        to_merge.emplace_back(histogram_params_);
+      }
       std::vector<StatusHistogram> to_merge_status(threads_.size());
 
       for (size_t i = 0; i < threads_.size(); i++) {
@@ -249,6 +253,17 @@ class Client {
 
   bool IsClosedLoop() { return closed_loop_; }
 
+  // Converts a time returned by NextIssueTime() to the UsageTimer::Now()
+  // time base.  Open-loop clients measure latency from the time a request
+  // was scheduled to be sent rather than from when it actually went out, so
+  // that a client falling behind its schedule (coordinated omission) shows
+  // up in the latency numbers instead of silently lowering the offered load.
+  static double IssueTimeToSeconds(gpr_timespec issue_time) {
+    const gpr_timespec t =
+        gpr_convert_clock_type(issue_time, GPR_CLOCK_REALTIME);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+  }
+
   gpr_timespec NextIssueTime(int thread_idx) {
     const gpr_timespec result = next_time_[thread_idx];
     next_time_[thread_idx] =
@@ -265,7 +280,11 @@ class Client {
   class Thread {
    public:
     Thread(Client* client, size_t idx)
-        : client_(client), idx_(idx), impl_(&Thread::ThreadFunc, this) {}
+        : histogram_(client->histogram_params_),
+          client_(client),
+          idx_(idx),
+          impl_(&Thread::ThreadFunc, this),
+          histogram_per_interval_(client->histogram_params_) {}
 
     ~Thread() { impl_.join(); }
 
@@ -361,6 +380,8 @@ class Client {
   virtual void DestroyMultithreading() = 0;
 
   void SetupLoadTest(const ClientConfig& config, size_t num_threads) {
+    histogram_params_ = config.histogram_params();
+
     // Set up the load distribution based on the number of threads
     const auto& load = config.load_params();
 
@@ -403,6 +424,8 @@ class Client {
   std::vector<std::unique_ptr<Thread>> threads_;
   std::unique_ptr<UsageTimer> timer_;
 
+  HistogramParams histogram_params_;
+
   InterarrivalTimer interarrival_timer_;
   std::vector<gpr_timespec> next_time_;
 
@@ -92,7 +92,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   bool RunNextState(bool /*ok*/, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        if (!next_issue_) start_ = UsageTimer::Now();
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -143,8 +143,10 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
     if (!next_issue_) {  // ready to issue
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
+      const gpr_timespec issue_time = next_issue_();
+      start_ = Client::IssueTimeToSeconds(issue_time);
       alarm_ = std::make_unique<Alarm>();
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
     }
   }
 };
@@ -370,16 +372,21 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
+        case State::WAIT: {
           next_state_ = State::READY_TO_WRITE;
+          // Time the request from when it was due, not from when the
+          // alarm actually fired.
+          const gpr_timespec issue_time = next_issue_();
+          start_ = Client::IssueTimeToSeconds(issue_time);
           alarm_ = std::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -556,16 +563,21 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
-          alarm_ = std::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+        case State::WAIT: {
           next_state_ = State::READY_TO_WRITE;
+          // Time the request from when it was due, not from when the
+          // alarm actually fired.
+          const gpr_timespec issue_time = next_issue_();
+          start_ = Client::IssueTimeToSeconds(issue_time);
+          alarm_ = std::make_unique<Alarm>();
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -803,16 +815,21 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
+        case State::WAIT: {
           next_state_ = State::READY_TO_WRITE;
+          // Time the request from when it was due, not from when the
+          // alarm actually fired.
+          const gpr_timespec issue_time = next_issue_();
+          start_ = Client::IssueTimeToSeconds(issue_time);
           alarm_ = std::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
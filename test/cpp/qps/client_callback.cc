@@ -173,21 +173,22 @@ class CallbackUnaryClient final : public CallbackClient {
     if (!closed_loop_) {
       gpr_timespec next_issue_time = NextRPCIssueTime();
       // Start an alarm callback to run the internal callback after
-      // next_issue_time
+      // next_issue_time, timing the RPC from when it was due rather than
+      // from when the alarm fired
       if (ctx_[vector_idx]->alarm_ == nullptr) {
         ctx_[vector_idx]->alarm_ = std::make_unique<Alarm>();
       }
-      ctx_[vector_idx]->alarm_->Set(next_issue_time,
-                                    [this, t, vector_idx](bool /*ok*/) {
-                                      IssueUnaryCallbackRpc(t, vector_idx);
-                                    });
+      const double start = IssueTimeToSeconds(next_issue_time);
+      ctx_[vector_idx]->alarm_->Set(
+          next_issue_time, [this, t, vector_idx, start](bool /*ok*/) {
+            IssueUnaryCallbackRpc(t, vector_idx, start);
+          });
     } else {
-      IssueUnaryCallbackRpc(t, vector_idx);
+      IssueUnaryCallbackRpc(t, vector_idx, UsageTimer::Now());
     }
   }
 
-  void IssueUnaryCallbackRpc(Thread* t, size_t vector_idx) {
-    double start = UsageTimer::Now();
+  void IssueUnaryCallbackRpc(Thread* t, size_t vector_idx, double start) {
     ctx_[vector_idx]->stub_->async()->UnaryCall(
         (&ctx_[vector_idx]->context_), &request_, &ctx_[vector_idx]->response_,
         [this, t, start, vector_idx](grpc::Status s) {
@@ -258,9 +259,9 @@ class CallbackStreamingPingPongReactor final
       std::unique_ptr<CallbackClientRpcContext> ctx)
       : client_(client), ctx_(std::move(ctx)), messages_issued_(0) {}
 
-  void StartNewRpc() {
+  void StartNewRpc(double write_time) {
     ctx_->stub_->async()->StreamingCall(&(ctx_->context_), this);
-    write_time_ = UsageTimer::Now();
+    write_time_ = write_time;
     StartWrite(client_->request());
     writes_done_started_.clear();
     StartCall();
@@ -294,9 +295,10 @@ class CallbackStreamingPingPongReactor final
     if (!client_->IsClosedLoop()) {
       gpr_timespec next_issue_time = client_->NextRPCIssueTime();
       // Start an alarm callback to run the internal callback after
-      // next_issue_time
-      ctx_->alarm_->Set(next_issue_time, [this](bool /*ok*/) {
-        write_time_ = UsageTimer::Now();
+      // next_issue_time, timing the round from when it was due
+      const double write_time = Client::IssueTimeToSeconds(next_issue_time);
+      ctx_->alarm_->Set(next_issue_time, [this, write_time](bool /*ok*/) {
+        write_time_ = write_time;
         StartWrite(client_->request());
       });
     } else {
@@ -322,10 +324,12 @@ class CallbackStreamingPingPongReactor final
       if (ctx_->alarm_ == nullptr) {
         ctx_->alarm_ = std::make_unique<Alarm>();
       }
-      ctx_->alarm_->Set(next_issue_time,
-                        [this](bool /*ok*/) { StartNewRpc(); });
+      const double write_time = Client::IssueTimeToSeconds(next_issue_time);
+      ctx_->alarm_->Set(next_issue_time, [this, write_time](bool /*ok*/) {
+        StartNewRpc(write_time);
+      });
     } else {
-      StartNewRpc();
+      StartNewRpc(UsageTimer::Now());
     }
   }
 
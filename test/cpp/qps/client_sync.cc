@@ -80,10 +80,14 @@ class SynchronousClient
   }
 
  protected:
-  // WaitToIssue returns false if we realize that we need to break out
-  bool WaitToIssue(int thread_idx) {
+  // WaitToIssue returns false if we realize that we need to break out.
+  // Otherwise, if start is non-null, it is set to the time the request
+  // should be timed from: now for closed loop, or the scheduled issue time
+  // for open loop (see Client::IssueTimeToSeconds).
+  bool WaitToIssue(int thread_idx, double* start = nullptr) {
     if (!closed_loop_) {
       const gpr_timespec next_issue_time = NextIssueTime(thread_idx);
+      if (start != nullptr) *start = IssueTimeToSeconds(next_issue_time);
       // Avoid sleeping for too long continuously because we might
       // need to terminate before then. This is an issue since
       // exponential distribution can occasionally produce bad outliers
@@ -102,6 +106,7 @@ class SynchronousClient
         }
       }
     }
+    if (start != nullptr) *start = UsageTimer::Now();
     return true;
   }
 
@@ -112,7 +117,8 @@ class SynchronousClient
 class SynchronousUnaryClient final : public SynchronousClient {
  public:
   explicit SynchronousUnaryClient(const ClientConfig& config)
-      : SynchronousClient(config) {
+      : SynchronousClient(config),
+        pass_messages_by_reference_(config.pass_messages_by_reference()) {
     StartThreads(num_threads_);
   }
   ~SynchronousUnaryClient() override {}
@@ -120,12 +126,13 @@ class SynchronousUnaryClient final : public SynchronousClient {
   bool InitThreadFuncImpl(size_t /*thread_idx*/) override { return true; }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double start;
+    if (!WaitToIssue(thread_idx, &start)) {
       return true;
     }
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
-    double start = UsageTimer::Now();
     grpc::ClientContext context;
+    context.set_pass_messages_by_reference(pass_messages_by_reference_);
     grpc::Status s =
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
     if (s.ok()) {
@@ -137,6 +144,8 @@ class SynchronousUnaryClient final : public SynchronousClient {
 
  private:
   void DestroyMultithreading() final { EndThreads(); }
+
+  const bool pass_messages_by_reference_;
 };
 
 template <class StreamType>
@@ -239,10 +248,10 @@ class SynchronousStreamingPingPongClient final
   }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double start;
+    if (!WaitToIssue(thread_idx, &start)) {
       return true;
     }
-    double start = UsageTimer::Now();
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
@@ -131,16 +131,18 @@ static bool IsSuccess(const Status& s) {
 }
 
 // Postprocess ScenarioResult and populate result summary.
-static void postprocess_scenario_result(ScenarioResult* result) {
+static void postprocess_scenario_result(
+    ScenarioResult* result, const HistogramParams& histogram_params) {
   // Get latencies from ScenarioResult latencies histogram and populate to
   // result summary.
-  Histogram histogram;
-  histogram.MergeProto(result->latencies());
+  Histogram histogram(histogram_params);
+  GPR_ASSERT(histogram.MergeProto(result->latencies()));
   result->mutable_summary()->set_latency_50(histogram.Percentile(50));
   result->mutable_summary()->set_latency_90(histogram.Percentile(90));
   result->mutable_summary()->set_latency_95(histogram.Percentile(95));
   result->mutable_summary()->set_latency_99(histogram.Percentile(99));
   result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
 
   // Calculate qps and cpu load for each client and then aggregate results for
   // all clients
@@ -260,7 +262,12 @@ static void ReceiveFinalStatusFromClients(
     if (client->stream->Read(&client_status)) {
       gpr_log(GPR_INFO, "Received final status from client %zu", i);
       const auto& stats = client_status.stats();
-      merged_latencies.MergeProto(stats.latencies());
+      if (!merged_latencies.MergeProto(stats.latencies())) {
+        gpr_log(GPR_ERROR,
+                "Latencies from client %zu do not match the scenario's "
+                "histogram params (%d buckets); leaving them out",
+                i, stats.latencies().bucket_size());
+      }
       for (int i = 0; i < stats.request_results_size(); i++) {
         merged_statuses[stats.request_results(i).status_code()] +=
             stats.request_results(i).count();
@@ -602,7 +609,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
 
   // Finish a run
   std::unique_ptr<ScenarioResult> result(new ScenarioResult);
-  Histogram merged_latencies;
+  Histogram merged_latencies(client_config.histogram_params());
   std::unordered_map<int, int64_t> merged_statuses;
 
   // For the case where clients lead the test such as UNARY and
@@ -645,7 +652,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   result->mutable_summary()->mutable_start_time()->set_seconds(start_time);
   result->mutable_summary()->mutable_end_time()->set_seconds(end_time);
 
-  postprocess_scenario_result(result.get());
+  postprocess_scenario_result(result.get(), client_config.histogram_params());
   return result;
 }
 
@@ -19,53 +19,135 @@
 #ifndef GRPC_TEST_CPP_QPS_HISTOGRAM_H
 #define GRPC_TEST_CPP_QPS_HISTOGRAM_H
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <grpc/support/log.h>
+
 #include "src/proto/grpc/testing/stats.pb.h"
 #include "test/core/util/histogram.h"
 
 namespace grpc {
 namespace testing {
 
+// HDR-style latency histogram.
+//
+// Values (nanoseconds) are bucketed into power-of-two ranges, each of which
+// is split into a fixed number of linear sub-buckets.  This bounds the
+// relative error of any recorded value by `resolution` across the whole
+// range up to `max_possible`, so that far tail percentiles (p99.9, p99.99)
+// are as precise as the median.  Histograms built with the same parameters
+// have identical layouts and can be merged, which is how per-thread
+// instances are combined by the client and the driver.
+//
+// Workers in other languages only report log buckets (see HistogramData), so
+// the same values are also kept in that layout.  Once such a report has been
+// merged, percentiles come from the log buckets.
 class Histogram {
  public:
-  // TODO(unknown): look into making histogram params not hardcoded for C++
-  Histogram()
-      : impl_(grpc_histogram_create(default_resolution(),
-                                    default_max_possible())) {}
-  ~Histogram() {
-    if (impl_) grpc_histogram_destroy(impl_);
+  Histogram() : Histogram(default_resolution(), default_max_possible()) {}
+  Histogram(double resolution, double max_possible) {
+    Init(resolution, max_possible);
   }
+  explicit Histogram(const HistogramParams& params)
+      : Histogram(params.resolution() > 0 ? params.resolution()
+                                          : default_resolution(),
+                  params.max_possible() > 0 ? params.max_possible()
+                                            : default_max_possible()) {}
+
+  Histogram(Histogram&& other) noexcept = default;
+  Histogram& operator=(Histogram&& other) noexcept = default;
+
   void Reset() {
-    if (impl_) grpc_histogram_destroy(impl_);
-    impl_ = grpc_histogram_create(default_resolution(), default_max_possible());
+    std::fill(counts_.begin(), counts_.end(), 0);
+    log_buckets_.reset(grpc_histogram_create(resolution_, max_possible_));
+    hdr_complete_ = true;
+    ResetStats();
+  }
+
+  void Merge(const Histogram& h) {
+    GPR_ASSERT(sub_bucket_half_count_magnitude_ ==
+                   h.sub_bucket_half_count_magnitude_ &&
+               counts_.size() == h.counts_.size());
+    GPR_ASSERT(grpc_histogram_merge(log_buckets_.get(), h.log_buckets_.get()));
+    hdr_complete_ = hdr_complete_ && h.hdr_complete_;
+    if (h.count_ == 0) return;
+    for (size_t i = 0; i < counts_.size(); i++) counts_[i] += h.counts_[i];
+    MergeStats(h.min_seen_, h.max_seen_, h.sum_, h.sum_of_squares_, h.count_);
   }
 
-  Histogram(Histogram&& other) noexcept : impl_(other.impl_) {
-    other.impl_ = nullptr;
+  void Add(double value) {
+    counts_[IndexFor(value)]++;
+    grpc_histogram_add(log_buckets_.get(), value);
+    MergeStats(value, value, value, value * value, 1);
   }
 
-  void Merge(const Histogram& h) { grpc_histogram_merge(impl_, h.impl_); }
-  void Add(double value) { grpc_histogram_add(impl_, value); }
+  // Returns the smallest value such that at least pctile percent of the
+  // recorded values are less than or equal to it (to within resolution).
   double Percentile(double pctile) const {
-    return grpc_histogram_percentile(impl_, pctile);
+    if (!hdr_complete_) {
+      return grpc_histogram_percentile(log_buckets_.get(), pctile);
+    }
+    if (count_ == 0) return 0;
+    if (pctile <= 0) return min_seen_;
+    if (pctile >= 100) return max_seen_;
+    const double target = std::ceil(count_ * pctile / 100.0);
+    double seen = 0;
+    for (size_t i = 0; i < counts_.size(); i++) {
+      seen += counts_[i];
+      if (seen >= target) {
+        return std::max(min_seen_, std::min(max_seen_, UpperBoundFor(i)));
+      }
+    }
+    return max_seen_;
   }
-  double Count() const { return grpc_histogram_count(impl_); }
-  void Swap(Histogram* other) { std::swap(impl_, other->impl_); }
+
+  double Count() const { return count_; }
+  void Swap(Histogram* other) { std::swap(*this, *other); }
+
   void FillProto(HistogramData* p) {
     size_t n;
-    const auto* data = grpc_histogram_get_contents(impl_, &n);
-    for (size_t i = 0; i < n; i++) {
-      p->add_bucket(data[i]);
+    const uint32_t* log_buckets =
+        grpc_histogram_get_contents(log_buckets_.get(), &n);
+    for (size_t i = 0; i < n; i++) p->add_bucket(log_buckets[i]);
+    if (hdr_complete_) {
+      for (uint32_t c : counts_) p->add_hdr_bucket(c);
+      p->set_hdr_layout(sub_bucket_half_count_magnitude_);
     }
-    p->set_min_seen(grpc_histogram_minimum(impl_));
-    p->set_max_seen(grpc_histogram_maximum(impl_));
-    p->set_sum(grpc_histogram_sum(impl_));
-    p->set_sum_of_squares(grpc_histogram_sum_of_squares(impl_));
-    p->set_count(grpc_histogram_count(impl_));
+    p->set_min_seen(min_seen_);
+    p->set_max_seen(max_seen_);
+    p->set_sum(sum_);
+    p->set_sum_of_squares(sum_of_squares_);
+    p->set_count(count_);
   }
-  void MergeProto(const HistogramData& p) {
-    grpc_histogram_merge_contents(impl_, &*p.bucket().begin(), p.bucket_size(),
+  // Returns false, leaving the histogram unchanged, if p was not built with
+  // the same HistogramParams.
+  bool MergeProto(const HistogramData& p) {
+    size_t n;
+    grpc_histogram_get_contents(log_buckets_.get(), &n);
+    if (static_cast<size_t>(p.bucket_size()) != n) return false;
+    if (p.count() == 0) return true;
+    grpc_histogram_merge_contents(log_buckets_.get(), p.bucket().data(), n,
                                   p.min_seen(), p.max_seen(), p.sum(),
                                   p.sum_of_squares(), p.count());
+    if (p.hdr_layout() ==
+            static_cast<uint32_t>(sub_bucket_half_count_magnitude_) &&
+        static_cast<size_t>(p.hdr_bucket_size()) == counts_.size()) {
+      for (size_t i = 0; i < counts_.size(); i++) {
+        counts_[i] += p.hdr_bucket(i);
+      }
+    } else {
+      hdr_complete_ = false;
+    }
+    MergeStats(p.min_seen(), p.max_seen(), p.sum(), p.sum_of_squares(),
+               p.count());
+    return true;
   }
 
   static double default_resolution() { return 0.01; }
@@ -75,7 +157,114 @@ class Histogram {
   Histogram(const Histogram&);
   Histogram& operator=(const Histogram&);
 
-  grpc_histogram* impl_;
+  struct LogBucketsDeleter {
+    void operator()(grpc_histogram* h) const { grpc_histogram_destroy(h); }
+  };
+
+  void Init(double resolution, double max_possible) {
+    GPR_ASSERT(resolution > 0 && resolution < 1);
+    GPR_ASSERT(max_possible >= 1);
+    resolution_ = resolution;
+    max_possible_ = max_possible;
+    log_buckets_.reset(grpc_histogram_create(resolution, max_possible));
+    hdr_complete_ = true;
+    // Within a power-of-two range [2^k, 2^(k+1)) the linear sub-buckets are
+    // 2^k / sub_bucket_half_count wide, so the relative error is at most
+    // 1 / sub_bucket_half_count.
+    sub_bucket_half_count_magnitude_ = 0;
+    while ((1.0 / (int64_t{1} << sub_bucket_half_count_magnitude_)) >
+           resolution) {
+      sub_bucket_half_count_magnitude_++;
+    }
+    const int64_t sub_bucket_count =
+        int64_t{1} << (sub_bucket_half_count_magnitude_ + 1);
+    sub_bucket_mask_ = sub_bucket_count - 1;
+    // The first bucket covers [0, sub_bucket_count) exactly; every
+    // following bucket doubles the covered range.
+    bucket_count_ = 1;
+    double covered = static_cast<double>(sub_bucket_count);
+    while (covered <= max_possible) {
+      covered *= 2;
+      bucket_count_++;
+    }
+    max_value_ = static_cast<int64_t>(std::min(
+        max_possible,
+        static_cast<double>(std::numeric_limits<int64_t>::max() / 2)));
+    counts_.assign((bucket_count_ + 1) * (sub_bucket_count / 2), 0);
+    ResetStats();
+  }
+
+  void ResetStats() {
+    min_seen_ = std::numeric_limits<double>::max();
+    max_seen_ = 0;
+    sum_ = 0;
+    sum_of_squares_ = 0;
+    count_ = 0;
+  }
+
+  void MergeStats(double min_seen, double max_seen, double sum,
+                  double sum_of_squares, double count) {
+    min_seen_ = std::min(min_seen_, min_seen);
+    max_seen_ = std::max(max_seen_, max_seen);
+    sum_ += sum;
+    sum_of_squares_ += sum_of_squares;
+    count_ += count;
+  }
+
+  // Values below sub_bucket_count land in bucket 0; bucket b > 0 holds
+  // values whose highest set bit is at position b + magnitude.
+  int BucketIndex(int64_t v) const {
+    const uint64_t x = static_cast<uint64_t>(v | sub_bucket_mask_);
+    int msb = sub_bucket_half_count_magnitude_;
+    while (x >> (msb + 1)) msb++;
+    return msb - sub_bucket_half_count_magnitude_;
+  }
+
+  // Buckets after the first only use the upper half of their sub-buckets
+  // (the lower half would overlap the previous bucket), which gives a dense
+  // index into counts_.
+  size_t IndexFor(double value) const {
+    const int64_t v =
+        value <= 0 ? 0
+                   : static_cast<int64_t>(
+                         std::min(value, static_cast<double>(max_value_)));
+    const int bucket = BucketIndex(v);
+    const int64_t sub_bucket = v >> bucket;
+    const int64_t half = int64_t{1} << sub_bucket_half_count_magnitude_;
+    return static_cast<size_t>(
+        ((int64_t{bucket} + 1) << sub_bucket_half_count_magnitude_) +
+        sub_bucket - half);
+  }
+
+  // Largest value that maps to counts_[index].
+  double UpperBoundFor(size_t index) const {
+    const int64_t half = int64_t{1} << sub_bucket_half_count_magnitude_;
+    const int64_t i = static_cast<int64_t>(index);
+    int64_t bucket = (i >> sub_bucket_half_count_magnitude_) - 1;
+    int64_t sub_bucket = (i & (half - 1)) + half;
+    if (bucket < 0) {
+      sub_bucket -= half;
+      bucket = 0;
+    }
+    return static_cast<double>(((sub_bucket + 1) << bucket) - 1);
+  }
+
+  double resolution_;
+  double max_possible_;
+  // The same values in the log layout of the HistogramData.bucket field.
+  std::unique_ptr<grpc_histogram, LogBucketsDeleter> log_buckets_;
+  // False once values only known by their log bucket have been merged in.
+  bool hdr_complete_;
+  int sub_bucket_half_count_magnitude_;
+  int64_t sub_bucket_mask_;
+  int bucket_count_;
+  int64_t max_value_;
+  std::vector<uint32_t> counts_;
+  double min_seen_;
+  double max_seen_;
+  double sum_;
+  double sum_of_squares_;
+  double count_;
 };
 }  // namespace testing
 }  // namespace grpc
@@ -0,0 +1,175 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "test/cpp/qps/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/histogram.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+TEST(HistogramTest, SmallValuesAreExact) {
+  for (int i = 0; i < 1000; i++) {
+    Histogram h;
+    h.Add(i);
+    EXPECT_EQ(h.Percentile(50), i);
+  }
+}
+
+TEST(HistogramTest, TailPercentilesWithinResolution) {
+  Histogram h;
+  std::vector<double> values;
+  std::mt19937_64 rng(42);
+  std::exponential_distribution<double> dist(1.0 / 1e5);
+  for (int i = 0; i < 1000000; i++) {
+    double v = dist(rng);
+    values.push_back(v);
+    h.Add(v);
+  }
+  std::sort(values.begin(), values.end());
+  for (double pctile : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+    size_t rank =
+        static_cast<size_t>(std::ceil(values.size() * pctile / 100)) - 1;
+    double exact = values[rank];
+    EXPECT_NEAR(h.Percentile(pctile), exact,
+                exact * Histogram::default_resolution())
+        << pctile;
+  }
+}
+
+TEST(HistogramTest, ConfigurablePrecision) {
+  HistogramParams params;
+  params.set_resolution(0.001);
+  params.set_max_possible(1e9);
+  Histogram h(params);
+  h.Add(123456789);
+  EXPECT_NEAR(h.Percentile(50), 123456789, 123456789 * 0.001);
+}
+
+TEST(HistogramTest, MergeAndProtoRoundTrip) {
+  Histogram a;
+  Histogram b;
+  for (int i = 1; i <= 100; i++) a.Add(i * 1000);
+  for (int i = 101; i <= 200; i++) b.Add(i * 1000);
+  a.Merge(b);
+  EXPECT_EQ(a.Count(), 200);
+  HistogramData data;
+  a.FillProto(&data);
+  Histogram c;
+  c.MergeProto(data);
+  EXPECT_EQ(c.Count(), 200);
+  EXPECT_EQ(c.Percentile(0), 1000);
+  EXPECT_EQ(c.Percentile(100), 200000);
+  EXPECT_NEAR(c.Percentile(50), 100000, 100000 * 0.01);
+}
+
+// Workers in other languages only send log buckets, as built by the core
+// histogram with the same params.
+HistogramData LogBucketsOnly(const std::vector<double>& values) {
+  grpc_histogram* h = grpc_histogram_create(Histogram::default_resolution(),
+                                            Histogram::default_max_possible());
+  for (double v : values) grpc_histogram_add(h, v);
+  size_t n;
+  const uint32_t* buckets = grpc_histogram_get_contents(h, &n);
+  HistogramData data;
+  for (size_t i = 0; i < n; i++) data.add_bucket(buckets[i]);
+  data.set_min_seen(grpc_histogram_minimum(h));
+  data.set_max_seen(grpc_histogram_maximum(h));
+  data.set_sum(grpc_histogram_sum(h));
+  data.set_sum_of_squares(grpc_histogram_sum_of_squares(h));
+  data.set_count(grpc_histogram_count(h));
+  grpc_histogram_destroy(h);
+  return data;
+}
+
+TEST(HistogramTest, ProtoKeepsLogBucketLayout) {
+  Histogram a;
+  std::vector<double> values;
+  for (int i = 1; i <= 100; i++) values.push_back(i * 1000);
+  for (double v : values) a.Add(v);
+  HistogramData data;
+  a.FillProto(&data);
+  HistogramData expected = LogBucketsOnly(values);
+  ASSERT_EQ(data.bucket_size(), expected.bucket_size());
+  for (int i = 0; i < data.bucket_size(); i++) {
+    EXPECT_EQ(data.bucket(i), expected.bucket(i)) << i;
+  }
+  EXPECT_NE(data.hdr_layout(), 0u);
+  EXPECT_GT(data.hdr_bucket_size(), 0);
+}
+
+TEST(HistogramTest, MergesLogBucketsFromOtherWorkers) {
+  Histogram a;
+  for (int i = 1; i <= 100; i++) a.Add(i * 1000);
+  std::vector<double> values;
+  for (int i = 101; i <= 200; i++) values.push_back(i * 1000);
+  HistogramData data;
+  a.FillProto(&data);
+  Histogram merged;
+  EXPECT_TRUE(merged.MergeProto(data));
+  EXPECT_TRUE(merged.MergeProto(LogBucketsOnly(values)));
+  EXPECT_EQ(merged.Count(), 200);
+  EXPECT_NEAR(merged.Percentile(50), 100000, 100000 * 0.02);
+  EXPECT_NEAR(merged.Percentile(99), 198000, 198000 * 0.02);
+  // Once merged, the HDR buckets are no longer complete, so they are not
+  // passed on.
+  HistogramData out;
+  merged.FillProto(&out);
+  EXPECT_EQ(out.hdr_layout(), 0u);
+  EXPECT_EQ(out.hdr_bucket_size(), 0);
+}
+
+TEST(HistogramTest, RejectsMismatchedLayout) {
+  Histogram other(0.05, 1e6);
+  other.Add(1000);
+  HistogramData data;
+  other.FillProto(&data);
+  Histogram h;
+  h.Add(10);
+  EXPECT_FALSE(h.MergeProto(data));
+  EXPECT_EQ(h.Count(), 1);
+  EXPECT_EQ(h.Percentile(50), 10);
+}
+
+TEST(HistogramTest, ValuesAboveMaxAreClamped) {
+  Histogram h(0.01, 1e6);
+  h.Add(1e9);
+  h.Add(10);
+  EXPECT_EQ(h.Count(), 2);
+  EXPECT_EQ(h.Percentile(100), 1e9);
+  EXPECT_EQ(h.Percentile(50), 10);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -35,8 +35,9 @@ namespace testing {
 static const int WARMUP = 1;
 static const int BENCHMARK = 3;
 
-static void RunSynchronousUnaryPingPong() {
-  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong");
+static void RunSynchronousUnaryPingPong(bool pass_messages_by_reference) {
+  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong%s",
+          pass_messages_by_reference ? " (messages passed by reference)" : "");
 
   ClientConfig client_config;
   client_config.set_client_type(SYNC_CLIENT);
@@ -44,9 +45,11 @@ static void RunSynchronousUnaryPingPong() {
   client_config.set_client_channels(1);
   client_config.set_rpc_type(UNARY);
   client_config.mutable_load_params()->mutable_closed_loop();
+  client_config.set_pass_messages_by_reference(pass_messages_by_reference);
 
   ServerConfig server_config;
   server_config.set_server_type(SYNC_SERVER);
+  server_config.set_pass_messages_by_reference(pass_messages_by_reference);
 
   const auto result =
       RunScenario(client_config, 1, server_config, 1, WARMUP, BENCHMARK, -2, "",
@@ -63,7 +66,8 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc::testing::InitTest(&argc, &argv, true);
 
-  grpc::testing::RunSynchronousUnaryPingPong();
+  grpc::testing::RunSynchronousUnaryPingPong(false);
+  grpc::testing::RunSynchronousUnaryPingPong(true);
 
   return 0;
 }
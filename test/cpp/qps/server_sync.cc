@@ -36,8 +36,12 @@ namespace testing {
 
 class BenchmarkServiceImpl final : public BenchmarkService::Service {
  public:
-  Status UnaryCall(ServerContext* /*context*/, const SimpleRequest* request,
+  explicit BenchmarkServiceImpl(bool pass_messages_by_reference)
+      : pass_messages_by_reference_(pass_messages_by_reference) {}
+
+  Status UnaryCall(ServerContext* context, const SimpleRequest* request,
                    SimpleResponse* response) override {
+    context->set_pass_messages_by_reference(pass_messages_by_reference_);
     auto s = SetResponse(request, response);
     if (!s.ok()) {
       return s;
@@ -150,11 +154,14 @@ class BenchmarkServiceImpl final : public BenchmarkService::Service {
     }
     return Status::OK;
   }
+
+  const bool pass_messages_by_reference_;
 };
 
 class SynchronousServer final : public grpc::testing::Server {
  public:
-  explicit SynchronousServer(const ServerConfig& config) : Server(config) {
+  explicit SynchronousServer(const ServerConfig& config)
+      : Server(config), service_(config.pass_messages_by_reference()) {
     std::unique_ptr<ServerBuilder> builder = CreateQpsServerBuilder();
 
     auto port_num = port();
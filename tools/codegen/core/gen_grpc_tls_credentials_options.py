@@ -220,6 +220,29 @@ _DATA_MEMBERS = [
         test_value_1='"crl_directory_1"',
         test_value_2='"crl_directory_2"',
     ),
+    DataMember(
+        name="session_ticket_key_provider",
+        type="grpc_core::RefCountedPtr<tsi::SslSessionTicketKeyProvider>",
+        override_getter="""tsi::SslSessionTicketKeyProvider* session_ticket_key_provider() const {
+    return session_ticket_key_provider_.get();
+  }""",
+        setter_comment=(
+            "Sets the source of the keys that a server encrypts its session"
+            " tickets with. Servers sharing a provider resume each other's"
+            " sessions. If not set, each server uses a key of its own that"
+            " never rotates. Ignored on the client side."
+        ),
+        setter_move_semantics=True,
+        test_name="DifferentSessionTicketKeyProvider",
+        test_value_1=(
+            "MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>("
+            "Duration::Hours(1), 2)"
+        ),
+        test_value_2=(
+            "MakeRefCounted<tsi::RotatingSslSessionTicketKeyProvider>("
+            "Duration::Hours(1), 2)"
+        ),
+    ),
 ]
 
 
@@ -294,6 +317,7 @@ print(
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_verifier.h"
 #include "src/core/lib/security/security_connector/ssl_utils.h"
+#include "src/core/tsi/ssl/session_ticket/ssl_session_ticket_key_provider.h"
 
 // Contains configurable options specified by callers to configure their certain
 // security features supported in TLS.